@@ -36,6 +36,46 @@ using namespace apache::thrift;
 using namespace apache::thrift::protocol;
 using namespace apache::thrift::transport;
 
+size_t g_calcite_plan_cache_max_entries{1024};
+
+namespace {
+
+// Collapses the runs of whitespace outside of quotes, so that reformatted queries share a plan.
+std::string normalize_sql(const std::string& sql) {
+  std::string normalized;
+  normalized.reserve(sql.size());
+  char quote = 0;
+  for (size_t i = 0; i < sql.size(); ++i) {
+    const char c = sql[i];
+    if (quote) {
+      normalized += c;
+      if (c == quote) {
+        quote = 0;
+      }
+      continue;
+    }
+    if (c == '\'' || c == '"') {
+      quote = c;
+    } else if (c == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+      // a line comment ends at the next newline, keep the rest as is
+      normalized += sql.substr(i);
+      break;
+    } else if (isspace(static_cast<unsigned char>(c))) {
+      if (!normalized.empty() && normalized.back() != ' ') {
+        normalized += ' ';
+      }
+      continue;
+    }
+    normalized += c;
+  }
+  if (!normalized.empty() && normalized.back() == ' ') {
+    normalized.pop_back();
+  }
+  return normalized;
+}
+
+}  // namespace
+
 void start_calcite_server_as_daemon(const int mapd_port,
                                     const int port,
                                     const std::string& data_dir,
@@ -180,13 +220,30 @@ void Calcite::updateMetadata(string catalog, string table) {
   } else {
     LOG(INFO) << "Not routing to Calcite, server is not up" << endl;
   }
+  // only bump the version once Calcite has seen the new metadata, plans made before are stale
+  std::lock_guard<std::mutex> lock(plan_cache_mutex_);
+  ++catalog_versions_[catalog];
 }
 
 string Calcite::process(const Catalog_Namespace::SessionInfo& session_info,
                         const string sql_string,
                         const bool legacy_syntax,
                         const bool is_explain) {
-  std::string ra = processImpl(session_info, sql_string, legacy_syntax, is_explain);
+  const auto& catalog_name = session_info.get_catalog().get_currentDB().dbName;
+  const auto plan_key = catalog_name + "\n" + session_info.get_currentUser().userName + "\n" +
+                        (legacy_syntax ? "legacy" : "") + (is_explain ? "explain" : "") + "\n" +
+                        normalize_sql(sql_string);
+  std::string ra;
+  if (getCachedPlan(ra, plan_key, catalog_name)) {
+    LOG(INFO) << "User " << session_info.get_currentUser().userName << " catalog " << catalog_name << " sql '"
+              << sql_string << "' (cached plan)";
+  } else {
+    const auto catalog_version = getCatalogVersion(catalog_name);
+    ra = processImpl(session_info, sql_string, legacy_syntax, is_explain);
+    if (!ra.empty()) {
+      addPlanToCache(plan_key, ra, catalog_name, catalog_version);
+    }
+  }
 
   // gather tables used in this query
   if (!is_explain) {
@@ -194,31 +251,94 @@ string Calcite::process(const Catalog_Namespace::SessionInfo& session_info,
     // basically add a structure that returns all objects even if it is explain
     // security requires explains to be restricted in real life
 
-    Catalog_Namespace::Catalog& catalog = session_info.get_catalog();
-    if (catalog.isAccessPrivCheckEnabled()) {
-      std::vector<DBObject> privObjects;
-      std::vector<std::string> v_db_obj = get_db_objects(ra);
-      for (size_t i = 0; i < v_db_obj.size(); i++) {
-        DBObject dbObject(v_db_obj[i], TableDBObjectType);
-        static_cast<Catalog_Namespace::SysCatalog&>(catalog).populateDBObjectKey(dbObject, catalog);
-        std::vector<bool> privs{true, false, false, false};  // SELECT
-        dbObject.setPrivileges(privs);
-        privObjects.push_back(dbObject);
-      }
-      if (!session_info.getSysCatalog()) {
-        throw std::runtime_error(
-            "After starting mapd server please login as mapd root user to mapd system DB prior to any other logins.");
-      } else {
-        if (!(static_cast<Catalog_Namespace::SysCatalog&>(catalog))
-                 .checkPrivileges(session_info.get_currentUser(), privObjects)) {
-          throw std::runtime_error("Violation of access privileges: user " + session_info.get_currentUser().userName +
-                                   " has no proper select privileges.");
-        }
+    checkAccessPrivileges(session_info, ra);
+  }
+
+  return ra;
+}
+
+void Calcite::checkAccessPrivileges(const Catalog_Namespace::SessionInfo& session_info, const std::string& ra) {
+  Catalog_Namespace::Catalog& catalog = session_info.get_catalog();
+  if (catalog.isAccessPrivCheckEnabled()) {
+    std::vector<DBObject> privObjects;
+    std::vector<std::string> v_db_obj = get_db_objects(ra);
+    for (size_t i = 0; i < v_db_obj.size(); i++) {
+      DBObject dbObject(v_db_obj[i], TableDBObjectType);
+      static_cast<Catalog_Namespace::SysCatalog&>(catalog).populateDBObjectKey(dbObject, catalog);
+      std::vector<bool> privs{true, false, false, false};  // SELECT
+      dbObject.setPrivileges(privs);
+      privObjects.push_back(dbObject);
+    }
+    if (!session_info.getSysCatalog()) {
+      throw std::runtime_error(
+          "After starting mapd server please login as mapd root user to mapd system DB prior to any other logins.");
+    } else {
+      if (!(static_cast<Catalog_Namespace::SysCatalog&>(catalog))
+               .checkPrivileges(session_info.get_currentUser(), privObjects)) {
+        throw std::runtime_error("Violation of access privileges: user " + session_info.get_currentUser().userName +
+                                 " has no proper select privileges.");
       }
     }
   }
+}
 
-  return ra;
+Calcite::PlanCacheStats Calcite::getPlanCacheStats() const {
+  std::lock_guard<std::mutex> lock(plan_cache_mutex_);
+  return {plan_cache_hits_, plan_cache_misses_, plan_cache_.size(), g_calcite_plan_cache_max_entries};
+}
+
+bool Calcite::getCachedPlan(std::string& ra, const std::string& key, const std::string& catalog) {
+  std::lock_guard<std::mutex> lock(plan_cache_mutex_);
+  auto it = plan_cache_.find(key);
+  if (it == plan_cache_.end()) {
+    ++plan_cache_misses_;
+    return false;
+  }
+  if (it->second.catalog_version != catalogVersionNoLock(catalog)) {
+    plan_cache_lru_.erase(it->second.lru_it);
+    plan_cache_.erase(it);
+    ++plan_cache_misses_;
+    return false;
+  }
+  plan_cache_lru_.splice(plan_cache_lru_.begin(), plan_cache_lru_, it->second.lru_it);
+  ++plan_cache_hits_;
+  ra = it->second.ra;
+  return true;
+}
+
+void Calcite::addPlanToCache(const std::string& key,
+                             const std::string& ra,
+                             const std::string& catalog,
+                             const size_t catalog_version) {
+  std::lock_guard<std::mutex> lock(plan_cache_mutex_);
+  if (!g_calcite_plan_cache_max_entries || catalog_version != catalogVersionNoLock(catalog)) {
+    // the metadata changed while planning, the plan might already be stale
+    return;
+  }
+  auto it = plan_cache_.find(key);
+  if (it != plan_cache_.end()) {
+    // planned concurrently by another session
+    plan_cache_lru_.erase(it->second.lru_it);
+    plan_cache_.erase(it);
+  }
+  auto it_ok = plan_cache_.emplace(key, CachedPlan{ra, catalog_version, plan_cache_lru_.end()});
+  CHECK(it_ok.second);
+  plan_cache_lru_.push_front(&it_ok.first->first);
+  it_ok.first->second.lru_it = plan_cache_lru_.begin();
+  while (plan_cache_.size() > g_calcite_plan_cache_max_entries) {
+    plan_cache_.erase(*plan_cache_lru_.back());
+    plan_cache_lru_.pop_back();
+  }
+}
+
+size_t Calcite::getCatalogVersion(const std::string& catalog) const {
+  std::lock_guard<std::mutex> lock(plan_cache_mutex_);
+  return catalogVersionNoLock(catalog);
+}
+
+size_t Calcite::catalogVersionNoLock(const std::string& catalog) const {
+  const auto it = catalog_versions_.find(catalog);
+  return it == catalog_versions_.end() ? 0 : it->second;
 }
 
 std::vector<TCompletionHint> Calcite::getCompletionHints(const Catalog_Namespace::SessionInfo& session_info,
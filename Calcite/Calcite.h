@@ -27,10 +27,15 @@
 #include <thrift/protocol/TBinaryProtocol.h>
 #include <thrift/transport/TSocket.h>
 #include <thrift/transport/TTransportUtils.h>
+#include <list>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 #include "gen-cpp/CalciteServer.h"
 #include "rapidjson/document.h"
 
+extern size_t g_calcite_plan_cache_max_entries;
+
 namespace Catalog_Namespace {
 class SessionInfo;
 }
@@ -49,6 +54,21 @@ class Calcite {
   void updateMetadata(std::string catalog, std::string table);
   virtual ~Calcite();
 
+  struct PlanCacheStats {
+    size_t hits;
+    size_t misses;
+    size_t entries;
+    size_t max_entries;
+  };
+
+  PlanCacheStats getPlanCacheStats() const;
+
+  // Version of the metadata of the catalog, plans obtained before a change must be discarded.
+  size_t getCatalogVersion(const std::string& catalog) const;
+
+  // Throws if the user isn't allowed to select from all the tables the plan reads from.
+  void checkAccessPrivileges(const Catalog_Namespace::SessionInfo& session_info, const std::string& ra);
+
  private:
   void runServer(const int mapd_port, const int port, const std::string& data_dir, const size_t calcite_max_mem);
   std::string processImpl(const Catalog_Namespace::SessionInfo& session_info,
@@ -57,11 +77,34 @@ class Calcite {
                           const bool is_explain);
   std::vector<std::string> get_db_objects(const std::string ra);
 
+  // Plans are cached on the normalized SQL text along with everything else Calcite gets to see.
+  // An entry is only valid for the version of the catalog it has been planned against, the
+  // version is bumped every time the metadata Calcite knows about changes.
+  bool getCachedPlan(std::string& ra, const std::string& key, const std::string& catalog);
+  void addPlanToCache(const std::string& key,
+                      const std::string& ra,
+                      const std::string& catalog,
+                      const size_t catalog_version);
+  size_t catalogVersionNoLock(const std::string& catalog) const;
+
   std::thread calcite_server_thread_;
   int ping();
 
   bool server_available_;
   int remote_calcite_port_ = -1;
+
+  struct CachedPlan {
+    std::string ra;
+    size_t catalog_version;
+    std::list<const std::string*>::iterator lru_it;
+  };
+
+  std::unordered_map<std::string, CachedPlan> plan_cache_;
+  std::list<const std::string*> plan_cache_lru_;  // most recently used first, points to the keys of plan_cache_
+  std::unordered_map<std::string, size_t> catalog_versions_;
+  size_t plan_cache_hits_ = 0;
+  size_t plan_cache_misses_ = 0;
+  mutable std::mutex plan_cache_mutex_;
 };
 
 #endif /* CALCITE_H */
@@ -33,6 +33,7 @@
 #include "SharedDictionaryValidator.h"
 #include "../Fragmenter/Fragmenter.h"
 #include "../Fragmenter/InsertOrderFragmenter.h"
+#include "../Fragmenter/SortedOrderFragmenter.h"
 #include "../Parser/ParserNode.h"
 #include "../Shared/StringTransform.h"
 #include "../Shared/measure.h"
@@ -46,6 +47,7 @@ using std::pair;
 using std::vector;
 using Chunk_NS::Chunk;
 using Fragmenter_Namespace::InsertOrderFragmenter;
+using Fragmenter_Namespace::SortedOrderFragmenter;
 
 bool g_aggregator{false};
 
@@ -226,7 +228,7 @@ void SysCatalog::createDatabase(const string& name, int owner) {
       "CREATE TABLE mapd_tables (tableid integer primary key, name text unique, ncolumns integer, isview boolean, "
       "fragments text, frag_type integer, max_frag_rows integer, max_chunk_size bigint, frag_page_size integer, "
       "max_rows bigint, partitions text, shard_column_id integer, shard integer, num_shards integer, version_num "
-      "BIGINT DEFAULT 1) ");
+      "BIGINT DEFAULT 1, storage_compression integer DEFAULT 0, sort_column_id integer DEFAULT 0) ");
   dbConn.query(
       "CREATE TABLE mapd_columns (tableid integer references mapd_tables, columnid integer, name text, coltype "
       "integer, colsubtype integer, coldim integer, colscale integer, is_notnull boolean, compression integer, "
@@ -1031,6 +1033,14 @@ void Catalog::updateTableDescriptorSchema() {
       string queryString("ALTER TABLE mapd_tables ADD key_metainfo TEXT DEFAULT '[]'");
       sqliteConnector_.query(queryString);
     }
+    if (std::find(cols.begin(), cols.end(), std::string("storage_compression")) == cols.end()) {
+      string queryString("ALTER TABLE mapd_tables ADD storage_compression INTEGER DEFAULT 0");
+      sqliteConnector_.query(queryString);
+    }
+    if (std::find(cols.begin(), cols.end(), std::string("sort_column_id")) == cols.end()) {
+      string queryString("ALTER TABLE mapd_tables ADD sort_column_id INTEGER DEFAULT 0");
+      sqliteConnector_.query(queryString);
+    }
   } catch (std::exception& e) {
     sqliteConnector_.query("ROLLBACK TRANSACTION");
     throw;
@@ -1341,7 +1351,8 @@ void Catalog::buildMaps() {
 
   string tableQuery(
       "SELECT tableid, name, ncolumns, isview, fragments, frag_type, max_frag_rows, max_chunk_size, frag_page_size, "
-      "max_rows, partitions, shard_column_id, shard, num_shards, key_metainfo from mapd_tables");
+      "max_rows, partitions, shard_column_id, shard, num_shards, key_metainfo, storage_compression, sort_column_id "
+      "from mapd_tables");
   sqliteConnector_.query(tableQuery);
   numRows = sqliteConnector_.getNumRows();
   for (size_t r = 0; r < numRows; ++r) {
@@ -1361,6 +1372,8 @@ void Catalog::buildMaps() {
     td->shard = sqliteConnector_.getData<int>(r, 12);
     td->nShards = sqliteConnector_.getData<int>(r, 13);
     td->keyMetainfo = sqliteConnector_.getData<string>(r, 14);
+    td->storageCompression = static_cast<File_Namespace::PageCodec>(sqliteConnector_.getData<int>(r, 15));
+    td->sortedColumnId = sqliteConnector_.getData<int>(r, 16);
     if (!td->isView) {
       td->fragmenter = nullptr;
     }
@@ -1573,23 +1586,39 @@ void Catalog::addLinkToMap(LinkDescriptor& ld) {
 void Catalog::instantiateFragmenter(TableDescriptor* td) const {
   auto time_ms = measure<>::execution([&]() {
     // instanciate table fragmenter upon first use
-    // assume only insert order fragmenter is supported
-    assert(td->fragType == Fragmenter_Namespace::FragmenterType::INSERT_ORDER);
     vector<Chunk> chunkVec;
     list<const ColumnDescriptor*> columnDescs;
     getAllColumnMetadataForTable(td, columnDescs, true, false);
     Chunk::translateColumnDescriptorsToChunkVec(columnDescs, chunkVec);
     ChunkKey chunkKeyPrefix = {currentDB_.dbId, td->tableId};
-    td->fragmenter = new InsertOrderFragmenter(chunkKeyPrefix,
-                                               chunkVec,
-                                               dataMgr_.get(),
-                                               td->tableId,
-                                               td->shard,
-                                               td->maxFragRows,
-                                               td->maxChunkSize,
-                                               td->fragPageSize,
-                                               td->maxRows,
-                                               td->persistenceLevel);
+    if (td->storageCompression != File_Namespace::PageCodec::NONE) {
+      dataMgr_->setTableStorageCompression(currentDB_.dbId, td->tableId, td->storageCompression);
+    }
+    if (td->fragType == Fragmenter_Namespace::FragmenterType::SORTED_ORDER) {
+      td->fragmenter = new SortedOrderFragmenter(chunkKeyPrefix,
+                                                 chunkVec,
+                                                 dataMgr_.get(),
+                                                 td->tableId,
+                                                 td->shard,
+                                                 td->sortedColumnId,
+                                                 td->maxFragRows,
+                                                 td->maxChunkSize,
+                                                 td->fragPageSize,
+                                                 td->maxRows,
+                                                 td->persistenceLevel);
+    } else {
+      CHECK_EQ(Fragmenter_Namespace::FragmenterType::INSERT_ORDER, td->fragType);
+      td->fragmenter = new InsertOrderFragmenter(chunkKeyPrefix,
+                                                 chunkVec,
+                                                 dataMgr_.get(),
+                                                 td->tableId,
+                                                 td->shard,
+                                                 td->maxFragRows,
+                                                 td->maxChunkSize,
+                                                 td->fragPageSize,
+                                                 td->maxRows,
+                                                 td->persistenceLevel);
+    }
   });
   LOG(INFO) << "Instantiating Fragmenter for table " << td->tableName << " took " << time_ms << "ms";
 }
@@ -1785,8 +1814,9 @@ void Catalog::createTable(TableDescriptor& td,
     try {
       sqliteConnector_.query_with_text_params(
           "INSERT INTO mapd_tables (name, ncolumns, isview, fragments, frag_type, max_frag_rows, max_chunk_size, "
-          "frag_page_size, max_rows, partitions, shard_column_id, shard, num_shards, key_metainfo) VALUES (?, ?, ?, ?, "
-          "?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+          "frag_page_size, max_rows, partitions, shard_column_id, shard, num_shards, key_metainfo, "
+          "storage_compression, sort_column_id) "
+          "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
 
           std::vector<std::string>{td.tableName,
                                    std::to_string(columns.size()),
@@ -1801,7 +1831,9 @@ void Catalog::createTable(TableDescriptor& td,
                                    std::to_string(td.shardedColumnId),
                                    std::to_string(td.shard),
                                    std::to_string(td.nShards),
-                                   td.keyMetainfo});
+                                   td.keyMetainfo,
+                                   std::to_string(static_cast<int>(td.storageCompression)),
+                                   std::to_string(td.sortedColumnId)});
 
       // now get the auto generated tableid
       sqliteConnector_.query_with_text_param("SELECT tableid FROM mapd_tables WHERE name = ?", td.tableName);
@@ -20,6 +20,7 @@
 #include <string>
 #include <cstdint>
 #include "../DataMgr/MemoryLevel.h"
+#include "../DataMgr/FileMgr/PageCodec.h"
 #include "../Shared/sqldefs.h"
 #include "../Fragmenter/AbstractFragmenter.h"
 
@@ -37,7 +38,7 @@ struct TableDescriptor {
   bool isView;
   std::string viewSQL;
   std::string fragments;                          // placeholder for fragmentation information
-  Fragmenter_Namespace::FragmenterType fragType;  // fragmentation type. Only INSERT_ORDER is supported now.
+  Fragmenter_Namespace::FragmenterType fragType;  // fragmentation type, SORTED_ORDER when sortedColumnId is set
   int32_t maxFragRows;                            // max number of rows per fragment
   int64_t maxChunkSize;                           // max number of rows per fragment
   int32_t fragPageSize;                           // page size
@@ -48,13 +49,17 @@ struct TableDescriptor {
       fragmenter;       // point to fragmenter object for the table.  it's instantiated upon first use.
   int32_t nShards;      // # of shards, i.e. physical tables for this logical table (default: 0)
   int shardedColumnId;  // Id of the column to be sharded on
+  int sortedColumnId;   // Id of the column the rows are clustered on (default: 0, none)
   Data_Namespace::MemoryLevel persistenceLevel;
+  File_Namespace::PageCodec storageCompression;  // codec the pages of the table are compressed with on disk
   TableDescriptor()
       : tableId(-1),
         shard(-1),
         nShards(0),
         shardedColumnId(0),
-        persistenceLevel(Data_Namespace::MemoryLevel::DISK_LEVEL) {}
+        sortedColumnId(0),
+        persistenceLevel(Data_Namespace::MemoryLevel::DISK_LEVEL),
+        storageCompression(File_Namespace::PageCodec::NONE) {}
 };
 
 inline bool table_is_replicated(const TableDescriptor* td) {
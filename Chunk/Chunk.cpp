@@ -128,6 +128,12 @@ size_t Chunk::getNumElemsForBytesInsertData(const DataBlockPtr& src_data,
   }
 }
 
+void Chunk::checkAppendData(const DataBlockPtr& src_data, const size_t num_elems) const {
+  if (!column_desc->columnType.is_varlen()) {
+    buffer->encoder->checkAppendData(src_data.numbersPtr, num_elems);
+  }
+}
+
 ChunkMetadata Chunk::appendData(DataBlockPtr& src_data, const size_t num_elems, const size_t start_idx) {
   if (column_desc->columnType.is_varlen()) {
     switch (column_desc->columnType.get_type()) {
@@ -188,6 +194,12 @@ ChunkIter Chunk::begin_iterator(const ChunkMetadata& chunk_metadata, int start_i
     it.current_pos = it.start_pos = index_buf->getMemoryPtr() + start_idx * sizeof(StringOffsetT);
     it.end_pos = index_buf->getMemoryPtr() + index_buf->size() - sizeof(StringOffsetT);
     it.second_buf = buffer->getMemoryPtr();
+  } else if (it.type_info.get_compression() == kENCODING_RL || it.type_info.get_compression() == kENCODING_DIFF ||
+             it.type_info.get_compression() == kENCODING_PACKED) {
+    // elements aren't addressable, the positions are virtual and decoded from the start of the chunk
+    it.second_buf = buffer->getMemoryPtr();
+    it.current_pos = it.start_pos = it.second_buf + start_idx * it.skip_size;
+    it.end_pos = it.second_buf + chunk_metadata.numElements * it.skip_size;
   } else {
     it.current_pos = it.start_pos = buffer->getMemoryPtr() + start_idx * it.skip_size;
     it.end_pos = buffer->getMemoryPtr() + buffer->size();
@@ -60,6 +60,7 @@ class Chunk {
                                        const size_t start_idx,
                                        const size_t byte_limit);
   ChunkMetadata appendData(DataBlockPtr& srcData, const size_t numAppendElems, const size_t startIdx);
+  void checkAppendData(const DataBlockPtr& srcData, const size_t numAppendElems) const;
   void createChunkBuffer(DataMgr* data_mgr,
                          const ChunkKey& key,
                          const MemoryLevel mem_level,
@@ -118,6 +118,8 @@ class AbstractBuffer {
         initEncoder(srcBuffer->sqlType);
       }
       encoder->copyMetadata(srcBuffer->encoder.get());
+      const auto& srcSketch = srcBuffer->encoder->chunkSketch;
+      encoder->chunkSketch.reset(srcSketch ? new ChunkSketch(*srcSketch) : nullptr);
     }
   }
 
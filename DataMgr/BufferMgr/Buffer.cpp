@@ -37,7 +37,14 @@ Buffer::Buffer(BufferMgr* bm,
                const int deviceId,
                const size_t pageSize,
                const size_t numBytes)
-    : AbstractBuffer(deviceId), mem_(0), bm_(bm), segIt_(segIt), pageSize_(pageSize), numPages_(0), pinCount_(0) {
+    : AbstractBuffer(deviceId),
+      mem_(0),
+      bm_(bm),
+      segIt_(segIt),
+      pageSize_(pageSize),
+      numPages_(0),
+      pinCount_(0),
+      isLoaded_(false) {
   pin();
   // so that the pointer value of this Buffer is stored
   segIt_->buffer = this;
@@ -25,6 +25,7 @@
 #include "../AbstractBuffer.h"
 #include "BufferSeg.h"
 
+#include <atomic>
 #include <iostream>
 #include <mutex>
 //#include <boost/thread/locks.hpp>
@@ -169,6 +170,7 @@ class Buffer : public AbstractBuffer {
   std::vector<bool> pageDirtyFlags_;
   int pinCount_;
   std::mutex pinMutex_;
+  std::atomic<bool> isLoaded_;  /// set once the chunk has been read in, lookups skip the pool lock from then on
 };
 
 }  // Buffer_Namespace
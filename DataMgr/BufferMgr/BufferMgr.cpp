@@ -26,6 +26,8 @@
 #include <algorithm>
 #include <limits>
 #include <iomanip>
+#include <set>
+#include <boost/functional/hash.hpp>
 #include <glog/logging.h>
 
 using namespace std;
@@ -56,8 +58,10 @@ BufferMgr::BufferMgr(const int deviceId,
       allocationsCapped_(false),
       parentMgr_(parentMgr),
       maxBufferId_(0),
-      bufferEpoch_(0) {
+      bufferEpoch_(1),
+      evictionPolicy_(EvictionPolicy::create(g_buffer_eviction_policy)) {
   CHECK(maxBufferSize_ > 0 && maxSlabSize_ > 0 && pageSize_ > 0 && maxSlabSize_ % pageSize_ == 0);
+  CHECK(evictionPolicy_);
   maxNumPages_ = maxBufferSize_ / pageSize_;
   maxNumPagesPerSlab_ = maxSlabSize_ / pageSize_;
   currentMaxSlabPageSize_ =
@@ -69,18 +73,27 @@ BufferMgr::~BufferMgr() {
   clear();
 }
 
+size_t BufferMgr::getShardId(const ChunkKey& key) {
+  return boost::hash_range(key.begin(), key.end()) % NUM_CHUNK_INDEX_SHARDS;
+}
+
+ChunkIndexShard& BufferMgr::getShard(const ChunkKey& key) {
+  return chunkIndexShards_[getShardId(key)];
+}
+
 void BufferMgr::clear() {
   std::lock_guard<std::mutex> sizedSegsLock(sizedSegsMutex_);
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  std::lock_guard<std::mutex> unsizedSegsLock(unsizedSegsMutex_);
-  for (auto bufferIt = chunkIndex_.begin(); bufferIt != chunkIndex_.end(); ++bufferIt) {
-    delete bufferIt->second->buffer;
+  for (auto& shard : chunkIndexShards_) {
+    mapd_lock_guard<mapd_shared_mutex> shardLock(shard.mutex);
+    for (auto bufferIt = shard.index.begin(); bufferIt != shard.index.end(); ++bufferIt) {
+      delete bufferIt->second->buffer;
+    }
+    shard.index.clear();
   }
-  chunkIndex_.clear();
   slabs_.clear();
   slabSegments_.clear();
   unsizedSegs_.clear();
-  bufferEpoch_ = 0;
+  bufferEpoch_ = 1;
 }
 
 /// Throws a runtime_error if the Chunk already exists
@@ -94,34 +107,40 @@ AbstractBuffer* BufferMgr::createBuffer(const ChunkKey& chunkKey,
   }
 
   // ChunkPageSize here is just for recording dirty pages
+  auto& shard = getShard(chunkKey);
+  BufferList::iterator segIt;
   {
-    std::lock_guard<std::mutex> lock(chunkIndexMutex_);
-    CHECK(chunkIndex_.find(chunkKey) == chunkIndex_.end());
+    mapd_lock_guard<mapd_shared_mutex> shardLock(shard.mutex);
+    CHECK(shard.index.find(chunkKey) == shard.index.end());
     BufferSeg bufferSeg(BufferSeg(-1, 0, USED));
     bufferSeg.chunkKey = chunkKey;
     std::lock_guard<std::mutex> unsizedSegsLock(unsizedSegsMutex_);
     unsizedSegs_.push_back(bufferSeg);  // race condition?
-    chunkIndex_[chunkKey] =
-        std::prev(unsizedSegs_.end(),
-                  1);  // need to do this before allocating Buffer because doing so could change the segment used
+    segIt = std::prev(unsizedSegs_.end(), 1);
+    shard.index[chunkKey] = segIt;  // need to do this before allocating Buffer because doing so could change the
+                                    // segment used
   }
   // following should be safe outside the lock b/c first thing Buffer
   // constructor does is pin (and its still in unsized segs at this point
   // so can't be evicted)
   try {
-    allocateBuffer(chunkIndex_[chunkKey], actualChunkPageSize, initialSize);
+    allocateBuffer(segIt, actualChunkPageSize, initialSize);
   } catch (const OutOfMemory&) {
-    auto bufferIt = chunkIndex_.find(chunkKey);
-    CHECK(bufferIt != chunkIndex_.end());
-    bufferIt->second->buffer = 0;  // constructor failed for the buffer object so make sure to mark it zero so
-                                   // deleteBuffer doesn't try to delete it
+    {
+      mapd_shared_lock<mapd_shared_mutex> shardLock(shard.mutex);
+      auto bufferIt = shard.index.find(chunkKey);
+      CHECK(bufferIt != shard.index.end());
+      bufferIt->second->buffer = 0;  // constructor failed for the buffer object so make sure to mark it zero so
+                                     // deleteBuffer doesn't try to delete it
+    }
     deleteBuffer(chunkKey);
     throw;
   }
-  CHECK(initialSize == 0 || chunkIndex_[chunkKey]->buffer->getMemoryPtr());
-  // chunkIndex_[chunkKey]->buffer->pin();
-  std::lock_guard<std::mutex> lock(chunkIndexMutex_);
-  return chunkIndex_[chunkKey]->buffer;
+  mapd_shared_lock<mapd_shared_mutex> shardLock(shard.mutex);
+  auto bufferIt = shard.index.find(chunkKey);
+  CHECK(bufferIt != shard.index.end());
+  CHECK(initialSize == 0 || bufferIt->second->buffer->getMemoryPtr());
+  return bufferIt->second->buffer;
 }
 
 BufferList::iterator BufferMgr::evict(BufferList::iterator& evictStart,
@@ -130,16 +149,37 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evictStart,
   // We can assume here that buffer for evictStart either doesn't exist
   // (evictStart is first buffer) or was not free, so don't need ot merge
   // it
-  auto evictIt = evictStart;
+  // Resident chunks get pinned under a shared lock of their index shard,
+  // lock the shards of the chunks to evict so that they can't be pinned
+  // anymore and give up if one of them was pinned in the meantime
+  std::set<size_t> shardIds;
   size_t numPages = 0;
-  size_t startPage = evictStart->startPage;
-  while (numPages < numPagesRequested) {
+  for (auto evictIt = evictStart; numPages < numPagesRequested; ++evictIt) {
     if (evictIt->memStatus == USED) {
-      CHECK(evictIt->buffer->getPinCount() < 1);
+      shardIds.insert(getShardId(evictIt->chunkKey));
     }
     numPages += evictIt->numPages;
+  }
+  std::vector<mapd_unique_lock<mapd_shared_mutex>> shardLocks;
+  for (const auto shardId : shardIds) {
+    shardLocks.emplace_back(chunkIndexShards_[shardId].mutex);
+  }
+  numPages = 0;
+  for (auto evictIt = evictStart; numPages < numPagesRequested; ++evictIt) {
+    if (evictIt->memStatus == USED && evictIt->buffer->getPinCount() > 0) {
+      return slabSegments_[slabNum].end();
+    }
+    numPages += evictIt->numPages;
+  }
+
+  auto evictIt = evictStart;
+  numPages = 0;
+  size_t startPage = evictStart->startPage;
+  while (numPages < numPagesRequested) {
+    numPages += evictIt->numPages;
     if (evictIt->memStatus == USED && evictIt->chunkKey.size() > 0) {
-      chunkIndex_.erase(evictIt->chunkKey);
+      getShard(evictIt->chunkKey).index.erase(evictIt->chunkKey);
+      countEviction(evictIt->chunkKey);
     }
     evictIt = slabSegments_[slabNum].erase(evictIt);  // erase operations returns next iterator - safe if we ever move
                                                       // to a vector (as opposed to erase(evictIt++)
@@ -193,6 +233,10 @@ BufferList::iterator BufferMgr::reserveBuffer(BufferList::iterator& segIt,
 
   /* Below should be in copy constructor for BufferSeg?*/
   newSegIt->buffer = segIt->buffer;
+  if (segIt->slabNum >= 0) {  // keep the access history of the chunk
+    newSegIt->lastTouched = segIt->lastTouched;
+    newSegIt->prevTouched = segIt->prevTouched;
+  }
   // newSegIt->buffer->segIt_ = newSegIt;
   newSegIt->chunkKey = segIt->chunkKey;
   int8_t* oldMem = newSegIt->buffer->mem_;
@@ -205,10 +249,12 @@ BufferList::iterator BufferMgr::reserveBuffer(BufferList::iterator& segIt,
     newSegIt->buffer->writeData(oldMem, newSegIt->buffer->size(), 0, newSegIt->buffer->getType(), deviceId_);
   }
   // Deincrement pin count to reverse effect above
-  removeSegment(segIt);
   {
-    std::lock_guard<std::mutex> lock(chunkIndexMutex_);
-    chunkIndex_[newSegIt->chunkKey] = newSegIt;
+    // readers of the index must not see the old segment once it's removed
+    auto& shard = getShard(newSegIt->chunkKey);
+    mapd_lock_guard<mapd_shared_mutex> shardLock(shard.mutex);
+    removeSegment(segIt);
+    shard.index[newSegIt->chunkKey] = newSegIt;
   }
 
   return newSegIt;
@@ -221,7 +267,7 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slabNum, const
       size_t excessPages = bufferIt->numPages - numPagesRequested;
       bufferIt->numPages = numPagesRequested;
       bufferIt->memStatus = USED;
-      bufferIt->lastTouched = bufferEpoch_++;
+      evictionPolicy_->admit(*bufferIt, bufferEpoch_++);
       bufferIt->slabNum = slabNum;
       if (excessPages > 0) {
         BufferSeg freeSeg(bufferIt->startPage + numPagesRequested, excessPages, FREE);
@@ -303,9 +349,9 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t numBytes) {
 
   size_t minScore = std::numeric_limits<size_t>::max();
   // We're going for lowest score here, like golf
-  // This is because score is the sum of the lastTouched score for all
-  // pages evicted. Evicting less pages and older pages will lower the
-  // score
+  // This is because score is the highest eviction policy score of all
+  // the segments evicted. Evicting less pages and older pages will lower
+  // the score
   BufferList::iterator bestEvictionStart = slabSegments_[0].end();
   int bestEvictionStartSlab = -1;
   int slabNum = 0;
@@ -327,9 +373,9 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t numBytes) {
       bool solutionFound = false;
       auto evictIt = bufferIt;
       for (; evictIt != slabSegments_[slabNum].end(); ++evictIt) {
-        // pinCount should never go up - only down because we have
-        // global lock on buffer pool and pin count only increments
-        // on getChunk
+        // pinCount can go up since lookups of resident chunks don't
+        // take the global lock, evict checks it again under the locks
+        // of the chunk index
         if (evictIt->memStatus == USED && evictIt->buffer->getPinCount() > 0) {
           break;
         }
@@ -342,7 +388,7 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t numBytes) {
           // score was larger than one large chunk so it always would evict a large chunk
           // so under memory pressure a query would evict its own current chunks and cause reloads
           // rather than evict several smaller unused older chunks.
-          score = std::max(score, static_cast<size_t>(evictIt->lastTouched));
+          score = std::max(score, evictionPolicy_->score(*evictIt));
         }
         if (pageCount >= numPagesRequested) {
           solutionFound = true;
@@ -375,8 +421,12 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t numBytes) {
   LOG(INFO) << "ALLOCATION failed to find " << numBytes << "B free. Forcing Eviction."
             << " Eviction start " << bestEvictionStart->startPage << " Number pages requested " << numPagesRequested
             << " Best Eviction Start Slab " << bestEvictionStartSlab << " " << getStringMgrType() << ":" << deviceId_;
-  bestEvictionStart = evict(bestEvictionStart, numPagesRequested, bestEvictionStartSlab);
-  return bestEvictionStart;
+  auto evictedIt = evict(bestEvictionStart, numPagesRequested, bestEvictionStartSlab);
+  if (evictedIt == slabSegments_[bestEvictionStartSlab].end()) {
+    // a chunk to evict got pinned since we looked, try again
+    return findFreeBuffer(numBytes);
+  }
+  return evictedIt;
 }
 
 std::string BufferMgr::printSlab(size_t slabNum) {
@@ -428,7 +478,15 @@ void BufferMgr::clearSlabs() {
       if (segIt->memStatus == FREE) {
         // no need to free
       } else if (segIt->buffer->getPinCount() < 1) {
-        deleteBuffer(segIt->chunkKey, true);
+        if (segIt->chunkKey.empty()) {
+          // retired while pinned, it's not in the index anymore
+          std::lock_guard<std::mutex> sizedSegsLock(sizedSegsMutex_);
+          delete segIt->buffer;
+          segIt->buffer = 0;
+          removeSegment(segIt);
+        } else {
+          deleteBuffer(segIt->chunkKey, true);
+        }
       }
     }
   }
@@ -493,13 +551,11 @@ std::string BufferMgr::printMap() {
   tss << std::endl
       << "Map Contents: "
       << " " << getStringMgrType() << ":" << deviceId_ << std::endl;
-  for (auto segIt = chunkIndex_.begin(); segIt != chunkIndex_.end(); ++segIt, ++segNum) {
-    //    tss << "Map Entry " << segNum << ": ";
-    //    for (auto vecIt = segIt->first.begin(); vecIt != segIt->first.end(); ++vecIt) {
-    //      tss << *vecIt << ",";
-    //    }
-    //    tss << " " << std::endl;
-    tss << printSeg(segIt->second);
+  for (auto& shard : chunkIndexShards_) {
+    mapd_shared_lock<mapd_shared_mutex> shardLock(shard.mutex);
+    for (auto segIt = shard.index.begin(); segIt != shard.index.end(); ++segIt, ++segNum) {
+      tss << printSeg(segIt->second);
+    }
   }
   tss << "--------------------" << std::endl;
   return tss.str();
@@ -522,8 +578,9 @@ void BufferMgr::printSegs() {
 }
 
 bool BufferMgr::isBufferOnDevice(const ChunkKey& key) {
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  if (chunkIndex_.find(key) == chunkIndex_.end()) {
+  auto& shard = getShard(key);
+  mapd_shared_lock<mapd_shared_mutex> shardLock(shard.mutex);
+  if (shard.index.find(key) == shard.index.end()) {
     return false;
   } else {
     return true;
@@ -532,16 +589,17 @@ bool BufferMgr::isBufferOnDevice(const ChunkKey& key) {
 
 /// This method throws a runtime_error when deleting a Chunk that does not exist.
 void BufferMgr::deleteBuffer(const ChunkKey& key, const bool purge) {
-  std::unique_lock<std::mutex> chunkIndexLock(chunkIndexMutex_);
+  auto& shard = getShard(key);
+  mapd_unique_lock<mapd_shared_mutex> shardLock(shard.mutex);
   // Note: purge is currently unused
 
-  // lookup the buffer for the Chunk in chunkIndex_
-  auto bufferIt = chunkIndex_.find(key);
+  // lookup the buffer for the Chunk in the index of its shard
+  auto bufferIt = shard.index.find(key);
   // Buffer *buffer = bufferIt->second->buffer;
-  CHECK(bufferIt != chunkIndex_.end());
+  CHECK(bufferIt != shard.index.end());
   auto segIt = bufferIt->second;
-  chunkIndex_.erase(bufferIt);
-  chunkIndexLock.unlock();
+  shard.index.erase(bufferIt);
+  shardLock.unlock();
   std::lock_guard<std::mutex> sizedSegsLock(sizedSegsMutex_);
   if (segIt->buffer) {
     delete segIt->buffer;  // Delete Buffer for segment
@@ -552,28 +610,39 @@ void BufferMgr::deleteBuffer(const ChunkKey& key, const bool purge) {
 
 void BufferMgr::deleteBuffersWithPrefix(const ChunkKey& keyPrefix, const bool purge) {
   // Note: purge is unused
-  // lookup the buffer for the Chunk in chunkIndex_
+  if (keyPrefix.size() == 2) {
+    const auto tableKey = std::make_pair(keyPrefix[0], keyPrefix[1]);
+    for (auto& shard : chunkIndexShards_) {
+      std::lock_guard<std::mutex> statsLock(shard.statsMutex);
+      shard.tableStats.erase(tableKey);
+    }
+  }
+  // the chunks with the prefix are spread across all the shards
   std::lock_guard<std::mutex> sizedSegsLock(sizedSegsMutex_);  // Take this lock early to prevent deadlock with
                                                                // reserveBuffer which needs segsMutex_ and then
-                                                               // chunkIndexMutex_
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  auto startChunkIt = chunkIndex_.lower_bound(keyPrefix);
-  if (startChunkIt == chunkIndex_.end()) {
-    return;
-  }
-
-  auto bufferIt = startChunkIt;
-  while (bufferIt != chunkIndex_.end() &&
-         std::search(
-             bufferIt->first.begin(), bufferIt->first.begin() + keyPrefix.size(), keyPrefix.begin(), keyPrefix.end()) !=
-             bufferIt->first.begin() + keyPrefix.size()) {
-    auto segIt = bufferIt->second;
-    if (segIt->buffer) {
-      delete segIt->buffer;  // Delete Buffer for segment
-      segIt->buffer = 0;
+                                                               // the lock of the shard
+  for (auto& shard : chunkIndexShards_) {
+    mapd_unique_lock<mapd_shared_mutex> shardLock(shard.mutex);
+    auto bufferIt = shard.index.lower_bound(keyPrefix);
+    while (bufferIt != shard.index.end() &&
+           std::search(bufferIt->first.begin(),
+                       bufferIt->first.begin() + keyPrefix.size(),
+                       keyPrefix.begin(),
+                       keyPrefix.end()) != bufferIt->first.begin() + keyPrefix.size()) {
+      auto segIt = bufferIt->second;
+      if (segIt->slabNum != -1 && segIt->buffer && segIt->buffer->getPinCount() > 0) {
+        // a query still reads the buffer, it's pinned under a shared lock of the shard so it can't be pinned by
+        // anyone else from now on
+        retirePinnedBuffer(shard, bufferIt++);
+        continue;
+      }
+      if (segIt->buffer) {
+        delete segIt->buffer;  // Delete Buffer for segment
+        segIt->buffer = 0;
+      }
+      removeSegment(segIt);
+      shard.index.erase(bufferIt++);
     }
-    removeSegment(segIt);
-    chunkIndex_.erase(bufferIt++);
   }
 }
 
@@ -611,12 +680,15 @@ void BufferMgr::removeSegment(BufferList::iterator& segIt) {
 void BufferMgr::checkpoint() {
   std::lock_guard<std::mutex> lock(globalMutex_);  // granular lock
 
-  for (auto bufferIt = chunkIndex_.begin(); bufferIt != chunkIndex_.end(); ++bufferIt) {
-    if (bufferIt->second->chunkKey[0] != -1 &&
-        bufferIt->second->buffer->isDirty_) {  // checks that buffer is actual chunk (not just buffer) and is dirty
+  for (auto& shard : chunkIndexShards_) {
+    mapd_shared_lock<mapd_shared_mutex> shardLock(shard.mutex);
+    for (auto bufferIt = shard.index.begin(); bufferIt != shard.index.end(); ++bufferIt) {
+      if (bufferIt->second->chunkKey[0] != -1 &&
+          bufferIt->second->buffer->isDirty_) {  // checks that buffer is actual chunk (not just buffer) and is dirty
 
-      parentMgr_->putBuffer(bufferIt->second->chunkKey, bufferIt->second->buffer);
-      bufferIt->second->buffer->clearDirtyBits();
+        parentMgr_->putBuffer(bufferIt->second->chunkKey, bufferIt->second->buffer);
+        bufferIt->second->buffer->clearDirtyBits();
+      }
     }
   }
 }
@@ -626,47 +698,75 @@ void BufferMgr::checkpoint(const int db_id, const int tb_id) {
   ChunkKey keyPrefix;
   keyPrefix.push_back(db_id);
   keyPrefix.push_back(tb_id);
-  auto startChunkIt = chunkIndex_.lower_bound(keyPrefix);
-  if (startChunkIt == chunkIndex_.end()) {
-    return;
+  for (auto& shard : chunkIndexShards_) {
+    mapd_shared_lock<mapd_shared_mutex> shardLock(shard.mutex);
+    auto bufferIt = shard.index.lower_bound(keyPrefix);
+    while (bufferIt != shard.index.end() &&
+           std::search(bufferIt->first.begin(),
+                       bufferIt->first.begin() + keyPrefix.size(),
+                       keyPrefix.begin(),
+                       keyPrefix.end()) != bufferIt->first.begin() + keyPrefix.size()) {
+      if (bufferIt->second->chunkKey[0] != -1 &&
+          bufferIt->second->buffer->isDirty_) {  // checks that buffer is actual chunk (not just buffer) and is dirty
+
+        parentMgr_->putBuffer(bufferIt->second->chunkKey, bufferIt->second->buffer);
+        bufferIt->second->buffer->clearDirtyBits();
+      }
+      bufferIt++;
+    }
   }
+}
 
-  auto bufferIt = startChunkIt;
-  while (bufferIt != chunkIndex_.end() &&
-         std::search(
-             bufferIt->first.begin(), bufferIt->first.begin() + keyPrefix.size(), keyPrefix.begin(), keyPrefix.end()) !=
-             bufferIt->first.begin() + keyPrefix.size()) {
-    if (bufferIt->second->chunkKey[0] != -1 &&
-        bufferIt->second->buffer->isDirty_) {  // checks that buffer is actual chunk (not just buffer) and is dirty
-
-      parentMgr_->putBuffer(bufferIt->second->chunkKey, bufferIt->second->buffer);
-      bufferIt->second->buffer->clearDirtyBits();
-    }
-    bufferIt++;
+/// Returns the pinned buffer of the chunk if it's in the pool with at least numBytes read in, nullptr otherwise.
+/// Only takes the shared lock of the shard of the key: eviction takes it exclusively and skips pinned buffers.
+Buffer* BufferMgr::getResidentBuffer(const ChunkKey& key, const size_t numBytes) {
+  auto& shard = getShard(key);
+  mapd_shared_lock<mapd_shared_mutex> shardLock(shard.mutex);
+  auto bufferIt = shard.index.find(key);
+  if (bufferIt == shard.index.end()) {
+    return nullptr;
   }
+  auto buffer = bufferIt->second->buffer;
+  if (!buffer || !buffer->isLoaded_ || buffer->size() < numBytes) {
+    return nullptr;
+  }
+  buffer->pin();
+  evictionPolicy_->touch(*bufferIt->second, bufferEpoch_++);  // race on the segment's history, harmless
+  shardLock.unlock();
+  countAccess(key, true);
+  return buffer;
 }
 
 /// Returns a pointer to the Buffer holding the chunk, if it exists; otherwise,
 /// throws a runtime_error.
 AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t numBytes) {
+  if (auto buffer = getResidentBuffer(key, numBytes)) {
+    return buffer;
+  }
   std::lock_guard<std::mutex> lock(globalMutex_);  // granular lock
 
   std::unique_lock<std::mutex> sizedSegsLock(sizedSegsMutex_);
-  std::unique_lock<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  auto bufferIt = chunkIndex_.find(key);
-  bool foundBuffer = bufferIt != chunkIndex_.end();
-  chunkIndexLock.unlock();
+  auto& shard = getShard(key);
+  mapd_unique_lock<mapd_shared_mutex> shardLock(shard.mutex);
+  auto bufferIt = shard.index.find(key);
+  bool foundBuffer = bufferIt != shard.index.end();
   if (foundBuffer) {
-    CHECK(bufferIt->second->buffer);
-    bufferIt->second->buffer->pin();
+    auto segIt = bufferIt->second;
+    CHECK(segIt->buffer);
+    segIt->buffer->pin();
+    evictionPolicy_->touch(*segIt, bufferEpoch_++);
+    shardLock.unlock();
     sizedSegsLock.unlock();
-    bufferIt->second->lastTouched = bufferEpoch_++;     // race
-    if (bufferIt->second->buffer->size() < numBytes) {  // need to fetch part of buffer we don't have - up to numBytes
-      parentMgr_->fetchBuffer(key, bufferIt->second->buffer, numBytes);
+    countAccess(key, true);
+    if (segIt->buffer->size() < numBytes) {  // need to fetch part of buffer we don't have - up to numBytes
+      parentMgr_->fetchBuffer(key, segIt->buffer, numBytes);
     }
-    return bufferIt->second->buffer;
+    segIt->buffer->isLoaded_ = true;
+    return segIt->buffer;
   } else {  // If wasn't in pool then we need to fetch it
+    shardLock.unlock();
     sizedSegsLock.unlock();
+    countAccess(key, false);
     AbstractBuffer* buffer = createBuffer(key, pageSize_, numBytes);  // createChunk pins for us
     try {
       parentMgr_->fetchBuffer(key, buffer, numBytes);  // this should put buffer in a BufferSegment
@@ -674,42 +774,50 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t numBytes)
       LOG(FATAL) << "Get chunk - Could not find chunk " << keyToString(key)
                  << " in buffer pool or parent buffer pools. Error was " << error.what();
     }
+    static_cast<Buffer*>(buffer)->isLoaded_ = true;
     return buffer;
   }
 }
 
 void BufferMgr::fetchBuffer(const ChunkKey& key, AbstractBuffer* destBuffer, const size_t numBytes) {
-  std::unique_lock<std::mutex> lock(globalMutex_);  // granular lock
-  std::unique_lock<std::mutex> sizedSegsLock(sizedSegsMutex_);
-  std::unique_lock<std::mutex> chunkIndexLock(chunkIndexMutex_);
-
-  auto bufferIt = chunkIndex_.find(key);
-  bool foundBuffer = bufferIt != chunkIndex_.end();
-  chunkIndexLock.unlock();
-  AbstractBuffer* buffer;
-  if (!foundBuffer) {
-    sizedSegsLock.unlock();
-    CHECK(parentMgr_ != 0);
-    buffer = createBuffer(key, pageSize_, numBytes);  // will pin buffer
-    try {
-      parentMgr_->fetchBuffer(key, buffer, numBytes);
-    } catch (std::runtime_error& error) {
-      LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key);
-    }
-  } else {
-    buffer = bufferIt->second->buffer;
-    buffer->pin();
-    if (numBytes > buffer->size()) {
+  Buffer* buffer = getResidentBuffer(key, numBytes);
+  if (!buffer) {
+    std::lock_guard<std::mutex> lock(globalMutex_);  // granular lock
+    std::unique_lock<std::mutex> sizedSegsLock(sizedSegsMutex_);
+    auto& shard = getShard(key);
+    mapd_unique_lock<mapd_shared_mutex> shardLock(shard.mutex);
+
+    auto bufferIt = shard.index.find(key);
+    bool foundBuffer = bufferIt != shard.index.end();
+    if (!foundBuffer) {
+      shardLock.unlock();
+      sizedSegsLock.unlock();
+      CHECK(parentMgr_ != 0);
+      countAccess(key, false);
+      buffer = static_cast<Buffer*>(createBuffer(key, pageSize_, numBytes));  // will pin buffer
       try {
         parentMgr_->fetchBuffer(key, buffer, numBytes);
       } catch (std::runtime_error& error) {
         LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key);
       }
+    } else {
+      buffer = bufferIt->second->buffer;
+      buffer->pin();
+      evictionPolicy_->touch(*bufferIt->second, bufferEpoch_++);
+      shardLock.unlock();
+      countAccess(key, true);
+      if (numBytes > buffer->size()) {
+        try {
+          parentMgr_->fetchBuffer(key, buffer, numBytes);
+        } catch (std::runtime_error& error) {
+          LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key);
+        }
+      }
+      sizedSegsLock.unlock();
     }
-    sizedSegsLock.unlock();
+    buffer->isLoaded_ = true;
   }
   size_t chunkSize = numBytes == 0 ? buffer->size() : numBytes;
-  lock.unlock();
   destBuffer->reserve(chunkSize);
   if (buffer->isUpdated()) {
     buffer->read(destBuffer->getMemoryPtr(), chunkSize, 0, destBuffer->getType(), destBuffer->getDeviceId());
@@ -726,15 +834,14 @@ void BufferMgr::fetchBuffer(const ChunkKey& key, AbstractBuffer* destBuffer, con
 }
 
 AbstractBuffer* BufferMgr::putBuffer(const ChunkKey& key, AbstractBuffer* srcBuffer, const size_t numBytes) {
-  std::unique_lock<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  auto bufferIt = chunkIndex_.find(key);
-  bool foundBuffer = bufferIt != chunkIndex_.end();
-  chunkIndexLock.unlock();
-  AbstractBuffer* buffer;
+  auto& shard = getShard(key);
+  mapd_shared_lock<mapd_shared_mutex> shardLock(shard.mutex);
+  auto bufferIt = shard.index.find(key);
+  bool foundBuffer = bufferIt != shard.index.end();
+  Buffer* buffer = foundBuffer ? bufferIt->second->buffer : nullptr;
+  shardLock.unlock();
   if (!foundBuffer) {
-    buffer = createBuffer(key, pageSize_);
-  } else {
-    buffer = bufferIt->second->buffer;
+    buffer = static_cast<Buffer*>(createBuffer(key, pageSize_));
   }
   size_t oldBufferSize = buffer->size();
   size_t newBufferSize = numBytes == 0 ? srcBuffer->size() : numBytes;
@@ -753,9 +860,57 @@ AbstractBuffer* BufferMgr::putBuffer(const ChunkKey& key, AbstractBuffer* srcBuf
   }
   srcBuffer->clearDirtyBits();
   buffer->syncEncoder(srcBuffer);
+  buffer->isLoaded_ = true;
   return buffer;
 }
 
+/// Drops a pinned buffer from the index, its memory is reclaimed once the queries reading it unpin it
+void BufferMgr::retirePinnedBuffer(ChunkIndexShard& shard,
+                                   std::map<ChunkKey, BufferList::iterator>::iterator bufferIt) {
+  // assumes the lock of the shard is held exclusively
+  auto segIt = bufferIt->second;
+  // a slab segment without a chunk key is evicted like any other unpinned one, without touching the index
+  segIt->chunkKey.clear();
+  shard.index.erase(bufferIt);
+}
+
+void BufferMgr::countAccess(const ChunkKey& key, const bool hit) {
+  if (key.size() < 2 || key[0] == -1) {  // not a chunk of a table
+    return;
+  }
+  auto& shard = getShard(key);
+  std::lock_guard<std::mutex> statsLock(shard.statsMutex);
+  auto& stats = shard.tableStats[std::make_pair(key[0], key[1])];
+  if (hit) {
+    ++stats.hits;
+  } else {
+    ++stats.misses;
+  }
+}
+
+void BufferMgr::countEviction(const ChunkKey& key) {
+  if (key.size() < 2 || key[0] == -1) {
+    return;
+  }
+  auto& shard = getShard(key);
+  std::lock_guard<std::mutex> statsLock(shard.statsMutex);
+  ++shard.tableStats[std::make_pair(key[0], key[1])].evictions;
+}
+
+std::map<std::pair<int, int>, BufferStats> BufferMgr::getTableStats() {
+  std::map<std::pair<int, int>, BufferStats> tableStats;
+  for (auto& shard : chunkIndexShards_) {
+    std::lock_guard<std::mutex> statsLock(shard.statsMutex);
+    for (const auto& tableStat : shard.tableStats) {
+      auto& stats = tableStats[tableStat.first];
+      stats.hits += tableStat.second.hits;
+      stats.misses += tableStat.second.misses;
+      stats.evictions += tableStat.second.evictions;
+    }
+  }
+  return tableStats;
+}
+
 int BufferMgr::getBufferId() {
   std::lock_guard<std::mutex> lock(bufferIdMutex_);
   return maxBufferId_++;
@@ -778,8 +933,12 @@ void BufferMgr::free(AbstractBuffer* buffer) {
 }
 
 size_t BufferMgr::getNumChunks() {
-  std::lock_guard<std::mutex> chunkIndexLock(chunkIndexMutex_);
-  return chunkIndex_.size();
+  size_t numChunks = 0;
+  for (auto& shard : chunkIndexShards_) {
+    mapd_shared_lock<mapd_shared_mutex> shardLock(shard.mutex);
+    numChunks += shard.index.size();
+  }
+  return numChunks;
 }
 
 size_t BufferMgr::size() {
@@ -25,12 +25,17 @@
 #ifndef DATAMGR_MEMORY_BUFFER_BUFFERMGR_H
 #define DATAMGR_MEMORY_BUFFER_BUFFERMGR_H
 
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <list>
 #include "../AbstractBuffer.h"
 #include "../AbstractBufferMgr.h"
 #include "BufferSeg.h"
+#include "EvictionPolicy.h"
+#include "../../Shared/mapd_shared_mutex.h"
+#include <memory>
 #include <mutex>
 
 class OutOfMemory : public std::runtime_error {
@@ -59,6 +64,20 @@ using namespace Data_Namespace;
 
 namespace Buffer_Namespace {
 
+struct BufferStats {
+  size_t hits{0};
+  size_t misses{0};
+  size_t evictions{0};
+};
+
+/// A stripe of the chunk index, lookups of resident chunks only take the shared lock of the shard of their key
+struct ChunkIndexShard {
+  mapd_shared_mutex mutex;
+  std::map<ChunkKey, BufferList::iterator> index;
+  std::mutex statsMutex;
+  std::map<std::pair<int, int>, BufferStats> tableStats;
+};
+
 /**
  * @class   BufferMgr
  * @brief
@@ -98,6 +117,8 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   size_t getPageSize();
   bool isAllocationCapped();
   const std::vector<BufferList>& getSlabSegments();
+  /// Returns the hits, misses and evictions of the chunks of each table, keyed by database and table id
+  std::map<std::pair<int, int>, BufferStats> getTableStats();
 
   /// Creates a chunk with the specified key and page size.
   virtual AbstractBuffer* createBuffer(const ChunkKey& key, const size_t pageSize = 0, const size_t initialSize = 0);
@@ -146,16 +167,22 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   void removeSegment(BufferList::iterator& segIt);
   BufferList::iterator findFreeBufferInSlab(const size_t slabNum, const size_t numPagesRequested);
   int getBufferId();
+  size_t getShardId(const ChunkKey& key);
+  ChunkIndexShard& getShard(const ChunkKey& key);
+  Buffer* getResidentBuffer(const ChunkKey& key, const size_t numBytes);
+  void countAccess(const ChunkKey& key, const bool hit);
+  void countEviction(const ChunkKey& key);
   virtual void addSlab(const size_t slabSize) = 0;
   virtual void freeAllMem() = 0;
   virtual void allocateBuffer(BufferList::iterator segIt, const size_t pageSize, const size_t numBytes) = 0;
-  std::mutex chunkIndexMutex_;
+  void retirePinnedBuffer(ChunkIndexShard& shard, std::map<ChunkKey, BufferList::iterator>::iterator bufferIt);
   std::mutex sizedSegsMutex_;
   std::mutex unsizedSegsMutex_;
   std::mutex bufferIdMutex_;
   std::mutex globalMutex_;
 
-  std::map<ChunkKey, BufferList::iterator> chunkIndex_;
+  static const size_t NUM_CHUNK_INDEX_SHARDS = 64;
+  std::array<ChunkIndexShard, NUM_CHUNK_INDEX_SHARDS> chunkIndexShards_;
   size_t maxBufferSize_;  /// max number of bytes allocated for the buffer pool
   size_t maxNumPages_;
   size_t numPagesAllocated_;
@@ -166,7 +193,8 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   bool allocationsCapped_;
   AbstractBufferMgr* parentMgr_;
   int maxBufferId_;
-  unsigned int bufferEpoch_;
+  std::atomic<unsigned int> bufferEpoch_;
+  std::unique_ptr<EvictionPolicy> evictionPolicy_;
   // File_Namespace::FileMgr *fileMgr_;
 
   /// Maps sizes of free memory areas to host buffer pool memory addresses
@@ -35,8 +35,9 @@ struct BufferSeg {
   unsigned int pinCount;
   int slabNum;
   unsigned int lastTouched;
+  unsigned int prevTouched;  // access before lastTouched, 0 if the chunk was accessed once only
 
-  BufferSeg() : memStatus(FREE), buffer(0), pinCount(0), slabNum(-1), lastTouched(0) {}
+  BufferSeg() : memStatus(FREE), buffer(0), pinCount(0), slabNum(-1), lastTouched(0), prevTouched(0) {}
   BufferSeg(const int startPage, const size_t numPages)
       : startPage(startPage),
         numPages(numPages),
@@ -44,7 +45,8 @@ struct BufferSeg {
         buffer(0),
         pinCount(0),
         slabNum(-1),
-        lastTouched(0) {}
+        lastTouched(0),
+        prevTouched(0) {}
   BufferSeg(const int startPage, const size_t numPages, const MemStatus memStatus)
       : startPage(startPage),
         numPages(numPages),
@@ -52,7 +54,8 @@ struct BufferSeg {
         buffer(0),
         pinCount(0),
         slabNum(-1),
-        lastTouched(0) {}
+        lastTouched(0),
+        prevTouched(0) {}
   BufferSeg(const int startPage, const size_t numPages, const MemStatus memStatus, const int lastTouched)
       : startPage(startPage),
         numPages(numPages),
@@ -60,7 +63,8 @@ struct BufferSeg {
         buffer(0),
         pinCount(0),
         slabNum(-1),
-        lastTouched(lastTouched) {}
+        lastTouched(lastTouched),
+        prevTouched(0) {}
 };
 
 typedef std::list<BufferSeg> BufferList;
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EvictionPolicy.h"
+
+#include <limits>
+
+std::string g_buffer_eviction_policy{"lru"};
+
+namespace Buffer_Namespace {
+
+std::unique_ptr<EvictionPolicy> EvictionPolicy::create(const std::string& name) {
+  if (name == "lru") {
+    return std::unique_ptr<EvictionPolicy>(new LruEvictionPolicy());
+  }
+  if (name == "lru2") {
+    return std::unique_ptr<EvictionPolicy>(new Lru2EvictionPolicy());
+  }
+  return nullptr;
+}
+
+size_t LruEvictionPolicy::score(const BufferSeg& seg) const {
+  return seg.lastTouched;
+}
+
+size_t Lru2EvictionPolicy::score(const BufferSeg& seg) const {
+  if (!seg.prevTouched) {
+    return seg.lastTouched;
+  }
+  // above the score of any chunk accessed once only
+  return static_cast<size_t>(std::numeric_limits<unsigned int>::max()) + 1 + seg.prevTouched;
+}
+
+}  // Buffer_Namespace
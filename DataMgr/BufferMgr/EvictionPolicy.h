@@ -0,0 +1,81 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    EvictionPolicy.h
+ * @brief   Policies ranking the segments of a buffer pool for eviction.
+ *
+ * BufferMgr evicts the run of unpinned segments of a slab with the lowest score, the
+ * score of a run being the highest score of its segments. Epochs increase with every
+ * access to the pool.
+ */
+
+#ifndef DATAMGR_BUFFERMGR_EVICTIONPOLICY_H
+#define DATAMGR_BUFFERMGR_EVICTIONPOLICY_H
+
+#include "../../Shared/types.h"
+#include "BufferSeg.h"
+
+#include <memory>
+#include <string>
+
+extern std::string g_buffer_eviction_policy;
+
+namespace Buffer_Namespace {
+
+class EvictionPolicy {
+ public:
+  virtual ~EvictionPolicy() {}
+
+  /// Returns the policy with the given name, nullptr if there isn't any.
+  static std::unique_ptr<EvictionPolicy> create(const std::string& name);
+
+  /// Records the first access to the chunk the segment was allocated for.
+  void admit(BufferSeg& seg, const unsigned int epoch) const {
+    seg.lastTouched = epoch;
+    seg.prevTouched = 0;
+  }
+
+  /// Records an access to the chunk of a resident segment.
+  virtual void touch(BufferSeg& seg, const unsigned int epoch) const {
+    seg.prevTouched = seg.lastTouched;
+    seg.lastTouched = epoch;
+  }
+
+  /// Segments with lower scores are evicted first.
+  virtual size_t score(const BufferSeg& seg) const = 0;
+};
+
+/// Evicts the least recently used chunks first.
+class LruEvictionPolicy : public EvictionPolicy {
+ public:
+  size_t score(const BufferSeg& seg) const override;
+};
+
+/**
+ * LRU-2: evicts the chunks whose second most recent access is the oldest first. Chunks
+ * accessed once only, such as the ones of a large ad-hoc scan, are evicted before any
+ * chunk accessed repeatedly, in the order they were loaded, so a scan cycles through
+ * its own chunks rather than pushing out the working set of other queries.
+ */
+class Lru2EvictionPolicy : public EvictionPolicy {
+ public:
+  size_t score(const BufferSeg& seg) const override;
+};
+
+}  // Buffer_Namespace
+
+#endif  // DATAMGR_BUFFERMGR_EVICTIONPOLICY_H
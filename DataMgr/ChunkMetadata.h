@@ -17,7 +17,9 @@
 #ifndef CHUNKMETADATA_H
 #define CHUNKMETADATA_H
 
+#include "ChunkSketch.h"
 #include "../Shared/sqltypes.h"
+#include <memory>
 #include <stddef.h>
 
 struct ChunkStats {
@@ -31,10 +33,17 @@ struct ChunkMetadata {
   size_t numBytes;
   size_t numElements;
   ChunkStats chunkStats;
+  std::shared_ptr<const ChunkSketch> chunkSketch;  // null unless built with --enable-chunk-sketches
 
   template <typename T>
   void fillChunkStats(const T min, const T max, const bool has_nulls) {
     chunkStats.has_nulls = has_nulls;
+    if (sqlType.is_dict_encoded_number()) {
+      // the stats are those of the ids, like for strings
+      chunkStats.min.intval = min;
+      chunkStats.max.intval = max;
+      return;
+    }
     switch (sqlType.get_type()) {
       case kBOOLEAN: {
         chunkStats.min.tinyintval = min;
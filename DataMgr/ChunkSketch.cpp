@@ -0,0 +1,118 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChunkSketch.h"
+
+#include <algorithm>
+
+#include "../QueryEngine/HyperLogLog.h"
+#include "../QueryEngine/HyperLogLogRank.h"
+#include "../QueryEngine/MurmurHash1Inl.h"
+
+#include <glog/logging.h>
+
+namespace {
+
+// 16 Kbit Bloom filter probed at 4 positions: 0.2% false positives for 1000 distinct values, 6% for 2800.
+const int BLOOM_BITS_LOG2 = 14;
+const size_t BLOOM_NUM_PROBES = 4;
+// 1024 registers, 3% standard error.
+const int HLL_PRECISION_BITS = 10;
+
+uint64_t hash_value(const int64_t val) {
+  return MurmurHash64AImpl(&val, sizeof(val), 0);
+}
+
+// Kirsch-Mitzenmacher double hashing from the two halves of the hash.
+size_t bloom_position(const uint64_t hash, const size_t probe) {
+  const uint32_t h1 = hash;
+  const uint32_t h2 = (hash >> 32) | 1;
+  return (h1 + probe * h2) & ((size_t(1) << BLOOM_BITS_LOG2) - 1);
+}
+
+}  // namespace
+
+ChunkSketch::ChunkSketch()
+    : bloomWords_((size_t(1) << BLOOM_BITS_LOG2) / 64, 0), hllRegisters_(size_t(1) << HLL_PRECISION_BITS, 0) {}
+
+bool ChunkSketch::isSupported(const SQLTypeInfo& ti) {
+  return ti.is_integer() || ti.is_time() || ti.is_boolean() || ti.is_decimal() ||
+         (ti.is_string() && ti.get_compression() == kENCODING_DICT);
+}
+
+void ChunkSketch::add(const int64_t val) {
+  const auto hash = hash_value(val);
+  for (size_t i = 0; i < BLOOM_NUM_PROBES; ++i) {
+    const auto pos = bloom_position(hash, i);
+    bloomWords_[pos / 64] |= uint64_t(1) << (pos % 64);
+  }
+  // same register choice and rank as approximate_distinct_tuples, the estimates are comparable
+  const auto index = hash >> (64 - HLL_PRECISION_BITS);
+  const int8_t rank = get_rank(hash << HLL_PRECISION_BITS, 64 - HLL_PRECISION_BITS);
+  hllRegisters_[index] = std::max(hllRegisters_[index], rank);
+}
+
+bool ChunkSketch::mayContain(const int64_t val) const {
+  const auto hash = hash_value(val);
+  for (size_t i = 0; i < BLOOM_NUM_PROBES; ++i) {
+    const auto pos = bloom_position(hash, i);
+    if (!(bloomWords_[pos / 64] & (uint64_t(1) << (pos % 64)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ChunkSketch::mayIntersect(const ChunkSketch& that) const {
+  // a common value sets its probe positions in both filters
+  size_t common_bits = 0;
+  for (size_t i = 0; i < bloomWords_.size(); ++i) {
+    common_bits += __builtin_popcountll(bloomWords_[i] & that.bloomWords_[i]);
+    if (common_bits >= BLOOM_NUM_PROBES) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ChunkSketch::unify(const ChunkSketch& that) {
+  for (size_t i = 0; i < bloomWords_.size(); ++i) {
+    bloomWords_[i] |= that.bloomWords_[i];
+  }
+  for (size_t i = 0; i < hllRegisters_.size(); ++i) {
+    hllRegisters_[i] = std::max(hllRegisters_[i], that.hllRegisters_[i]);
+  }
+}
+
+size_t ChunkSketch::approxDistinctCount() const {
+  return hll_size(&hllRegisters_[0], HLL_PRECISION_BITS);
+}
+
+void ChunkSketch::write(FILE* f) const {
+  const int32_t sizes[]{BLOOM_BITS_LOG2, HLL_PRECISION_BITS};
+  fwrite(sizes, sizeof(int32_t), 2, f);
+  fwrite(&bloomWords_[0], sizeof(uint64_t), bloomWords_.size(), f);
+  fwrite(&hllRegisters_[0], sizeof(int8_t), hllRegisters_.size(), f);
+}
+
+void ChunkSketch::read(FILE* f) {
+  int32_t sizes[2];
+  fread(sizes, sizeof(int32_t), 2, f);
+  CHECK_EQ(sizes[0], BLOOM_BITS_LOG2);
+  CHECK_EQ(sizes[1], HLL_PRECISION_BITS);
+  fread(&bloomWords_[0], sizeof(uint64_t), bloomWords_.size(), f);
+  fread(&hllRegisters_[0], sizeof(int8_t), hllRegisters_.size(), f);
+}
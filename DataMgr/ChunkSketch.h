@@ -0,0 +1,70 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ChunkSketch.h
+ * @brief   Bloom filter and HyperLogLog sketch of the values of a chunk.
+ *
+ * Built by the encoder as values are appended and persisted after the encoder metadata, the Bloom
+ * filter lets the executor skip fragments for equality, IN and equi-join predicates the min / max
+ * stats can't rule out; the HyperLogLog registers estimate the number of distinct values. Both are
+ * sized to fit the metadata page, the Bloom filter saturates past a few thousand distinct values.
+ */
+
+#ifndef DATAMGR_CHUNKSKETCH_H
+#define DATAMGR_CHUNKSKETCH_H
+
+#include "../Shared/sqltypes.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+class ChunkSketch {
+ public:
+  ChunkSketch();
+
+  static bool isSupported(const SQLTypeInfo& ti);
+
+  template <typename T>
+  void add(const T* vals, const size_t numVals) {
+    for (size_t i = 0; i < numVals; ++i) {
+      add(static_cast<int64_t>(vals[i]));
+    }
+  }
+
+  void add(const int64_t val);
+
+  // False if val has never been added, true if it may have been.
+  bool mayContain(const int64_t val) const;
+
+  // False if no value has been added to both sketches, true if some may have been.
+  bool mayIntersect(const ChunkSketch& that) const;
+
+  // Makes this the sketch of the union of both value sets.
+  void unify(const ChunkSketch& that);
+
+  size_t approxDistinctCount() const;
+
+  void write(FILE* f) const;
+  void read(FILE* f);
+
+ private:
+  std::vector<uint64_t> bloomWords_;
+  std::vector<int8_t> hllRegisters_;
+};
+
+#endif  // DATAMGR_CHUNKSKETCH_H
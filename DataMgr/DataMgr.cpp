@@ -201,6 +201,7 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
         mi.nodeMemoryData.push_back(md);
       }
     }
+    mi.tableStats = cpuBuffer->getTableStats();
     memInfo.push_back(mi);
   } else if (hasGpus_) {
     int numGpus = cudaMgr_->getDeviceCount();
@@ -227,6 +228,7 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfo(const MemoryLevel memLevel) {
           mi.nodeMemoryData.push_back(md);
         }
       }
+      mi.tableStats = gpuBuffer->getTableStats();
       memInfo.push_back(mi);
     }
   }
@@ -425,4 +427,14 @@ size_t DataMgr::getTableEpoch(const int db_id, const int tb_id) {
   return dynamic_cast<GlobalFileMgr*>(bufferMgrs_[0][0])->getTableEpoch(db_id, tb_id);
 }
 
+void DataMgr::setTableStorageCompression(const int db_id, const int tb_id, const File_Namespace::PageCodec codec) {
+  dynamic_cast<GlobalFileMgr*>(bufferMgrs_[0][0])->setTableStorageCompression(db_id, tb_id, codec);
+}
+
+void DataMgr::compactTable(const int db_id,
+                           const int tb_id,
+                           const std::function<void(const size_t, const size_t)>& progress) {
+  dynamic_cast<GlobalFileMgr*>(bufferMgrs_[0][0])->compactTable(db_id, tb_id, progress);
+}
+
 }  // Data_Namespace
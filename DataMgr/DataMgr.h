@@ -26,8 +26,10 @@
 #include "BufferMgr/Buffer.h"
 #include "BufferMgr/BufferMgr.h"
 #include "MemoryLevel.h"
+#include "FileMgr/PageCodec.h"
 #include "../Shared/mapd_shared_mutex.h"
 
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -59,6 +61,7 @@ struct MemoryInfo {
   size_t numPageAllocated;
   bool isAllocationCapped;
   std::vector<MemoryData> nodeMemoryData;
+  std::map<std::pair<int, int>, Buffer_Namespace::BufferStats> tableStats;
 };
 
 class DataMgr {
@@ -106,6 +109,8 @@ class DataMgr {
   void removeTableRelatedDS(const int db_id, const int tb_id);
   void setTableEpoch(const int db_id, const int tb_id, const int start_epoch);
   size_t getTableEpoch(const int db_id, const int tb_id);
+  void setTableStorageCompression(const int db_id, const int tb_id, const File_Namespace::PageCodec codec);
+  void compactTable(const int db_id, const int tb_id, const std::function<void(const size_t, const size_t)>& progress);
 
   CudaMgr_Namespace::CudaMgr* cudaMgr_;
 
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DIFF_ENCODER_H
+#define DIFF_ENCODER_H
+#include "Encoder.h"
+#include "AbstractBuffer.h"
+#include "NoneEncoder.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <glog/logging.h>
+
+/**
+ * Frame of reference encoding. The chunk starts with a 64-bit baseline, followed by the
+ * difference of each value to the baseline stored as a V. The baseline is the minimum of
+ * the first values appended to the chunk, the minimum of V stands for null. Appends with a value
+ * whose difference doesn't fit in V are rejected.
+ */
+template <typename T, typename V>
+class DiffEncoder : public Encoder {
+ public:
+  DiffEncoder(Data_Namespace::AbstractBuffer* buffer)
+      : Encoder(buffer),
+        baseline(0),
+        dataMin(std::numeric_limits<T>::max()),
+        dataMax(std::numeric_limits<T>::min()),
+        has_nulls(false) {}
+
+  ChunkMetadata appendData(int8_t*& srcData, const size_t numAppendElems) {
+    checkAppendData(srcData, numAppendElems);
+    T* unencodedData = reinterpret_cast<T*>(srcData);
+    updateSketch(unencodedData, numAppendElems);
+    if (numElems == 0 && numAppendElems > 0) {
+      baseline = computeBaseline(unencodedData, numAppendElems);
+      buffer_->append(reinterpret_cast<int8_t*>(&baseline), sizeof(int64_t));
+    }
+    auto encodedData = std::unique_ptr<V[]>(new V[numAppendElems]);
+    for (size_t i = 0; i < numAppendElems; ++i) {
+      T data = unencodedData[i];
+      if (data == none_encoded_null_value<T>()) {
+        encodedData.get()[i] = std::numeric_limits<V>::min();
+        has_nulls = true;
+        continue;
+      }
+      encodedData.get()[i] = static_cast<V>(static_cast<int64_t>(data) - baseline);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+    numElems += numAppendElems;
+
+    buffer_->append((int8_t*)(encodedData.get()), numAppendElems * sizeof(V));
+    ChunkMetadata chunkMetadata;
+    getMetadata(chunkMetadata);
+    srcData += numAppendElems * sizeof(T);
+    return chunkMetadata;
+  }
+
+  void checkAppendData(const int8_t* srcData, const size_t numAppendElems) const {
+    const T* unencodedData = reinterpret_cast<const T*>(srcData);
+    const int64_t appendBaseline = numElems == 0 ? computeBaseline(unencodedData, numAppendElems) : baseline;
+    for (size_t i = 0; i < numAppendElems; ++i) {
+      const T data = unencodedData[i];
+      if (data == none_encoded_null_value<T>()) {
+        continue;
+      }
+      const int64_t diff = static_cast<int64_t>(data) - appendBaseline;
+      if (diff <= std::numeric_limits<V>::min() || diff > std::numeric_limits<V>::max()) {
+        throw std::runtime_error("Value " + std::to_string(data) + " is out of the range of DIFF(" +
+                                 std::to_string(sizeof(V) * 8) + ") encoding from the chunk baseline " +
+                                 std::to_string(appendBaseline));
+      }
+    }
+  }
+
+  void getMetadata(ChunkMetadata& chunkMetadata) {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata.fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  ChunkMetadata getMetadata(const SQLTypeInfo& ti) {
+    ChunkMetadata chunk_metadata{ti, 0, 0, ChunkStats{}};
+    chunk_metadata.fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) {
+    const auto& that_typed = static_cast<const DiffEncoder<T, V>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) {
+    numElems = copyFromEncoder->numElems;
+    auto castedEncoder = reinterpret_cast<const DiffEncoder<T, V>*>(copyFromEncoder);
+    baseline = castedEncoder->baseline;
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&numElems, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+    fwrite((int8_t*)&baseline, sizeof(int64_t), 1, f);
+  }
+
+  void readMetadata(FILE* f) {
+    // assumes pointer is already in right place
+    fread((int8_t*)&numElems, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(T), f);
+    fread((int8_t*)&dataMax, 1, sizeof(T), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+    fread((int8_t*)&baseline, 1, sizeof(int64_t), f);
+  }
+  int64_t baseline;
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+ private:
+  static int64_t computeBaseline(const T* data, const size_t numElems) {
+    bool found = false;
+    T minData = 0;
+    for (size_t i = 0; i < numElems; ++i) {
+      if (data[i] != none_encoded_null_value<T>() && (!found || data[i] < minData)) {
+        minData = data[i];
+        found = true;
+      }
+    }
+    return minData;
+  }
+
+};  // DiffEncoder
+
+#endif  // DIFF_ENCODER_H
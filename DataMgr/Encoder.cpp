@@ -17,11 +17,18 @@
 #include "Encoder.h"
 #include "NoneEncoder.h"
 #include "FixedLengthEncoder.h"
+#include "DiffEncoder.h"
+#include "RunLengthEncoder.h"
+#include "PackedEncoder.h"
 #include "StringNoneEncoder.h"
 #include "ArrayNoneEncoder.h"
 #include <glog/logging.h>
 
-Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer, const SQLTypeInfo sqlType) {
+bool g_enable_chunk_sketches{false};
+
+namespace {
+
+Encoder* create_encoder(Data_Namespace::AbstractBuffer* buffer, const SQLTypeInfo sqlType) {
   switch (sqlType.get_compression()) {
     case kENCODING_NONE: {
       switch (sqlType.get_type()) {
@@ -131,12 +138,101 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer, const SQLTypeIn
       }  // switch (sqlType)
       break;
     }  // Case: kENCODING_FIXED
+    case kENCODING_RL: {
+      switch (sqlType.get_type()) {
+        case kBOOLEAN:
+          return new RunLengthEncoder<int8_t, int32_t>(buffer);
+        case kSMALLINT:
+          return new RunLengthEncoder<int16_t, int32_t>(buffer);
+        case kINT:
+          return new RunLengthEncoder<int32_t, int32_t>(buffer);
+        case kBIGINT:
+        case kNUMERIC:
+        case kDECIMAL:
+          return new RunLengthEncoder<int64_t, int64_t>(buffer);
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          return new RunLengthEncoder<time_t, int64_t>(buffer);
+        default:
+          return 0;
+      }
+      break;
+    }  // Case: kENCODING_RL
+    case kENCODING_DIFF: {
+      switch (sqlType.get_type()) {
+        case kSMALLINT: {
+          switch (sqlType.get_comp_param()) {
+            case 8:
+              return new DiffEncoder<int16_t, int8_t>(buffer);
+            default:
+              return 0;
+          }
+        }
+        case kINT: {
+          switch (sqlType.get_comp_param()) {
+            case 8:
+              return new DiffEncoder<int32_t, int8_t>(buffer);
+            case 16:
+              return new DiffEncoder<int32_t, int16_t>(buffer);
+            default:
+              return 0;
+          }
+        }
+        case kBIGINT: {
+          switch (sqlType.get_comp_param()) {
+            case 8:
+              return new DiffEncoder<int64_t, int8_t>(buffer);
+            case 16:
+              return new DiffEncoder<int64_t, int16_t>(buffer);
+            case 32:
+              return new DiffEncoder<int64_t, int32_t>(buffer);
+            default:
+              return 0;
+          }
+        }
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE: {
+          switch (sqlType.get_comp_param()) {
+            case 8:
+              return new DiffEncoder<time_t, int8_t>(buffer);
+            case 16:
+              return new DiffEncoder<time_t, int16_t>(buffer);
+            case 32:
+              return new DiffEncoder<time_t, int32_t>(buffer);
+            default:
+              return 0;
+          }
+        }
+        default:
+          return 0;
+      }
+      break;
+    }  // Case: kENCODING_DIFF
+    case kENCODING_PACKED: {
+      switch (sqlType.get_type()) {
+        case kSMALLINT:
+          return new PackedEncoder<int16_t>(buffer, sqlType.get_comp_param());
+        case kINT:
+          return new PackedEncoder<int32_t>(buffer, sqlType.get_comp_param());
+        case kBIGINT:
+          return new PackedEncoder<int64_t>(buffer, sqlType.get_comp_param());
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          return new PackedEncoder<time_t>(buffer, sqlType.get_comp_param());
+        default:
+          return 0;
+      }
+      break;
+    }  // Case: kENCODING_PACKED
     case kENCODING_DICT: {
       if (sqlType.get_type() == kARRAY) {
         CHECK(IS_STRING(sqlType.get_subtype()));
         return new ArrayNoneEncoder(buffer);
       } else {
-        CHECK(sqlType.is_string());
+        CHECK(sqlType.is_string() || sqlType.is_dict_encoded_number());
         switch (sqlType.get_size()) {
           case 1:
             return new NoneEncoder<uint8_t>(buffer);
@@ -162,11 +258,25 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer, const SQLTypeIn
   return 0;
 }
 
+}  // namespace
+
+Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer, const SQLTypeInfo sqlType) {
+  auto encoder = create_encoder(buffer, sqlType);
+  // the dummy encoders of synthesized metadata have no buffer and never get a sketch
+  if (encoder && buffer && g_enable_chunk_sketches && ChunkSketch::isSupported(sqlType)) {
+    encoder->chunkSketch.reset(new ChunkSketch());
+  }
+  return encoder;
+}
+
 void Encoder::getMetadata(ChunkMetadata& chunkMetadata) {
   // chunkMetadata = metadataTemplate_; // invoke copy constructor
   chunkMetadata.sqlType = buffer_->sqlType;
   chunkMetadata.numBytes = buffer_->size();
   chunkMetadata.numElements = numElems;
+  if (chunkSketch) {
+    chunkMetadata.chunkSketch = std::make_shared<const ChunkSketch>(*chunkSketch);
+  }
 }
 
 ChunkMetadata Encoder::getMetadata(const SQLTypeInfo& ti) {
@@ -23,6 +23,7 @@
 
 #include <vector>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <limits>
 
@@ -38,6 +39,8 @@ class Encoder {
   static Encoder* Create(Data_Namespace::AbstractBuffer* buffer, const SQLTypeInfo sqlType);
   Encoder(Data_Namespace::AbstractBuffer* buffer) : numElems(0), buffer_(buffer) {}
   virtual ChunkMetadata appendData(int8_t*& srcData, const size_t numAppendElems) = 0;
+  // Throws if some of the elements can't be represented by the encoding of the chunk, without appending anything.
+  virtual void checkAppendData(const int8_t* srcData, const size_t numAppendElems) const {}
   virtual void getMetadata(ChunkMetadata& chunkMetadata);
   // Only called from the executor for synthesized meta-information.
   virtual ChunkMetadata getMetadata(const SQLTypeInfo& ti);
@@ -48,9 +51,18 @@ class Encoder {
   virtual void writeMetadata(FILE* f /*, const size_t offset*/) = 0;
   virtual void readMetadata(FILE* f /*, const size_t offset*/) = 0;
   size_t numElems;
+  // Sketch of the appended values, only for the chunks created with --enable-chunk-sketches.
+  std::unique_ptr<ChunkSketch> chunkSketch;
   virtual ~Encoder() {}
 
  protected:
+  template <typename T>
+  void updateSketch(const T* vals, const size_t numVals) {
+    if (chunkSketch) {
+      chunkSketch->add(vals, numVals);
+    }
+  }
+
   Data_Namespace::AbstractBuffer* buffer_;
   // ChunkMetadata metadataTemplate_;
 };
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    AsyncFileReader.cpp
+ * @brief   Asynchronous, batched reads of file pages.
+ */
+
+#include "AsyncFileReader.h"
+
+#include <glog/logging.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+
+bool g_enable_async_file_reads{true};
+
+namespace File_Namespace {
+
+ReadBatch::ReadBatch(std::vector<ReadRequest>&& requests) : requests_(std::move(requests)), next_(0), done_(0) {}
+
+void ReadBatch::wait() {
+  while (runNext()) {
+  }
+  std::unique_lock<std::mutex> lock(done_mutex_);
+  done_cv_.wait(lock, [this] { return done_ == requests_.size(); });
+}
+
+bool ReadBatch::runNext() {
+  const auto idx = next_.fetch_add(1);
+  if (idx >= requests_.size()) {
+    return false;
+  }
+  AsyncFileReader::read(requests_[idx]);
+  std::lock_guard<std::mutex> lock(done_mutex_);
+  if (++done_ == requests_.size()) {
+    done_cv_.notify_all();
+  }
+  return true;
+}
+
+AsyncFileReader& AsyncFileReader::instance() {
+  static AsyncFileReader reader(std::max(std::thread::hardware_concurrency(), 1u));
+  return reader;
+}
+
+AsyncFileReader::AsyncFileReader(const size_t num_threads) : stop_(false) {
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this] { worker(); });
+  }
+}
+
+AsyncFileReader::~AsyncFileReader() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_ = true;
+  }
+  queue_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+std::shared_ptr<ReadBatch> AsyncFileReader::submit(std::vector<ReadRequest>&& requests) {
+  auto batch = std::make_shared<ReadBatch>(std::move(requests));
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_.push_back(batch);
+  }
+  queue_cv_.notify_all();
+  return batch;
+}
+
+void AsyncFileReader::read(const ReadRequest& request) {
+  const int fd = fileno(request.f);
+  size_t bytes_read = 0;
+  while (bytes_read < request.size) {
+    const auto ret =
+        pread(fd, request.dst + bytes_read, request.size - bytes_read, request.offset + bytes_read);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    CHECK_GT(ret, 0) << "Failed to read " << request.size << " bytes at offset " << request.offset;
+    bytes_read += ret;
+  }
+}
+
+void AsyncFileReader::readAhead(FILE* f, const size_t offset, const size_t size) {
+#ifdef __APPLE__
+  radvisory advice{static_cast<off_t>(offset), static_cast<int>(size)};
+  fcntl(fileno(f), F_RDADVISE, &advice);
+#else
+  posix_fadvise(fileno(f), offset, size, POSIX_FADV_WILLNEED);
+#endif
+}
+
+void AsyncFileReader::worker() {
+  while (true) {
+    std::shared_ptr<ReadBatch> batch;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (stop_) {
+        return;
+      }
+      batch = queue_.front();
+    }
+    while (batch->runNext()) {
+    }
+    // every read of the batch has been claimed, by us or by other threads
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (!queue_.empty() && queue_.front() == batch) {
+      queue_.pop_front();
+    }
+  }
+}
+
+}  // namespace File_Namespace
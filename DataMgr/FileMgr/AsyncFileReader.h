@@ -0,0 +1,99 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    AsyncFileReader.h
+ * @brief   Asynchronous, batched reads of file pages.
+ *
+ * Reads are positional (pread), they don't go through the stdio stream of the file and
+ * don't need its lock, so any number of them can run concurrently on the same file. All
+ * the page reads of a chunk are submitted as a single batch to a process-wide pool of
+ * I/O threads, the thread which waits for the batch runs its pending reads as well.
+ */
+
+#ifndef DATAMGR_FILEMGR_ASYNCFILEREADER_H
+#define DATAMGR_FILEMGR_ASYNCFILEREADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern bool g_enable_async_file_reads;
+
+namespace File_Namespace {
+
+struct ReadRequest {
+  FILE* f;
+  size_t offset;
+  size_t size;
+  int8_t* dst;
+};
+
+class ReadBatch {
+ public:
+  explicit ReadBatch(std::vector<ReadRequest>&& requests);
+
+  /// Blocks until all the reads of the batch are done, running the unclaimed ones on the calling thread.
+  void wait();
+
+ private:
+  friend class AsyncFileReader;
+
+  /// Claims and runs the next read, returns false if all of them have been claimed already.
+  bool runNext();
+
+  std::vector<ReadRequest> requests_;
+  std::atomic<size_t> next_;
+  size_t done_;
+  std::mutex done_mutex_;
+  std::condition_variable done_cv_;
+};
+
+class AsyncFileReader {
+ public:
+  static AsyncFileReader& instance();
+
+  ~AsyncFileReader();
+
+  std::shared_ptr<ReadBatch> submit(std::vector<ReadRequest>&& requests);
+
+  /// Reads synchronously on the calling thread.
+  static void read(const ReadRequest& request);
+
+  /// Hints the kernel to start reading the range into the page cache, doesn't block.
+  static void readAhead(FILE* f, const size_t offset, const size_t size);
+
+ private:
+  explicit AsyncFileReader(const size_t num_threads);
+
+  void worker();
+
+  std::deque<std::shared_ptr<ReadBatch>> queue_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  bool stop_;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace File_Namespace
+
+#endif  // DATAMGR_FILEMGR_ASYNCFILEREADER_H
@@ -21,26 +21,27 @@
  */
 
 #include "FileBuffer.h"
+#include "AsyncFileReader.h"
 #include "File.h"
 #include "FileMgr.h"
 #include <map>
 #include <glog/logging.h>
 #include <thread>
 #include <future>
-
-#define METADATA_PAGE_SIZE 4096
+#include <cstring>
 
 using namespace std;
 
 namespace File_Namespace {
-size_t FileBuffer::headerBufferOffset_ = 32;
 
 FileBuffer::FileBuffer(FileMgr* fm, const size_t pageSize, const ChunkKey& chunkKey, const size_t initialSize)
     : AbstractBuffer(fm->getDeviceId()),
       fm_(fm),
       metadataPages_(METADATA_PAGE_SIZE),
       pageSize_(pageSize),
-      chunkKey_(chunkKey) {
+      chunkKey_(chunkKey),
+      firstDirtyPage_(0),
+      persistedSize_(0) {
   // Create a new FileBuffer
   CHECK(fm_);
   calcHeaderBuffer();
@@ -69,7 +70,9 @@ FileBuffer::FileBuffer(FileMgr* fm,
       fm_(fm),
       metadataPages_(METADATA_PAGE_SIZE),
       pageSize_(pageSize),
-      chunkKey_(chunkKey) {
+      chunkKey_(chunkKey),
+      firstDirtyPage_(0),
+      persistedSize_(0) {
   CHECK(fm_);
   calcHeaderBuffer();
   pageDataSize_ = pageSize_ - reservedHeaderSize_;
@@ -83,7 +86,8 @@ FileBuffer::FileBuffer(FileMgr* fm,
       fm_(fm),
       metadataPages_(METADATA_PAGE_SIZE),
       pageSize_(0),
-      chunkKey_(chunkKey) {
+      chunkKey_(chunkKey),
+      persistedSize_(0) {
   // We are being assigned an existing FileBuffer on disk
 
   CHECK(fm_);
@@ -124,6 +128,7 @@ FileBuffer::FileBuffer(FileMgr* fm,
   }
   // auto lastHeaderIt = std::prev(headerEndIt);
   // size_ = lastHeaderIt->chunkSize;
+  firstDirtyPage_ = multiPages_.size();
 }
 
 FileBuffer::~FileBuffer() {
@@ -143,18 +148,11 @@ void FileBuffer::reserve(const size_t numBytes) {
 }
 
 void FileBuffer::calcHeaderBuffer() {
-  // 3 * sizeof(int) is for headerSize, for pageId and versionEpoch
-  // sizeof(size_t) is for chunkSize
-  // reservedHeaderSize_ = (chunkKey_.size() + 3) * sizeof(int) + sizeof(size_t);
-  reservedHeaderSize_ = (chunkKey_.size() + 3) * sizeof(int);
-  size_t headerMod = reservedHeaderSize_ % headerBufferOffset_;
-  if (headerMod > 0) {
-    reservedHeaderSize_ += headerBufferOffset_ - headerMod;
-  }
-  // pageDataSize_ = pageSize_-reservedHeaderSize_;
+  reservedHeaderSize_ = reserved_header_size(chunkKey_.size());
 }
 
 void FileBuffer::freePages() {
+  fm_->invalidateMetadataIndex();
   // Need to zero headers (actually just first four bytes of header)
 
   // First delete metadata pages
@@ -173,6 +171,18 @@ void FileBuffer::freePages() {
   }
 }
 
+void FileBuffer::getPageHeaders(std::vector<HeaderInfo>& headerVec) const {
+  for (size_t i = 0; i < metadataPages_.pageVersions.size(); ++i) {
+    headerVec.emplace_back(chunkKey_, -1, metadataPages_.epochs[i], metadataPages_.pageVersions[i]);
+  }
+  for (size_t pageId = 0; pageId < multiPages_.size(); ++pageId) {
+    const auto& multiPage = multiPages_[pageId];
+    for (size_t i = 0; i < multiPage.pageVersions.size(); ++i) {
+      headerVec.emplace_back(chunkKey_, pageId, multiPage.epochs[i], multiPage.pageVersions[i]);
+    }
+  }
+}
+
 struct readThreadDS {
   FileMgr* t_fm;                      // ptr to FileMgr
   size_t t_startPage;                 // start page for the thread
@@ -197,22 +207,17 @@ static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS)
     CHECK(threadDS.multiPages[pageNum].pageSize == fileBuffer->pageSize());
     Page page = threadDS.multiPages[pageNum].current();
 
-    FileInfo* fileInfo = threadDS.t_fm->getFileInfoForFileId(page.fileId);
-    CHECK(fileInfo);
-
     // Read the page into the destination (dst) buffer at its
-    // current (cur) location
+    // current (cur) location, compressed pages are decompressed by this thread
     size_t bytesRead = 0;
     if (isFirstPage) {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + threadDS.t_startPageOffset + fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize() - threadDS.t_startPageOffset, bytesLeft),
-          curPtr);
+      bytesRead = fileBuffer->readPage(page,
+                                       threadDS.t_startPageOffset,
+                                       min(fileBuffer->pageDataSize() - threadDS.t_startPageOffset, bytesLeft),
+                                       curPtr);
       isFirstPage = false;
     } else {
-      bytesRead = fileInfo->read(page.pageNum * fileBuffer->pageSize() + fileBuffer->reservedHeaderSize(),
-                                 min(fileBuffer->pageDataSize(), bytesLeft),
-                                 curPtr);
+      bytesRead = fileBuffer->readPage(page, 0, min(fileBuffer->pageDataSize(), bytesLeft), curPtr);
     }
     curPtr += bytesRead;
     bytesLeft -= bytesRead;
@@ -223,6 +228,75 @@ static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS)
   return (totalBytesRead);
 }
 
+namespace {
+
+// Decompresses the bytes [pageOffset, pageOffset + numBytes) of a compressed page into dst,
+// compressed holds the data of the page, its size prefix included.
+void decompress_page_range(const Page& page,
+                           const int8_t* compressed,
+                           const size_t pageOffset,
+                           const size_t numBytes,
+                           int8_t* dst) {
+  int32_t prefix[2];
+  memcpy(prefix, compressed, sizeof(prefix));
+  CHECK_EQ(prefix[0], page.compressedSize);
+  const size_t rawSize = prefix[1];
+  CHECK_LE(pageOffset + numBytes, rawSize);
+  const int8_t* payload = compressed + COMPRESSED_PAGE_PREFIX_SIZE;
+  if (pageOffset == 0 && numBytes == rawSize) {
+    decompress_page(page.codec, payload, page.compressedSize, dst, rawSize);
+    return;
+  }
+  std::vector<int8_t> raw(rawSize);
+  decompress_page(page.codec, payload, page.compressedSize, &raw[0], rawSize);
+  memcpy(dst, &raw[pageOffset], numBytes);
+}
+
+// A read of a compressed page, staged in compressed until it can be decompressed into dst.
+struct CompressedRead {
+  Page page;
+  size_t pageOffset;
+  size_t numBytes;
+  int8_t* dst;
+  std::vector<int8_t> compressed;
+};
+
+// Decompresses the staged reads with numThreads threads, the calling one included.
+void decompress_reads(std::vector<CompressedRead>& reads, const size_t numThreads) {
+  const size_t numWorkers = std::min(std::max(numThreads, size_t(1)), reads.size());
+  auto decompress_stride = [&reads, numWorkers](const size_t first) {
+    for (size_t i = first; i < reads.size(); i += numWorkers) {
+      const auto& read = reads[i];
+      decompress_page_range(read.page, &read.compressed[0], read.pageOffset, read.numBytes, read.dst);
+    }
+  };
+  std::vector<std::future<void>> workers;
+  for (size_t i = 1; i < numWorkers; ++i) {
+    workers.push_back(std::async(std::launch::async, decompress_stride, i));
+  }
+  if (numWorkers) {
+    decompress_stride(0);
+  }
+  for (auto& worker : workers) {
+    worker.get();
+  }
+}
+
+}  // namespace
+
+size_t FileBuffer::readPage(const Page& page, const size_t pageOffset, const size_t numBytes, int8_t* dst) {
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  CHECK(fileInfo);
+  const size_t dataOffset = page.pageNum * pageSize_ + reservedHeaderSize_;
+  if (page.codec == PageCodec::NONE) {
+    return fileInfo->read(dataOffset + pageOffset, numBytes, dst);
+  }
+  std::vector<int8_t> compressed(COMPRESSED_PAGE_PREFIX_SIZE + page.compressedSize);
+  fileInfo->read(dataOffset, compressed.size(), &compressed[0]);
+  decompress_page_range(page, &compressed[0], pageOffset, numBytes, dst);
+  return numBytes;
+}
+
 void FileBuffer::read(int8_t* const dst,
                       const size_t numBytes,
                       const size_t offset,
@@ -246,7 +320,55 @@ void FileBuffer::read(int8_t* const dst,
   }
   */
 
-  CHECK(startPage + numPagesToRead <= multiPages_.size());
+  if (g_enable_async_file_reads) {
+    std::vector<Page> pages;
+    pages.reserve(numPagesToRead);
+    {
+      std::lock_guard<std::mutex> pagesLock(pagesMutex_);
+      CHECK(startPage + numPagesToRead <= multiPages_.size());
+      for (size_t pageNum = startPage; pageNum < startPage + numPagesToRead; ++pageNum) {
+        CHECK(multiPages_[pageNum].pageSize == pageSize_);
+        pages.push_back(multiPages_[pageNum].current());
+      }
+    }
+    // submit the reads of all pages as a single batch, compressed pages are read into staging buffers
+    std::vector<ReadRequest> requests;
+    requests.reserve(numPagesToRead);
+    std::vector<CompressedRead> compressedReads;
+    compressedReads.reserve(numPagesToRead);
+    int8_t* curPtr = dst;
+    size_t bytesLeft = numBytes;
+    size_t pageOffset = startPageOffset;
+    for (size_t pageNum = startPage; pageNum < startPage + numPagesToRead; ++pageNum) {
+      const Page& page = pages[pageNum - startPage];
+      FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+      CHECK(fileInfo);
+      const size_t bytesToRead = min(pageDataSize_ - pageOffset, bytesLeft);
+      if (page.codec != PageCodec::NONE) {
+        compressedReads.push_back(CompressedRead{page, pageOffset, bytesToRead, curPtr, {}});
+        auto& compressed = compressedReads.back().compressed;
+        compressed.resize(COMPRESSED_PAGE_PREFIX_SIZE + page.compressedSize);
+        requests.push_back(ReadRequest{
+            fileInfo->f, page.pageNum * pageSize_ + reservedHeaderSize_, compressed.size(), &compressed[0]});
+      } else {
+        requests.push_back(ReadRequest{
+            fileInfo->f, page.pageNum * pageSize_ + pageOffset + reservedHeaderSize_, bytesToRead, curPtr});
+      }
+      curPtr += bytesToRead;
+      bytesLeft -= bytesToRead;
+      pageOffset = 0;
+    }
+    CHECK_EQ(bytesLeft, size_t(0));
+    if (requests.size() == 1) {
+      AsyncFileReader::read(requests.front());
+    } else if (!requests.empty()) {
+      AsyncFileReader::instance().submit(std::move(requests))->wait();
+    }
+    decompress_reads(compressedReads, fm_->getNumReaderThreads());
+    return;
+  }
+
+  CHECK(startPage + numPagesToRead <= pageCount());
 
   size_t numPagesPerThread = 0;
   size_t numBytesCurrent = numBytes;  // total number of bytes still to be read
@@ -320,15 +442,43 @@ void FileBuffer::read(int8_t* const dst,
   CHECK(bytesRead == numBytes);
 }
 
+void FileBuffer::prefetch() {
+  // the next fragment may be appended to concurrently, coalesce the pages which are contiguous in a file into
+  // ranges under the page lock and only issue the hints once it's released
+  struct ReadAheadRange {
+    FILE* f;
+    size_t start;
+    size_t end;
+  };
+  std::vector<ReadAheadRange> ranges;
+  {
+    std::lock_guard<std::mutex> pagesLock(pagesMutex_);
+    for (const auto& multiPage : multiPages_) {
+      const Page& page = multiPage.current();
+      FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+      CHECK(fileInfo);
+      const size_t pageStart = page.pageNum * pageSize_;
+      if (!ranges.empty() && ranges.back().f == fileInfo->f && ranges.back().end == pageStart) {
+        ranges.back().end += pageSize_;
+        continue;
+      }
+      ranges.push_back(ReadAheadRange{fileInfo->f, pageStart, pageStart + pageSize_});
+    }
+  }
+  for (const auto& range : ranges) {
+    AsyncFileReader::readAhead(range.f, range.start, range.end - range.start);
+  }
+}
+
 void FileBuffer::copyPage(Page& srcPage, Page& destPage, const size_t numBytes, const size_t offset) {
   // FILE *srcFile = fm_->files_[srcPage.fileId]->f;
   // FILE *destFile = fm_->files_[destPage.fileId]->f;
-  CHECK(offset + numBytes < pageDataSize_);
-  FileInfo* srcFileInfo = fm_->getFileInfoForFileId(srcPage.fileId);
+  CHECK(offset + numBytes <= pageDataSize_);
+  CHECK_EQ(destPage.codec, PageCodec::NONE);
   FileInfo* destFileInfo = fm_->getFileInfoForFileId(destPage.fileId);
 
   int8_t* buffer = new int8_t[numBytes];
-  size_t bytesRead = srcFileInfo->read(srcPage.pageNum * pageSize_ + offset + reservedHeaderSize_, numBytes, buffer);
+  size_t bytesRead = readPage(srcPage, offset, numBytes, buffer);
   CHECK(bytesRead == numBytes);
   size_t bytesWritten =
       destFileInfo->write(destPage.pageNum * pageSize_ + offset + reservedHeaderSize_, numBytes, buffer);
@@ -341,22 +491,29 @@ Page FileBuffer::addNewMultiPage(const int epoch) {
   MultiPage multiPage(pageSize_);
   multiPage.epochs.push_back(epoch);
   multiPage.pageVersions.push_back(page);
+  std::lock_guard<std::mutex> pagesLock(pagesMutex_);
   multiPages_.push_back(multiPage);
   return page;
 }
 
-void FileBuffer::writeHeader(Page& page, const int pageId, const int epoch, const bool writeMetadata) {
+std::vector<int> FileBuffer::makeHeader(const Page& page, const int pageId, const int epoch) const {
   int intHeaderSize = chunkKey_.size() + 3;  // does not include chunkSize
   vector<int> header(intHeaderSize);
   // in addition to chunkkey we need size of header, pageId, version
   header[0] = (intHeaderSize - 1) *
               sizeof(int);  // don't need to include size of headerSize value - sizeof(size_t) is for chunkSize
+  header[0] |= static_cast<int>(page.codec) << PAGE_CODEC_SHIFT;
   std::copy(chunkKey_.begin(), chunkKey_.end(), header.begin() + 1);
   header[intHeaderSize - 2] = pageId;
   header[intHeaderSize - 1] = epoch;
+  return header;
+}
+
+void FileBuffer::writeHeader(Page& page, const int pageId, const int epoch, const bool writeMetadata) {
+  auto header = makeHeader(page, pageId, epoch);
   FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
   size_t pageSize = writeMetadata ? METADATA_PAGE_SIZE : pageSize_;
-  fileInfo->write(page.pageNum * pageSize, (intHeaderSize) * sizeof(int), (int8_t*)&header[0]);
+  fileInfo->write(page.pageNum * pageSize, header.size() * sizeof(int), (int8_t*)&header[0]);
 }
 
 void FileBuffer::readMetadata(const Page& page) {
@@ -364,11 +521,12 @@ void FileBuffer::readMetadata(const Page& page) {
   fseek(f, page.pageNum * METADATA_PAGE_SIZE + reservedHeaderSize_, SEEK_SET);
   fread((int8_t*)&pageSize_, sizeof(size_t), 1, f);
   fread((int8_t*)&size_, sizeof(size_t), 1, f);
+  persistedSize_ = size_;
   vector<int> typeData(
       NUM_METADATA);  // assumes we will encode hasEncoder, bufferType, encodingType, encodingBits all as int
   fread((int8_t*)&(typeData[0]), sizeof(int), typeData.size(), f);
   int version = typeData[0];
-  CHECK(version == METADATA_VERSION);  // add backward compatibility code here
+  CHECK_LE(version, METADATA_VERSION);  // add backward compatibility code here
   hasEncoder = static_cast<bool>(typeData[1]);
   if (hasEncoder) {
     sqlType.set_type(static_cast<SQLTypes>(typeData[2]));
@@ -381,21 +539,38 @@ void FileBuffer::readMetadata(const Page& page) {
     sqlType.set_size(typeData[9]);
     initEncoder(sqlType);
     encoder->readMetadata(f);
+    // only the metadata of chunks with a sketch is at version 1
+    if (version >= 1) {
+      encoder->chunkSketch.reset(new ChunkSketch());
+      encoder->chunkSketch->read(f);
+    } else {
+      encoder->chunkSketch.reset();
+    }
   }
 }
 
 void FileBuffer::writeMetadata(const int epoch) {
+  Page page = fm_->requestFreePage(METADATA_PAGE_SIZE, true);
+  std::vector<int8_t> pageImage(METADATA_PAGE_SIZE, 0);
+  const size_t numBytes = fillMetadataPage(page, epoch, &pageImage[0]);
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  fileInfo->write(page.pageNum * METADATA_PAGE_SIZE, numBytes, &pageImage[0]);
+}
+
+size_t FileBuffer::fillMetadataPage(const Page& page, const int epoch, int8_t* pageImage) {
+  const auto header = makeHeader(page, -1, epoch);
+  memcpy(pageImage, &header[0], header.size() * sizeof(int));
+  // the encoder serializes itself to a stream, have it write to the page image
+  FILE* f = fmemopen(pageImage + reservedHeaderSize_, METADATA_PAGE_SIZE - reservedHeaderSize_, "wb");
+  CHECK(f);
   // Right now stats page is size_ (in bytes), bufferType, encodingType,
   // encodingDataType, numElements
-  Page page = fm_->requestFreePage(METADATA_PAGE_SIZE, true);
-  writeHeader(page, -1, epoch, true);
-  FILE* f = fm_->getFileForFileId(page.fileId);
-  fseek(f, page.pageNum * METADATA_PAGE_SIZE + reservedHeaderSize_, SEEK_SET);
   fwrite((int8_t*)&pageSize_, sizeof(size_t), 1, f);
   fwrite((int8_t*)&size_, sizeof(size_t), 1, f);
   vector<int> typeData(
       NUM_METADATA);  // assumes we will encode hasEncoder, bufferType, encodingType, encodingBits all as int
-  typeData[0] = METADATA_VERSION;
+  // releases without chunk sketches can still read the metadata of the chunks which have none
+  typeData[0] = hasEncoder && encoder->chunkSketch ? METADATA_VERSION : 0;
   typeData[1] = static_cast<int>(hasEncoder);
   if (hasEncoder) {
     typeData[2] = static_cast<int>(sqlType.get_type());
@@ -410,9 +585,18 @@ void FileBuffer::writeMetadata(const int epoch) {
   fwrite((int8_t*)&(typeData[0]), sizeof(int), typeData.size(), f);
   if (hasEncoder) {  // redundant
     encoder->writeMetadata(f);
+    if (encoder->chunkSketch) {
+      encoder->chunkSketch->write(f);
+    }
   }
+  // fails if the metadata overflows the page
+  CHECK_EQ(fflush(f), 0);
+  const size_t metadataSize = ftell(f);
+  fclose(f);
   metadataPages_.epochs.push_back(epoch);
   metadataPages_.pageVersions.push_back(page);
+  persistedSize_ = size_;
+  return reservedHeaderSize_ + metadataSize;
 }
 
 /*
@@ -438,12 +622,36 @@ void FileBuffer::append(int8_t* src, const size_t numBytes, const MemoryLevel sr
   int8_t* curPtr = src;  // a pointer to the current location in dst being written to
   size_t initialNumPages = multiPages_.size();
   size_ = size_ + numBytes;
+  firstDirtyPage_ = std::min(firstDirtyPage_, startPage);
   int epoch = fm_->epoch();
   for (size_t pageNum = startPage; pageNum < startPage + numPagesToWrite; ++pageNum) {
     Page page;
     if (pageNum >= initialNumPages) {
       page = addNewMultiPage(epoch);
       writeHeader(page, pageNum, epoch);
+    } else if (multiPages_[pageNum].current().codec != PageCodec::NONE) {
+      // compressed pages can't be extended in place, append to an uncompressed copy
+      Page lastPage = multiPages_[pageNum].current();
+      page = fm_->requestFreePage(pageSize_, false);
+      {
+        std::lock_guard<std::mutex> pagesLock(pagesMutex_);
+        multiPages_[pageNum].push(page, epoch);
+      }
+      copyPage(lastPage, page, startPageOffset, 0);
+      writeHeader(page, pageNum, epoch);
+    } else if (multiPages_[pageNum].epochs.back() < epoch &&
+               pageNum * pageDataSize_ + (pageNum == startPage ? startPageOffset : 0) < persistedSize_) {
+      // the buffer has been truncated and is rewritten, keep the checkpointed version of the page
+      Page lastPage = multiPages_[pageNum].current();
+      page = fm_->requestFreePage(pageSize_, false);
+      {
+        std::lock_guard<std::mutex> pagesLock(pagesMutex_);
+        multiPages_[pageNum].push(page, epoch);
+      }
+      if (pageNum == startPage && startPageOffset > 0) {
+        copyPage(lastPage, page, startPageOffset, 0);
+      }
+      writeHeader(page, pageNum, epoch);
     } else {
       // we already have a new page at current
       // epoch for this page - just grab this page
@@ -478,6 +686,7 @@ void FileBuffer::write(int8_t* src,
   if (offset < size_) {
     isUpdated_ = true;
   }
+  const size_t prevSize = size_;
   bool tempIsAppended = false;
 
   if (offset + numBytes > size_) {
@@ -493,6 +702,7 @@ void FileBuffer::write(int8_t* src,
   int8_t* curPtr = src;  // a pointer to the current location in dst being written to
   size_t initialNumPages = multiPages_.size();
   int epoch = fm_->epoch();
+  firstDirtyPage_ = std::min(firstDirtyPage_, std::min(startPage, initialNumPages));
 
   if (startPage > initialNumPages) {  // means there is a gap we need to allocate pages for
     for (size_t pageNum = initialNumPages; pageNum < startPage; ++pageNum) {
@@ -510,18 +720,23 @@ void FileBuffer::write(int8_t* src,
                          // also need to copy if we are on first or last page
       Page lastPage = multiPages_[pageNum].current();
       page = fm_->requestFreePage(pageSize_, false);
-      multiPages_[pageNum].epochs.push_back(epoch);
-      multiPages_[pageNum].pageVersions.push_back(page);
+      {
+        std::lock_guard<std::mutex> pagesLock(pagesMutex_);
+        multiPages_[pageNum].epochs.push_back(epoch);
+        multiPages_[pageNum].pageVersions.push_back(page);
+      }
       if (pageNum == startPage && startPageOffset > 0) {
         // copyPage takes care of header offset so don't worry
         // about it
         copyPage(lastPage, page, startPageOffset, 0);
       }
-      if (pageNum == startPage + numPagesToWrite && bytesLeft > 0) {  // bytesLeft should always > 0
-        copyPage(lastPage,
-                 page,
-                 pageDataSize_ - bytesLeft,
-                 bytesLeft);  // these would be empty if we're appending but we won't worry about it right now
+      if (pageNum == startPage + numPagesToWrite - 1 && prevSize > pageNum * pageDataSize_) {
+        // keep the valid bytes of the previous version which follow the written range on the last page
+        const size_t endPageOffset = startPageOffset + numBytes - (numPagesToWrite - 1) * pageDataSize_;
+        const size_t validPageBytes = std::min(pageDataSize_, prevSize - pageNum * pageDataSize_);
+        if (validPageBytes > endPageOffset) {
+          copyPage(lastPage, page, validPageBytes - endPageOffset, endPageOffset);
+        }
       }
       writeHeader(page, pageNum, epoch);
     } else {
@@ -551,4 +766,90 @@ void FileBuffer::write(int8_t* src,
   CHECK(bytesLeft == 0);
 }
 
+void FileBuffer::relocatePages(const int epoch) {
+  CHECK(!isDirty_);
+  // pages past the end of the data aren't worth keeping
+  const size_t numPages = std::min(multiPages_.size(), (size_ + pageDataSize_ - 1) / pageDataSize_);
+  {
+    std::lock_guard<std::mutex> pagesLock(pagesMutex_);
+    multiPages_.erase(multiPages_.begin() + numPages, multiPages_.end());
+  }
+  std::vector<int8_t> data(pageDataSize_);
+  for (size_t pageNum = 0; pageNum < numPages; ++pageNum) {
+    const Page lastPage = multiPages_[pageNum].current();
+    // compressed pages are copied as they are, their size prefix included
+    const size_t dataSize = lastPage.codec == PageCodec::NONE
+                                ? std::min(pageDataSize_, size_ - pageNum * pageDataSize_)
+                                : COMPRESSED_PAGE_PREFIX_SIZE + lastPage.compressedSize;
+    Page page = fm_->requestFreePage(pageSize_, false);
+    page.codec = lastPage.codec;
+    page.compressedSize = lastPage.compressedSize;
+    FileInfo* srcFileInfo = fm_->getFileInfoForFileId(lastPage.fileId);
+    FileInfo* destFileInfo = fm_->getFileInfoForFileId(page.fileId);
+    const size_t bytesRead =
+        srcFileInfo->read(lastPage.pageNum * pageSize_ + reservedHeaderSize_, dataSize, &data[0]);
+    CHECK_EQ(bytesRead, dataSize);
+    const size_t dataOffset = page.pageNum * pageSize_ + reservedHeaderSize_;
+    const size_t bytesWritten = destFileInfo->write(dataOffset, dataSize, &data[0]);
+    CHECK_EQ(bytesWritten, dataSize);
+    if (page.codec != PageCodec::NONE) {
+      destFileInfo->punchHole(dataOffset + dataSize, pageDataSize_ - dataSize);
+    }
+    writeHeader(page, pageNum, epoch);
+    MultiPage multiPage(pageSize_);
+    multiPage.push(page, epoch);
+    std::lock_guard<std::mutex> pagesLock(pagesMutex_);
+    multiPages_[pageNum] = multiPage;
+  }
+  firstDirtyPage_ = multiPages_.size();
+  metadataPages_ = MultiPage(METADATA_PAGE_SIZE);
+  writeMetadata(epoch);
+}
+
+void FileBuffer::compressPages(const PageCodec codec) {
+  const int epoch = fm_->epoch();
+  std::vector<int8_t> raw(pageDataSize_);
+  std::vector<int8_t> compressed(pageDataSize_);
+  for (size_t pageNum = firstDirtyPage_; pageNum < multiPages_.size() && pageNum * pageDataSize_ < size_;
+       ++pageNum) {
+    MultiPage& multiPage = multiPages_[pageNum];
+    const Page lastPage = multiPage.current();
+    if (lastPage.codec != PageCodec::NONE) {
+      continue;
+    }
+    const size_t rawSize = std::min(pageDataSize_, size_ - pageNum * pageDataSize_);
+    // keep the pages which don't shrink by at least an eighth uncompressed
+    const size_t maxSize = rawSize - rawSize / 8;
+    if (maxSize <= COMPRESSED_PAGE_PREFIX_SIZE) {
+      continue;
+    }
+    readPage(lastPage, 0, rawSize, &raw[0]);
+    const size_t compressedSize = compress_page(
+        codec, &raw[0], rawSize, &compressed[COMPRESSED_PAGE_PREFIX_SIZE], maxSize - COMPRESSED_PAGE_PREFIX_SIZE);
+    if (!compressedSize) {
+      continue;
+    }
+    const int32_t prefix[2] = {static_cast<int32_t>(compressedSize), static_cast<int32_t>(rawSize)};
+    memcpy(&compressed[0], prefix, sizeof(prefix));
+    // readers may be reading the page and appends extend checkpointed pages in place, which must stay readable
+    // until the epoch is synced: the compressed version goes to a new page and replaces the current one
+    Page page = fm_->requestFreePage(pageSize_, false);
+    page.codec = codec;
+    page.compressedSize = compressedSize;
+    FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+    const size_t dataOffset = page.pageNum * pageSize_ + reservedHeaderSize_;
+    const size_t dataSize = COMPRESSED_PAGE_PREFIX_SIZE + compressedSize;
+    fileInfo->write(dataOffset, dataSize, &compressed[0]);
+    fileInfo->punchHole(dataOffset + dataSize, pageDataSize_ - dataSize);
+    writeHeader(page, pageNum, epoch);
+    {
+      std::lock_guard<std::mutex> pagesLock(pagesMutex_);
+      multiPage.pageVersions.back() = page;
+      multiPage.epochs.back() = epoch;
+    }
+    fm_->retirePage(lastPage);
+  }
+  firstDirtyPage_ = multiPages_.size();
+}
+
 }  // File_Namespace
@@ -27,12 +27,13 @@
 #include "Page.h"
 
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
 
 using namespace Data_Namespace;
 
 #define NUM_METADATA 10
-#define METADATA_VERSION 0
+#define METADATA_VERSION 1
 
 namespace File_Namespace {
 
@@ -80,12 +81,28 @@ class FileBuffer : public AbstractBuffer {
 
   void freePages();
 
+  /// Appends the headers of all the page versions of the buffer, the metadata ones included, to headerVec.
+  void getPageHeaders(std::vector<HeaderInfo>& headerVec) const;
+
   virtual void read(int8_t* const dst,
                     const size_t numBytes = 0,
                     const size_t offset = 0,
                     const MemoryLevel dstMemoryLevel = CPU_LEVEL,
                     const int deviceId = -1);
 
+  /// Reads numBytes of the data of a page from pageOffset on into dst, decompressing the page if needed.
+  size_t readPage(const Page& page, const size_t pageOffset, const size_t numBytes, int8_t* dst);
+
+  /// Compresses the pages written since the last checkpoint, the ones which don't shrink are left as they are.
+  void compressPages(const PageCodec codec);
+
+  /// Copies the current version of every page and the metadata to newly requested pages at epoch, in page order.
+  /// The previous versions are dropped from the buffer but not freed, see FileMgr::compact.
+  void relocatePages(const int epoch);
+
+  /// Starts reading the current version of all pages into the OS page cache, doesn't block.
+  void prefetch();
+
   /**
    * @brief Writes the contents of source (src) into new versions of the affected logical pages.
    *
@@ -122,7 +139,10 @@ class FileBuffer : public AbstractBuffer {
   inline virtual size_t reservedHeaderSize() const { return reservedHeaderSize_; }
 
   /// Returns vector of MultiPages in the FileBuffer.
-  inline virtual std::vector<MultiPage> getMultiPage() const { return multiPages_; }
+  inline virtual std::vector<MultiPage> getMultiPage() const {
+    std::lock_guard<std::mutex> pagesLock(pagesMutex_);
+    return multiPages_;
+  }
 
   inline virtual size_t size() const { return size_; }
 
@@ -143,18 +163,31 @@ class FileBuffer : public AbstractBuffer {
   // headerSize(numBytes), ChunkKey, pageId, version epoch
   // void writeHeader(Page &page, const int pageId, const int epoch, const bool writeSize = false);
   void writeHeader(Page& page, const int pageId, const int epoch, const bool writeMetadata = false);
+  std::vector<int> makeHeader(const Page& page, const int pageId, const int epoch) const;
   void writeMetadata(const int epoch);
+  /**
+   * @brief Writes the header and the metadata of the chunk to the image of the given metadata page,
+   * which becomes the current metadata version, without writing it to the file
+   *
+   * Returns the number of bytes of the image to write, from its start. Lets the FileMgr serialize the
+   * metadata of several chunks concurrently and write adjacent pages with a single write.
+   */
+  size_t fillMetadataPage(const Page& page, const int epoch, int8_t* pageImage);
   void readMetadata(const Page& page);
   void calcHeaderBuffer();
 
   FileMgr* fm_;  // a reference to FileMgr is needed for writing to new pages in available files
-  static size_t headerBufferOffset_;
   MultiPage metadataPages_;
   std::vector<MultiPage> multiPages_;
+  // guards multiPages_ against readers which don't hold the chunk index lock (reads, prefetches of the next
+  // fragment) while a writer adds pages or page versions, writers don't hold it for the page I/O
+  mutable std::mutex pagesMutex_;
   size_t pageSize_;
   size_t pageDataSize_;
   size_t reservedHeaderSize_;  // lets make this a constant now for simplicity - 128 bytes
   ChunkKey chunkKey_;
+  size_t firstDirtyPage_;  // first page written since the last checkpoint
+  size_t persistedSize_;   // size at the last checkpoint, appends below it must not overwrite checkpointed pages
 };
 
 }  // File_Namespace
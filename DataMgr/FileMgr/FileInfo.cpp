@@ -17,7 +17,9 @@
 #include "FileInfo.h"
 #include "File.h"
 #include "Page.h"
+#include "WriteAheadLog.h"
 #include <glog/logging.h>
+#include <cerrno>
 #include <iostream>
 
 #include <utility>
@@ -26,7 +28,7 @@ using namespace std;
 namespace File_Namespace {
 
 FileInfo::FileInfo(const int fileId, FILE* f, const size_t pageSize, size_t numPages, bool init)
-    : fileId(fileId), f(f), pageSize(pageSize), numPages(numPages) {
+    : fileId(fileId), f(f), pageSize(pageSize), numPages(numPages), unsyncedBytes(0), wal(nullptr) {
   if (init) {
     initNewFile();
   }
@@ -48,10 +50,15 @@ void FileInfo::initNewFile() {
     File_Namespace::write(f, pageId * pageSize, sizeof(int), headerSizePtr);
     freePages.insert(pageId);
   }
+  unsyncedBytes += numPages * sizeof(int);
 }
 
 size_t FileInfo::write(const size_t offset, const size_t size, int8_t* buf) {
   std::lock_guard<std::mutex> lock(readWriteMutex_);
+  unsyncedBytes += size;
+  if (wal) {
+    wal->logWrite(fileId, pageSize, offset, size, buf);
+  }
   return File_Namespace::write(f, offset, size, buf);
 }
 
@@ -70,6 +77,9 @@ void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec, const int fi
     int headerSize;
     fseek(f, pageNum * pageSize, SEEK_SET);
     fread((int8_t*)(&headerSize), sizeof(int), 1, f);
+    // the high byte of the header size is the codec of compressed pages
+    const auto codec = static_cast<PageCodec>(static_cast<uint32_t>(headerSize) >> PAGE_CODEC_SHIFT);
+    headerSize &= PAGE_HEADER_SIZE_MASK;
     if (headerSize != 0) {
       // headerSize doesn't include headerSize itself
       // We're tying ourself to headers of ints here
@@ -120,6 +130,7 @@ void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec, const int fi
         // header to mark as free
         headerSize = 0;
         File_Namespace::write(f, pageNum * pageSize, sizeof(int), (int8_t*)&headerSize);
+        unsyncedBytes += sizeof(int);
         // Now add page to free list
         freePages.insert(pageNum);
         LOG(WARNING) << "Was not checkpointed: Chunk key: " << showChunk(chunkKey) << " Page id: " << pageId
@@ -127,6 +138,11 @@ void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec, const int fi
 
       } else {  // page was checkpointed properly
         Page page(fileId, pageNum);
+        if (codec != PageCodec::NONE) {
+          page.codec = codec;
+          fseek(f, pageNum * pageSize + reserved_header_size(chunkKey.size()), SEEK_SET);
+          fread((int8_t*)(&page.compressedSize), sizeof(int32_t), 1, f);
+        }
         headerVec.push_back(HeaderInfo(chunkKey, pageId, versionEpoch, page));
         // std::cout << "Inserted into headerVec" << std::endl;
       }
@@ -146,10 +162,25 @@ void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec, const int fi
   }
 }
 
+void FileInfo::punchHole(const size_t offset, const size_t size) {
+#ifdef __linux__
+  std::lock_guard<std::mutex> lock(readWriteMutex_);
+  fflush(f);
+  if (fallocate(fileno(f), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, size) != 0) {
+    // the file system doesn't support holes, the bytes stay allocated
+    VLOG(1) << "Failed to punch a hole in file " << fileId << ", the errno is " << errno;
+  }
+#endif  // __linux__
+}
+
 void FileInfo::freePage(int pageId) {
   int zeroVal = 0;
   int8_t* zeroAddr = reinterpret_cast<int8_t*>(&zeroVal);
   File_Namespace::write(f, pageId * pageSize, sizeof(int), zeroAddr);
+  unsyncedBytes += sizeof(int);
+  if (wal) {
+    wal->logWrite(fileId, pageSize, pageId * pageSize, sizeof(int), zeroAddr);
+  }
   std::lock_guard<std::mutex> lock(freePagesMutex_);
   freePages.insert(pageId);
 }
@@ -19,6 +19,7 @@
 
 #include "../../Shared/types.h"
 #include "Page.h"
+#include <atomic>
 #include <cstdio>
 #include <set>
 #include <vector>
@@ -29,6 +30,7 @@
 namespace File_Namespace {
 
 struct Page;
+class WriteAheadLog;
 
 /**
  * @type FileInfo
@@ -53,6 +55,8 @@ struct FileInfo {
   std::set<size_t> freePages;  /// set of page numbers of free pages
   std::mutex freePagesMutex_;
   std::mutex readWriteMutex_;
+  std::atomic<size_t> unsyncedBytes;  /// bytes written since the last sync, the file needs no sync if zero
+  WriteAheadLog* wal;                 /// log of the table the writes are recorded in, if any
 
   /// Constructor
   FileInfo(const int fileId, FILE* f, const size_t pageSize, const size_t numPages, const bool init = false);
@@ -68,6 +72,8 @@ struct FileInfo {
   int getFreePage();
   size_t write(const size_t offset, const size_t size, int8_t* buf);
   size_t read(const size_t offset, const size_t size, int8_t* buf);
+  /// Releases the disk blocks of a range of the file, which then reads as zeros.
+  void punchHole(const size_t offset, const size_t size);
 
   void openExistingFile(std::vector<HeaderInfo>& headerVec, const int fileMgrEpoch);
   /// Prints a summary of the file to stdout
@@ -77,6 +83,7 @@ struct FileInfo {
   inline size_t size() { return pageSize * numPages; }
 
   inline int syncToDisk() {
+    unsyncedBytes = 0;
     fflush(f);
 #ifdef __APPLE__
     return fcntl(fileno(f), 51);
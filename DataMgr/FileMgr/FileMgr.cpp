@@ -21,8 +21,10 @@
  */
 
 #include "FileMgr.h"
+#include "AsyncFileReader.h"
 #include "GlobalFileMgr.h"
 #include "File.h"
+#include "HeaderScanPool.h"
 #include "../Shared/measure.h"
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
@@ -38,6 +40,8 @@
 
 #define EPOCH_FILENAME "epoch"
 #define DB_META_FILENAME "dbmeta"
+#define WAL_FILENAME "wal"
+#define METADATA_INDEX_FILENAME "metadata_index"
 
 using namespace std;
 
@@ -59,6 +63,50 @@ bool headerCompare(const HeaderInfo& firstElem, const HeaderInfo& secondElem) {
   */
 }
 
+std::shared_ptr<void> ReadTracker::pinReads() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto readIt = activeReads_.insert(nextTag_);
+  auto self = shared_from_this();
+  return std::shared_ptr<void>(nullptr, [self, readIt](void*) {
+    std::lock_guard<std::mutex> lock(self->mutex_);
+    self->activeReads_.erase(readIt);
+  });
+}
+
+void ReadTracker::retirePage(const Page& page) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the reads which started before have a tag up to this one
+  retiredPages_.emplace_back(nextTag_++, page);
+}
+
+void ReadTracker::retireFile(FileInfo* fileInfo) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  retiredFiles_.emplace_back(nextTag_++, fileInfo);
+}
+
+void ReadTracker::takeReclaimable(std::vector<Page>& pages, std::vector<FileInfo*>& files) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t oldestRead = activeReads_.empty() ? nextTag_ : *activeReads_.begin();
+  auto keptIt = retiredPages_.begin();
+  for (const auto& retiredPage : retiredPages_) {
+    if (retiredPage.first < oldestRead) {
+      pages.push_back(retiredPage.second);
+    } else {
+      *keptIt++ = retiredPage;
+    }
+  }
+  retiredPages_.erase(keptIt, retiredPages_.end());
+  auto keptFileIt = retiredFiles_.begin();
+  for (const auto& retiredFile : retiredFiles_) {
+    if (retiredFile.first < oldestRead) {
+      files.push_back(retiredFile.second);
+    } else {
+      *keptFileIt++ = retiredFile;
+    }
+  }
+  retiredFiles_.erase(keptFileIt, retiredFiles_.end());
+}
+
 FileMgr::FileMgr(const int deviceId,
                  GlobalFileMgr* gfm,
                  const std::pair<const int, const int> fileMgrKey,
@@ -70,7 +118,12 @@ FileMgr::FileMgr(const int deviceId,
       fileMgrKey_(fileMgrKey),
       defaultPageSize_(defaultPageSize),
       nextFileId_(0),
-      epoch_(epoch) {
+      epoch_(epoch),
+      storageCompression_(PageCodec::NONE),
+      lastCheckpointBytes_(0),
+      metadataIndexOnDisk_(false),
+      requestedPagesEpoch_(-1),
+      readTracker_(std::make_shared<ReadTracker>()) {
   init(num_reader_threads);
 }
 
@@ -81,7 +134,12 @@ FileMgr::FileMgr(GlobalFileMgr* gfm, const size_t defaultPageSize, std::string b
       fileMgrBasePath_(basePath),
       defaultPageSize_(defaultPageSize),
       nextFileId_(0),
-      epoch_(-1) {
+      epoch_(-1),
+      storageCompression_(PageCodec::NONE),
+      lastCheckpointBytes_(0),
+      metadataIndexOnDisk_(false),
+      requestedPagesEpoch_(-1),
+      readTracker_(std::make_shared<ReadTracker>()) {
   init(basePath);
 }
 
@@ -92,11 +150,27 @@ FileMgr::~FileMgr() {
     delete chunkIt->second;
   }
   for (auto file_info : files_) {
-    delete file_info;
+    if (file_info && retiredFileIds_.count(file_info->fileId)) {
+      deleteFile(file_info);
+    } else {
+      delete file_info;
+    }
   }
 }
 
 void FileMgr::init(const size_t num_reader_threads) {
+  /* define number of reader threads to be used */
+  size_t num_hardware_based_threads =
+      std::thread::hardware_concurrency();  // # of threads is based on # of cores on the host
+  if (num_reader_threads == 0) {            // # of threads has not been defined by user
+    num_reader_threads_ = num_hardware_based_threads;
+  } else {
+    if (num_reader_threads > num_hardware_based_threads)
+      num_reader_threads_ = num_hardware_based_threads;
+    else
+      num_reader_threads_ = num_reader_threads;
+  }
+
   // if epoch = -1 this means open from epoch file
   const std::string fileMgrDirPrefix("table");
   const std::string FileMgrDirDelim("_");
@@ -111,19 +185,19 @@ void FileMgr::init(const size_t num_reader_threads) {
     if (epoch_ != -1) {  // if opening at previous epoch
       int epochCopy = epoch_;
       openEpochFile(EPOCH_FILENAME);
+      initWal();
       epoch_ = epochCopy;
     } else {
       openEpochFile(EPOCH_FILENAME);
+      initWal();
     }
 
     auto clock_begin = timer_start();
 
     boost::filesystem::directory_iterator endItr;  // default construction yields past-the-end
     int maxFileId = -1;
-    int fileCount = 0;
-    int threadCount = std::thread::hardware_concurrency();
-    std::vector<HeaderInfo> headerVec;
-    std::vector<std::future<std::vector<HeaderInfo>>> file_futures;
+    std::vector<MetadataIndexFile> dataFiles;
+    std::map<int, std::string> dataFilePaths;
     for (boost::filesystem::directory_iterator fileIt(path); fileIt != endItr; ++fileIt) {
       if (boost::filesystem::is_regular_file(fileIt->status())) {
         // note that boost::filesystem leaves preceding dot on
@@ -152,26 +226,40 @@ void FileMgr::init(const size_t num_reader_threads) {
 
           VLOG(1) << "File id: " << fileId << " Page size: " << pageSize << " Num pages: " << numPages;
 
-          file_futures.emplace_back(std::async(std::launch::async, [filePath, fileId, pageSize, numPages, this] {
-            std::vector<HeaderInfo> tempHeaderVec;
-            openExistingFile(filePath, fileId, pageSize, numPages, tempHeaderVec);
-            return tempHeaderVec;
-          }));
-          fileCount++;
-          if (fileCount % threadCount == 0) {
-            processFileFutures(file_futures, headerVec);
-          }
+          dataFiles.push_back({fileId, pageSize, numPages});
+          dataFilePaths[fileId] = filePath;
         }
       }
     }
+    std::sort(dataFiles.begin(), dataFiles.end());
 
-    if (file_futures.size() > 0) {
+    const std::string metadataIndexPath(fileMgrBasePath_ + METADATA_INDEX_FILENAME);
+    metadataIndexOnDisk_ = boost::filesystem::exists(metadataIndexPath);
+    std::vector<HeaderInfo> headerVec;
+    std::vector<MetadataIndexFile> indexFiles;
+    // the index is only current if it was written at the epoch of the epoch file, for the same files
+    const bool fromIndex = g_enable_metadata_index &&
+                           read_metadata_index(metadataIndexPath, epoch_ - 1, indexFiles, headerVec) &&
+                           indexFiles == dataFiles && openFromMetadataIndex(dataFiles, dataFilePaths, headerVec);
+    if (!fromIndex) {
+      headerVec.clear();
+      // the files of all the tables being opened share the threads of the pool
+      std::vector<std::future<std::vector<HeaderInfo>>> file_futures;
+      for (const auto& dataFile : dataFiles) {
+        const auto filePath = dataFilePaths[dataFile.fileId];
+        file_futures.emplace_back(gfm_->getHeaderScanPool().submit([filePath, dataFile, this] {
+          std::vector<HeaderInfo> tempHeaderVec;
+          openExistingFile(filePath, dataFile.fileId, dataFile.pageSize, dataFile.numPages, tempHeaderVec);
+          return tempHeaderVec;
+        }));
+      }
       processFileFutures(file_futures, headerVec);
     }
     int64_t queue_time_ms = timer_stop(clock_begin);
 
-    LOG(INFO) << "Completed Reading table's file metadata, Elasped time : " << queue_time_ms << "ms Epoch: " << epoch_
-              << " files read: " << fileCount << " table location: '" << fileMgrBasePath_ << "'";
+    LOG(INFO) << "Completed Reading table's file metadata " << (fromIndex ? "from its index" : "from the page headers")
+              << ", Elasped time : " << queue_time_ms << "ms Epoch: " << epoch_ << " files read: " << dataFiles.size()
+              << " table location: '" << fileMgrBasePath_ << "'";
 
     /* Sort headerVec so that all HeaderInfos
      * from a chunk will be grouped together
@@ -221,6 +309,14 @@ void FileMgr::init(const size_t num_reader_threads) {
     }
     nextFileId_ = maxFileId + 1;
     // std::cout << "next file id: " << nextFileId_ << std::endl;
+    if (!g_enable_metadata_index) {
+      // an index left by a previous run would be outdated by the time it's enabled again
+      invalidateMetadataIndex();
+    } else if (!fromIndex) {
+      // the headers of the pages the scan freed must be cleared on disk before the index omits them
+      syncDirtyFiles();
+      writeMetadataIndex(epoch_ - 1);
+    }
   } else {  // data directory does not exist
     // std::cout << basePath_ << " does not exist. Creating" << std::endl;
     if (!boost::filesystem::create_directory(path)) {
@@ -229,18 +325,7 @@ void FileMgr::init(const size_t num_reader_threads) {
     // std::cout << basePath_ << " created." << std::endl;
     // now create epoch file
     createEpochFile(EPOCH_FILENAME);
-  }
-
-  /* define number of reader threads to be used */
-  size_t num_hardware_based_threads =
-      std::thread::hardware_concurrency();  // # of threads is based on # of cores on the host
-  if (num_reader_threads == 0) {            // # of threads has not been defined by user
-    num_reader_threads_ = num_hardware_based_threads;
-  } else {
-    if (num_reader_threads > num_hardware_based_threads)
-      num_reader_threads_ = num_hardware_based_threads;
-    else
-      num_reader_threads_ = num_reader_threads;
+    initWal();
   }
 }
 
@@ -267,15 +352,15 @@ void FileMgr::init(const std::string dataPathToConvertFrom) {
     if (epoch_ != -1) {  // if opening at previous epoch
       int epochCopy = epoch_;
       openEpochFile(EPOCH_FILENAME);
+      initWal();
       epoch_ = epochCopy;
     } else {
       openEpochFile(EPOCH_FILENAME);
+      initWal();
     }
 
     boost::filesystem::directory_iterator endItr;  // default construction yields past-the-end
     int maxFileId = -1;
-    int fileCount = 0;
-    int threadCount = std::thread::hardware_concurrency();
     std::vector<HeaderInfo> headerVec;
     std::vector<std::future<std::vector<HeaderInfo>>> file_futures;
     for (boost::filesystem::directory_iterator fileIt(path); fileIt != endItr; ++fileIt) {
@@ -304,15 +389,12 @@ void FileMgr::init(const std::string dataPathToConvertFrom) {
           assert(fileSize % pageSize == 0);  // should be no partial pages
           size_t numPages = fileSize / pageSize;
 
-          file_futures.emplace_back(std::async(std::launch::async, [filePath, fileId, pageSize, numPages, this] {
-            std::vector<HeaderInfo> tempHeaderVec;
-            openExistingFile(filePath, fileId, pageSize, numPages, tempHeaderVec);
-            return tempHeaderVec;
-          }));
-          fileCount++;
-          if (fileCount % threadCount) {
-            processFileFutures(file_futures, headerVec);
-          }
+          file_futures.emplace_back(
+              gfm_->getHeaderScanPool().submit([filePath, fileId, pageSize, numPages, this] {
+                std::vector<HeaderInfo> tempHeaderVec;
+                openExistingFile(filePath, fileId, pageSize, numPages, tempHeaderVec);
+                return tempHeaderVec;
+              }));
         }
       }
     }
@@ -447,7 +529,12 @@ void FileMgr::openEpochFile(const std::string& epochFileName) {
 }
 
 void FileMgr::writeAndSyncEpochToDisk() {
-  write(epochFile_, 0, sizeof(int), (int8_t*)&epoch_);
+  syncEpochToDisk(epoch_);
+  ++epoch_;
+}
+
+void FileMgr::syncEpochToDisk(const int epoch) {
+  write(epochFile_, 0, sizeof(int), (int8_t*)&epoch);
   int status = fflush(epochFile_);
   // int status = fcntl(fileno(epochFile_),51);
   if (status != 0) {
@@ -461,7 +548,25 @@ void FileMgr::writeAndSyncEpochToDisk() {
   if (status != 0) {
     LOG(FATAL) << "Could not sync epoch file to disk";
   }
-  ++epoch_;
+}
+
+void FileMgr::initWal() {
+  // the log of a previous run is replayed even if it's disabled now
+  const std::string walPath(fileMgrBasePath_ + WAL_FILENAME);
+  if (boost::filesystem::exists(walPath)) {
+    WriteAheadLog wal(walPath);
+    const int lastEpoch = wal.replay(epoch_ - 1, fileMgrBasePath_);
+    if (lastEpoch >= epoch_) {
+      epoch_ = lastEpoch;
+      writeAndSyncEpochToDisk();
+    }
+    wal.reset();
+  }
+  if (g_enable_table_wal) {
+    wal_.reset(new WriteAheadLog(walPath));
+  } else if (boost::filesystem::exists(walPath)) {
+    boost::filesystem::remove(walPath);
+  }
 }
 
 void FileMgr::createDBMetaFile(const std::string& DBMetaFileName) {
@@ -506,30 +611,295 @@ void FileMgr::writeAndSyncDBMetaToDisk() {
 }
 
 void FileMgr::checkpoint() {
+  checkpointImpl(true);
+}
+
+void FileMgr::checkpointImpl(const bool logToWal) {
   // std::cout << "Checkpointing " << epoch_ <<  std::endl;
+  const auto clock_begin = timer_start();
+  std::lock_guard<std::mutex> walLock(walMutex_);
   mapd_unique_lock<mapd_shared_mutex> chunkIndexWriteLock(chunkIndexMutex_);
+  reclaimRetired();
+  std::vector<FileBuffer*> dirtyChunks;
   for (auto chunkIt = chunkIndex_.begin(); chunkIt != chunkIndex_.end(); ++chunkIt) {
-    /*
-    for (auto vecIt = chunkIt->first.begin(); vecIt != chunkIt->first.end(); ++vecIt) {
-        std::cout << *vecIt << ",";
-    }
-    cout << "Is dirty: " << chunkIt->second->isDirty_ << endl;
-    */
     if (chunkIt->second->isDirty_) {
-      chunkIt->second->writeMetadata(epoch_);
-      chunkIt->second->clearDirtyBits();
+      dirtyChunks.push_back(chunkIt->second);
     }
   }
+  if (storageCompression_ != PageCodec::NONE) {
+    compressDirtyChunks(dirtyChunks);
+  }
+  writeDirtyMetadata(dirtyChunks);
+  for (auto chunk : dirtyChunks) {
+    chunk->clearDirtyBits();
+  }
   chunkIndexWriteLock.unlock();
 
+  if (logToWal && wal_) {
+    // the epoch file lags until the log is flushed, the replay brings it to the last commit
+    lastCheckpointBytes_ = wal_->commit(epoch_);
+    if (lastCheckpointBytes_) {
+      ++epoch_;
+      VLOG(1) << "Committed " << dirtyChunks.size() << " chunks of table location '" << fileMgrBasePath_
+              << "' at epoch " << epoch_ - 1 << " to the write-ahead log: " << lastCheckpointBytes_ << " bytes in "
+              << timer_stop(clock_begin) << " ms";
+      return;
+    }
+  }
+  lastCheckpointBytes_ = syncDirtyFiles();
+  writeAndSyncEpochToDisk();
+  if (wal_) {
+    wal_->reset();
+  }
+  writeMetadataIndex(epoch_ - 1);
+  VLOG(1) << "Checkpointed " << dirtyChunks.size() << " chunks of table location '" << fileMgrBasePath_
+          << "' at epoch " << epoch_ - 1 << ": " << lastCheckpointBytes_ << " bytes in " << timer_stop(clock_begin)
+          << " ms";
+}
+
+void FileMgr::reclaimRetired() {
+  // the pages were retired by earlier checkpoints, which have synced or logged the epoch superseding them,
+  // the files by compact once the epoch of the copy was synced
+  std::vector<Page> pages;
+  std::vector<FileInfo*> files;
+  readTracker_->takeReclaimable(pages, files);
+  if (!pages.empty()) {
+    invalidateMetadataIndex();
+  }
+  for (const auto& page : pages) {
+    // the last mapping of a page may go after its file
+    FileInfo* fileInfo = getFileInfoForFileId(page.fileId);
+    if (fileInfo) {
+      fileInfo->freePage(page.pageNum);
+    }
+  }
+  if (files.empty()) {
+    return;
+  }
+  mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
+  for (auto fileInfo : files) {
+    files_[fileInfo->fileId] = nullptr;
+    retiredFileIds_.erase(fileInfo->fileId);
+    deleteFile(fileInfo);
+  }
+}
+
+void FileMgr::deleteFile(FileInfo* fileInfo) {
+  const std::string filePath(fileMgrBasePath_ + std::to_string(fileInfo->fileId) + "." +
+                             std::to_string(fileInfo->pageSize) + std::string(MAPD_FILE_EXT));
+  delete fileInfo;
+  boost::system::error_code ec;
+  boost::filesystem::remove(filePath, ec);
+  if (ec) {
+    // the pages left in the file are older than the ones copied, they will be ignored
+    LOG(WARNING) << "Failed to remove file " << filePath << ": " << ec.message();
+  }
+}
+
+void FileMgr::flushWal() {
+  std::lock_guard<std::mutex> walLock(walMutex_);
+  if (!wal_ || wal_->empty()) {
+    return;
+  }
+  // writes past the last commit may be synced too, their epoch is ahead of the epoch file
+  syncDirtyFiles();
+  syncEpochToDisk(wal_->lastCommittedEpoch());
+  wal_->truncate();
+  writeMetadataIndex(wal_->lastCommittedEpoch());
+}
+
+void FileMgr::invalidateMetadataIndex() {
+  std::lock_guard<std::mutex> lock(metadataIndexMutex_);
+  requestedPagesEpoch_ = std::max(requestedPagesEpoch_, epoch_);
+  if (metadataIndexOnDisk_) {
+    remove_metadata_index(fileMgrBasePath_ + METADATA_INDEX_FILENAME);
+    metadataIndexOnDisk_ = false;
+  }
+}
+
+void FileMgr::writeMetadataIndex(const int epoch) {
+  if (!g_enable_metadata_index) {
+    return;
+  }
+  // the chunk index lock comes first, page requests under it take the metadata index lock
+  mapd_shared_lock<mapd_shared_mutex> chunkIndexReadLock(chunkIndexMutex_);
+  // a page has to be requested before a buffer changes, no buffer changes until the index is written
+  std::lock_guard<std::mutex> lock(metadataIndexMutex_);
+  if (requestedPagesEpoch_ > epoch) {
+    // pages past the epoch may have reached the disk, the next sync of the epoch writes the index
+    return;
+  }
+  std::vector<HeaderInfo> headerVec;
+  for (const auto& chunk : chunkIndex_) {
+    chunk.second->getPageHeaders(headerVec);
+  }
+  std::vector<MetadataIndexFile> indexFiles;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
+    for (auto fileInfo : files_) {
+      if (fileInfo && !retiredFileIds_.count(fileInfo->fileId)) {  // null or retired if replaced by compact
+        indexFiles.push_back({fileInfo->fileId, fileInfo->pageSize, fileInfo->numPages});
+      }
+    }
+  }
+  write_metadata_index(fileMgrBasePath_ + METADATA_INDEX_FILENAME, epoch, indexFiles, headerVec);
+  metadataIndexOnDisk_ = true;
+}
+
+bool FileMgr::openFromMetadataIndex(const std::vector<MetadataIndexFile>& dataFiles,
+                                    const std::map<int, std::string>& dataFilePaths,
+                                    const std::vector<HeaderInfo>& headerVec) {
+  std::map<int, std::vector<bool>> usedPages;
+  for (const auto& dataFile : dataFiles) {
+    usedPages[dataFile.fileId].resize(dataFile.numPages, false);
+  }
+  for (const auto& headerInfo : headerVec) {
+    auto usedPagesIt = usedPages.find(headerInfo.page.fileId);
+    if (usedPagesIt == usedPages.end() || headerInfo.page.pageNum >= usedPagesIt->second.size() ||
+        headerInfo.versionEpoch >= epoch_) {
+      LOG(WARNING) << "Metadata index of table location '" << fileMgrBasePath_
+                   << "' is inconsistent, the page headers will be scanned";
+      return false;
+    }
+    usedPagesIt->second[headerInfo.page.pageNum] = true;
+  }
+  // the pages aren't read, the ones the index doesn't list are free
+  for (const auto& dataFile : dataFiles) {
+    FileInfo* fInfo =
+        openFile(dataFilePaths.at(dataFile.fileId), dataFile.fileId, dataFile.pageSize, dataFile.numPages);
+    const auto& filePages = usedPages[dataFile.fileId];
+    for (size_t pageNum = 0; pageNum < filePages.size(); ++pageNum) {
+      if (!filePages[pageNum]) {
+        fInfo->freePages.insert(pageNum);
+      }
+    }
+  }
+  return true;
+}
+
+void FileMgr::writeDirtyMetadata(const std::vector<FileBuffer*>& dirtyChunks) {
+  if (dirtyChunks.empty()) {
+    return;
+  }
+  // the metadata pages are taken in order from the free lists, they are mostly adjacent
+  std::vector<std::pair<Page, FileBuffer*>> metadataPages;
+  for (auto chunk : dirtyChunks) {
+    metadataPages.emplace_back(requestFreePage(METADATA_PAGE_SIZE, true), chunk);
+  }
+  std::sort(metadataPages.begin(),
+            metadataPages.end(),
+            [](const std::pair<Page, FileBuffer*>& lhs, const std::pair<Page, FileBuffer*>& rhs) {
+              return std::make_pair(lhs.first.fileId, lhs.first.pageNum) <
+                     std::make_pair(rhs.first.fileId, rhs.first.pageNum);
+            });
+  std::vector<int8_t> pageImages(metadataPages.size() * METADATA_PAGE_SIZE, 0);
+  std::vector<size_t> imageSizes(metadataPages.size());
+  auto fill_page = [this, &metadataPages, &pageImages, &imageSizes](const size_t i) {
+    imageSizes[i] =
+        metadataPages[i].second->fillMetadataPage(metadataPages[i].first, epoch_, &pageImages[i * METADATA_PAGE_SIZE]);
+  };
+  parallel_stride(num_reader_threads_, metadataPages.size(), fill_page);
+  // one write per run of adjacent pages, up to the end of the metadata of the last one
+  size_t runStart = 0;
+  for (size_t i = 1; i <= metadataPages.size(); ++i) {
+    if (i < metadataPages.size() && metadataPages[i].first.fileId == metadataPages[i - 1].first.fileId &&
+        metadataPages[i].first.pageNum == metadataPages[i - 1].first.pageNum + 1) {
+      continue;
+    }
+    const Page& firstPage = metadataPages[runStart].first;
+    getFileInfoForFileId(firstPage.fileId)
+        ->write(firstPage.pageNum * METADATA_PAGE_SIZE,
+                (i - 1 - runStart) * METADATA_PAGE_SIZE + imageSizes[i - 1],
+                &pageImages[runStart * METADATA_PAGE_SIZE]);
+    runStart = i;
+  }
+}
+
+size_t FileMgr::syncDirtyFiles() {
   mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
-  for (auto fileIt = files_.begin(); fileIt != files_.end(); ++fileIt) {
-    int status = (*fileIt)->syncToDisk();
-    if (status != 0)
+  std::vector<FileInfo*> dirtyFiles;
+  size_t numBytes = 0;
+  for (auto fileInfo : files_) {
+    if (fileInfo && fileInfo->unsyncedBytes) {  // null if deleted by compact
+      dirtyFiles.push_back(fileInfo);
+      numBytes += fileInfo->unsyncedBytes;
+    }
+  }
+  parallel_stride(num_reader_threads_, dirtyFiles.size(), [&dirtyFiles](const size_t i) {
+    if (dirtyFiles[i]->syncToDisk() != 0) {
       LOG(FATAL) << "Could not sync file to disk";
+    }
+  });
+  return numBytes;
+}
+
+void FileMgr::compact(const std::function<void(const size_t, const size_t)>& progress) {
+  // the log can't refer to the files about to be deleted
+  checkpointImpl(false);
+  mapd_unique_lock<mapd_shared_mutex> chunkIndexWriteLock(chunkIndexMutex_);
+  // new pages must come from new files, the old ones are only read from now on
+  std::vector<FileInfo*> oldFiles;
+  size_t oldNumBytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(getPageMutex_);
+    mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
+    for (auto fileInfo : files_) {
+      if (fileInfo && !retiredFileIds_.count(fileInfo->fileId)) {
+        oldFiles.push_back(fileInfo);
+        oldNumBytes += fileInfo->size();
+      }
+    }
+    fileIndex_.clear();
+  }
+  const size_t firstNewFileId = nextFileId_;
+  size_t numPages = 0;
+  for (const auto& chunk : chunkIndex_) {
+    numPages += chunk.second->pageCount();
+  }
+  size_t numPagesCopied = 0;
+  progress(numPagesCopied, numPages);
+  for (auto& chunk : chunkIndex_) {
+    numPagesCopied += chunk.second->pageCount();
+    chunk.second->relocatePages(epoch_);
+    progress(numPagesCopied, numPages);
   }
 
+  // the copy becomes current once the epoch is synced
+  size_t newNumBytes = 0;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
+    for (size_t fileId = firstNewFileId; fileId < files_.size(); ++fileId) {
+      if (files_[fileId]->syncToDisk() != 0) {
+        LOG(FATAL) << "Could not sync file to disk";
+      }
+      newNumBytes += files_[fileId]->size();
+    }
+  }
   writeAndSyncEpochToDisk();
+  if (wal_) {
+    wal_->reset();
+  }
+
+  mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
+  for (auto fileInfo : oldFiles) {
+    // the reads which started before may still use the old files
+    retiredFileIds_.insert(fileInfo->fileId);
+    readTracker_->retireFile(fileInfo);
+  }
+  LOG(INFO) << "Compacted " << numPages << " pages of table location '" << fileMgrBasePath_ << "' from "
+            << oldFiles.size() << " files of " << oldNumBytes << " bytes to " << files_.size() - firstNewFileId
+            << " files of " << newNumBytes << " bytes";
+  write_lock.unlock();
+  reclaimRetired();
+  chunkIndexWriteLock.unlock();
+  writeMetadataIndex(epoch_ - 1);
+}
+
+void FileMgr::compressDirtyChunks(const std::vector<FileBuffer*>& dirtyChunks) {
+  // the chunks are compressed by the reader threads
+  parallel_stride(num_reader_threads_, dirtyChunks.size(), [this, &dirtyChunks](const size_t i) {
+    dirtyChunks[i]->compressPages(storageCompression_);
+  });
 }
 
 AbstractBuffer* FileMgr::createBuffer(const ChunkKey& key, const size_t pageSize, const size_t numBytes) {
@@ -614,6 +984,8 @@ void FileMgr::fetchBuffer(const ChunkKey& key, AbstractBuffer* destBuffer, const
   if (destBuffer->isDirty()) {
     LOG(FATAL) << " Chunk inconsitency - fetchChunk";
   }
+  // the pages looked up from now on stay allocated until the read is done
+  const auto readPin = readTracker_->pinReads();
   mapd_shared_lock<mapd_shared_mutex> chunkIndexReadLock(chunkIndexMutex_);
   auto chunkIt = chunkIndex_.find(key);
   if (chunkIt == chunkIndex_.end()) {
@@ -641,6 +1013,24 @@ void FileMgr::fetchBuffer(const ChunkKey& key, AbstractBuffer* destBuffer, const
   }
   destBuffer->setSize(chunkSize);
   destBuffer->syncEncoder(chunk);
+  if (g_enable_async_file_reads) {
+    prefetchNextFragment(key);
+  }
+}
+
+void FileMgr::prefetchNextFragment(const ChunkKey& key) {
+  // scans go through the fragments of a column in order, the next one is likely to be fetched soon
+  if (key.size() < 4) {
+    return;
+  }
+  auto nextKey = key;
+  ++nextKey[3];
+  const auto readPin = readTracker_->pinReads();
+  mapd_shared_lock<mapd_shared_mutex> chunkIndexReadLock(chunkIndexMutex_);
+  auto chunkIt = chunkIndex_.find(nextKey);
+  if (chunkIt != chunkIndex_.end()) {
+    chunkIt->second->prefetch();
+  }
 }
 
 AbstractBuffer* FileMgr::putBuffer(const ChunkKey& key, AbstractBuffer* srcBuffer, const size_t numBytes) {
@@ -693,6 +1083,7 @@ void FileMgr::free(AbstractBuffer* buffer) {
 //}
 
 Page FileMgr::requestFreePage(size_t pageSize, const bool isMetadata) {
+  invalidateMetadataIndex();
   std::lock_guard<std::mutex> lock(getPageMutex_);
 
   auto candidateFiles = fileIndex_.equal_range(pageSize);
@@ -722,6 +1113,7 @@ void FileMgr::requestFreePages(size_t numPagesRequested,
                                const bool isMetadata) {
   // not used currently
   // @todo add method to FileInfo to get more than one page
+  invalidateMetadataIndex();
   std::lock_guard<std::mutex> lock(getPageMutex_);
   auto candidateFiles = fileIndex_.equal_range(pageSize);
   size_t numPagesNeeded = numPagesRequested;
@@ -766,10 +1158,15 @@ FileInfo* FileMgr::openExistingFile(const std::string& path,
                                     const size_t pageSize,
                                     const size_t numPages,
                                     std::vector<HeaderInfo>& headerVec) {
+  FileInfo* fInfo = openFile(path, fileId, pageSize, numPages);
+  fInfo->openExistingFile(headerVec, epoch_);
+  return fInfo;
+}
+
+FileInfo* FileMgr::openFile(const std::string& path, const int fileId, const size_t pageSize, const size_t numPages) {
   FILE* f = open(path);
   FileInfo* fInfo = new FileInfo(fileId, f, pageSize, numPages, false);  // false means don't init file
-
-  fInfo->openExistingFile(headerVec, epoch_);
+  fInfo->wal = wal_.get();
   mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
   if (fileId >= static_cast<int>(files_.size())) {
     files_.resize(fileId + 1);
@@ -796,6 +1193,10 @@ FileInfo* FileMgr::createFile(const size_t pageSize, const size_t numPages) {
   int fileId = nextFileId_++;
   FileInfo* fInfo = new FileInfo(fileId, f, pageSize, numPages, true);  // true means init file
   assert(fInfo);
+  if (wal_) {
+    wal_->logCreateFile(fileId, pageSize, numPages);
+    fInfo->wal = wal_.get();
+  }
 
   mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
   // update file manager data structures
@@ -806,9 +1207,15 @@ FileInfo* FileMgr::createFile(const size_t pageSize, const size_t numPages) {
   return fInfo;
 }
 
+FileInfo* FileMgr::getFileInfoForFileId(const int fileId) {
+  // files are added by page requests and compact removes them while pages are read
+  mapd_shared_lock<mapd_shared_mutex> read_lock(files_rw_mutex_);
+  return files_[fileId];
+}
+
 FILE* FileMgr::getFileForFileId(const int fileId) {
   assert(fileId >= 0);
-  return files_[fileId]->f;
+  return getFileInfoForFileId(fileId)->f;
 }
 /*
 void FileMgr::getAllChunkMetaInfo(std::vector<std::pair<ChunkKey, int64_t> > &metadata) {
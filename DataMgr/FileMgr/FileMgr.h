@@ -28,9 +28,11 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
+#include <functional>
 #include <future>
 
 #include "../AbstractBuffer.h"
@@ -38,7 +40,9 @@
 #include "../Shared/mapd_shared_mutex.h"
 #include "FileBuffer.h"
 #include "FileInfo.h"
+#include "MetadataIndex.h"
 #include "Page.h"
+#include "WriteAheadLog.h"
 
 using namespace Data_Namespace;
 
@@ -79,6 +83,62 @@ typedef FileBuffer Chunk;
  */
 typedef std::map<ChunkKey, FileBuffer*> ChunkKeyToChunkMap;
 
+/**
+ * @brief Calls func(i) for every i in [0, n) on up to numThreads threads, the calling one included.
+ *
+ * The k-th thread takes every numThreads-th index starting from k.
+ */
+template <typename FUNC>
+void parallel_stride(const size_t numThreads, const size_t n, FUNC func) {
+  const size_t threadCount = std::min(std::max(numThreads, size_t(1)), n);
+  auto run_stride = [&func, n, threadCount](const size_t first) {
+    for (size_t i = first; i < n; i += threadCount) {
+      func(i);
+    }
+  };
+  std::vector<std::future<void>> threads;
+  for (size_t i = 1; i < threadCount; ++i) {
+    threads.push_back(std::async(std::launch::async, run_stride, i));
+  }
+  if (threadCount) {
+    run_stride(0);
+  }
+  for (auto& thread : threads) {
+    thread.get();
+  }
+}
+
+/**
+ * @class   ReadTracker
+ * @brief   Tracks the reads of the pages of a table in progress.
+ *
+ * Readers look up pages without holding the chunk index lock, a page version superseded while they may
+ * still read it is retired instead of freed. It's reclaimed once every read which started before it was
+ * retired is done. The files compact replaces are retired the same way. Handles hold a reference to the
+ * tracker, which outlives the FileMgr if they do.
+ */
+class ReadTracker : public std::enable_shared_from_this<ReadTracker> {
+ public:
+  ReadTracker() : nextTag_(0) {}
+
+  /// Returns a handle keeping the pages retired from now on from being reclaimed until it's released.
+  std::shared_ptr<void> pinReads();
+
+  void retirePage(const Page& page);
+
+  void retireFile(FileInfo* fileInfo);
+
+  /// Appends the retired pages and files no read can use anymore to pages and files and forgets about them.
+  void takeReclaimable(std::vector<Page>& pages, std::vector<FileInfo*>& files);
+
+ private:
+  std::mutex mutex_;
+  uint64_t nextTag_;                     /// tag of the next retirement
+  std::multiset<uint64_t> activeReads_;  /// tags current when the reads in progress started
+  std::vector<std::pair<uint64_t, Page>> retiredPages_;
+  std::vector<std::pair<uint64_t, FileInfo*>> retiredFiles_;
+};
+
 /**
  * @class   FileMgr
  * @brief
@@ -141,7 +201,16 @@ class FileMgr : public AbstractBufferMgr {  // implements
   virtual inline size_t getAllocated() { return 0; }
   virtual inline bool isAllocationCapped() { return false; }
 
-  inline FileInfo* getFileInfoForFileId(const int fileId) { return files_[fileId]; }
+  /// Returns the file with the given id, null if compact deleted it. Safe concurrently with page requests.
+  FileInfo* getFileInfoForFileId(const int fileId);
+
+  /**
+   * @brief Frees a superseded page version once no read can use it anymore
+   *
+   * Only for versions superseded by the checkpoint in progress, they're freed at a later checkpoint, after
+   * the epoch which doesn't need them anymore is synced.
+   */
+  inline void retirePage(const Page& page) { readTracker_->retirePage(page); }
 
   void init(const size_t num_reader_threads);
   void init(const std::string dataPathToConvertFrom);
@@ -174,24 +243,59 @@ class FileMgr : public AbstractBufferMgr {  // implements
   /**
    * @brief Fsyncs data files, writes out epoch and
    * fsyncs that
+   *
+   * The metadata of the dirty chunks is serialized on the reader threads and written with one write
+   * per run of adjacent metadata pages; only the files written since the last checkpoint are fsynced,
+   * concurrently. With a write-ahead log, the writes since the last checkpoint are committed to the log
+   * instead unless they're too large for it, the data files and the epoch file are synced by flushWal.
    */
 
   void checkpoint();
   void checkpoint(const int db_id, const int tb_id) {
     LOG(FATAL) << "Operation not supported, api checkpoint() should be used instead";
   }
+  /**
+   * @brief Rewrites the current version of all chunks contiguously into new files and deletes the old ones
+   *
+   * Checkpoints first, then copies the pages chunk by chunk, in chunk key order, and makes the copy
+   * current with the next checkpoint. Until then the old files are left untouched, a crash rolls back
+   * to them. Frees the space of the free pages and of the superseded page versions, the table can't
+   * be rolled back to an epoch prior to the compaction afterwards. Reports the number of pages copied
+   * so far and the total through progress. The caller must keep writes out, reads may go on: the old
+   * files are deleted once the reads which started before they were replaced are done.
+   */
+  void compact(const std::function<void(const size_t, const size_t)>& progress);
+
+  /// Syncs the data files and the epoch file up to the last commit to the write-ahead log, then empties it.
+  void flushWal();
+
+  /**
+   * @brief Removes the metadata index before pages get written or freed
+   *
+   * The pages written after the epoch of the index have headers on disk it doesn't know about,
+   * the index can't be used to open the table until it's rewritten at the next sync of the epoch.
+   */
+  void invalidateMetadataIndex();
+
   /**
    * @brief Returns current value of epoch - should be
    * one greater than recorded at last checkpoint
    */
   inline int epoch() { return epoch_; }
 
+  /// Returns the number of bytes the last checkpoint made durable, written to the files since the one before.
+  inline size_t getLastCheckpointBytes() const { return lastCheckpointBytes_; }
+
   /**
    * @brief Returns number of threads defined by parameter num-reader-threads
    * which should be used during initial load and consequent read of data.
    */
   inline size_t getNumReaderThreads() { return num_reader_threads_; }
 
+  /// Sets the codec the pages written from now on are compressed with at checkpoints.
+  inline void setStorageCompression(const PageCodec codec) { storageCompression_ = codec; }
+  inline PageCodec getStorageCompression() const { return storageCompression_; }
+
   /**
    * @brief Returns FILE pointer associated with
    * requested fileId
@@ -217,18 +321,27 @@ class FileMgr : public AbstractBufferMgr {  // implements
   std::pair<const int, const int> fileMgrKey_;
   std::string fileMgrBasePath_;   /// The OS file system path containing files related to this FileMgr
   std::vector<FileInfo*> files_;  /// A vector of files accessible via a file identifier.
+  std::set<int> retiredFileIds_;  /// files replaced by compact, still in files_ until no read uses them
   PageSizeFileMMap fileIndex_;    /// Maps page sizes to FileInfo objects.
   size_t num_reader_threads_;     /// number of threads used when loading data
   size_t defaultPageSize_;
   unsigned nextFileId_;  /// the index of the next file id
   int epoch_;            /// the current epoch (time of last checkpoint)
+  PageCodec storageCompression_;  /// codec of the pages compressed at checkpoints
+  size_t lastCheckpointBytes_;    /// bytes synced by the last checkpoint
   FILE* epochFile_;
   int db_version_;    /// DB version from dbmeta file, should be compatible with GlobalFileMgr::mapd_db_version_
   FILE* DBMetaFile_;  /// pointer to DB level metadata
   // bool isDirty_;      /// true if metadata changed since last writeState()
   std::mutex getPageMutex_;
+  std::unique_ptr<WriteAheadLog> wal_;  /// write-ahead log of the table, null if disabled
+  std::mutex walMutex_;                 /// serializes checkpoints and WAL flushes
   mutable mapd_shared_mutex chunkIndexMutex_;
   mutable mapd_shared_mutex files_rw_mutex_;
+  std::mutex metadataIndexMutex_;  /// serializes writes and removals of the metadata index
+  bool metadataIndexOnDisk_;       /// the metadata index may exist and must be removed before pages are written
+  int requestedPagesEpoch_;        /// latest epoch pages were requested or freed at since the table was opened
+  std::shared_ptr<ReadTracker> readTracker_;  /// reads in progress and the pages retired while they may use them
 
   /**
    * @brief Adds a file to the file manager repository.
@@ -246,6 +359,7 @@ class FileMgr : public AbstractBufferMgr {  // implements
    */
 
   FileInfo* createFile(const size_t pageSize, const size_t numPages);
+  FileInfo* openFile(const std::string& path, const int fileId, const size_t pageSize, const size_t numPages);
   FileInfo* openExistingFile(const std::string& path,
                              const int fileId,
                              const size_t pageSize,
@@ -254,12 +368,26 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void createEpochFile(const std::string& epochFileName);
   void openEpochFile(const std::string& epochFileName);
   void writeAndSyncEpochToDisk();
+  void syncEpochToDisk(const int epoch);
   void createDBMetaFile(const std::string& DBMetaFileName);
   bool openDBMetaFile(const std::string& DBMetaFileName);
   void writeAndSyncDBMetaToDisk();
   void setEpoch(int epoch);  // resets current value of epoch at startup
+  void checkpointImpl(const bool logToWal);
+  void reclaimRetired();
+  void deleteFile(FileInfo* fileInfo);  /// closes a file compact replaced and removes it from the disk
+  void initWal();
+  void compressDirtyChunks(const std::vector<FileBuffer*>& dirtyChunks);
+  void writeDirtyMetadata(const std::vector<FileBuffer*>& dirtyChunks);
+  size_t syncDirtyFiles();
   void processFileFutures(std::vector<std::future<std::vector<HeaderInfo>>>& file_futures,
                           std::vector<HeaderInfo>& headerVec);
+  bool openFromMetadataIndex(const std::vector<MetadataIndexFile>& dataFiles,
+                             const std::map<int, std::string>& dataFilePaths,
+                             const std::vector<HeaderInfo>& headerVec);
+  /// Writes the metadata index of the pages checkpointed at epoch, unless pages were requested since.
+  void writeMetadataIndex(const int epoch);
+  void prefetchNextFragment(const ChunkKey& key);
 };
 
 }  // File_Namespace
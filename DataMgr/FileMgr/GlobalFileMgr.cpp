@@ -22,6 +22,8 @@
 
 #include "GlobalFileMgr.h"
 #include "File.h"
+#include "../../Shared/measure.h"
+#include "../../Shared/thread_count.h"
 #include <string>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
@@ -45,13 +47,26 @@ GlobalFileMgr::GlobalFileMgr(const int deviceId,
       basePath_(basePath),
       num_reader_threads_(num_reader_threads),
       epoch_(-1),  // set the default epoch for all tables corresponding to the time of last checkpoint
-      defaultPageSize_(defaultPageSize) {
+      defaultPageSize_(defaultPageSize),
+      stopWalFlusher_(false) {
   mapd_db_version_ = 1;  // DS changes triggered by individual FileMgr per table project (release 2.1.0)
   dbConvert_ = false;
+  headerScanPool_.reset(new HeaderScanPool(num_reader_threads_ ? num_reader_threads_ : cpu_threads()));
   init();
+  if (g_enable_table_wal) {
+    walFlusher_ = std::thread([this] { runWalFlusher(); });
+  }
 }
 
 GlobalFileMgr::~GlobalFileMgr() {
+  if (walFlusher_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(walFlusherMutex_);
+      stopWalFlusher_ = true;
+    }
+    walFlusherCondition_.notify_one();
+    walFlusher_.join();
+  }
   mapd_lock_guard<mapd_shared_mutex> fileMgrsMutex(fileMgrs_mutex_);
   for (auto fileMgrsIt = fileMgrs_.begin(); fileMgrsIt != fileMgrs_.end(); ++fileMgrsIt) {
     delete fileMgrsIt->second;
@@ -75,16 +90,43 @@ void GlobalFileMgr::init() {
 }
 
 void GlobalFileMgr::checkpoint() {
+  const auto clock_begin = timer_start();
   mapd_lock_guard<mapd_shared_mutex> fileMgrsMutex(fileMgrs_mutex_);
+  std::vector<FileMgr*> fileMgrs;
   for (auto fileMgrsIt = fileMgrs_.begin(); fileMgrsIt != fileMgrs_.end(); ++fileMgrsIt) {
-    fileMgrsIt->second->checkpoint();
+    fileMgrs.push_back(fileMgrsIt->second);
   }
+  // the tables share no files, their checkpoints and fsyncs overlap
+  const size_t numThreads = num_reader_threads_ ? num_reader_threads_ : cpu_threads();
+  parallel_stride(numThreads, fileMgrs.size(), [&fileMgrs](const size_t i) { fileMgrs[i]->checkpoint(); });
+  size_t numBytes = 0;
+  for (auto fileMgr : fileMgrs) {
+    numBytes += fileMgr->getLastCheckpointBytes();
+  }
+  LOG(INFO) << "Checkpointed " << fileMgrs.size() << " tables, " << numBytes << " bytes synced in "
+            << timer_stop(clock_begin) << " ms";
 }
 
 void GlobalFileMgr::checkpoint(const int db_id, const int tb_id) {
   getFileMgr(db_id, tb_id)->checkpoint();
 }
 
+void GlobalFileMgr::flushWals() {
+  // a FileMgr can't be removed from the map, and deleted, while its log is flushed
+  mapd_shared_lock<mapd_shared_mutex> fileMgrsMutex(fileMgrs_mutex_);
+  for (auto fileMgrsIt = fileMgrs_.begin(); fileMgrsIt != fileMgrs_.end(); ++fileMgrsIt) {
+    fileMgrsIt->second->flushWal();
+  }
+}
+
+void GlobalFileMgr::runWalFlusher() {
+  std::unique_lock<std::mutex> lock(walFlusherMutex_);
+  while (!walFlusherCondition_.wait_for(
+      lock, std::chrono::seconds(g_table_wal_flush_interval), [this] { return stopWalFlusher_; })) {
+    flushWals();
+  }
+}
+
 size_t GlobalFileMgr::getNumChunks() {
   {
     mapd_shared_lock<mapd_shared_mutex> fileMgrsMutex(fileMgrs_mutex_);
@@ -123,14 +165,17 @@ void GlobalFileMgr::getChunkMetadataVec(std::vector<std::pair<ChunkKey, ChunkMet
 FileMgr* GlobalFileMgr::findFileMgr(const int db_id, const int tb_id, const bool removeFromMap) {
   FileMgr* fm = nullptr;
   const auto file_mgr_key = std::make_pair(db_id, tb_id);
+  if (!removeFromMap) {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(fileMgrs_mutex_);
+    auto it = fileMgrs_.find(file_mgr_key);
+    return it != fileMgrs_.end() ? it->second : nullptr;
+  }
   {
-    mapd_lock_guard<mapd_shared_mutex> read_lock(fileMgrs_mutex_);
+    mapd_lock_guard<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
     auto it = fileMgrs_.find(file_mgr_key);
     if (it != fileMgrs_.end()) {
       fm = it->second;
-      if (removeFromMap) {
-        fileMgrs_.erase(it);
-      }
+      fileMgrs_.erase(it);
     }
   }
   return fm;
@@ -144,19 +189,49 @@ FileMgr* GlobalFileMgr::getFileMgr(const int db_id, const int tb_id) {
     }
   }
 
-  { /* create new FileMgr for (db_id, tb_id) */
-    const auto file_mgr_key = std::make_pair(db_id, tb_id);
-    mapd_lock_guard<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
+  const auto file_mgr_key = std::make_pair(db_id, tb_id);
+  std::promise<FileMgr*> opened;
+  { /* wait for the FileMgr if another thread is opening it, or claim the opening */
+    mapd_unique_lock<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
     auto it = fileMgrs_.find(file_mgr_key);
     if (it != fileMgrs_.end()) {
       return it->second;
     }
-    FileMgr* fm = new FileMgr(0, this, file_mgr_key, num_reader_threads_, epoch_, defaultPageSize_);
+    auto openingIt = openingFileMgrs_.find(file_mgr_key);
+    if (openingIt != openingFileMgrs_.end()) {
+      auto opening = openingIt->second;
+      write_lock.unlock();
+      return opening.get();
+    }
+    openingFileMgrs_.insert(std::make_pair(file_mgr_key, opened.get_future().share()));
+  }
+
+  /* create new FileMgr for (db_id, tb_id), the other tables stay accessible while its files are read */
+  FileMgr* fm = nullptr;
+  try {
+    fm = new FileMgr(0, this, file_mgr_key, num_reader_threads_, epoch_, defaultPageSize_);
+  } catch (...) {
+    // the threads waiting for this table get the error, the next opener tries again
+    {
+      mapd_lock_guard<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
+      openingFileMgrs_.erase(file_mgr_key);
+    }
+    opened.set_exception(std::current_exception());
+    throw;
+  }
+  {
+    mapd_lock_guard<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
+    auto codecIt = storageCompressions_.find(file_mgr_key);
+    if (codecIt != storageCompressions_.end()) {
+      fm->setStorageCompression(codecIt->second);
+    }
     auto it_ok = fileMgrs_.insert(std::make_pair(file_mgr_key, fm));
     CHECK(it_ok.second);
-
-    return fm;
+    openingFileMgrs_.erase(file_mgr_key);
   }
+  opened.set_value(fm);
+
+  return fm;
 }
 
 void GlobalFileMgr::writeFileMgrData(FileMgr* fileMgr) {  // this function is not used, keep it for now for future needs
@@ -177,6 +252,10 @@ void GlobalFileMgr::removeTableRelatedDS(const int db_id, const int tb_id) {
   if (fm == nullptr) {
     LOG(FATAL) << "Drop table failed. Table " << db_id << " " << tb_id << " does not exist.";
   }
+  {
+    mapd_lock_guard<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
+    storageCompressions_.erase(std::make_pair(db_id, tb_id));
+  }
 
   /* remove directory containing table related data */
   boost::system::error_code ec;
@@ -206,6 +285,20 @@ void GlobalFileMgr::setTableEpoch(const int db_id, const int tb_id, const int st
   }
 }
 
+void GlobalFileMgr::setTableStorageCompression(const int db_id, const int tb_id, const PageCodec codec) {
+  {
+    mapd_lock_guard<mapd_shared_mutex> write_lock(fileMgrs_mutex_);
+    storageCompressions_[std::make_pair(db_id, tb_id)] = codec;
+  }
+  getFileMgr(db_id, tb_id)->setStorageCompression(codec);
+}
+
+void GlobalFileMgr::compactTable(const int db_id,
+                                 const int tb_id,
+                                 const std::function<void(const size_t, const size_t)>& progress) {
+  getFileMgr(db_id, tb_id)->compact(progress);
+}
+
 size_t GlobalFileMgr::getTableEpoch(const int db_id, const int tb_id) {
   FileMgr* fm = getFileMgr(db_id, tb_id);
 
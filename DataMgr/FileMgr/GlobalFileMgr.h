@@ -26,13 +26,18 @@
 #ifndef DATAMGR_MEMORY_FILE_GLOBAL_FILEMGR_H
 #define DATAMGR_MEMORY_FILE_GLOBAL_FILEMGR_H
 
+#include <condition_variable>
+#include <future>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <set>
 #include <mutex>
+#include <thread>
 #include "../Shared/mapd_shared_mutex.h"
 
 #include "FileMgr.h"
+#include "HeaderScanPool.h"
 #include "../AbstractBuffer.h"
 #include "../AbstractBufferMgr.h"
 
@@ -122,6 +127,9 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
   void checkpoint();
   void checkpoint(const int db_id, const int tb_id);
 
+  /// Flushes the write-ahead logs of all tables, see FileMgr::flushWal.
+  void flushWals();
+
   /**
    * @brief Returns number of threads defined by parameter num-reader-threads
    * which should be used during initial load and consequent read of data.
@@ -130,6 +138,9 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
 
   size_t getNumChunks();
 
+  /// Returns the pool the FileMgrs being opened scan the page headers of their files with.
+  HeaderScanPool& getHeaderScanPool() { return *headerScanPool_; }
+
   FileMgr* findFileMgr(const int db_id, const int tb_id, const bool removeFromMap = false);
   FileMgr* getFileMgr(const int db_id, const int tb_id);
   FileMgr* getFileMgr(const ChunkKey& key) { return getFileMgr(key[0], key[1]); }
@@ -145,6 +156,8 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
   void removeTableRelatedDS(const int db_id, const int tb_id);
   void setTableEpoch(const int db_id, const int tb_id, const int start_epoch);
   size_t getTableEpoch(const int db_id, const int tb_id);
+  void setTableStorageCompression(const int db_id, const int tb_id, const PageCodec codec);
+  void compactTable(const int db_id, const int tb_id, const std::function<void(const size_t, const size_t)>& progress);
 
  private:
   std::string basePath_;       /// The OS file system path containing the files.
@@ -162,7 +175,17 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
                           */
   bool dbConvert_;       /// true if conversion should be done between different "mapd_db_version_"
   std::map<std::pair<int, int>, FileMgr*> fileMgrs_;
+  /// FileMgrs being opened, the tables are opened on first access and without holding fileMgrs_mutex_
+  std::map<std::pair<int, int>, std::shared_future<FileMgr*>> openingFileMgrs_;
+  std::unique_ptr<HeaderScanPool> headerScanPool_;  /// shared by the header scans of all tables
+  std::map<std::pair<int, int>, PageCodec> storageCompressions_;  /// kept for the FileMgrs created later
   mapd_shared_mutex fileMgrs_mutex_;
+  std::thread walFlusher_;  /// flushes the write-ahead logs every g_table_wal_flush_interval seconds
+  std::mutex walFlusherMutex_;
+  std::condition_variable walFlusherCondition_;
+  bool stopWalFlusher_;
+
+  void runWalFlusher();
 };
 
 }  // File_Namespace
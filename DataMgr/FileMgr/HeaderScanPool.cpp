@@ -0,0 +1,72 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    HeaderScanPool.cpp
+ * @brief   Bounded pool of threads scanning the page headers of data files.
+ */
+
+#include "HeaderScanPool.h"
+
+#include <algorithm>
+
+namespace File_Namespace {
+
+HeaderScanPool::HeaderScanPool(const size_t num_threads) : stop_(false) {
+  for (size_t i = 0; i < std::max(num_threads, size_t(1)); ++i) {
+    threads_.emplace_back([this] { worker(); });
+  }
+}
+
+HeaderScanPool::~HeaderScanPool() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_ = true;
+  }
+  queue_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+std::future<std::vector<HeaderInfo>> HeaderScanPool::submit(std::function<std::vector<HeaderInfo>()> scan) {
+  std::packaged_task<std::vector<HeaderInfo>()> task(std::move(scan));
+  auto result = task.get_future();
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_.push_back(std::move(task));
+  }
+  queue_cv_.notify_one();
+  return result;
+}
+
+void HeaderScanPool::worker() {
+  while (true) {
+    std::packaged_task<std::vector<HeaderInfo>()> task;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace File_Namespace
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    HeaderScanPool.h
+ * @brief   Bounded pool of threads scanning the page headers of data files.
+ *
+ * The tables are opened on first access, possibly many at once. Their header scans share the
+ * threads of the pool of the GlobalFileMgr instead of starting one thread per file, so the number
+ * of files read at the same time stays bounded however many tables are being opened.
+ */
+
+#ifndef DATAMGR_FILEMGR_HEADERSCANPOOL_H
+#define DATAMGR_FILEMGR_HEADERSCANPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Page.h"
+
+namespace File_Namespace {
+
+class HeaderScanPool {
+ public:
+  explicit HeaderScanPool(const size_t num_threads);
+  ~HeaderScanPool();
+
+  /// Queues the scan of a file, the future holds the headers of its checkpointed pages.
+  std::future<std::vector<HeaderInfo>> submit(std::function<std::vector<HeaderInfo>()> scan);
+
+  size_t getNumThreads() const { return threads_.size(); }
+
+ private:
+  void worker();
+
+  std::deque<std::packaged_task<std::vector<HeaderInfo>()>> queue_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  bool stop_;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace File_Namespace
+
+#endif  // DATAMGR_FILEMGR_HEADERSCANPOOL_H
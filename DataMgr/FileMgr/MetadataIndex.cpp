@@ -0,0 +1,239 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    MetadataIndex.cpp
+ * @brief   Compact on-disk index of the page headers of a table.
+ */
+
+#include "MetadataIndex.h"
+
+#include "../../QueryEngine/MurmurHash1Inl.h"
+
+#include <boost/filesystem.hpp>
+#include <glog/logging.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+bool g_enable_metadata_index{true};
+
+namespace File_Namespace {
+
+namespace {
+
+const uint32_t METADATA_INDEX_MAGIC{0x4d444958};  // "MDIX"
+const uint32_t METADATA_INDEX_VERSION{1};
+
+// The index is a MetadataIndexHeader, numFiles MetadataIndexFileRecords, then numHeaders page
+// headers, each a MetadataIndexPageRecord followed by keySize ints of chunk key, and a checksum
+// of all of the above.
+struct MetadataIndexHeader {
+  uint32_t magic;
+  uint32_t version;
+  int32_t epoch;
+  uint32_t numFiles;
+  uint64_t numHeaders;
+};
+
+struct MetadataIndexFileRecord {
+  int32_t fileId;
+  int32_t padding;
+  uint64_t pageSize;
+  uint64_t numPages;
+};
+
+struct MetadataIndexPageRecord {
+  int32_t keySize;
+  int32_t pageId;
+  int32_t versionEpoch;
+  int32_t fileId;
+  uint64_t pageNum;
+  int32_t codec;
+  int32_t compressedSize;
+};
+
+template <typename T>
+void append_value(std::vector<int8_t>& buf, const T& val) {
+  const auto pos = buf.size();
+  buf.resize(pos + sizeof(T));
+  memcpy(&buf[pos], &val, sizeof(T));
+}
+
+template <typename T>
+bool read_value(const std::vector<int8_t>& buf, size_t& pos, T& val) {
+  if (pos + sizeof(T) > buf.size()) {
+    return false;
+  }
+  memcpy(&val, &buf[pos], sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+int sync_fd(const int fd) {
+#ifdef __APPLE__
+  return fcntl(fd, 51);
+#else
+  return fsync(fd);
+#endif
+}
+
+}  // namespace
+
+bool read_metadata_index(const std::string& path,
+                         const int epoch,
+                         std::vector<MetadataIndexFile>& files,
+                         std::vector<HeaderInfo>& headerVec) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  const auto size = lseek(fd, 0, SEEK_END);
+  std::vector<int8_t> buf(size > 0 ? size : 0);
+  size_t numRead = 0;
+  while (numRead < buf.size()) {
+    const auto status = pread(fd, &buf[numRead], buf.size() - numRead, numRead);
+    if (status <= 0) {
+      break;
+    }
+    numRead += status;
+  }
+  ::close(fd);
+  if (numRead < buf.size() || buf.size() < sizeof(MetadataIndexHeader) + sizeof(uint64_t)) {
+    return false;
+  }
+  const size_t bodySize = buf.size() - sizeof(uint64_t);
+  uint64_t checksum;
+  memcpy(&checksum, &buf[bodySize], sizeof(checksum));
+  if (checksum != MurmurHash64AImpl(&buf[0], bodySize, 0)) {
+    LOG(WARNING) << "Metadata index '" << path << "' is corrupt, the page headers will be scanned";
+    return false;
+  }
+  buf.resize(bodySize);
+  size_t pos = 0;
+  MetadataIndexHeader header;
+  read_value(buf, pos, header);
+  if (header.magic != METADATA_INDEX_MAGIC || header.version != METADATA_INDEX_VERSION || header.epoch != epoch) {
+    return false;
+  }
+  files.clear();
+  for (uint32_t i = 0; i < header.numFiles; ++i) {
+    MetadataIndexFileRecord record;
+    if (!read_value(buf, pos, record)) {
+      return false;
+    }
+    files.push_back({record.fileId, record.pageSize, record.numPages});
+  }
+  std::sort(files.begin(), files.end());
+  headerVec.clear();
+  headerVec.reserve(header.numHeaders);
+  for (uint64_t i = 0; i < header.numHeaders; ++i) {
+    MetadataIndexPageRecord record;
+    if (!read_value(buf, pos, record) || record.keySize < 0 ||
+        pos + record.keySize * sizeof(int32_t) > buf.size()) {
+      return false;
+    }
+    ChunkKey chunkKey(record.keySize);
+    memcpy(chunkKey.data(), &buf[pos], record.keySize * sizeof(int32_t));
+    pos += record.keySize * sizeof(int32_t);
+    Page page(record.fileId, record.pageNum);
+    page.codec = static_cast<PageCodec>(record.codec);
+    page.compressedSize = record.compressedSize;
+    headerVec.emplace_back(chunkKey, record.pageId, record.versionEpoch, page);
+  }
+  return pos == buf.size();
+}
+
+void write_metadata_index(const std::string& path,
+                          const int epoch,
+                          const std::vector<MetadataIndexFile>& files,
+                          const std::vector<HeaderInfo>& headerVec) {
+  std::vector<int8_t> buf;
+  MetadataIndexHeader header{METADATA_INDEX_MAGIC,
+                             METADATA_INDEX_VERSION,
+                             epoch,
+                             static_cast<uint32_t>(files.size()),
+                             static_cast<uint64_t>(headerVec.size())};
+  append_value(buf, header);
+  for (const auto& file : files) {
+    append_value(buf, MetadataIndexFileRecord{file.fileId, 0, file.pageSize, file.numPages});
+  }
+  for (const auto& headerInfo : headerVec) {
+    append_value(buf,
+                 MetadataIndexPageRecord{static_cast<int32_t>(headerInfo.chunkKey.size()),
+                                         headerInfo.pageId,
+                                         headerInfo.versionEpoch,
+                                         headerInfo.page.fileId,
+                                         headerInfo.page.pageNum,
+                                         static_cast<int32_t>(headerInfo.page.codec),
+                                         headerInfo.page.compressedSize});
+    for (const auto key : headerInfo.chunkKey) {
+      append_value(buf, static_cast<int32_t>(key));
+    }
+  }
+  append_value(buf, MurmurHash64AImpl(&buf[0], buf.size(), 0));
+
+  // written aside and renamed over the index, a crash leaves either the old or the new one
+  const std::string tmpPath(path + ".tmp");
+  const int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG(WARNING) << "Could not create metadata index '" << tmpPath << "', the errno is " << errno;
+    return;
+  }
+  size_t numWritten = 0;
+  while (numWritten < buf.size()) {
+    const auto status = ::write(fd, &buf[numWritten], buf.size() - numWritten);
+    if (status < 0 && errno == EINTR) {
+      continue;
+    }
+    if (status <= 0) {
+      break;
+    }
+    numWritten += status;
+  }
+  const bool synced = numWritten == buf.size() && sync_fd(fd) == 0;
+  ::close(fd);
+  boost::system::error_code ec;
+  if (!synced) {
+    LOG(WARNING) << "Could not write metadata index '" << tmpPath << "', the errno is " << errno;
+    boost::filesystem::remove(tmpPath, ec);
+    return;
+  }
+  boost::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    LOG(WARNING) << "Could not rename metadata index '" << tmpPath << "': " << ec.message();
+  }
+}
+
+void remove_metadata_index(const std::string& path) {
+  if (::unlink(path.c_str()) != 0) {
+    if (errno != ENOENT) {
+      LOG(FATAL) << "Could not remove metadata index '" << path << "', the errno is " << errno;
+    }
+    return;
+  }
+  const auto dirPath = boost::filesystem::path(path).parent_path().string();
+  const int fd = ::open(dirPath.c_str(), O_RDONLY);
+  if (fd < 0 || sync_fd(fd) != 0) {
+    LOG(FATAL) << "Could not sync directory '" << dirPath << "', the errno is " << errno;
+  }
+  ::close(fd);
+}
+
+}  // namespace File_Namespace
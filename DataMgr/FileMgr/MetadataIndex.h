@@ -0,0 +1,73 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    MetadataIndex.h
+ * @brief   Compact on-disk index of the page headers of a table.
+ *
+ * Opening a table used to read the header of every page of every data file. The index holds
+ * the headers of the checkpointed pages in a single file, written whenever the epoch file is
+ * synced, and lets the table open with one sequential read. It's only used if it was written
+ * at the epoch the table opens at and lists exactly the data files found in the directory;
+ * otherwise, after a crash, a write-ahead log replay or a rollback to an earlier epoch, the
+ * headers are scanned as before.
+ */
+
+#ifndef DATAMGR_FILEMGR_METADATAINDEX_H
+#define DATAMGR_FILEMGR_METADATAINDEX_H
+
+#include <string>
+#include <vector>
+
+#include "Page.h"
+
+extern bool g_enable_metadata_index;
+
+namespace File_Namespace {
+
+struct MetadataIndexFile {
+  int fileId;
+  size_t pageSize;
+  size_t numPages;
+
+  bool operator<(const MetadataIndexFile& that) const { return fileId < that.fileId; }
+  bool operator==(const MetadataIndexFile& that) const {
+    return fileId == that.fileId && pageSize == that.pageSize && numPages == that.numPages;
+  }
+};
+
+/**
+ * @brief Reads the index at path into files, sorted by id, and headerVec
+ *
+ * Returns false if the index doesn't exist, is corrupt or wasn't written at epoch.
+ */
+bool read_metadata_index(const std::string& path,
+                         const int epoch,
+                         std::vector<MetadataIndexFile>& files,
+                         std::vector<HeaderInfo>& headerVec);
+
+/// Atomically replaces the index at path, the page headers are those of the pages checkpointed at epoch.
+void write_metadata_index(const std::string& path,
+                          const int epoch,
+                          const std::vector<MetadataIndexFile>& files,
+                          const std::vector<HeaderInfo>& headerVec);
+
+/// Removes the index at path, if any, and syncs its directory so that it can't reappear after a crash.
+void remove_metadata_index(const std::string& path);
+
+}  // namespace File_Namespace
+
+#endif  // DATAMGR_FILEMGR_METADATAINDEX_H
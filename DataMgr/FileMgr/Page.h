@@ -29,6 +29,7 @@
 #include <stdexcept>
 #include <glog/logging.h>
 #include "../../Shared/types.h"
+#include "PageCodec.h"
 
 namespace File_Namespace {
 
@@ -41,14 +42,18 @@ namespace File_Namespace {
  *
  * Note: the number of used bytes should not be greater than the page
  * size. The page size is determined by the containing file.
+ *
+ * Compressed pages also carry their codec and the size of their compressed data, see PageCodec.h.
  */
 struct Page {
-  int fileId;      /// unique identifier of the owning file
-  size_t pageNum;  /// page number
+  int fileId;              /// unique identifier of the owning file
+  size_t pageNum;          /// page number
+  PageCodec codec;         /// codec of the page data, NONE if it isn't compressed
+  int32_t compressedSize;  /// size of the compressed data, excluding its size prefix
 
   /// Constructor
-  Page(int fileId, size_t pageNum) : fileId(fileId), pageNum(pageNum) {}
-  Page() : fileId(-1), pageNum(0) {}
+  Page(int fileId, size_t pageNum) : fileId(fileId), pageNum(pageNum), codec(PageCodec::NONE), compressedSize(0) {}
+  Page() : fileId(-1), pageNum(0), codec(PageCodec::NONE), compressedSize(0) {}
 
   inline bool isValid() { return fileId >= 0; }
 };
@@ -106,6 +111,13 @@ struct MultiPage {
   }
 };
 
+/// Size of the header at the start of the pages of a chunk, padded to 32 bytes.
+inline size_t reserved_header_size(const size_t chunkKeySize) {
+  // 3 * sizeof(int) is for headerSize, for pageId and versionEpoch
+  const size_t headerSize = (chunkKeySize + 3) * sizeof(int);
+  return (headerSize + 31) / 32 * 32;
+}
+
 /**
  * @type HeaderInfo
  * @brief Stores Pair of ChunkKey and Page id and version, in a pair with
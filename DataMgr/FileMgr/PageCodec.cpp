@@ -0,0 +1,130 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PageCodec.h"
+
+#include <boost/algorithm/string.hpp>
+#include <glog/logging.h>
+#include <stdexcept>
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif  // HAVE_LZ4
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif  // HAVE_ZSTD
+
+namespace File_Namespace {
+
+namespace {
+
+// cold pages are written once and read many times, favor the ratio over the compression speed
+const int ZSTD_PAGE_LEVEL = 6;
+
+}  // namespace
+
+PageCodec page_codec_from_string(const std::string& name) {
+  const auto name_uc = boost::to_upper_copy<std::string>(name);
+  if (name_uc == "NONE") {
+    return PageCodec::NONE;
+  }
+  if (name_uc == "LZ4") {
+#ifdef HAVE_LZ4
+    return PageCodec::LZ4;
+#else
+    throw std::runtime_error("LZ4 storage compression is not supported by this build.");
+#endif  // HAVE_LZ4
+  }
+  if (name_uc == "ZSTD") {
+#ifdef HAVE_ZSTD
+    return PageCodec::ZSTD;
+#else
+    throw std::runtime_error("ZSTD storage compression is not supported by this build.");
+#endif  // HAVE_ZSTD
+  }
+  throw std::runtime_error("Unknown storage compression " + name + ". Should be NONE, LZ4 or ZSTD.");
+}
+
+std::string to_string(const PageCodec codec) {
+  switch (codec) {
+    case PageCodec::NONE:
+      return "NONE";
+    case PageCodec::LZ4:
+      return "LZ4";
+    case PageCodec::ZSTD:
+      return "ZSTD";
+  }
+  CHECK(false);
+  return "";
+}
+
+size_t compress_page(const PageCodec codec,
+                     const int8_t* src,
+                     const size_t src_size,
+                     int8_t* dst,
+                     const size_t dst_capacity) {
+  switch (codec) {
+#ifdef HAVE_LZ4
+    case PageCodec::LZ4: {
+      const int compressed_size = LZ4_compress_default(reinterpret_cast<const char*>(src),
+                                                       reinterpret_cast<char*>(dst),
+                                                       static_cast<int>(src_size),
+                                                       static_cast<int>(dst_capacity));
+      return compressed_size > 0 ? compressed_size : 0;
+    }
+#endif  // HAVE_LZ4
+#ifdef HAVE_ZSTD
+    case PageCodec::ZSTD: {
+      const size_t compressed_size = ZSTD_compress(dst, dst_capacity, src, src_size, ZSTD_PAGE_LEVEL);
+      return ZSTD_isError(compressed_size) ? 0 : compressed_size;
+    }
+#endif  // HAVE_ZSTD
+    default:
+      CHECK(false) << "Unsupported page codec " << to_string(codec);
+  }
+  return 0;
+}
+
+void decompress_page(const PageCodec codec,
+                     const int8_t* src,
+                     const size_t src_size,
+                     int8_t* dst,
+                     const size_t dst_size) {
+  switch (codec) {
+#ifdef HAVE_LZ4
+    case PageCodec::LZ4: {
+      const int decompressed_size = LZ4_decompress_safe(reinterpret_cast<const char*>(src),
+                                                        reinterpret_cast<char*>(dst),
+                                                        static_cast<int>(src_size),
+                                                        static_cast<int>(dst_size));
+      CHECK_EQ(decompressed_size, static_cast<int>(dst_size));
+      return;
+    }
+#endif  // HAVE_LZ4
+#ifdef HAVE_ZSTD
+    case PageCodec::ZSTD: {
+      const size_t decompressed_size = ZSTD_decompress(dst, dst_size, src, src_size);
+      CHECK(!ZSTD_isError(decompressed_size)) << ZSTD_getErrorName(decompressed_size);
+      CHECK_EQ(decompressed_size, dst_size);
+      return;
+    }
+#endif  // HAVE_ZSTD
+    default:
+      CHECK(false) << "Unsupported page codec " << to_string(codec);
+  }
+}
+
+}  // File_Namespace
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    PageCodec.h
+ * @brief   Compression of the data pages of a table's files.
+ *
+ * The data of a compressed page starts with its compressed size and its uncompressed size, as 32-bit
+ * integers, followed by the compressed bytes. The codec is recorded in the high byte of the header size
+ * field of the page header, the rest of the page is a hole in the file.
+ */
+
+#ifndef DATAMGR_MEMORY_FILE_PAGECODEC_H
+#define DATAMGR_MEMORY_FILE_PAGECODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace File_Namespace {
+
+enum class PageCodec : int32_t { NONE = 0, LZ4 = 1, ZSTD = 2 };
+
+constexpr size_t COMPRESSED_PAGE_PREFIX_SIZE = 2 * sizeof(int32_t);
+constexpr int PAGE_CODEC_SHIFT = 24;
+constexpr int PAGE_HEADER_SIZE_MASK = (1 << PAGE_CODEC_SHIFT) - 1;
+
+/// Parses NONE, LZ4 or ZSTD, in any case. Throws if the codec is unknown or not built in.
+PageCodec page_codec_from_string(const std::string& name);
+
+std::string to_string(const PageCodec codec);
+
+/// Compresses src_size bytes of src into dst, returns the compressed size or 0 if it exceeds dst_capacity.
+size_t compress_page(const PageCodec codec,
+                     const int8_t* src,
+                     const size_t src_size,
+                     int8_t* dst,
+                     const size_t dst_capacity);
+
+/// Decompresses src_size bytes of src, which must expand to exactly dst_size bytes, into dst.
+void decompress_page(const PageCodec codec,
+                     const int8_t* src,
+                     const size_t src_size,
+                     int8_t* dst,
+                     const size_t dst_size);
+
+}  // File_Namespace
+
+#endif  // DATAMGR_MEMORY_FILE_PAGECODEC_H
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    WriteAheadLog.cpp
+ * @brief   Append-only redo log of the writes to the files of a table.
+ */
+
+#include "WriteAheadLog.h"
+#include "File.h"
+
+#include "../../QueryEngine/MurmurHash1Inl.h"
+
+#include <boost/filesystem.hpp>
+#include <glog/logging.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+bool g_enable_table_wal{false};
+size_t g_table_wal_max_size{64 << 20};
+size_t g_table_wal_flush_interval{10};
+
+namespace File_Namespace {
+
+namespace {
+
+enum WalRecordType : int32_t { WAL_WRITE = 1, WAL_CREATE_FILE = 2, WAL_COMMIT = 3 };
+
+// A WAL_WRITE record is followed by the size bytes written at offset. A WAL_CREATE_FILE record
+// has the number of pages in size. A WAL_COMMIT record has the epoch in fileId, the number of
+// bytes of the records of its group in offset and their checksum in size.
+struct WalRecord {
+  int32_t type;
+  int32_t fileId;
+  uint64_t pageSize;
+  uint64_t offset;
+  uint64_t size;
+};
+
+uint64_t group_checksum(const int8_t* group, const size_t groupSize) {
+  return MurmurHash64AImpl(group, groupSize, 0);
+}
+
+std::string data_file_path(const std::string& basePath, const int fileId, const size_t pageSize) {
+  return basePath + std::to_string(fileId) + "." + std::to_string(pageSize) + std::string(MAPD_FILE_EXT);
+}
+
+int sync_fd(const int fd) {
+#ifdef __APPLE__
+  return fcntl(fd, 51);
+#else
+  return fsync(fd);
+#endif
+}
+
+}  // namespace
+
+WriteAheadLog::WriteAheadLog(const std::string& path)
+    : path_(path), logSize_(0), lastCommittedEpoch_(-1), overflowed_(false) {
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd_ < 0) {
+    LOG(FATAL) << "Could not open write-ahead log '" << path << "', the errno is " << errno;
+  }
+  logSize_ = lseek(fd_, 0, SEEK_END);
+}
+
+WriteAheadLog::~WriteAheadLog() {
+  ::close(fd_);
+}
+
+void WriteAheadLog::appendRecord(const int32_t type,
+                                 const int32_t fileId,
+                                 const uint64_t pageSize,
+                                 const uint64_t offset,
+                                 const uint64_t size) {
+  const WalRecord record{type, fileId, pageSize, offset, size};
+  const auto recordBytes = reinterpret_cast<const int8_t*>(&record);
+  pending_.insert(pending_.end(), recordBytes, recordBytes + sizeof(record));
+}
+
+void WriteAheadLog::logWrite(const int fileId,
+                             const size_t pageSize,
+                             const size_t offset,
+                             const size_t size,
+                             const int8_t* buf) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (overflowed_) {
+    return;
+  }
+  if (pending_.size() + sizeof(WalRecord) + size > g_table_wal_max_size) {
+    // a bulk load, syncing the data files is cheaper than logging it
+    overflowed_ = true;
+    std::vector<int8_t>().swap(pending_);
+    return;
+  }
+  appendRecord(WAL_WRITE, fileId, pageSize, offset, size);
+  pending_.insert(pending_.end(), buf, buf + size);
+}
+
+void WriteAheadLog::logCreateFile(const int fileId, const size_t pageSize, const size_t numPages) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!overflowed_) {
+    appendRecord(WAL_CREATE_FILE, fileId, pageSize, 0, numPages);
+  }
+}
+
+size_t WriteAheadLog::commit(const int epoch) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (overflowed_ || logSize_ + pending_.size() + sizeof(WalRecord) > g_table_wal_max_size) {
+    return 0;
+  }
+  const size_t groupSize = pending_.size();
+  appendRecord(WAL_COMMIT, epoch, 0, groupSize, group_checksum(pending_.data(), groupSize));
+  size_t written = 0;
+  while (written < pending_.size()) {
+    const auto status = pwrite(fd_, &pending_[written], pending_.size() - written, logSize_ + written);
+    if (status < 0) {
+      LOG(FATAL) << "Could not append to write-ahead log '" << path_ << "', the errno is " << errno;
+    }
+    written += status;
+  }
+  syncLog();
+  logSize_ += written;
+  lastCommittedEpoch_ = epoch;
+  if (pending_.capacity() > (1 << 20)) {
+    std::vector<int8_t>().swap(pending_);
+  } else {
+    pending_.clear();
+  }
+  return written;
+}
+
+int WriteAheadLog::replay(const int durableEpoch, const std::string& basePath) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<int8_t> log(logSize_);
+  size_t numRead = 0;
+  while (numRead < log.size()) {
+    const auto status = pread(fd_, &log[numRead], log.size() - numRead, numRead);
+    if (status <= 0) {
+      LOG(FATAL) << "Could not read write-ahead log '" << path_ << "', the errno is " << errno;
+    }
+    numRead += status;
+  }
+  int lastEpoch = durableEpoch;
+  size_t numGroups = 0;
+  std::map<std::string, FILE*> files;
+  size_t groupStart = 0;
+  size_t pos = 0;
+  while (pos + sizeof(WalRecord) <= log.size()) {
+    WalRecord record;
+    memcpy(&record, &log[pos], sizeof(record));
+    if (record.type == WAL_COMMIT) {
+      if (record.offset != pos - groupStart || record.size != group_checksum(&log[groupStart], pos - groupStart)) {
+        break;
+      }
+      if (record.fileId > durableEpoch) {
+        applyGroup(&log[groupStart], pos - groupStart, basePath, files);
+        lastEpoch = record.fileId;
+        ++numGroups;
+      }
+      pos += sizeof(record);
+      groupStart = pos;
+    } else if (record.type == WAL_WRITE) {
+      pos += sizeof(record) + record.size;
+    } else if (record.type == WAL_CREATE_FILE) {
+      pos += sizeof(record);
+    } else {
+      break;
+    }
+  }
+  if (groupStart != log.size()) {
+    LOG(WARNING) << "Ignored " << log.size() - groupStart << " bytes of uncommitted records in write-ahead log '"
+                 << path_ << "'";
+  }
+  for (auto& file : files) {
+    if (fflush(file.second) != 0 || sync_fd(fileno(file.second)) != 0) {
+      LOG(FATAL) << "Could not sync file '" << file.first << "' to disk";
+    }
+    close(file.second);
+  }
+  LOG(INFO) << "Replayed " << numGroups << " groups from write-ahead log '" << path_ << "' up to epoch " << lastEpoch;
+  return lastEpoch;
+}
+
+void WriteAheadLog::applyGroup(const int8_t* group,
+                               const size_t groupSize,
+                               const std::string& basePath,
+                               std::map<std::string, FILE*>& files) {
+  size_t pos = 0;
+  while (pos < groupSize) {
+    WalRecord record;
+    memcpy(&record, group + pos, sizeof(record));
+    pos += sizeof(record);
+    const auto filePath = data_file_path(basePath, record.fileId, record.pageSize);
+    if (record.type == WAL_CREATE_FILE) {
+      // the creation may not have reached the disk, nor the size of the file
+      if (!boost::filesystem::exists(filePath)) {
+        close(create(basePath, record.fileId, record.pageSize, record.size));
+      } else if (boost::filesystem::file_size(filePath) < record.pageSize * record.size) {
+        boost::filesystem::resize_file(filePath, record.pageSize * record.size);
+      }
+      continue;
+    }
+    CHECK_EQ(record.type, WAL_WRITE);
+    auto fileIt = files.find(filePath);
+    if (fileIt == files.end()) {
+      fileIt = files.emplace(filePath, open(filePath)).first;
+    }
+    write(fileIt->second, record.offset, record.size, const_cast<int8_t*>(group + pos));
+    pos += record.size;
+  }
+}
+
+void WriteAheadLog::truncate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ftruncate(fd_, 0) != 0) {
+    LOG(FATAL) << "Could not truncate write-ahead log '" << path_ << "', the errno is " << errno;
+  }
+  syncLog();
+  logSize_ = 0;
+}
+
+void WriteAheadLog::reset() {
+  truncate();
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<int8_t>().swap(pending_);
+  overflowed_ = false;
+}
+
+void WriteAheadLog::syncLog() {
+  if (sync_fd(fd_) != 0) {
+    LOG(FATAL) << "Could not sync write-ahead log '" << path_ << "' to disk";
+  }
+}
+
+bool WriteAheadLog::empty() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return logSize_ == 0;
+}
+
+int WriteAheadLog::lastCommittedEpoch() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lastCommittedEpoch_;
+}
+
+}  // File_Namespace
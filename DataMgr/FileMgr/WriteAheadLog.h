@@ -0,0 +1,111 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    WriteAheadLog.h
+ * @brief   Append-only redo log of the writes to the files of a table.
+ *
+ * The files of the table record every write they receive since the last commit. A commit
+ * appends them to the log as a group, followed by a commit record carrying the epoch and a
+ * checksum of the group, and fsyncs the log only: a small insert is durable after a single
+ * fsync of a single file. The data files and the epoch file are synced later, lazily, and the
+ * log emptied. On startup, the groups committed after the epoch of the epoch file are redone
+ * in the data files before they're opened; a torn group at the end of the log is ignored.
+ */
+
+#ifndef DATAMGR_FILEMGR_WRITEAHEADLOG_H
+#define DATAMGR_FILEMGR_WRITEAHEADLOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern bool g_enable_table_wal;
+extern size_t g_table_wal_max_size;
+extern size_t g_table_wal_flush_interval;
+
+namespace File_Namespace {
+
+class WriteAheadLog {
+ public:
+  /// Opens the log at path, creating it if it doesn't exist.
+  explicit WriteAheadLog(const std::string& path);
+  ~WriteAheadLog();
+
+  /// Records a write to a data file, the next commit makes it durable.
+  void logWrite(const int fileId, const size_t pageSize, const size_t offset, const size_t size, const int8_t* buf);
+
+  /// Records the creation of a data file, its pages are all free.
+  void logCreateFile(const int fileId, const size_t pageSize, const size_t numPages);
+
+  /**
+   * @brief Appends the records since the last commit to the log as a group committed at epoch
+   * and fsyncs the log
+   *
+   * Returns the number of bytes appended, or 0 without writing anything if the records overflowed
+   * the memory they're kept in or would grow the log past g_table_wal_max_size: the caller must
+   * sync the data files instead.
+   */
+  size_t commit(const int epoch);
+
+  /**
+   * @brief Redoes in the data files under basePath the writes of the groups committed after
+   * durableEpoch and syncs them
+   *
+   * Returns the epoch of the last group redone, durableEpoch if there's none.
+   */
+  int replay(const int durableEpoch, const std::string& basePath);
+
+  /// Empties the log once the data files hold its groups, the records not committed yet are kept.
+  void truncate();
+
+  /// Empties the log and drops the records not committed yet, the data files hold them all.
+  void reset();
+
+  /// Returns whether the log holds no committed group.
+  bool empty() const;
+
+  /// Returns the epoch of the last group committed since the log was last emptied.
+  int lastCommittedEpoch() const;
+
+ private:
+  void appendRecord(const int32_t type,
+                    const int32_t fileId,
+                    const uint64_t pageSize,
+                    const uint64_t offset,
+                    const uint64_t size);
+  void applyGroup(const int8_t* group,
+                  const size_t groupSize,
+                  const std::string& basePath,
+                  std::map<std::string, FILE*>& files);
+  void syncLog();
+
+  const std::string path_;
+  int fd_;
+  size_t logSize_;  // bytes of committed groups in the log
+  int lastCommittedEpoch_;
+  std::vector<int8_t> pending_;  // records since the last commit
+  bool overflowed_;              // records were dropped, the next commit can't go to the log
+  mutable std::mutex mutex_;
+};
+
+}  // File_Namespace
+
+#endif  // DATAMGR_FILEMGR_WRITEAHEADLOG_H
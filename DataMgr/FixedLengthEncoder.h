@@ -34,6 +34,7 @@ class FixedLengthEncoder : public Encoder {
 
   ChunkMetadata appendData(int8_t*& srcData, const size_t numAppendElems) {
     T* unencodedData = reinterpret_cast<T*>(srcData);
+    updateSketch(unencodedData, numAppendElems);
     auto encodedData = std::unique_ptr<V[]>(new V[numAppendElems]);
     for (size_t i = 0; i < numAppendElems; ++i) {
       // std::cout << "Unencoded: " << unencodedData[i] << std::endl;
@@ -98,7 +99,7 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) {
-    const auto that_typed = static_cast<const FixedLengthEncoder<T, V>&>(that);
+    const auto& that_typed = static_cast<const FixedLengthEncoder<T, V>&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
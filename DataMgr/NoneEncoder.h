@@ -36,6 +36,7 @@ class NoneEncoder : public Encoder {
 
   ChunkMetadata appendData(int8_t*& srcData, const size_t numAppendElems) {
     T* unencodedData = reinterpret_cast<T*>(srcData);
+    updateSketch(unencodedData, numAppendElems);
     for (size_t i = 0; i < numAppendElems; ++i) {
       T data = unencodedData[i];
       if (data == none_encoded_null_value<T>())
@@ -89,7 +90,7 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) {
-    const auto that_typed = static_cast<const NoneEncoder&>(that);
+    const auto& that_typed = static_cast<const NoneEncoder&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
     }
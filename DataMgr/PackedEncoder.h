@@ -0,0 +1,178 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PACKED_ENCODER_H
+#define PACKED_ENCODER_H
+#include "Encoder.h"
+#include "AbstractBuffer.h"
+#include "NoneEncoder.h"
+#include "../Shared/BitPacking.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <glog/logging.h>
+
+/**
+ * Bit-packed encoding, see BitPacking.h for the layout. The smallest value representable on
+ * bitWidth bits stands for null, appends of values out of the range are refused before anything
+ * is written. An append rewrites the last, partially filled byte of the chunk and the padding
+ * which follows it.
+ */
+template <typename T>
+class PackedEncoder : public Encoder {
+ public:
+  PackedEncoder(Data_Namespace::AbstractBuffer* buffer, const int bitWidth)
+      : Encoder(buffer),
+        bitWidth(bitWidth),
+        lastByte(0),
+        dataMin(std::numeric_limits<T>::max()),
+        dataMax(std::numeric_limits<T>::min()),
+        has_nulls(false) {
+    CHECK_GT(bitWidth, 1);
+    CHECK_LE(bitWidth, MAX_PACKED_BIT_WIDTH);
+  }
+
+  ChunkMetadata appendData(int8_t*& srcData, const size_t numAppendElems) {
+    checkAppendData(srcData, numAppendElems);
+    T* unencodedData = reinterpret_cast<T*>(srcData);
+    updateSketch(unencodedData, numAppendElems);
+    const int64_t nullValue = -(int64_t(1) << (bitWidth - 1));
+    auto encodedData = std::vector<int64_t>(numAppendElems);
+    for (size_t i = 0; i < numAppendElems; ++i) {
+      T data = unencodedData[i];
+      if (data == none_encoded_null_value<T>()) {
+        encodedData[i] = nullValue;
+        has_nulls = true;
+        continue;
+      }
+      encodedData[i] = data;
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+
+    if (numAppendElems) {
+      const size_t startBit = numElems * bitWidth;
+      const size_t startByte = startBit / 8;
+      const size_t endByte = packed_byte_size(numElems + numAppendElems, bitWidth);
+      std::vector<int8_t> packed(endByte - startByte + PACKED_PADDING, 0);
+      packed[0] = lastByte;
+      pack_bits(&encodedData[0], numAppendElems, bitWidth, &packed[0], startBit % 8);
+      lastByte = (numElems + numAppendElems) * bitWidth % 8 ? packed[endByte - startByte - 1] : 0;
+      buffer_->write(&packed[0], packed.size(), startByte);
+    }
+    numElems += numAppendElems;
+
+    ChunkMetadata chunkMetadata;
+    getMetadata(chunkMetadata);
+    srcData += numAppendElems * sizeof(T);
+    return chunkMetadata;
+  }
+
+  void checkAppendData(const int8_t* srcData, const size_t numAppendElems) const {
+    const T* unencodedData = reinterpret_cast<const T*>(srcData);
+    const int64_t nullValue = -(int64_t(1) << (bitWidth - 1));
+    for (size_t i = 0; i < numAppendElems; ++i) {
+      const T data = unencodedData[i];
+      if (data == none_encoded_null_value<T>()) {
+        continue;
+      }
+      // the smallest value is the null sentinel
+      if (static_cast<int64_t>(data) <= nullValue || static_cast<int64_t>(data) >= -nullValue) {
+        throw std::runtime_error("Value " + std::to_string(data) + " is out of the range of PACKED(" +
+                                 std::to_string(bitWidth) + ") encoding");
+      }
+    }
+  }
+
+  void getMetadata(ChunkMetadata& chunkMetadata) {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata.fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  ChunkMetadata getMetadata(const SQLTypeInfo& ti) {
+    ChunkMetadata chunk_metadata{ti, 0, 0, ChunkStats{}};
+    chunk_metadata.fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) {
+    const auto& that_typed = static_cast<const PackedEncoder<T>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) {
+    numElems = copyFromEncoder->numElems;
+    auto castedEncoder = reinterpret_cast<const PackedEncoder<T>*>(copyFromEncoder);
+    lastByte = castedEncoder->lastByte;
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&numElems, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+    fwrite((int8_t*)&lastByte, sizeof(int8_t), 1, f);
+  }
+
+  void readMetadata(FILE* f) {
+    // assumes pointer is already in right place
+    fread((int8_t*)&numElems, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(T), f);
+    fread((int8_t*)&dataMax, 1, sizeof(T), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+    fread((int8_t*)&lastByte, 1, sizeof(int8_t), f);
+  }
+  const int bitWidth;
+  int8_t lastByte;
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+};  // PackedEncoder
+
+#endif  // PACKED_ENCODER_H
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RUN_LENGTH_ENCODER_H
+#define RUN_LENGTH_ENCODER_H
+#include "Encoder.h"
+#include "AbstractBuffer.h"
+#include "NoneEncoder.h"
+#include <vector>
+
+/**
+ * Run length encoding. The chunk is a sequence of pairs of S slots: the first pair holds the
+ * number of runs, each following one the end of a run (the position past its last row) and
+ * its value. Appends which start with the value of the last run extend it, so the last run
+ * and the number of runs are rewritten in place.
+ */
+template <typename T, typename S>
+class RunLengthEncoder : public Encoder {
+ public:
+  RunLengthEncoder(Data_Namespace::AbstractBuffer* buffer)
+      : Encoder(buffer),
+        numRuns(0),
+        lastValue(0),
+        dataMin(std::numeric_limits<T>::max()),
+        dataMax(std::numeric_limits<T>::min()),
+        has_nulls(false) {}
+
+  ChunkMetadata appendData(int8_t*& srcData, const size_t numAppendElems) {
+    T* unencodedData = reinterpret_cast<T*>(srcData);
+    updateSketch(unencodedData, numAppendElems);
+    const size_t prevNumRuns = numRuns;
+    // the pairs from the header of an empty chunk or from the last run on
+    std::vector<S> encodedData{static_cast<S>(prevNumRuns ? numElems : 0), static_cast<S>(lastValue)};
+    for (size_t i = 0; i < numAppendElems; ++i) {
+      T data = unencodedData[i];
+      if (data == none_encoded_null_value<T>()) {
+        has_nulls = true;
+      } else {
+        dataMin = std::min(dataMin, data);
+        dataMax = std::max(dataMax, data);
+      }
+      if (numRuns && data == lastValue) {
+        encodedData[encodedData.size() - 2] = numElems + i + 1;
+      } else {
+        encodedData.push_back(numElems + i + 1);
+        encodedData.push_back(data);
+        lastValue = data;
+        ++numRuns;
+      }
+    }
+    numElems += numAppendElems;
+
+    if (numAppendElems) {
+      if (!prevNumRuns) {
+        encodedData[0] = numRuns;
+      }
+      buffer_->write(reinterpret_cast<int8_t*>(&encodedData[0]),
+                     encodedData.size() * sizeof(S),
+                     2 * prevNumRuns * sizeof(S));
+      if (prevNumRuns && numRuns != prevNumRuns) {
+        S numRunsSlot = numRuns;
+        buffer_->write(reinterpret_cast<int8_t*>(&numRunsSlot), sizeof(S), 0);
+      }
+    }
+    ChunkMetadata chunkMetadata;
+    getMetadata(chunkMetadata);
+    srcData += numAppendElems * sizeof(T);
+    return chunkMetadata;
+  }
+
+  void getMetadata(ChunkMetadata& chunkMetadata) {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata.fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  ChunkMetadata getMetadata(const SQLTypeInfo& ti) {
+    ChunkMetadata chunk_metadata{ti, 0, 0, ChunkStats{}};
+    chunk_metadata.fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) {
+    const auto& that_typed = static_cast<const RunLengthEncoder<T, S>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) {
+    numElems = copyFromEncoder->numElems;
+    auto castedEncoder = reinterpret_cast<const RunLengthEncoder<T, S>*>(copyFromEncoder);
+    numRuns = castedEncoder->numRuns;
+    lastValue = castedEncoder->lastValue;
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&numElems, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+    fwrite((int8_t*)&numRuns, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&lastValue, sizeof(T), 1, f);
+  }
+
+  void readMetadata(FILE* f) {
+    // assumes pointer is already in right place
+    fread((int8_t*)&numElems, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(T), f);
+    fread((int8_t*)&dataMax, 1, sizeof(T), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+    fread((int8_t*)&numRuns, 1, sizeof(size_t), f);
+    fread((int8_t*)&lastValue, 1, sizeof(T), f);
+  }
+  size_t numRuns;
+  T lastValue;
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+};  // RunLengthEncoder
+
+#endif  // RUN_LENGTH_ENCODER_H
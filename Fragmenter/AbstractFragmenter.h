@@ -24,6 +24,7 @@
 
 #include "../Shared/sqltypes.h"
 #include "Fragmenter.h"
+#include <functional>
 #include <vector>
 #include <string>
 
@@ -86,6 +87,13 @@ class AbstractFragmenter {
 
   virtual void dropFragmentsToSize(const size_t maxRows) = 0;
 
+  /**
+   * @brief Rewrites the storage of the table contiguously and releases
+   * the space of its free pages, reporting the pages copied and the total
+   */
+
+  virtual void compactStorage(const std::function<void(const size_t, const size_t)>& progress) = 0;
+
   /**
    * @brief Gets the id of the partitioner
    */
@@ -41,7 +41,8 @@ namespace Fragmenter_Namespace {
  */
 
 enum FragmenterType {
-  INSERT_ORDER = 0  // these values persist in catalog.  make explicit
+  INSERT_ORDER = 0,  // these values persist in catalog.  make explicit
+  SORTED_ORDER = 1
 };
 
 /**
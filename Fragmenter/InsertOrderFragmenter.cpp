@@ -170,6 +170,17 @@ void InsertOrderFragmenter::dropFragmentsToSize(const size_t maxRows) {
   }
 }
 
+void InsertOrderFragmenter::compactStorage(const std::function<void(const size_t, const size_t)>& progress) {
+  if (defaultInsertLevel_ != Data_Namespace::DISK_LEVEL) {  // nothing to compact if the data isn't on disk
+    return;
+  }
+  // no insert may run while the pages move, nor query read them
+  mapd_unique_lock<mapd_shared_mutex> tableLevelWriteLock(*dataMgr_->getMutexForChunkPrefix(chunkKeyPrefix_));
+  mapd_unique_lock<mapd_shared_mutex> insertLock(insertMutex_);
+  mapd_unique_lock<mapd_shared_mutex> tableLock(tableMutex_);
+  dataMgr_->compactTable(chunkKeyPrefix_[0], chunkKeyPrefix_[1], progress);
+}
+
 void InsertOrderFragmenter::deleteFragments(const vector<int>& dropFragIds) {
   mapd_unique_lock<mapd_shared_mutex> tableLock(tableMutex_);
   for (const auto fragId : dropFragIds) {
@@ -268,6 +279,13 @@ void InsertOrderFragmenter::insertDataImpl(const InsertData& insertDataStruct) {
 
     CHECK_GT(numRowsToInsert, size_t(0));  // would put us into an endless loop as we'd never be able to insert anything
 
+    // reject the rows the encodings can't represent before any column of the fragment is appended to
+    for (size_t i = 0; i < insertDataStruct.columnIds.size(); ++i) {
+      auto colMapIt = columnMap_.find(insertDataStruct.columnIds[i]);
+      assert(colMapIt != columnMap_.end());
+      colMapIt->second.checkAppendData(dataCopy[i], numRowsToInsert);
+    }
+
     // for each column, append the data in the appropriate insert buffer
     for (size_t i = 0; i < insertDataStruct.columnIds.size(); ++i) {
       int columnId = insertDataStruct.columnIds[i];
@@ -279,6 +297,18 @@ void InsertOrderFragmenter::insertDataImpl(const InsertData& insertDataStruct) {
       if (varLenColInfoIt != varLenColInfo_.end()) {
         varLenColInfoIt->second = colMapIt->second.get_buffer()->size();
       }
+      const auto compression = colMapIt->second.get_column_desc()->columnType.get_compression();
+      if (compression == kENCODING_RL || compression == kENCODING_PACKED) {
+        // run length and bit-packed appends rewrite the tail of the chunk in place, cached copies
+        // only fetch appended bytes. The copies queries still read are only dropped from the buffer
+        // pools and freed once unpinned.
+        ChunkKey chunkKey = chunkKeyPrefix_;
+        chunkKey.push_back(columnId);
+        chunkKey.push_back(currentFragment->fragmentId);
+        for (int level = defaultInsertLevel_ + 1; level <= Data_Namespace::GPU_LEVEL; ++level) {
+          dataMgr_->deleteChunksWithPrefix(chunkKey, static_cast<Data_Namespace::MemoryLevel>(level));
+        }
+      }
     }
     if (hasMaterializedRowId_) {
       size_t startId = maxFragmentRows_ * currentFragment->fragmentId + currentFragment->shadowNumTuples;
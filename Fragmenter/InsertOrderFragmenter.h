@@ -86,6 +86,8 @@ class InsertOrderFragmenter : public AbstractFragmenter {
   virtual void insertDataNoCheckpoint(const InsertData& insertDataStruct);
 
   virtual void dropFragmentsToSize(const size_t maxRows);
+
+  virtual void compactStorage(const std::function<void(const size_t, const size_t)>& progress);
   /**
    * @brief get fragmenter's id
    */
@@ -96,7 +98,7 @@ class InsertOrderFragmenter : public AbstractFragmenter {
    */
   inline std::string getFragmenterType() { return fragmenterType_; }
 
- private:
+ protected:
   std::vector<int> chunkKeyPrefix_;
   std::map<int, Chunk_NS::Chunk> columnMap_; /**< stores a map of column id to metadata about that column */
   std::deque<FragmentInfo> fragmentInfoVec_; /**< data about each fragment stored - id and number of rows */
@@ -134,8 +136,9 @@ class InsertOrderFragmenter : public AbstractFragmenter {
   void getChunkMetadata();
 
   void lockInsertCheckpointData(const InsertData& insertDataStruct);
-  void insertDataImpl(const InsertData& insertDataStruct);
+  virtual void insertDataImpl(const InsertData& insertDataStruct);
 
+ private:
   InsertOrderFragmenter(const InsertOrderFragmenter&);
   InsertOrderFragmenter& operator=(const InsertOrderFragmenter&);
 };
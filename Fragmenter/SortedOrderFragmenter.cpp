@@ -0,0 +1,450 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SortedOrderFragmenter.h"
+#include "../DataMgr/DataMgr.h"
+#include "../DataMgr/AbstractBuffer.h"
+#include "../DataMgr/Encoder.h"
+#include "../Utils/ChunkIter.h"
+#include "../Shared/checked_alloc.h"
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <numeric>
+
+using Data_Namespace::DataMgr;
+using Chunk_NS::Chunk;
+
+namespace Fragmenter_Namespace {
+
+namespace {
+
+// The rows of a column in the layout InsertData points to.
+struct ColumnValues {
+  std::vector<int8_t> numbers;
+  std::vector<std::string> strings;
+  std::vector<ArrayDatum> arrays;
+};
+
+// Dictionary encoded strings and numbers are inserted as ids on the width of the column, the
+// other fixed width types unencoded.
+size_t insert_data_width(const SQLTypeInfo& ti) {
+  return ti.get_compression() == kENCODING_DICT ? ti.get_size() : ti.get_logical_size();
+}
+
+// Dictionary encoded columns, floating point ones included, are sorted on their ids.
+bool is_fp_sort_key(const SQLTypeInfo& ti) {
+  return ti.is_fp() && ti.get_compression() != kENCODING_DICT;
+}
+
+DataBlockPtr to_data_block(const SQLTypeInfo& ti, ColumnValues& values) {
+  DataBlockPtr rows;
+  if (ti.get_type() == kARRAY) {
+    rows.arraysPtr = &values.arrays;
+  } else if (ti.is_varlen()) {
+    rows.stringsPtr = &values.strings;
+  } else {
+    rows.numbersPtr = values.numbers.data();
+  }
+  return rows;
+}
+
+int64_t int_sort_key(const SQLTypeInfo& ti, const int8_t* val) {
+  switch (insert_data_width(ti)) {
+    case 1:
+      return ti.get_compression() == kENCODING_DICT ? *reinterpret_cast<const uint8_t*>(val) : *val;
+    case 2:
+      return ti.get_compression() == kENCODING_DICT ? *reinterpret_cast<const uint16_t*>(val)
+                                                    : *reinterpret_cast<const int16_t*>(val);
+    case 4:
+      return *reinterpret_cast<const int32_t*>(val);
+    case 8:
+      return *reinterpret_cast<const int64_t*>(val);
+    default:
+      CHECK(false);
+  }
+  return 0;
+}
+
+double fp_sort_key(const SQLTypeInfo& ti, const int8_t* val) {
+  return ti.get_type() == kFLOAT ? *reinterpret_cast<const float*>(val) : *reinterpret_cast<const double*>(val);
+}
+
+template <typename T>
+std::vector<size_t> stable_order(const std::vector<T>& keys) {
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+      order.begin(), order.end(), [&keys](const size_t lhs, const size_t rhs) { return keys[lhs] < keys[rhs]; });
+  return order;
+}
+
+// Positions of the rows in ascending order of the sort column, equal keys keep their order.
+std::vector<size_t> sorted_order(const SQLTypeInfo& ti, const int8_t* vals, const size_t numRows) {
+  const size_t width = insert_data_width(ti);
+  if (is_fp_sort_key(ti)) {
+    std::vector<double> keys(numRows);
+    for (size_t i = 0; i < numRows; ++i) {
+      keys[i] = fp_sort_key(ti, vals + i * width);
+    }
+    return stable_order(keys);
+  }
+  std::vector<int64_t> keys(numRows);
+  for (size_t i = 0; i < numRows; ++i) {
+    keys[i] = int_sort_key(ti, vals + i * width);
+  }
+  return stable_order(keys);
+}
+
+bool is_identity(const std::vector<size_t>& order) {
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (order[i] != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+DataBlockPtr permute_rows(const SQLTypeInfo& ti,
+                          const DataBlockPtr rows,
+                          const std::vector<size_t>& order,
+                          ColumnValues& permuted) {
+  if (ti.get_type() == kARRAY) {
+    permuted.arrays.reserve(order.size());
+    for (const auto idx : order) {
+      permuted.arrays.push_back((*rows.arraysPtr)[idx]);
+    }
+  } else if (ti.is_varlen()) {
+    permuted.strings.reserve(order.size());
+    for (const auto idx : order) {
+      permuted.strings.push_back((*rows.stringsPtr)[idx]);
+    }
+  } else {
+    const size_t width = insert_data_width(ti);
+    permuted.numbers.resize(order.size() * width);
+    for (size_t i = 0; i < order.size(); ++i) {
+      memcpy(&permuted.numbers[i * width], rows.numbersPtr + order[i] * width, width);
+    }
+  }
+  return to_data_block(ti, permuted);
+}
+
+// Appends the rows of a chunk to values, decoding fixed width, run length, differential
+// and bit-packed encodings.
+void read_fragment_column(DataMgr* dataMgr,
+                          const ColumnDescriptor* cd,
+                          const ChunkKey& chunkKey,
+                          const FragmentInfo& fragment,
+                          ColumnValues& values) {
+  const auto& chunkMetadata = fragment.getChunkMetadataMapPhysical().at(cd->columnId);
+  const auto chunk = Chunk::getChunk(cd,
+                                     dataMgr,
+                                     chunkKey,
+                                     Data_Namespace::CPU_LEVEL,
+                                     fragment.deviceIds[static_cast<int>(Data_Namespace::CPU_LEVEL)],
+                                     chunkMetadata.numBytes,
+                                     chunkMetadata.numElements);
+  auto it = chunk->begin_iterator(chunkMetadata);
+  const auto& ti = cd->columnType;
+  const bool uncompress = ti.get_compression() == kENCODING_FIXED;
+  const size_t width = insert_data_width(ti);
+  for (size_t i = 0; i < chunkMetadata.numElements; ++i) {
+    bool is_end;
+    if (ti.get_type() == kARRAY) {
+      ArrayDatum ad;
+      ChunkIter_get_nth(&it, i, &ad, &is_end);
+      // the chunk is unpinned before the rows are written back, copy the elements
+      int8_t* elems = nullptr;
+      if (!ad.is_null) {
+        elems = static_cast<int8_t*>(checked_malloc(ad.length));
+        memcpy(elems, ad.pointer, ad.length);
+      }
+      values.arrays.emplace_back(ad.length, elems, ad.is_null);
+    } else {
+      VarlenDatum vd;
+      ChunkIter_get_nth(&it, i, uncompress, &vd, &is_end);
+      if (ti.is_varlen()) {
+        values.strings.emplace_back(vd.is_null ? std::string() : std::string(reinterpret_cast<char*>(vd.pointer),
+                                                                             vd.length));
+      } else {
+        CHECK_EQ(width, static_cast<size_t>(vd.length));
+        values.numbers.insert(values.numbers.end(), vd.pointer, vd.pointer + width);
+      }
+    }
+    CHECK(!is_end);
+  }
+}
+
+int64_t int_stat(const SQLTypeInfo& ti, const Datum& stat) {
+  if (ti.get_compression() == kENCODING_DICT) {
+    return stat.intval;  // the stats are those of the ids
+  }
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+      return stat.tinyintval;
+    case kSMALLINT:
+      return stat.smallintval;
+    case kINT:
+      return stat.intval;
+    case kBIGINT:
+    case kNUMERIC:
+    case kDECIMAL:
+      return stat.bigintval;
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      return stat.timeval;
+    default:
+      CHECK(false);
+  }
+  return 0;
+}
+
+double fp_stat(const SQLTypeInfo& ti, const Datum& stat) {
+  return ti.get_type() == kFLOAT ? stat.floatval : stat.doubleval;
+}
+
+template <typename T>
+bool ranges_overlap(const T lowerMin, const T lowerMax, const T upperMin, const T upperMax) {
+  // the range of a fragment of nulls is empty, min above max
+  return lowerMin <= lowerMax && upperMin <= upperMax && lowerMax > upperMin;
+}
+
+}  // namespace
+
+SortedOrderFragmenter::SortedOrderFragmenter(const std::vector<int> chunkKeyPrefix,
+                                             std::vector<Chunk>& chunkVec,
+                                             Data_Namespace::DataMgr* dataMgr,
+                                             const int physicalTableId,
+                                             const int shard,
+                                             const int sortedColumnId,
+                                             const size_t maxFragmentRows,
+                                             const size_t maxChunkSize,
+                                             const size_t pageSize,
+                                             const size_t maxRows,
+                                             const Data_Namespace::MemoryLevel defaultInsertLevel)
+    : InsertOrderFragmenter(chunkKeyPrefix,
+                            chunkVec,
+                            dataMgr,
+                            physicalTableId,
+                            shard,
+                            maxFragmentRows,
+                            maxChunkSize,
+                            pageSize,
+                            maxRows,
+                            defaultInsertLevel),
+      sortedColumnId_(sortedColumnId),
+      lastClusteredFragmentId_(-1) {
+  fragmenterType_ = "sorted_order";
+  CHECK(columnMap_.count(sortedColumnId_));
+  CHECK(!columnMap_[sortedColumnId_].get_column_desc()->columnType.is_varlen());
+  // full fragments were clustered in the epoch which filled them, overlaps left behind by
+  // a busy table are merged by the next recluster
+  if (fragmentInfoVec_.size() > 1) {
+    lastClusteredFragmentId_ = fragmentInfoVec_[fragmentInfoVec_.size() - 2].fragmentId;
+  }
+}
+
+void SortedOrderFragmenter::insertDataImpl(const InsertData& insertDataStruct) {
+  const auto sortColumnIt =
+      std::find(insertDataStruct.columnIds.begin(), insertDataStruct.columnIds.end(), sortedColumnId_);
+  std::vector<size_t> order;
+  if (sortColumnIt != insertDataStruct.columnIds.end()) {
+    const auto& sortTi = columnMap_[sortedColumnId_].get_column_desc()->columnType;
+    order = sorted_order(sortTi,
+                         insertDataStruct.data[sortColumnIt - insertDataStruct.columnIds.begin()].numbersPtr,
+                         insertDataStruct.numRows);
+  }
+  if (is_identity(order)) {
+    InsertOrderFragmenter::insertDataImpl(insertDataStruct);
+  } else {
+    InsertData sortedInsertData = insertDataStruct;
+    std::vector<ColumnValues> sortedValues(insertDataStruct.columnIds.size());
+    for (size_t i = 0; i < insertDataStruct.columnIds.size(); ++i) {
+      const auto& ti = columnMap_[insertDataStruct.columnIds[i]].get_column_desc()->columnType;
+      sortedInsertData.data[i] = permute_rows(ti, insertDataStruct.data[i], order, sortedValues[i]);
+    }
+    InsertOrderFragmenter::insertDataImpl(sortedInsertData);
+  }
+  mapd_unique_lock<mapd_shared_mutex> insertLock(insertMutex_);
+  recluster();
+}
+
+void SortedOrderFragmenter::recluster() {
+  // the last fragment is still being filled
+  if (fragmentInfoVec_.size() < 2 ||
+      fragmentInfoVec_[fragmentInfoVec_.size() - 2].fragmentId <= lastClusteredFragmentId_) {
+    return;
+  }
+  // Queries take the table lock before they copy the fragment list and hold it until they
+  // are done with the chunks, which are rewritten with the fragment metadata under it alone.
+  if (!tableMutex_.try_lock()) {
+    return;
+  }
+  try {
+    const size_t numFullFragments = fragmentInfoVec_.size() - 1;
+    for (size_t i = 0; i < numFullFragments; ++i) {
+      if (fragmentInfoVec_[i].fragmentId > lastClusteredFragmentId_) {
+        sortFragments(i, 1);
+      }
+    }
+    // Merge-split of adjacent overlapping fragments from the end, one pass moves the rows of a
+    // new fragment to their place when the fragments have the same number of rows.
+    for (size_t pass = 0; pass < numFullFragments; ++pass) {
+      bool merged = false;
+      for (size_t i = numFullFragments - 1; i > 0; --i) {
+        if (fragmentsOverlap(fragmentInfoVec_[i - 1], fragmentInfoVec_[i]) && sortFragments(i - 1, 2)) {
+          merged = true;
+        }
+      }
+      if (!merged) {
+        break;
+      }
+    }
+    lastClusteredFragmentId_ = fragmentInfoVec_[numFullFragments - 1].fragmentId;
+  } catch (...) {
+    tableMutex_.unlock();
+    throw;
+  }
+  tableMutex_.unlock();
+}
+
+bool SortedOrderFragmenter::fragmentsOverlap(const FragmentInfo& lower, const FragmentInfo& upper) const {
+  const auto& ti = columnMap_.at(sortedColumnId_).get_column_desc()->columnType;
+  const auto& lowerStats = lower.getChunkMetadataMapPhysical().at(sortedColumnId_).chunkStats;
+  const auto& upperStats = upper.getChunkMetadataMapPhysical().at(sortedColumnId_).chunkStats;
+  if (is_fp_sort_key(ti)) {
+    return ranges_overlap(fp_stat(ti, lowerStats.min),
+                          fp_stat(ti, lowerStats.max),
+                          fp_stat(ti, upperStats.min),
+                          fp_stat(ti, upperStats.max));
+  }
+  return ranges_overlap(int_stat(ti, lowerStats.min),
+                        int_stat(ti, lowerStats.max),
+                        int_stat(ti, upperStats.min),
+                        int_stat(ti, upperStats.max));
+}
+
+bool SortedOrderFragmenter::sortFragments(const size_t firstFragmentIdx, const size_t numFragments) {
+  CHECK_LE(firstFragmentIdx + numFragments, fragmentInfoVec_.size());
+  auto chunkKey = [this](const int columnId, const FragmentInfo& fragment) {
+    ChunkKey key = chunkKeyPrefix_;
+    key.push_back(columnId);
+    key.push_back(fragment.fragmentId);
+    return key;
+  };
+  // moving rows between fragments must not overflow the variable length chunks
+  if (numFragments > 1) {
+    for (const auto& varLenColInfo : varLenColInfo_) {
+      size_t numBytes = 0;
+      for (size_t i = firstFragmentIdx; i < firstFragmentIdx + numFragments; ++i) {
+        numBytes += fragmentInfoVec_[i].getChunkMetadataMapPhysical().at(varLenColInfo.first).numBytes;
+      }
+      if (numBytes > maxChunkSize_) {
+        return false;
+      }
+    }
+  }
+
+  const auto sortCd = columnMap_[sortedColumnId_].get_column_desc();
+  ColumnValues keys;
+  size_t numRows = 0;
+  for (size_t i = firstFragmentIdx; i < firstFragmentIdx + numFragments; ++i) {
+    const auto& fragment = fragmentInfoVec_[i];
+    read_fragment_column(dataMgr_, sortCd, chunkKey(sortedColumnId_, fragment), fragment, keys);
+    numRows += fragment.getPhysicalNumTuples();
+  }
+  const auto order = sorted_order(sortCd->columnType, keys.numbers.data(), numRows);
+  if (is_identity(order)) {
+    return false;
+  }
+
+  // Every column is sorted and checked against a fresh encoder of each fragment before the first
+  // chunk is rewritten, rows which can't be encoded after the move, like DIFF values too far from
+  // the new baseline of their fragment, leave all the columns of the fragments as they were.
+  std::map<int, ColumnValues> sortedColumns;
+  for (auto& col : columnMap_) {
+    if (hasMaterializedRowId_ && col.first == rowIdColId_) {
+      continue;  // row ids are positions in the table, they stay
+    }
+    const auto cd = col.second.get_column_desc();
+    const auto& ti = cd->columnType;
+    ColumnValues values;
+    if (col.first == sortedColumnId_) {
+      values = std::move(keys);
+    } else {
+      for (size_t i = firstFragmentIdx; i < firstFragmentIdx + numFragments; ++i) {
+        read_fragment_column(dataMgr_, cd, chunkKey(col.first, fragmentInfoVec_[i]), fragmentInfoVec_[i], values);
+      }
+    }
+    auto& sortedValues = sortedColumns[col.first];
+    permute_rows(ti, to_data_block(ti, values), order, sortedValues);
+    std::unique_ptr<Encoder> encoder(Encoder::Create(nullptr, ti));
+    if (ti.is_varlen() || !encoder) {
+      continue;
+    }
+    size_t startRow = 0;
+    for (size_t i = firstFragmentIdx; i < firstFragmentIdx + numFragments; ++i) {
+      const auto numFragmentRows = fragmentInfoVec_[i].getPhysicalNumTuples();
+      try {
+        encoder->checkAppendData(&sortedValues.numbers[startRow * insert_data_width(ti)], numFragmentRows);
+      } catch (const std::runtime_error& e) {
+        LOG(INFO) << "Fragments of table " << physicalTableId_ << " left unsorted: " << e.what();
+        return false;
+      }
+      startRow += numFragmentRows;
+    }
+  }
+
+  for (auto& sortedColumn : sortedColumns) {
+    const auto cd = columnMap_[sortedColumn.first].get_column_desc();
+    const auto& ti = cd->columnType;
+    auto& sortedValues = sortedColumn.second;
+    size_t startRow = 0;
+    for (size_t i = firstFragmentIdx; i < firstFragmentIdx + numFragments; ++i) {
+      auto& fragment = fragmentInfoVec_[i];
+      const auto key = chunkKey(sortedColumn.first, fragment);
+      Chunk chunk(cd);
+      chunk.getChunkBuffer(
+          dataMgr_, key, defaultInsertLevel_, fragment.deviceIds[static_cast<int>(defaultInsertLevel_)]);
+      // rewritten from the start, the file buffer keeps the checkpointed version of the pages
+      chunk.get_buffer()->setSize(0);
+      if (chunk.get_index_buf()) {
+        chunk.get_index_buf()->setSize(0);
+      }
+      chunk.init_encoder();
+      auto rows = to_data_block(ti, sortedValues);
+      if (!ti.is_varlen()) {
+        rows.numbersPtr += startRow * insert_data_width(ti);
+      }
+      const auto numFragmentRows = fragment.getPhysicalNumTuples();
+      const auto chunkMetadata = chunk.appendData(rows, numFragmentRows, startRow);
+      fragment.shadowChunkMetadataMap[sortedColumn.first] = chunkMetadata;
+      fragment.setChunkMetadata(sortedColumn.first, chunkMetadata);
+      for (int level = defaultInsertLevel_ + 1; level <= Data_Namespace::GPU_LEVEL; ++level) {
+        dataMgr_->deleteChunksWithPrefix(key, static_cast<Data_Namespace::MemoryLevel>(level));
+      }
+      startRow += numFragmentRows;
+    }
+    sortedValues = ColumnValues();
+  }
+  return true;
+}
+
+}  // Fragmenter_Namespace
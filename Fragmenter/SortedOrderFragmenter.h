@@ -0,0 +1,85 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    SortedOrderFragmenter.h
+ * @brief   Fragmenter which clusters the rows of a table on a sort column.
+ */
+#ifndef SORTED_ORDER_FRAGMENTER_H
+#define SORTED_ORDER_FRAGMENTER_H
+
+#include "InsertOrderFragmenter.h"
+
+namespace Fragmenter_Namespace {
+
+/**
+ * @type SortedOrderFragmenter
+ * @brief Sorts the rows of every insert on the sort column before appending them
+ * like the InsertOrderFragmenter does. Once a fragment is full, it is sorted and
+ * merged with the full fragments whose range of the sort column it overlaps, until
+ * the full fragments cover disjoint ranges in ascending order. The min / max
+ * statistics of the sort column then let range filters on it skip most fragments.
+ */
+
+class SortedOrderFragmenter : public InsertOrderFragmenter {
+ public:
+  SortedOrderFragmenter(const std::vector<int> chunkKeyPrefix,
+                        std::vector<Chunk_NS::Chunk>& chunkVec,
+                        Data_Namespace::DataMgr* dataMgr,
+                        const int physicalTableId,
+                        const int shard,
+                        const int sortedColumnId,
+                        const size_t maxFragmentRows = DEFAULT_FRAGMENT_ROWS,
+                        const size_t maxChunkSize = DEFAULT_MAX_CHUNK_SIZE,
+                        const size_t pageSize = DEFAULT_PAGE_SIZE,
+                        const size_t maxRows = DEFAULT_MAX_ROWS,
+                        const Data_Namespace::MemoryLevel defaultInsertLevel = Data_Namespace::DISK_LEVEL);
+
+  /**
+   * @brief sorts the full fragments filled since the last call and merges the
+   * overlapping ones, rewriting their chunks in the current epoch
+   *
+   * Gives up without waiting if a query is reading the table, the next insert
+   * retries. Called with the insert lock held, doesn't checkpoint.
+   */
+  void recluster();
+
+  inline int getSortedColumnId() const { return sortedColumnId_; }
+
+ protected:
+  virtual void insertDataImpl(const InsertData& insertDataStruct);
+
+ private:
+  const int sortedColumnId_;
+  int lastClusteredFragmentId_;  // full fragments up to this one are sorted and disjoint
+
+  bool fragmentsOverlap(const FragmentInfo& lower, const FragmentInfo& upper) const;
+
+  /**
+   * @brief sorts the rows of the given fragments, adjacent in the fragment list, and
+   * redistributes them in order keeping the number of rows of each fragment
+   *
+   * Returns false, without writing anything, if the rows are already in order.
+   */
+  bool sortFragments(const size_t firstFragmentIdx, const size_t numFragments);
+
+  SortedOrderFragmenter(const SortedOrderFragmenter&);
+  SortedOrderFragmenter& operator=(const SortedOrderFragmenter&);
+};
+
+}  // Fragmenter_Namespace
+
+#endif  // SORTED_ORDER_FRAGMENTER_H
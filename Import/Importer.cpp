@@ -315,21 +315,27 @@ void addBinaryStringArray(const TDatum& datum, std::vector<std::string>& string_
   }
 }
 
+// Dictionary encoded numbers are buffered as values and encoded when loaded, like strings.
+static int64_t import_buffer_null_val(const SQLTypeInfo& ti) {
+  return ti.is_dict_encoded_number() ? inline_int_null_val(SQLTypeInfo(ti.get_type(), false))
+                                     : inline_fixed_encoding_null_val(ti);
+}
+
 Datum TDatumToDatum(const TDatum& datum, SQLTypeInfo& ti) {
   Datum d;
   const auto type = ti.is_decimal() ? decimal_to_int_type(ti) : ti.get_type();
   switch (type) {
     case kBOOLEAN:
-      d.boolval = datum.is_null ? inline_fixed_encoding_null_val(ti) : datum.val.int_val;
+      d.boolval = datum.is_null ? import_buffer_null_val(ti) : datum.val.int_val;
       break;
     case kBIGINT:
-      d.bigintval = datum.is_null ? inline_fixed_encoding_null_val(ti) : datum.val.int_val;
+      d.bigintval = datum.is_null ? import_buffer_null_val(ti) : datum.val.int_val;
       break;
     case kINT:
-      d.intval = datum.is_null ? inline_fixed_encoding_null_val(ti) : datum.val.int_val;
+      d.intval = datum.is_null ? import_buffer_null_val(ti) : datum.val.int_val;
       break;
     case kSMALLINT:
-      d.smallintval = datum.is_null ? inline_fixed_encoding_null_val(ti) : datum.val.int_val;
+      d.smallintval = datum.is_null ? import_buffer_null_val(ti) : datum.val.int_val;
       break;
     case kFLOAT:
       d.floatval = datum.is_null ? NULL_FLOAT : datum.val.real_val;
@@ -340,7 +346,7 @@ Datum TDatumToDatum(const TDatum& datum, SQLTypeInfo& ti) {
     case kTIME:
     case kTIMESTAMP:
     case kDATE:
-      d.timeval = datum.is_null ? inline_fixed_encoding_null_val(ti) : datum.val.int_val;
+      d.timeval = datum.is_null ? import_buffer_null_val(ti) : datum.val.int_val;
       break;
     default:
       throw std::runtime_error("Internal error: invalid type in StringToDatum.");
@@ -382,7 +388,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       if (is_null) {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addBoolean(inline_fixed_encoding_null_val(cd->columnType));
+        addBoolean(import_buffer_null_val(cd->columnType));
       } else {
         SQLTypeInfo ti = cd->columnType;
         Datum d = StringToDatum(val, ti);
@@ -398,7 +404,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       } else {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addSmallint(inline_fixed_encoding_null_val(cd->columnType));
+        addSmallint(import_buffer_null_val(cd->columnType));
       }
       break;
     }
@@ -410,7 +416,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       } else {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addInt(inline_fixed_encoding_null_val(cd->columnType));
+        addInt(import_buffer_null_val(cd->columnType));
       }
       break;
     }
@@ -422,7 +428,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       } else {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addBigint(inline_fixed_encoding_null_val(cd->columnType));
+        addBigint(import_buffer_null_val(cd->columnType));
       }
       break;
     }
@@ -436,7 +442,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       } else {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addBigint(inline_fixed_encoding_null_val(cd->columnType));
+        addBigint(import_buffer_null_val(cd->columnType));
       }
       break;
     }
@@ -485,7 +491,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd,
       } else {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addTime(inline_fixed_encoding_null_val(cd->columnType));
+        addTime(import_buffer_null_val(cd->columnType));
       }
       break;
     case kARRAY:
@@ -585,7 +591,7 @@ inline void append_arrow_primitive(const Array& values, const T null_sentinel, s
 
 void append_arrow_boolean(const ColumnDescriptor* cd, const Array& values, std::vector<int8_t>* buffer) {
   ARROW_THROW_IF(values.type_id() != Type::BOOL, "Expected boolean col");
-  const int8_t null_sentinel = inline_fixed_encoding_null_val(cd->columnType);
+  const int8_t null_sentinel = import_buffer_null_val(cd->columnType);
   const auto& typed_values = static_cast<const BooleanArray&>(values);
   buffer->reserve(typed_values.length());
   for (int64_t i = 0; i < typed_values.length(); i++) {
@@ -600,7 +606,7 @@ void append_arrow_boolean(const ColumnDescriptor* cd, const Array& values, std::
 template <typename ArrowType, typename T>
 void append_arrow_integer(const ColumnDescriptor* cd, const Array& values, std::vector<T>* buffer) {
   using ArrayType = typename TypeTraits<ArrowType>::ArrayType;
-  const T null_sentinel = inline_fixed_encoding_null_val(cd->columnType);
+  const T null_sentinel = import_buffer_null_val(cd->columnType);
   append_arrow_primitive<ArrayType, T>(values, null_sentinel, buffer);
 }
 
@@ -620,7 +626,7 @@ constexpr int64_t kNanosecondsinSecond = 1000L * 1000L * 1000L;
 constexpr int32_t kSecondsInDay = 86400;
 
 void append_arrow_time(const ColumnDescriptor* cd, const Array& values, std::vector<time_t>* buffer) {
-  const time_t null_sentinel = inline_fixed_encoding_null_val(cd->columnType);
+  const time_t null_sentinel = import_buffer_null_val(cd->columnType);
   if (values.type_id() == Type::TIME32) {
     const auto& typed_values = static_cast<const Time32Array&>(values);
     const auto& type = static_cast<const Time32Type&>(*values.type());
@@ -681,7 +687,7 @@ void append_arrow_time(const ColumnDescriptor* cd, const Array& values, std::vec
 void append_arrow_timestamp(const ColumnDescriptor* cd, const Array& values, std::vector<time_t>* buffer) {
   ARROW_THROW_IF(values.type_id() != Type::TIMESTAMP, "Expected timestamp col");
 
-  const time_t null_sentinel = inline_fixed_encoding_null_val(cd->columnType);
+  const time_t null_sentinel = import_buffer_null_val(cd->columnType);
   const auto& typed_values = static_cast<const TimestampArray&>(values);
   const auto& type = static_cast<const TimestampType&>(*values.type());
 
@@ -714,7 +720,7 @@ void append_arrow_timestamp(const ColumnDescriptor* cd, const Array& values, std
 }
 
 void append_arrow_date(const ColumnDescriptor* cd, const Array& values, std::vector<time_t>* buffer) {
-  const time_t null_sentinel = inline_fixed_encoding_null_val(cd->columnType);
+  const time_t null_sentinel = import_buffer_null_val(cd->columnType);
   if (values.type_id() == Type::DATE32) {
     const auto& typed_values = static_cast<const Date32Array&>(values);
 
@@ -836,7 +842,7 @@ size_t TypedImportBuffer::add_values(const ColumnDescriptor* cd, const TColumn&
       bool_buffer_->reserve(dataSize);
       for (size_t i = 0; i < dataSize; i++) {
         if (col.nulls[i])
-          bool_buffer_->push_back(inline_fixed_encoding_null_val(cd->columnType));
+          bool_buffer_->push_back(import_buffer_null_val(cd->columnType));
         else
           bool_buffer_->push_back((int8_t)col.data.int_col[i]);
       }
@@ -847,7 +853,7 @@ size_t TypedImportBuffer::add_values(const ColumnDescriptor* cd, const TColumn&
       smallint_buffer_->reserve(dataSize);
       for (size_t i = 0; i < dataSize; i++) {
         if (col.nulls[i])
-          smallint_buffer_->push_back(inline_fixed_encoding_null_val(cd->columnType));
+          smallint_buffer_->push_back(import_buffer_null_val(cd->columnType));
         else
           smallint_buffer_->push_back((int16_t)col.data.int_col[i]);
       }
@@ -858,7 +864,7 @@ size_t TypedImportBuffer::add_values(const ColumnDescriptor* cd, const TColumn&
       int_buffer_->reserve(dataSize);
       for (size_t i = 0; i < dataSize; i++) {
         if (col.nulls[i])
-          int_buffer_->push_back(inline_fixed_encoding_null_val(cd->columnType));
+          int_buffer_->push_back(import_buffer_null_val(cd->columnType));
         else
           int_buffer_->push_back((int32_t)col.data.int_col[i]);
       }
@@ -869,7 +875,7 @@ size_t TypedImportBuffer::add_values(const ColumnDescriptor* cd, const TColumn&
       bigint_buffer_->reserve(dataSize);
       for (size_t i = 0; i < dataSize; i++) {
         if (col.nulls[i])
-          bigint_buffer_->push_back(inline_fixed_encoding_null_val(cd->columnType));
+          bigint_buffer_->push_back(import_buffer_null_val(cd->columnType));
         else
           bigint_buffer_->push_back((int64_t)col.data.int_col[i]);
       }
@@ -918,7 +924,7 @@ size_t TypedImportBuffer::add_values(const ColumnDescriptor* cd, const TColumn&
       time_buffer_->reserve(dataSize);
       for (size_t i = 0; i < dataSize; i++) {
         if (col.nulls[i])
-          time_buffer_->push_back(inline_fixed_encoding_null_val(cd->columnType));
+          time_buffer_->push_back(import_buffer_null_val(cd->columnType));
         else
           time_buffer_->push_back((time_t)col.data.int_col[i]);
       }
@@ -1088,7 +1094,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd, const TDatum& datu
       if (is_null) {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addBoolean(inline_fixed_encoding_null_val(cd->columnType));
+        addBoolean(import_buffer_null_val(cd->columnType));
       } else {
         addBoolean((int8_t)datum.val.int_val);
       }
@@ -1100,7 +1106,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd, const TDatum& datu
       } else {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addSmallint(inline_fixed_encoding_null_val(cd->columnType));
+        addSmallint(import_buffer_null_val(cd->columnType));
       }
       break;
     case kINT:
@@ -1109,7 +1115,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd, const TDatum& datu
       } else {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addInt(inline_fixed_encoding_null_val(cd->columnType));
+        addInt(import_buffer_null_val(cd->columnType));
       }
       break;
     case kBIGINT:
@@ -1118,7 +1124,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd, const TDatum& datu
       } else {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addBigint(inline_fixed_encoding_null_val(cd->columnType));
+        addBigint(import_buffer_null_val(cd->columnType));
       }
       break;
     case kFLOAT:
@@ -1159,7 +1165,7 @@ void TypedImportBuffer::add_value(const ColumnDescriptor* cd, const TDatum& datu
       } else {
         if (cd->columnType.get_notnull())
           throw std::runtime_error("NULL for column " + cd->columnName);
-        addTime(inline_fixed_encoding_null_val(cd->columnType));
+        addTime(import_buffer_null_val(cd->columnType));
       }
       break;
     case kARRAY:
@@ -1313,7 +1319,7 @@ int64_t int_value_at(const TypedImportBuffer& import_buffer, const size_t index)
     values_buffer = import_buffer.getAsBytes();
   }
   CHECK(values_buffer);
-  switch (ti.get_logical_size()) {
+  switch (ti.is_dict_encoded_number() ? import_buffer.getElementSize() : ti.get_logical_size()) {
     case 1: {
       return values_buffer[index];
     }
@@ -1471,8 +1477,11 @@ bool Loader::loadToShard(const std::vector<std::unique_ptr<TypedImportBuffer>>&
   bool success = true;
   for (const auto& import_buff : import_buffers) {
     DataBlockPtr p;
-    if (import_buff->getTypeInfo().is_number() || import_buff->getTypeInfo().is_time() ||
-        import_buff->getTypeInfo().get_type() == kBOOLEAN) {
+    if (import_buff->getTypeInfo().is_dict_encoded_number()) {
+      import_buff->addDictEncodedNumbers();
+      p.numbersPtr = import_buff->getStringDictBuffer();
+    } else if (import_buff->getTypeInfo().is_number() || import_buff->getTypeInfo().is_time() ||
+               import_buff->getTypeInfo().get_type() == kBOOLEAN) {
       p.numbersPtr = import_buff->getAsBytes();
     } else if (import_buff->getTypeInfo().is_string()) {
       auto string_payload_ptr = import_buff->getStringBuffer();
@@ -1514,7 +1523,7 @@ void Loader::init() {
   for (auto cd : column_descs) {
     insert_data.columnIds.push_back(cd->columnId);
     if (cd->columnType.get_compression() == kENCODING_DICT) {
-      CHECK(cd->columnType.is_string() || cd->columnType.is_string_array());
+      CHECK(cd->columnType.is_string() || cd->columnType.is_string_array() || cd->columnType.is_dict_encoded_number());
       const auto dd = catalog.getMetadataForDict(cd->columnType.get_comp_param());
       CHECK(dd);
       dict_map[cd->columnId] = dd->stringDict.get();
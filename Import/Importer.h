@@ -42,6 +42,7 @@
 #include "../Catalog/Catalog.h"
 #include "../Fragmenter/Fragmenter.h"
 #include "../Shared/checked_alloc.h"
+#include "../StringDictionary/NumericDictionary.h"
 #include "../StringDictionary/StringDictionary.h"
 
 class TDatum;
@@ -119,19 +120,7 @@ class TypedImportBuffer : boost::noncopyable {
       case kCHAR:
         string_buffer_ = new std::vector<std::string>();
         if (col_desc->columnType.get_compression() == kENCODING_DICT) {
-          switch (col_desc->columnType.get_size()) {
-            case 1:
-              string_dict_i8_buffer_ = new std::vector<uint8_t>();
-              break;
-            case 2:
-              string_dict_i16_buffer_ = new std::vector<uint16_t>();
-              break;
-            case 4:
-              string_dict_i32_buffer_ = new std::vector<int32_t>();
-              break;
-            default:
-              CHECK(false);
-          }
+          newStringDictBuffer();
         }
         break;
       case kTIME:
@@ -150,6 +139,9 @@ class TypedImportBuffer : boost::noncopyable {
       default:
         CHECK(false);
     }
+    if (col_desc->columnType.is_dict_encoded_number()) {
+      newStringDictBuffer();
+    }
   }
 
   ~TypedImportBuffer() {
@@ -179,17 +171,7 @@ class TypedImportBuffer : boost::noncopyable {
       case kCHAR:
         delete string_buffer_;
         if (column_desc_->columnType.get_compression() == kENCODING_DICT) {
-          switch (column_desc_->columnType.get_size()) {
-            case 1:
-              delete string_dict_i8_buffer_;
-              break;
-            case 2:
-              delete string_dict_i16_buffer_;
-              break;
-            case 4:
-              delete string_dict_i32_buffer_;
-              break;
-          }
+          deleteStringDictBuffer();
         }
         break;
       case kTIME:
@@ -207,6 +189,9 @@ class TypedImportBuffer : boost::noncopyable {
       default:
         CHECK(false);
     }
+    if (column_desc_->columnType.is_dict_encoded_number()) {
+      deleteStringDictBuffer();
+    }
   }
 
   void addBoolean(const int8_t v) { bool_buffer_->push_back(v); }
@@ -259,6 +244,36 @@ class TypedImportBuffer : boost::noncopyable {
     }
   }
 
+  // Encodes the buffered values of a dictionary encoded number column into the dictionary buffer.
+  void addDictEncodedNumbers() {
+    const auto& ti = column_desc_->columnType;
+    CHECK(ti.is_dict_encoded_number());
+    std::vector<std::string> keys;
+    switch (ti.get_type()) {
+      case kINT:
+        keys.reserve(int_buffer_->size());
+        for (const auto v : *int_buffer_) {
+          keys.push_back(v == NULL_INT ? std::string() : numeric_dict_key(v));
+        }
+        break;
+      case kBIGINT:
+        keys.reserve(bigint_buffer_->size());
+        for (const auto v : *bigint_buffer_) {
+          keys.push_back(v == NULL_BIGINT ? std::string() : numeric_dict_key(v));
+        }
+        break;
+      case kDOUBLE:
+        keys.reserve(double_buffer_->size());
+        for (const auto v : *double_buffer_) {
+          keys.push_back(v == NULL_DOUBLE ? std::string() : numeric_dict_key(numeric_dict_bits(v)));
+        }
+        break;
+      default:
+        CHECK(false);
+    }
+    addDictEncodedString(keys);
+  }
+
   void addDictEncodedStringArray(const std::vector<std::vector<std::string>>& string_array_vec) {
     CHECK(string_dict_);
     for (auto& p : string_array_vec) {
@@ -390,19 +405,7 @@ class TypedImportBuffer : boost::noncopyable {
       case kCHAR: {
         string_buffer_->clear();
         if (column_desc_->columnType.get_compression() == kENCODING_DICT) {
-          switch (column_desc_->columnType.get_size()) {
-            case 1:
-              string_dict_i8_buffer_->clear();
-              break;
-            case 2:
-              string_dict_i16_buffer_->clear();
-              break;
-            case 4:
-              string_dict_i32_buffer_->clear();
-              break;
-            default:
-              CHECK(false);
-          }
+          clearStringDictBuffer();
         }
         break;
       }
@@ -423,6 +426,9 @@ class TypedImportBuffer : boost::noncopyable {
       default:
         CHECK(false);
     }
+    if (column_desc_->columnType.is_dict_encoded_number()) {
+      clearStringDictBuffer();
+    }
   }
 
   size_t add_values(const ColumnDescriptor* cd, const TColumn& data);
@@ -434,6 +440,52 @@ class TypedImportBuffer : boost::noncopyable {
   void pop_value();
 
  private:
+  void newStringDictBuffer() {
+    switch (column_desc_->columnType.get_size()) {
+      case 1:
+        string_dict_i8_buffer_ = new std::vector<uint8_t>();
+        break;
+      case 2:
+        string_dict_i16_buffer_ = new std::vector<uint16_t>();
+        break;
+      case 4:
+        string_dict_i32_buffer_ = new std::vector<int32_t>();
+        break;
+      default:
+        CHECK(false);
+    }
+  }
+
+  void deleteStringDictBuffer() {
+    switch (column_desc_->columnType.get_size()) {
+      case 1:
+        delete string_dict_i8_buffer_;
+        break;
+      case 2:
+        delete string_dict_i16_buffer_;
+        break;
+      case 4:
+        delete string_dict_i32_buffer_;
+        break;
+    }
+  }
+
+  void clearStringDictBuffer() {
+    switch (column_desc_->columnType.get_size()) {
+      case 1:
+        string_dict_i8_buffer_->clear();
+        break;
+      case 2:
+        string_dict_i16_buffer_->clear();
+        break;
+      case 4:
+        string_dict_i32_buffer_->clear();
+        break;
+      default:
+        CHECK(false);
+    }
+  }
+
   union {
     std::vector<int8_t>* bool_buffer_;
     std::vector<int16_t>* smallint_buffer_;
@@ -468,7 +520,8 @@ class Loader {
   const Fragmenter_Namespace::InsertData& get_insert_data() const { return insert_data; }
   StringDictionary* get_string_dict(const ColumnDescriptor* cd) const {
     if ((cd->columnType.get_type() != kARRAY || !IS_STRING(cd->columnType.get_subtype())) &&
-        (!cd->columnType.is_string() || cd->columnType.get_compression() != kENCODING_DICT))
+        (!cd->columnType.is_string() || cd->columnType.get_compression() != kENCODING_DICT) &&
+        !cd->columnType.is_dict_encoded_number())
       return nullptr;
     return dict_map.at(cd->columnId);
   }
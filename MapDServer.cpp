@@ -28,6 +28,10 @@
 
 #include "MapDRelease.h"
 
+#include "DataMgr/BufferMgr/EvictionPolicy.h"
+#include "QueryEngine/PersistentObjectCache.h"
+#include "QueryEngine/WorkStealingPool.h"
+#include "StringDictionary/NgramIndex.h"
 #include "Shared/MapDParameters.h"
 #include "Shared/scope.h"
 
@@ -51,6 +55,13 @@ using boost::make_shared;
 using boost::shared_ptr;
 
 extern bool g_aggregator;
+extern bool g_enable_async_file_reads;
+extern bool g_enable_chunk_sketches;
+extern std::string g_buffer_eviction_policy;
+extern bool g_enable_table_wal;
+extern size_t g_table_wal_max_size;
+extern size_t g_table_wal_flush_interval;
+extern bool g_enable_metadata_index;
 extern size_t g_leaf_count;
 
 AggregatedColRange column_ranges_from_thrift(const std::vector<TColumnRange>& thrift_column_ranges) {
@@ -158,12 +169,16 @@ void releaseWarmupSession(TSessionId& sessionId, std::ifstream& query_file) {
   }
 }
 
-void run_warmup_queries(boost::shared_ptr<MapDHandler> handler, std::string base_path, std::string query_file_path) {
-  // run warmup queries to load cache if requested
+void run_warmup_queries(boost::shared_ptr<MapDHandler> handler,
+                        std::string base_path,
+                        std::string query_file_path,
+                        const bool precompile_only) {
+  // run warmup queries to load cache if requested, or just compile them when the file contains relational algebra
   if (query_file_path.empty()) {
     return;
   }
-  LOG(INFO) << "Running DB warmup with queries from " << query_file_path;
+  LOG(INFO) << (precompile_only ? "Precompiling queries from " : "Running DB warmup with queries from ")
+            << query_file_path;
   try {
     warmup_handler = handler;
     std::string db_info;
@@ -198,7 +213,11 @@ void run_warmup_queries(boost::shared_ptr<MapDHandler> handler, std::string base
             single_query.clear();
             break;
           }
-          warmup_handler->sql_execute(ret, sessionId, single_query, true, "", -1, -1);
+          if (precompile_only) {
+            warmup_handler->precompile_rel_alg(sessionId, single_query);
+          } else {
+            warmup_handler->sql_execute(ret, sessionId, single_query, true, "", -1, -1);
+          }
           single_query.clear();
         }
 
@@ -245,6 +264,8 @@ int main(int argc, char** argv) {
   size_t num_reader_threads = 0;   // number of threads used when loading data
   std::string db_convert_dir("");  // path to mapd DB to convert from; if path is empty, no conversion is requested
   std::string db_query_file("");   // path to file containing warmup queries list
+  std::string jit_warm_list("");   // path to file containing relational algebra to precompile
+  bool enable_persistent_code_cache = false;
   bool enable_access_priv_check = false;  // enable DB objects access privileges checking
 
   namespace po = boost::program_options;
@@ -300,6 +321,31 @@ int main(int argc, char** argv) {
   desc_adv.add_options()("num-reader-threads",
                          po::value<size_t>(&num_reader_threads)->default_value(num_reader_threads),
                          "Number of reader threads to use");
+  desc_adv.add_options()(
+      "enable-async-file-reads",
+      po::value<bool>(&g_enable_async_file_reads)->default_value(g_enable_async_file_reads)->implicit_value(true),
+      "Read chunks from disk with batched positional reads and prefetch the next fragment");
+  desc_adv.add_options()(
+      "enable-chunk-sketches",
+      po::value<bool>(&g_enable_chunk_sketches)->default_value(g_enable_chunk_sketches)->implicit_value(true),
+      "Build a Bloom filter and a distinct count sketch of the new integer, time and dictionary encoded chunks");
+  desc_adv.add_options()("buffer-eviction-policy",
+                         po::value<std::string>(&g_buffer_eviction_policy)->default_value(g_buffer_eviction_policy),
+                         "Eviction policy of the CPU and GPU buffer pools: lru or lru2 (scan resistant)");
+  desc_adv.add_options()(
+      "enable-table-wal",
+      po::value<bool>(&g_enable_table_wal)->default_value(g_enable_table_wal)->implicit_value(true),
+      "Make small inserts durable through a write-ahead log per table, the table files are synced lazily");
+  desc_adv.add_options()("table-wal-max-size",
+                         po::value<size_t>(&g_table_wal_max_size)->default_value(g_table_wal_max_size),
+                         "Size in bytes of the write-ahead log of a table past which inserts sync the table files");
+  desc_adv.add_options()("table-wal-flush-interval",
+                         po::value<size_t>(&g_table_wal_flush_interval)->default_value(g_table_wal_flush_interval),
+                         "Seconds between the flushes of the write-ahead logs to the table files");
+  desc_adv.add_options()(
+      "enable-metadata-index",
+      po::value<bool>(&g_enable_metadata_index)->default_value(g_enable_metadata_index)->implicit_value(true),
+      "Open tables from an index of their page headers written at checkpoints, scan the headers only to recover");
   desc_adv.add_options()("enable-watchdog",
                          po::value<bool>(&enable_watchdog)->default_value(enable_watchdog)->implicit_value(true),
                          "Enable watchdog");
@@ -339,6 +385,10 @@ int main(int argc, char** argv) {
       "calcite-max-mem",
       po::value<size_t>(&mapd_parameters.calcite_max_mem)->default_value(mapd_parameters.calcite_max_mem),
       "Max memory available to calcite JVM");
+  desc_adv.add_options()(
+      "calcite-plan-cache-max-entries",
+      po::value<size_t>(&g_calcite_plan_cache_max_entries)->default_value(g_calcite_plan_cache_max_entries),
+      "Maximum number of relational algebra plans cached for repeated queries, 0 disables the cache");
   desc_adv.add_options()(
       "db-convert", po::value<std::string>(&db_convert_dir), "Directory path to mapd DB to convert from");
 
@@ -348,11 +398,45 @@ int main(int argc, char** argv) {
   desc_adv.add_options()("bigint-count",
                          po::value<bool>(&g_bigint_count)->default_value(g_bigint_count)->implicit_value(false),
                          "Use 64-bit count");
+  desc_adv.add_options()(
+      "num-executor-threads",
+      po::value<size_t>(&mapd_parameters.num_executor_threads)->default_value(mapd_parameters.num_executor_threads),
+      "Number of threads executing query fragments, shared by all queries. 0 uses all the cpu threads");
+  desc_adv.add_options()(
+      "max-concurrent-cpu-queries",
+      po::value<unsigned>(&g_max_concurrent_cpu_queries)->default_value(g_max_concurrent_cpu_queries),
+      "Maximum number of queries executing on CPU at the same time");
+  desc_adv.add_options()("code-cache-max-entries",
+                         po::value<size_t>(&g_code_cache_max_entries)->default_value(g_code_cache_max_entries),
+                         "Maximum number of compiled queries kept in the code cache, per device type");
+  desc_adv.add_options()("code-cache-max-size",
+                         po::value<size_t>(&g_code_cache_max_size)->default_value(g_code_cache_max_size),
+                         "Maximum size in bytes of the IR the cached code has been compiled from, per device type");
+  desc_adv.add_options()(
+      "string-dictionary-like-cache-max-size",
+      po::value<size_t>(&g_string_dictionary_like_cache_max_size)
+          ->default_value(g_string_dictionary_like_cache_max_size),
+      "Maximum size in bytes of the LIKE and REGEXP results cached by each string dictionary");
+  desc_adv.add_options()("enable-string-dictionary-ngram-index",
+                         po::value<bool>(&g_enable_string_dictionary_ngram_index)
+                             ->default_value(g_enable_string_dictionary_ngram_index)
+                             ->implicit_value(true),
+                         "Index the trigrams of dictionary encoded strings to speed up substring LIKE filters, at the "
+                         "cost of about four bytes of memory and disk per character of every string");
   desc_adv.add_options()("allow-cpu-retry",
                          po::value<bool>(&g_allow_cpu_retry)->default_value(g_allow_cpu_retry)->implicit_value(true),
                          "Allow the queries which failed on GPU to retry on CPU, even when watchdog is enabled");
   desc_adv.add_options()(
       "db-query-list", po::value<std::string>(&db_query_file), "Path to file containing mapd queries");
+  desc_adv.add_options()("jit-warm-list",
+                         po::value<std::string>(&jit_warm_list),
+                         "Path to file containing relational algebra to compile in the background at startup, in the "
+                         "same format as db-query-list");
+  desc_adv.add_options()("enable-persistent-code-cache",
+                         po::value<bool>(&enable_persistent_code_cache)
+                             ->default_value(enable_persistent_code_cache)
+                             ->implicit_value(true),
+                         "Keep the object code of CPU queries in the data directory, to reuse it across restarts");
   desc_adv.add_options()(
       "enable-access-priv-check",
       po::value<bool>(&enable_access_priv_check)->default_value(enable_access_priv_check)->implicit_value(false),
@@ -432,6 +516,7 @@ int main(int argc, char** argv) {
     g_enable_watchdog = enable_watchdog;
     g_enable_dynamic_watchdog = enable_dynamic_watchdog;
     g_dynamic_watchdog_time_limit = dynamic_watchdog_time_limit;
+    WorkStealingPool::init(mapd_parameters.num_executor_threads);
   } catch (boost::program_options::error& e) {
     std::cerr << "Usage Error: " << e.what() << std::endl;
     return 1;
@@ -441,11 +526,20 @@ int main(int argc, char** argv) {
     std::cerr << "hll-precision-bits must be between 1 and 16." << std::endl;
     return 1;
   }
+  if (!Buffer_Namespace::EvictionPolicy::create(g_buffer_eviction_policy)) {
+    std::cerr << "buffer-eviction-policy must be lru or lru2." << std::endl;
+    return 1;
+  }
   boost::algorithm::trim_if(db_query_file, boost::is_any_of("\"'"));
   if (db_query_file.length() > 0 && !boost::filesystem::exists(db_query_file)) {
     std::cerr << "File containing DB queries " << db_query_file << " does not exist." << std::endl;
     return 1;
   }
+  boost::algorithm::trim_if(jit_warm_list, boost::is_any_of("\"'"));
+  if (jit_warm_list.length() > 0 && !boost::filesystem::exists(jit_warm_list)) {
+    std::cerr << "File containing queries to precompile " << jit_warm_list << " does not exist." << std::endl;
+    return 1;
+  }
   boost::algorithm::trim_if(db_convert_dir, boost::is_any_of("\"'"));
   if (db_convert_dir.length() > 0 && !boost::filesystem::exists(db_convert_dir)) {
     std::cerr << "Data conversion source directory " << db_convert_dir << " does not exist." << std::endl;
@@ -506,6 +600,9 @@ int main(int argc, char** argv) {
 
   // add all parameters to be displayed on startup
   LOG(INFO) << "MapD started with data directory at '" << base_path << "'";
+  if (enable_persistent_code_cache) {
+    PersistentObjectCache::init((boost::filesystem::path(base_path) / "mapd_code_cache").string());
+  }
   if (vm.count("cluster")) {
     LOG(INFO) << "Cluster file specified running as aggregator with config at '" << cluster_file << "'";
   }
@@ -582,9 +679,12 @@ int main(int argc, char** argv) {
     std::thread bufThread(start_server, std::ref(bufServer));
     std::thread httpThread(start_server, std::ref(httpServer));
 
-    // run warm up queries if any exists
-    run_warmup_queries(handler, base_path, db_query_file);
+    // compile the queries from the warm list first, the server is already accepting connections
+    // and compiling is much cheaper than running the warmup queries which also load the data
+    run_warmup_queries(handler, base_path, jit_warm_list, true);
 
+    // run warm up queries if any exists
+    run_warmup_queries(handler, base_path, db_query_file, false);
     bufThread.join();
     httpThread.join();
   } else {  // running ha server
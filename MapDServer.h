@@ -125,6 +125,7 @@ inline TEncodingType::type encoding_to_thrift(const SQLTypeInfo& type_info) {
     THRIFT_ENCODING_CASE(DIFF)
     THRIFT_ENCODING_CASE(DICT)
     THRIFT_ENCODING_CASE(SPARSE)
+    THRIFT_ENCODING_CASE(PACKED)
     default:
       CHECK(false);
   }
@@ -141,6 +142,7 @@ inline EncodingType thrift_to_encoding(const TEncodingType::type tEncodingType)
     UNTHRIFT_ENCODING_CASE(DIFF)
     UNTHRIFT_ENCODING_CASE(DICT)
     UNTHRIFT_ENCODING_CASE(SPARSE)
+    UNTHRIFT_ENCODING_CASE(PACKED)
     default:
       CHECK(false);
   }
@@ -42,6 +42,7 @@
 #include "../Import/Importer.h"
 #include "../Shared/measure.h"
 #include "../Shared/mapd_glob.h"
+#include "../Shared/BitPacking.h"
 #include "parser.h"
 
 #include "../QueryEngine/ExtensionFunctionsWhitelist.h"
@@ -168,12 +169,57 @@ std::shared_ptr<Analyzer::Expr> OperExpr::analyze(const Catalog_Namespace::Catal
   return normalize(optype, opqualifier, left_expr, right_expr);
 }
 
+namespace {
+
+// Whether a literal compared for equality with a dictionary encoded number can be looked up in
+// the dictionary, i.e. the cast to the type of the column keeps its value.
+bool is_dict_number_literal(const std::shared_ptr<Analyzer::Expr>& expr, const SQLTypeInfo& dict_ti) {
+  const auto constant = std::dynamic_pointer_cast<const Analyzer::Constant>(expr);
+  if (!constant) {
+    return false;
+  }
+  if (constant->get_is_null()) {
+    return true;
+  }
+  const auto& const_ti = constant->get_type_info();
+  switch (dict_ti.get_type()) {
+    case kINT: {
+      if (!const_ti.is_integer()) {
+        return false;
+      }
+      const auto val = constant->get_constval().bigintval;
+      return const_ti.get_type() != kBIGINT ||
+             (val >= std::numeric_limits<int32_t>::min() && val <= std::numeric_limits<int32_t>::max());
+    }
+    case kBIGINT:
+      return const_ti.is_integer();
+    case kDOUBLE:
+      return const_ti.is_number();
+    default:
+      CHECK(false);
+  }
+  return false;
+}
+
+}  // namespace
+
 std::shared_ptr<Analyzer::Expr> OperExpr::normalize(const SQLOps optype,
                                                     const SQLQualifier qual,
                                                     std::shared_ptr<Analyzer::Expr> left_expr,
                                                     std::shared_ptr<Analyzer::Expr> right_expr) {
   const auto& left_type = left_expr->get_type_info();
   auto right_type = right_expr->get_type_info();
+  if ((IS_EQUIVALENCE(optype) || optype == kNE) && qual == kONE) {
+    // compare the ids of dictionary encoded numbers with the id of the literal, if any
+    if (left_type.is_dict_encoded_number() && is_dict_number_literal(right_expr, left_type)) {
+      return makeExpr<Analyzer::BinOper>(
+          kBOOLEAN, left_expr->get_contains_agg(), optype, qual, left_expr, right_expr->add_cast(left_type));
+    }
+    if (right_type.is_dict_encoded_number() && is_dict_number_literal(left_expr, right_type)) {
+      return makeExpr<Analyzer::BinOper>(
+          kBOOLEAN, right_expr->get_contains_agg(), optype, qual, left_expr->add_cast(right_type), right_expr);
+    }
+  }
   if (qual != kONE) {
     // subquery not supported yet.
     CHECK(!std::dynamic_pointer_cast<Analyzer::Subquery>(right_expr));
@@ -737,6 +783,12 @@ std::shared_ptr<Analyzer::Expr> CaseExpr::normalize(
             "THEN clauses.");
     }
   }
+  if (ti.is_dict_encoded_number()) {
+    // the branches could yield values missing from the dictionary, decode them
+    ti.set_compression(kENCODING_NONE);
+    ti.set_comp_param(0);
+    ti.set_fixed_size();
+  }
   std::list<std::pair<std::shared_ptr<Analyzer::Expr>, std::shared_ptr<Analyzer::Expr>>> cast_expr_pair_list;
   for (auto p : expr_pair_list) {
     ti.set_notnull(false);
@@ -1608,6 +1660,20 @@ void validate_shard_column_type(const size_t shard_column_id, const std::list<Co
                            col_ti.get_compression_name());
 }
 
+void validate_sort_column_type(const size_t sort_column_id, const std::list<ColumnDescriptor>& columns) {
+  CHECK_NE(size_t(0), sort_column_id);
+  CHECK_LE(sort_column_id, columns.size());
+  auto column_it = columns.begin();
+  std::advance(column_it, sort_column_id - 1);
+  const auto& col_ti = column_it->columnType;
+  if (col_ti.is_integer() || col_ti.is_decimal() || col_ti.is_fp() || col_ti.is_time() || col_ti.is_boolean() ||
+      (col_ti.is_string() && col_ti.get_compression() == kENCODING_DICT)) {
+    return;
+  }
+  throw std::runtime_error("Cannot sort on type " + col_ti.get_type_name() + ", encoding " +
+                           col_ti.get_compression_name());
+}
+
 void set_string_field(rapidjson::Value& obj,
                       const std::string& field_name,
                       const std::string& field_value,
@@ -1755,19 +1821,76 @@ void CreateTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
         cd.columnType.set_compression(kENCODING_FIXED);
         cd.columnType.set_comp_param(compression->get_encoding_param());
       } else if (boost::iequals(comp, "rl")) {
+        if (!cd.columnType.is_boolean() && !cd.columnType.is_integer() && !cd.columnType.is_decimal() &&
+            !cd.columnType.is_time())
+          throw std::runtime_error(
+              cd.columnName + ": RL encoding is only supported for boolean, integer, decimal or time columns.");
+        if (compression->get_encoding_param() != 0)
+          throw std::runtime_error(cd.columnName + ": RL encoding does not take a compression parameter.");
         // run length encoding
         cd.columnType.set_compression(kENCODING_RL);
         cd.columnType.set_comp_param(0);
-        // throw std::runtime_error("RL(Run Length) encoding not supported yet.");
       } else if (boost::iequals(comp, "diff")) {
-        // differential encoding
+        if (!cd.columnType.is_integer() && !cd.columnType.is_time())
+          throw std::runtime_error(cd.columnName + ": DIFF encoding is only supported for integer or time columns.");
+        // differential encoding, the deltas default to half the width of the type
+        switch (cd.columnType.get_type()) {
+          case kSMALLINT:
+            comp_param = compression->get_encoding_param() == 0 ? 8 : compression->get_encoding_param();
+            if (comp_param != 8)
+              throw std::runtime_error(cd.columnName +
+                                       ": Compression parameter for DIFF encoding on SMALLINT must be 8.");
+            break;
+          case kINT:
+            comp_param = compression->get_encoding_param() == 0 ? 16 : compression->get_encoding_param();
+            if (comp_param != 8 && comp_param != 16)
+              throw std::runtime_error(cd.columnName +
+                                       ": Compression parameter for DIFF encoding on INTEGER must be 8 or 16.");
+            break;
+          case kBIGINT:
+          case kTIMESTAMP:
+          case kDATE:
+          case kTIME:
+            comp_param = compression->get_encoding_param() == 0 ? 32 : compression->get_encoding_param();
+            if (comp_param != 8 && comp_param != 16 && comp_param != 32)
+              throw std::runtime_error(cd.columnName +
+                                       ": Compression parameter for DIFF encoding on BIGINT, TIME, DATE or TIMESTAMP "
+                                       "must be 8 or 16 or 32.");
+            break;
+          default:
+            throw std::runtime_error(cd.columnName + ": Cannot apply DIFF encoding to " + t->to_string());
+        }
         cd.columnType.set_compression(kENCODING_DIFF);
-        cd.columnType.set_comp_param(0);
-        // throw std::runtime_error("DIFF(differential) encoding not supported yet.");
+        cd.columnType.set_comp_param(comp_param);
+      } else if (boost::iequals(comp, "packed")) {
+        if (!cd.columnType.is_integer() && !cd.columnType.is_time())
+          throw std::runtime_error(cd.columnName + ": PACKED encoding is only supported for integer or time columns.");
+        // bit-packed encoding, one bit width below the width of the type is taken for null
+        comp_param = compression->get_encoding_param();
+        int max_bits;
+        switch (cd.columnType.get_type()) {
+          case kSMALLINT:
+            max_bits = 15;
+            break;
+          case kINT:
+            max_bits = 31;
+            break;
+          default:
+            max_bits = MAX_PACKED_BIT_WIDTH;
+            break;
+        }
+        if (comp_param < 2 || comp_param > max_bits)
+          throw std::runtime_error(cd.columnName + ": Compression parameter for PACKED encoding on " + t->to_string() +
+                                   " must be between 2 and " + std::to_string(max_bits) + ".");
+        cd.columnType.set_compression(kENCODING_PACKED);
+        cd.columnType.set_comp_param(comp_param);
       } else if (boost::iequals(comp, "dict")) {
-        if (!cd.columnType.is_string() && !cd.columnType.is_string_array())
+        const bool is_dict_number_type = cd.columnType.get_type() == kINT || cd.columnType.get_type() == kBIGINT ||
+                                         cd.columnType.get_type() == kDOUBLE;
+        if (!cd.columnType.is_string() && !cd.columnType.is_string_array() && !is_dict_number_type)
           throw std::runtime_error(cd.columnName +
-                                   ": Dictionary encoding is only supported on string or string array columns.");
+                                   ": Dictionary encoding is only supported on string, string array, INTEGER, "
+                                   "BIGINT or DOUBLE columns.");
         if (compression->get_encoding_param() == 0)
           comp_param = 32;  // default to 32-bits
         else
@@ -1885,9 +2008,27 @@ void CreateTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
         } else {
           td.nShards = shard_count;
         }
+      } else if (boost::iequals(*p->get_name(), "storage_compression")) {
+        if (!dynamic_cast<const StringLiteral*>(p->get_value()))
+          throw std::runtime_error("STORAGE_COMPRESSION must be a string literal.");
+        const auto codec = static_cast<const StringLiteral*>(p->get_value())->get_stringval();
+        CHECK(codec);
+        td.storageCompression = File_Namespace::page_codec_from_string(*codec);
+      } else if (boost::iequals(*p->get_name(), "sort_column")) {
+        if (!dynamic_cast<const StringLiteral*>(p->get_value()))
+          throw std::runtime_error("SORT_COLUMN must be a string literal.");
+        const auto sort_column = static_cast<const StringLiteral*>(p->get_value())->get_stringval();
+        CHECK(sort_column);
+        td.sortedColumnId = shard_column_index(*sort_column, columns);
+        if (!td.sortedColumnId) {
+          throw std::runtime_error("Specified sort column " + *sort_column + " doesn't exist");
+        }
+        validate_sort_column_type(td.sortedColumnId, columns);
+        td.fragType = Fragmenter_Namespace::FragmenterType::SORTED_ORDER;
       } else {
         throw std::runtime_error("Invalid CREATE TABLE option " + *p->get_name() +
-                                 ".  Should be FRAGMENT_SIZE, PAGE_SIZE, MAX_ROWS, PARTITIONS or SHARD_COUNT.");
+                                 ".  Should be FRAGMENT_SIZE, PAGE_SIZE, MAX_ROWS, PARTITIONS, SHARD_COUNT, "
+                                 "STORAGE_COMPRESSION or SORT_COLUMN.");
       }
     }
   }
@@ -2147,6 +2288,47 @@ void TruncateTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   catalog.truncateTable(td);
 }
 
+void OptimizeTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
+  auto& catalog = session.get_catalog();
+  const TableDescriptor* td = catalog.getMetadataForTable(*table);
+  if (td == nullptr) {
+    throw std::runtime_error("Table " + *table + " does not exist.");
+  }
+
+  // check access privileges, rewriting the table takes the same ones as truncating it
+  if (catalog.isAccessPrivCheckEnabled()) {
+    std::vector<DBObject> privObjects;
+    DBObject dbObject(*table, TableDBObjectType);
+    static_cast<Catalog_Namespace::SysCatalog&>(catalog).populateDBObjectKey(dbObject, catalog);
+    std::vector<bool> privs{false, false, false, true};  // TRUNCATE
+    dbObject.setPrivileges(privs);
+    privObjects.push_back(dbObject);
+    if (!(static_cast<Catalog_Namespace::SysCatalog&>(catalog))
+             .checkPrivileges(session.get_currentUser(), privObjects)) {
+      throw std::runtime_error("Table " + *table + " will not be optimized. User " +
+                               session.get_currentUser().userName + " has no proper privileges.");
+    }
+  }
+
+  if (td->isView)
+    throw std::runtime_error(*table + " is a view.  Cannot Optimize.");
+  // the progress is reported in pages through the import status of "optimize_<table name>"
+  const std::string import_id = "optimize_" + td->tableName;
+  Importer_NS::ImportStatus import_status;
+  Importer_NS::Importer::set_import_status(import_id, import_status);
+  size_t pages_before = 0;
+  for (const auto physical_td : catalog.getPhysicalTablesDescriptors(td)) {
+    size_t num_table_pages = 0;
+    physical_td->fragmenter->compactStorage([&](const size_t pages_copied, const size_t num_pages) {
+      import_status.rows_completed = pages_before + pages_copied;
+      import_status.rows_estimated = pages_before + num_pages;
+      Importer_NS::Importer::set_import_status(import_id, import_status);
+      num_table_pages = num_pages;
+    });
+    pages_before += num_table_pages;
+  }
+}
+
 void RenameTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   auto& catalog = session.get_catalog();
   const TableDescriptor* td = catalog.getMetadataForTable(*table);
@@ -952,6 +952,20 @@ class TruncateTableStmt : public DDLStmt {
   std::unique_ptr<std::string> table;
 };
 
+/*
+ * @type OptimizeTableStmt
+ * @brief OPTIMIZE TABLE statement
+ */
+class OptimizeTableStmt : public DDLStmt {
+ public:
+  OptimizeTableStmt(std::string* tab) : table(tab) {}
+  const std::string* get_table() const { return table.get(); }
+  virtual void execute(const Catalog_Namespace::SessionInfo& session);
+
+ private:
+  std::unique_ptr<std::string> table;
+};
+
 class RenameTableStmt : public DDLStmt {
  public:
   RenameTableStmt(std::string* tab, std::string* new_tab_name) : table(tab), new_table_name(new_tab_name) {}
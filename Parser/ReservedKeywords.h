@@ -40,6 +40,7 @@ static std::set<std::string> reserved_keywords{
     "LENGTH",
     "NOW",
     "NULLX",
+    "OPTIMIZE",
     "OPTION",
     "PRIVILEGES",
     "PUBLIC",
@@ -43,6 +43,9 @@ llvm::Value* Executor::codegenCast(llvm::Value* operand_lv,
                                    const SQLTypeInfo& ti,
                                    const bool operand_is_const,
                                    const CompilationOptions& co) {
+  if (operand_ti.is_dict_encoded_number() || ti.is_dict_encoded_number()) {
+    return codegenCastDictEncodedNumber(operand_lv, operand_ti, ti, operand_is_const, co);
+  }
   if (operand_lv->getType()->isIntegerTy()) {
     if (operand_ti.is_string()) {
       return codegenCastFromString(operand_lv, operand_ti, ti, operand_is_const, co);
@@ -73,6 +76,68 @@ llvm::Value* Executor::codegenCast(llvm::Value* operand_lv,
   return nullptr;
 }
 
+llvm::Value* Executor::codegenCastDictEncodedNumber(llvm::Value* operand_lv,
+                                                    const SQLTypeInfo& operand_ti,
+                                                    const SQLTypeInfo& ti,
+                                                    const bool operand_is_const,
+                                                    const CompilationOptions& co) {
+  if (ti.is_dict_encoded_number()) {
+    // constants have already been translated to ids of the dictionary of the cast
+    if (operand_is_const ||
+        (operand_ti.is_dict_encoded_number() && operand_ti.get_comp_param() == ti.get_comp_param())) {
+      return operand_lv;
+    }
+    throw std::runtime_error("Cast from " + operand_ti.get_type_name() + " to dictionary-encoded " +
+                             ti.get_type_name() + " not supported");
+  }
+  CHECK(operand_ti.is_dict_encoded_number());
+  CHECK(operand_lv->getType()->isIntegerTy(32));
+  if (g_cluster) {
+    throw std::runtime_error("Decoding a dictionary-encoded number not supported for distributed queries");
+  }
+  if (co.device_type_ == ExecutorDeviceType::GPU) {
+    throw QueryMustRunOnCpu();
+  }
+  auto logical_ti = operand_ti;
+  logical_ti.set_compression(kENCODING_NONE);
+  logical_ti.set_comp_param(0);
+  const auto& values =
+      getStringDictionaryProxy(operand_ti.get_comp_param(), row_set_mem_owner_, true)->getNumericValues();
+  if (values.empty()) {
+    // only nulls have been stored so far
+    auto null_lv = logical_ti.is_fp() ? static_cast<llvm::Value*>(inlineFpNull(logical_ti)) : inlineIntNull(logical_ti);
+    return logical_ti == ti ? null_lv : codegenCast(null_lv, logical_ti, ti, false, co);
+  }
+  auto& ir_builder = cgen_state_->ir_builder_;
+  const auto null_id = ll_int(static_cast<int32_t>(inline_int_null_val(operand_ti)));
+  const auto is_null = ir_builder.CreateICmpEQ(operand_lv, null_id);
+  const auto idx_lv = ir_builder.CreateSExt(ir_builder.CreateSelect(is_null, ll_int(int32_t(0)), operand_lv),
+                                            get_int_type(64, cgen_state_->context_));
+  const auto values_lv = ir_builder.CreateIntToPtr(ll_int(reinterpret_cast<int64_t>(values.data())),
+                                                   llvm::PointerType::get(get_int_type(64, cgen_state_->context_), 0));
+  llvm::Value* decoded_lv = ir_builder.CreateLoad(ir_builder.CreateGEP(values_lv, idx_lv));
+  llvm::Value* null_lv{nullptr};
+  switch (logical_ti.get_type()) {
+    case kINT:
+      decoded_lv = ir_builder.CreateTrunc(decoded_lv, get_int_type(32, cgen_state_->context_));
+      null_lv = inlineIntNull(logical_ti);
+      break;
+    case kBIGINT:
+      null_lv = inlineIntNull(logical_ti);
+      break;
+    case kDOUBLE:
+      decoded_lv = ir_builder.CreateBitCast(decoded_lv, llvm::Type::getDoubleTy(cgen_state_->context_));
+      null_lv = inlineFpNull(logical_ti);
+      break;
+    default:
+      CHECK(false);
+  }
+  if (!operand_ti.get_notnull()) {
+    decoded_lv = ir_builder.CreateSelect(is_null, null_lv, decoded_lv);
+  }
+  return logical_ti == ti ? decoded_lv : codegenCast(decoded_lv, logical_ti, ti, false, co);
+}
+
 llvm::Value* Executor::codegenCastTimestampToDate(llvm::Value* ts_lv, const bool nullable) {
   static_assert(sizeof(time_t) == 4 || sizeof(time_t) == 8, "Unsupported time_t size");
   CHECK(ts_lv->getType()->isIntegerTy(32) || ts_lv->getType()->isIntegerTy(64));
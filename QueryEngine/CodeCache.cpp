@@ -0,0 +1,130 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CodeCache.h"
+
+#include <glog/logging.h>
+#include <algorithm>
+
+size_t g_code_cache_max_entries{1024};
+size_t g_code_cache_max_size{256 * 1024 * 1024};
+
+CodeCacheEntry::~CodeCacheEntry() {
+  const bool owned_by_engine =
+      std::any_of(native_code.begin(), native_code.end(), [](const CodeCacheVal::value_type& native_func) {
+        return std::get<1>(native_func) != nullptr;
+      });
+  native_code.clear();
+  if (!owned_by_engine) {
+    delete module;
+  }
+}
+
+const std::vector<int64_t>& CodeCache::compileTimeBuckets() {
+  // the caches are statics of the executor, don't depend on the initialization order of another static
+  static const std::vector<int64_t> buckets{10, 50, 100, 250, 500, 1000, 2500, 5000};
+  return buckets;
+}
+
+CodeCache::CodeCache()
+    : size_(0), hits_(0), misses_(0), evictions_(0), compile_time_counts_(compileTimeBuckets().size() + 1, 0) {}
+
+std::shared_ptr<CodeCacheEntry> CodeCache::get(const CodeCacheKey& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  return it->second.entry;
+}
+
+std::shared_ptr<CodeCacheEntry> CodeCache::put(const CodeCacheKey& key,
+                                               CodeCacheVal&& native_code,
+                                               llvm::Module* module,
+                                               const int64_t compile_time_ms) {
+  size_t entry_size = 0;
+  for (const auto& part : key) {
+    entry_size += part.size();
+  }
+  auto entry = std::make_shared<CodeCacheEntry>(std::move(native_code), module, entry_size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto& buckets = compileTimeBuckets();
+  ++compile_time_counts_[std::lower_bound(buckets.begin(), buckets.end(), compile_time_ms) - buckets.begin()];
+  auto it_ok = index_.emplace(key, Node{entry, lru_.end()});
+  CHECK(it_ok.second);
+  lru_.push_front(&it_ok.first->first);
+  it_ok.first->second.lru_it = lru_.begin();
+  size_ += entry_size;
+  sweepRetired();
+  evictOverBudget();
+  return entry;
+}
+
+void CodeCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& kv : index_) {
+    retire(std::move(kv.second.entry));
+  }
+  index_.clear();
+  lru_.clear();
+  size_ = 0;
+  sweepRetired();
+}
+
+CodeCache::Stats CodeCache::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {index_.size(),
+          size_,
+          g_code_cache_max_entries,
+          g_code_cache_max_size,
+          hits_,
+          misses_,
+          evictions_,
+          compile_time_counts_};
+}
+
+void CodeCache::evictOverBudget() {
+  // never evict the entry which has just been added, the caller is about to use it
+  while (lru_.size() > 1 && (lru_.size() > g_code_cache_max_entries || size_ > g_code_cache_max_size)) {
+    auto it = index_.find(*lru_.back());
+    CHECK(it != index_.end());
+    lru_.pop_back();
+    CHECK_GE(size_, it->second.entry->size);
+    size_ -= it->second.entry->size;
+    retire(std::move(it->second.entry));
+    index_.erase(it);
+    ++evictions_;
+  }
+}
+
+void CodeCache::retire(std::shared_ptr<CodeCacheEntry>&& entry) {
+  // queries hold a reference to the code they run, destroy it only once they're done
+  if (entry.use_count() > 1) {
+    retired_.emplace_back(std::move(entry));
+  } else {
+    entry.reset();
+  }
+}
+
+void CodeCache::sweepRetired() {
+  retired_.erase(std::remove_if(retired_.begin(),
+                                retired_.end(),
+                                [](const std::shared_ptr<CodeCacheEntry>& entry) { return entry.use_count() == 1; }),
+                 retired_.end());
+}
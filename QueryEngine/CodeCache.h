@@ -0,0 +1,131 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    CodeCache.h
+ * @brief   Bounded, least recently used cache of the native code generated for queries.
+ *
+ * The size of an entry is approximated by the size of the serialized IR it has been
+ * generated from. Evicted entries which are still used by a running query are kept
+ * aside until the query releases them, so that native code never vanishes under it.
+ */
+
+#ifndef QUERYENGINE_CODECACHE_H
+#define QUERYENGINE_CODECACHE_H
+
+#include "NvidiaKernel.h"
+
+#include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/IR/Module.h>
+#include <boost/functional/hash.hpp>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+extern size_t g_code_cache_max_entries;
+extern size_t g_code_cache_max_size;
+
+typedef std::vector<std::string> CodeCacheKey;
+typedef std::vector<std::tuple<void*, std::unique_ptr<llvm::ExecutionEngine>, std::unique_ptr<GpuCompilationContext>>>
+    CodeCacheVal;
+
+struct CodeCacheKeyHash {
+  size_t operator()(const CodeCacheKey& key) const {
+    size_t seed = 0;
+    for (const auto& part : key) {
+      boost::hash_combine(seed, std::hash<std::string>()(part));
+    }
+    return seed;
+  }
+};
+
+struct CodeCacheEntry {
+  CodeCacheEntry(CodeCacheVal&& native_code_in, llvm::Module* module_in, const size_t size_in)
+      : native_code(std::move(native_code_in)), module(module_in), size(size_in) {}
+
+  ~CodeCacheEntry();
+
+  CodeCacheVal native_code;
+  llvm::Module* module;  // owned by the execution engine on CPU, by the entry itself on GPU
+  const size_t size;
+};
+
+class CodeCache {
+ public:
+  struct Stats {
+    size_t entries;
+    size_t size;
+    size_t max_entries;
+    size_t max_size;
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    std::vector<size_t> compile_time_counts;  // one more than the bucket bounds, the last one is unbounded
+  };
+
+  // Upper bounds, in milliseconds, of the compilation time histogram buckets.
+  static const std::vector<int64_t>& compileTimeBuckets();
+
+  CodeCache();
+
+  std::shared_ptr<CodeCacheEntry> get(const CodeCacheKey& key);
+
+  // Adds the native code generated in compile_time_ms and evicts the least recently
+  // used entries over the budget. Must be called with the compilation lock held since
+  // it can destroy modules and the LLVM context they belong to isn't thread-safe.
+  std::shared_ptr<CodeCacheEntry> put(const CodeCacheKey& key,
+                                      CodeCacheVal&& native_code,
+                                      llvm::Module* module,
+                                      const int64_t compile_time_ms);
+
+  // Same locking requirements as put().
+  void clear();
+
+  Stats getStats() const;
+
+ private:
+  typedef std::list<const CodeCacheKey*> LruList;
+
+  struct Node {
+    std::shared_ptr<CodeCacheEntry> entry;
+    LruList::iterator lru_it;
+  };
+
+  void evictOverBudget();
+
+  void retire(std::shared_ptr<CodeCacheEntry>&& entry);
+
+  void sweepRetired();
+
+  // most recently used first, points to the keys of index_ to avoid keeping the IR twice
+  LruList lru_;
+  std::unordered_map<CodeCacheKey, Node, CodeCacheKeyHash> index_;
+  std::vector<std::shared_ptr<CodeCacheEntry>> retired_;
+  size_t size_;
+  size_t hits_;
+  size_t misses_;
+  size_t evictions_;
+  std::vector<size_t> compile_time_counts_;
+  mutable std::mutex mutex_;
+};
+
+#endif  // QUERYENGINE_CODECACHE_H
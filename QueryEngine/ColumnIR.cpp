@@ -51,7 +51,7 @@ std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var) {
       }
     }
     case kENCODING_DICT:
-      CHECK(ti.is_string());
+      CHECK(ti.is_string() || ti.is_dict_encoded_number());
       // For dictionary-encoded columns encoded on less than 4 bytes, we can use
       // unsigned representation for double the maximum cardinality. The inline
       // null value is going to be the maximum value of the underlying type.
@@ -64,6 +64,12 @@ std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var) {
       CHECK_EQ(0, bit_width % 8);
       return std::make_shared<FixedWidthInt>(bit_width / 8);
     }
+    case kENCODING_DIFF:
+      return std::make_shared<DiffFixedWidthInt>(ti.get_size(), inline_int_null_val(ti));
+    case kENCODING_RL:
+      return std::make_shared<RunLengthInt>(ti.get_size());
+    case kENCODING_PACKED:
+      return std::make_shared<PackedInt>(ti.get_comp_param());
     default:
       abort();
   }
@@ -184,7 +190,7 @@ llvm::Value* Executor::codegenFixedLengthColVar(const Analyzer::ColumnVar* col_v
                                                            : llvm::Instruction::CastOps::Trunc,
                                                        dec_val,
                                                        get_int_type(col_width, cgen_state_->context_));
-    if ((col_ti.get_compression() == kENCODING_FIXED ||
+    if ((col_ti.get_compression() == kENCODING_FIXED || col_ti.get_compression() == kENCODING_PACKED ||
          (col_ti.get_compression() == kENCODING_DICT && col_ti.get_size() < 4)) &&
         !col_ti.get_notnull()) {
       dec_val_cast = codgenAdjustFixedEncNull(dec_val_cast, col_ti);
@@ -260,6 +266,12 @@ SQLTypes get_phys_int_type(const size_t byte_sz) {
 }  // namespace
 
 llvm::Value* Executor::codgenAdjustFixedEncNull(llvm::Value* val, const SQLTypeInfo& col_ti) {
+  if (col_ti.get_compression() == kENCODING_PACKED) {
+    // the decoder sign extends, the smallest value on comp_param bits stands for null
+    const auto packed_null = llvm::ConstantInt::get(val->getType(), inline_fixed_encoding_null_val(col_ti));
+    return cgen_state_->ir_builder_.CreateSelect(
+        cgen_state_->ir_builder_.CreateICmpEQ(val, packed_null), inlineIntNull(col_ti), val);
+  }
   CHECK_LT(col_ti.get_size(), col_ti.get_logical_size());
   const auto col_phys_width = col_ti.get_size() * 8;
   auto from_typename = "int" + std::to_string(col_phys_width) + "_t";
@@ -24,6 +24,12 @@
 
 namespace {
 
+// Run length, differential and bit-packed layouts can't be written or copied one row at a time.
+bool is_row_addressable(const SQLTypeInfo& type_info) {
+  return type_info.get_compression() != kENCODING_RL && type_info.get_compression() != kENCODING_DIFF &&
+         type_info.get_compression() != kENCODING_PACKED;
+}
+
 int64_t fixed_encoding_nullable_val(const int64_t val, const SQLTypeInfo& type_info) {
   if (type_info.get_compression() != kENCODING_NONE) {
     CHECK(type_info.get_compression() == kENCODING_FIXED || type_info.get_compression() == kENCODING_DICT);
@@ -48,7 +54,7 @@ ColumnarResults::ColumnarResults(const std::shared_ptr<RowSetMemoryOwner> row_se
   for (size_t i = 0; i < num_columns; ++i) {
     const bool is_varlen = target_types[i].is_array() ||
                            (target_types[i].is_string() && target_types[i].get_compression() == kENCODING_NONE);
-    if (is_varlen) {
+    if (is_varlen || !is_row_addressable(target_types[i])) {
       throw ColumnarConversionNotSupported();
     }
     column_buffers_[i] = reinterpret_cast<const int8_t*>(checked_malloc(num_rows_ * target_types[i].get_size()));
@@ -175,7 +181,7 @@ ColumnarResults::ColumnarResults(const std::shared_ptr<RowSetMemoryOwner> row_se
     : column_buffers_(1), num_rows_(num_rows), target_types_{target_type} {
   const bool is_varlen =
       target_type.is_array() || (target_type.is_string() && target_type.get_compression() == kENCODING_NONE);
-  if (is_varlen) {
+  if (is_varlen || !is_row_addressable(target_type)) {
     throw ColumnarConversionNotSupported();
   }
   const auto buf_size = num_rows * target_type.get_size();
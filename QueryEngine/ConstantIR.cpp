@@ -25,6 +25,13 @@ std::vector<llvm::Value*> Executor::codegen(const Analyzer::Constant* constant,
     return codegenHoistedConstants(constants, enc_type, dict_id);
   }
   const auto& type_info = constant->get_type_info();
+  if (type_info.is_number() && enc_type == kENCODING_DICT) {
+    if (constant->get_is_null()) {
+      return {ll_int(int32_t(inline_int_null_value<int32_t>()))};
+    }
+    const auto key = numeric_dict_key(numeric_dict_bits(constant->get_constval(), type_info));
+    return {ll_int(getStringDictionaryProxy(dict_id, row_set_mem_owner_, true)->getIdOfString(key))};
+  }
   const auto type = type_info.is_decimal() ? decimal_to_int_type(type_info) : type_info.get_type();
   switch (type) {
     case kBOOLEAN:
@@ -129,10 +136,10 @@ std::vector<llvm::Value*> Executor::codegenHoistedConstants(const std::vector<co
     return {ll_int(int64_t(0)), cgen_state_->ir_builder_.CreateGEP(lit_buff_lv, off_lv), len_lv};
   }
   llvm::Type* val_ptr_type{nullptr};
-  const auto val_bits = get_bit_width(type_info);
+  const auto val_bits = enc_type == kENCODING_DICT ? 32 : get_bit_width(type_info);
   CHECK_EQ(size_t(0), val_bits % 8);
   if (type_info.is_integer() || type_info.is_decimal() || type_info.is_time() || type_info.is_timeinterval() ||
-      type_info.is_string() || type_info.is_boolean()) {
+      type_info.is_string() || type_info.is_boolean() || enc_type == kENCODING_DICT) {
     val_ptr_type = llvm::PointerType::get(llvm::IntegerType::get(cgen_state_->context_, val_bits), 0);
   } else {
     CHECK(type_info.get_type() == kFLOAT || type_info.get_type() == kDOUBLE);
@@ -89,11 +89,77 @@ extern "C" DEVICE NEVER_INLINE int64_t SUFFIX(fixed_width_unsigned_decode_noinli
   return SUFFIX(fixed_width_unsigned_decode)(byte_stream, byte_width, pos);
 }
 
+// The chunk starts with the 64-bit baseline, followed by the differences to it on byte_width bytes.
+// The smallest difference representable on byte_width bytes stands for null.
 extern "C" DEVICE ALWAYS_INLINE int64_t SUFFIX(diff_fixed_width_int_decode)(const int8_t* byte_stream,
                                                                             const int32_t byte_width,
-                                                                            const int64_t baseline,
+                                                                            const int64_t null_val,
                                                                             const int64_t pos) {
-  return SUFFIX(fixed_width_int_decode)(byte_stream, byte_width, pos) + baseline;
+  const auto diff = SUFFIX(fixed_width_int_decode)(byte_stream + sizeof(int64_t), byte_width, pos);
+  if (diff == -(1LL << (8 * byte_width - 1))) {
+    return null_val;
+  }
+  return SUFFIX(fixed_width_int_decode)(byte_stream, sizeof(int64_t), 0) + diff;
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t SUFFIX(diff_fixed_width_int_decode_noinline)(const int8_t* byte_stream,
+                                                                                    const int32_t byte_width,
+                                                                                    const int64_t null_val,
+                                                                                    const int64_t pos) {
+  return SUFFIX(diff_fixed_width_int_decode)(byte_stream, byte_width, null_val, pos);
+}
+
+// The chunk is a sequence of pairs of slot_width-byte slots. The first pair holds the number
+// of runs, the following ones the end (the position past its last row) and the value of each run.
+extern "C" DEVICE ALWAYS_INLINE int64_t SUFFIX(run_length_int_decode)(const int8_t* byte_stream,
+                                                                      const int32_t slot_width,
+                                                                      const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  // binary search for the first run which ends past pos
+  int64_t lo = 1;
+  int64_t hi = SUFFIX(fixed_width_int_decode)(byte_stream, slot_width, 0);
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (SUFFIX(fixed_width_int_decode)(byte_stream, slot_width, 2 * mid) > pos) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return SUFFIX(fixed_width_int_decode)(byte_stream, slot_width, 2 * lo + 1);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t SUFFIX(run_length_int_decode_noinline)(const int8_t* byte_stream,
+                                                                              const int32_t slot_width,
+                                                                              const int64_t pos) {
+  return SUFFIX(run_length_int_decode)(byte_stream, slot_width, pos);
+}
+
+// Value pos occupies bits [pos * bit_width, (pos + 1) * bit_width) of the stream, see BitPacking.h.
+// The stream is padded so that the 64-bit word holding the value can always be read.
+extern "C" DEVICE ALWAYS_INLINE int64_t SUFFIX(packed_int_decode)(const int8_t* byte_stream,
+                                                                  const int32_t bit_width,
+                                                                  const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const int64_t bit = pos * bit_width;
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(byte_stream + (bit >> 3));
+  uint64_t word = 0;
+  for (int i = 0; i < 8; ++i) {
+    word |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  const uint64_t sign = static_cast<uint64_t>(1) << (bit_width - 1);
+  const uint64_t val = (word >> (bit & 7)) & ((sign << 1) - 1);
+  return static_cast<int64_t>((val ^ sign) - sign);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t SUFFIX(packed_int_decode_noinline)(const int8_t* byte_stream,
+                                                                          const int32_t bit_width,
+                                                                          const int64_t pos) {
+  return SUFFIX(packed_int_decode)(byte_stream, bit_width, pos);
 }
 
 extern "C" DEVICE ALWAYS_INLINE float SUFFIX(fixed_width_float_decode)(const int8_t* byte_stream, const int64_t pos) {
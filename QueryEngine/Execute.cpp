@@ -40,6 +40,7 @@
 
 #include "AggregatedColRange.h"
 #include "StringDictionaryGenerations.h"
+#include "WorkStealingPool.h"
 
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <boost/filesystem/operations.hpp>
@@ -89,24 +90,33 @@ std::shared_ptr<Executor> Executor::getExecutor(const int db_id,
                                                 const MapDParameters mapd_parameters,
                                                 ::QueryRenderer::QueryRenderManager* render_manager) {
   const auto executor_key = std::make_pair(db_id, render_manager);
+  // References are only ever taken while holding the cache lock, so an executor
+  // only referenced by the cache is idle and can't be picked up by anybody else.
+  mapd_unique_lock<mapd_shared_mutex> write_lock(executors_cache_mutex_);
+  auto& executors = executors_[executor_key];
+  for (const auto& executor : executors) {
+    if (executor.use_count() == 1) {
+      return executor;
+    }
+  }
+  auto executor = std::make_shared<Executor>(
+      db_id, mapd_parameters.cuda_block_size, mapd_parameters.cuda_grid_size, debug_dir, debug_file, render_manager);
+  executors.push_back(executor);
+  return executor;
+}
+
+void Executor::interruptExecutors(const int db_id) {
+  std::vector<std::shared_ptr<Executor>> db_executors;
   {
     mapd_shared_lock<mapd_shared_mutex> read_lock(executors_cache_mutex_);
-    auto it = executors_.find(executor_key);
-    if (it != executors_.end()) {
-      return it->second;
+    for (const auto& kv : executors_) {
+      if (kv.first.first == db_id) {
+        db_executors.insert(db_executors.end(), kv.second.begin(), kv.second.end());
+      }
     }
   }
-  {
-    mapd_unique_lock<mapd_shared_mutex> write_lock(executors_cache_mutex_);
-    auto it = executors_.find(executor_key);
-    if (it != executors_.end()) {
-      return it->second;
-    }
-    auto executor = std::make_shared<Executor>(
-        db_id, mapd_parameters.cuda_block_size, mapd_parameters.cuda_grid_size, debug_dir, debug_file, render_manager);
-    auto it_ok = executors_.insert(std::make_pair(executor_key, executor));
-    CHECK(it_ok.second);
-    return executor;
+  for (auto executor : db_executors) {
+    executor->interrupt();
   }
 }
 
@@ -273,6 +283,9 @@ int Executor::deviceCount(const ExecutorDeviceType device_type) const {
 
 llvm::ConstantInt* Executor::inlineIntNull(const SQLTypeInfo& type_info) {
   auto type = type_info.is_decimal() ? decimal_to_int_type(type_info) : type_info.get_type();
+  if (type_info.is_dict_encoded_number()) {
+    return ll_int(static_cast<int32_t>(inline_int_null_val(type_info)));
+  }
   if (type_info.is_string()) {
     switch (type_info.get_compression()) {
       case kENCODING_DICT:
@@ -1172,7 +1185,8 @@ void Executor::dispatchFragments(
     std::unordered_set<int>& available_gpus,
     int& available_cpus) {
   size_t frag_list_idx{0};
-  std::vector<std::thread> query_threads;
+  WorkStealingPool::TaskGroup fragment_tasks;
+  auto& worker_pool = WorkStealingPool::instance();
   int64_t rowid_lookup_key{-1};
   const auto& ra_exe_unit = execution_dispatch.getExecutionUnit();
   CHECK(!ra_exe_unit.input_descs.empty());
@@ -1185,6 +1199,7 @@ void Executor::dispatchFragments(
 
   const auto& query_mem_desc = execution_dispatch.getQueryMemoryDescriptor();
   const auto inner_table_id_to_join_condition = getInnerTabIdToJoinCond();
+  const auto inner_join_key_filters = getInnerJoinKeyFilters(ra_exe_unit, selected_tables_fragments);
 
   const bool allow_multifrag =
       eo.allow_multifrag && (ra_exe_unit.groupby_exprs.empty() || query_mem_desc.usesCachedContext() ||
@@ -1202,8 +1217,12 @@ void Executor::dispatchFragments(
     // in the inner table to each device. Sharding will change this model.
     for (size_t outer_frag_id = 0; outer_frag_id < outer_fragments->size(); ++outer_frag_id) {
       const auto& fragment = (*outer_fragments)[outer_frag_id];
-      const auto skip_frag =
-          skipFragment(outer_table_desc, fragment, ra_exe_unit.simple_quals, execution_dispatch, outer_frag_id);
+      const auto skip_frag = skipFragment(outer_table_desc,
+                                          fragment,
+                                          ra_exe_unit.simple_quals,
+                                          inner_join_key_filters,
+                                          execution_dispatch,
+                                          outer_frag_id);
       if (skip_frag.first) {
         continue;
       }
@@ -1235,13 +1254,42 @@ void Executor::dispatchFragments(
       checkWorkUnitWatchdog(ra_exe_unit, *catalog_);
     }
     for (const auto& kv : fragments_per_device) {
-      query_threads.push_back(std::thread(
-          dispatch, ExecutorDeviceType::GPU, kv.first, kv.second, kv.first % context_count, rowid_lookup_key));
+      worker_pool.submit(fragment_tasks, [dispatch, kv, context_count, rowid_lookup_key] {
+        dispatch(ExecutorDeviceType::GPU, kv.first, kv.second, kv.first % context_count, rowid_lookup_key);
+      });
     }
   } else {
+    // Small CPU fragments are run back to back by a single task, it isn't worth
+    // paying for the scheduling of a task for each of them.
+    struct FragmentDispatch {
+      ExecutorDeviceType device_type;
+      int device_id;
+      std::vector<std::pair<int, std::vector<size_t>>> frag_ids;
+      size_t ctx_idx;
+      int64_t rowid_lookup_key;
+    };
+    std::vector<FragmentDispatch> batch;
+    size_t batch_row_count{0};
+    auto submit_batch = [&worker_pool, &fragment_tasks, &dispatch, &batch, &batch_row_count] {
+      if (batch.empty()) {
+        return;
+      }
+      worker_pool.submit(fragment_tasks, [dispatch, batch] {
+        for (const auto& frag_dispatch : batch) {
+          dispatch(frag_dispatch.device_type,
+                   frag_dispatch.device_id,
+                   frag_dispatch.frag_ids,
+                   frag_dispatch.ctx_idx,
+                   frag_dispatch.rowid_lookup_key);
+        }
+      });
+      batch.clear();
+      batch_row_count = 0;
+    };
     for (size_t i = 0; i < outer_fragments->size(); ++i) {
       const auto& fragment = (*outer_fragments)[i];
-      const auto skip_frag = skipFragment(outer_table_desc, fragment, ra_exe_unit.simple_quals, execution_dispatch, i);
+      const auto skip_frag = skipFragment(
+          outer_table_desc, fragment, ra_exe_unit.simple_quals, inner_join_key_filters, execution_dispatch, i);
       if (skip_frag.first) {
         continue;
       }
@@ -1282,21 +1330,20 @@ void Executor::dispatchFragments(
       if (eo.with_watchdog && rowid_lookup_key < 0) {
         checkWorkUnitWatchdog(ra_exe_unit, *catalog_);
       }
-      query_threads.push_back(std::thread(dispatch,
-                                          chosen_device_type,
-                                          chosen_device_id,
-                                          frag_ids_for_table,
-                                          frag_list_idx % context_count,
-                                          rowid_lookup_key));
+      batch.push_back(
+          {chosen_device_type, chosen_device_id, frag_ids_for_table, frag_list_idx % context_count, rowid_lookup_key});
+      batch_row_count += fragment.getNumTuples();
+      if (device_type != ExecutorDeviceType::CPU || batch_row_count >= min_rows_per_fragment_task_) {
+        submit_batch();
+      }
       ++frag_list_idx;
       if (is_sample_query(ra_exe_unit) && fragment.getNumTuples() >= ra_exe_unit.scan_limit) {
         break;
       }
     }
+    submit_batch();
   }
-  for (auto& child : query_threads) {
-    child.join();
-  }
+  fragment_tasks.wait();
 }
 
 std::vector<size_t> Executor::getTableFragmentIndices(
@@ -1975,7 +2022,10 @@ int64_t insert_one_dict_str(T* col_data,
   } else {
     const int dict_id = cd->columnType.get_comp_param();
     const auto col_datum = col_cv->get_constval();
-    const auto& str = *col_datum.stringval;
+    // dictionary encoded numbers are keyed by their bits
+    const auto str = cd->columnType.is_dict_encoded_number()
+                         ? numeric_dict_key(numeric_dict_bits(col_datum, col_cv->get_type_info()))
+                         : *col_datum.stringval;
     const auto dd = catalog.getMetadataForDict(dict_id);
     CHECK(dd && dd->stringDict);
     int32_t str_id = dd->stringDict->getOrAdd(str);
@@ -1986,8 +2036,8 @@ int64_t insert_one_dict_str(T* col_data,
     const bool invalid = str_id > max_valid_int_value<T>();
     if (invalid || str_id == inline_int_null_value<int32_t>()) {
       if (invalid) {
-        LOG(ERROR) << "Could not encode string: " << str << ", the encoded value doesn't fit in " << sizeof(T) * 8
-                   << " bits. Will store NULL instead.";
+        LOG(ERROR) << "Could not encode " << (cd->columnType.is_string() ? "string: " + str : "value")
+                   << ", the encoded value doesn't fit in " << sizeof(T) * 8 << " bits. Will store NULL instead.";
       }
       str_id = inline_fixed_encoding_null_val(cd->columnType);
     }
@@ -1996,6 +2046,23 @@ int64_t insert_one_dict_str(T* col_data,
   return *col_data;
 }
 
+int64_t insert_one_dict_number(uint8_t* col_data_bytes,
+                               const ColumnDescriptor* cd,
+                               const Analyzer::Constant* col_cv,
+                               const Catalog_Namespace::Catalog& catalog) {
+  switch (cd->columnType.get_size()) {
+    case 1:
+      return insert_one_dict_str(col_data_bytes, cd, col_cv, catalog);
+    case 2:
+      return insert_one_dict_str(reinterpret_cast<uint16_t*>(col_data_bytes), cd, col_cv, catalog);
+    case 4:
+      return insert_one_dict_str(reinterpret_cast<int32_t*>(col_data_bytes), cd, col_cv, catalog);
+    default:
+      CHECK(false);
+  }
+  return 0;
+}
+
 }  // namespace
 
 void Executor::executeSimpleInsert(const Planner::RootPlan* root_plan) {
@@ -2083,12 +2150,23 @@ void Executor::executeSimpleInsert(const Planner::RootPlan* root_plan) {
         break;
       }
       case kINT: {
+        if (cd->columnType.is_dict_encoded_number()) {
+          // shards are picked by value, like the importer does
+          insert_one_dict_number(col_data_bytes, cd, col_cv, cat);
+          int_col_val = col_datum.intval;
+          break;
+        }
         auto col_data = reinterpret_cast<int32_t*>(col_data_bytes);
         *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType) : col_datum.intval;
         int_col_val = col_datum.intval;
         break;
       }
       case kBIGINT: {
+        if (cd->columnType.is_dict_encoded_number()) {
+          insert_one_dict_number(col_data_bytes, cd, col_cv, cat);
+          int_col_val = col_datum.bigintval;
+          break;
+        }
         auto col_data = reinterpret_cast<int64_t*>(col_data_bytes);
         *col_data = col_cv->get_is_null() ? inline_fixed_encoding_null_val(cd->columnType) : col_datum.bigintval;
         int_col_val = col_datum.bigintval;
@@ -2100,6 +2178,10 @@ void Executor::executeSimpleInsert(const Planner::RootPlan* root_plan) {
         break;
       }
       case kDOUBLE: {
+        if (cd->columnType.is_dict_encoded_number()) {
+          insert_one_dict_number(col_data_bytes, cd, col_cv, cat);
+          break;
+        }
         auto col_data = reinterpret_cast<double*>(col_data_bytes);
         *col_data = col_datum.doubleval;
         break;
@@ -2578,9 +2660,118 @@ int Executor::getLocalColumnId(const Analyzer::ColumnVar* col_var, const bool fe
   return it->second;
 }
 
+namespace {
+
+bool is_sketched_type(const SQLTypeInfo& ti) {
+  return ti.is_integer() || ti.is_time();
+}
+
+// True if none of the constants of an IN list on a column of the outer table can be in the fragment.
+bool in_values_miss_fragment(const Analyzer::InValues* in_values, const Fragmenter_Namespace::FragmentInfo& fragment) {
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(in_values->get_arg());
+  if (!col_var || !col_var->get_table_id() || col_var->get_rte_idx() || !is_sketched_type(col_var->get_type_info())) {
+    return false;
+  }
+  const auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_var->get_column_id());
+  if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+    return false;
+  }
+  const auto& chunk_metadata = chunk_meta_it->second;
+  const auto& chunk_type = col_var->get_type_info();
+  const auto chunk_min = extract_min_stat(chunk_metadata.chunkStats, chunk_type);
+  const auto chunk_max = extract_max_stat(chunk_metadata.chunkStats, chunk_type);
+  for (const auto& value : in_values->get_value_list()) {
+    const auto constant = dynamic_cast<const Analyzer::Constant*>(value.get());
+    if (!constant || !is_sketched_type(constant->get_type_info())) {
+      return false;
+    }
+    if (constant->get_is_null()) {
+      continue;
+    }
+    const auto val = extract_from_datum(constant->get_constval(), constant->get_type_info());
+    if (val >= chunk_min && val <= chunk_max &&
+        (!chunk_metadata.chunkSketch || chunk_metadata.chunkSketch->mayContain(val))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+std::vector<Executor::InnerJoinKeyFilter> Executor::getInnerJoinKeyFilters(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::map<int, const TableFragments*>& selected_tables_fragments) const {
+  std::list<std::shared_ptr<Analyzer::Expr>> join_quals;
+  if (ra_exe_unit.join_type == JoinType::INNER) {
+    join_quals = ra_exe_unit.inner_join_quals;
+  }
+  for (const auto& level_quals : ra_exe_unit.inner_joins) {
+    join_quals.insert(join_quals.end(), level_quals.begin(), level_quals.end());
+  }
+  std::vector<InnerJoinKeyFilter> filters;
+  for (const auto& join_qual : join_quals) {
+    // NULL never joins, unlike with a bitwise equality
+    const auto equals = std::dynamic_pointer_cast<const Analyzer::BinOper>(join_qual);
+    if (!equals || equals->get_optype() != kEQ) {
+      continue;
+    }
+    auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(equals->get_left_operand());
+    auto inner_col = dynamic_cast<const Analyzer::ColumnVar*>(equals->get_right_operand());
+    if (!outer_col || !inner_col) {
+      continue;
+    }
+    if (outer_col->get_rte_idx()) {
+      std::swap(outer_col, inner_col);
+    }
+    if (outer_col->get_rte_idx() || !outer_col->get_table_id() || !inner_col->get_rte_idx() ||
+        inner_col->get_table_id() <= 0 || !is_sketched_type(outer_col->get_type_info()) ||
+        !is_sketched_type(inner_col->get_type_info())) {
+      continue;
+    }
+    const auto inner_frags_it = selected_tables_fragments.find(inner_col->get_table_id());
+    if (inner_frags_it == selected_tables_fragments.end()) {
+      continue;
+    }
+    InnerJoinKeyFilter filter{outer_col->get_column_id(),
+                              outer_col->get_type_info(),
+                              std::numeric_limits<int64_t>::max(),
+                              std::numeric_limits<int64_t>::min(),
+                              nullptr};
+    auto sketch = std::make_shared<ChunkSketch>();
+    bool has_metadata{true};
+    for (const auto& inner_fragment : *inner_frags_it->second) {
+      const auto chunk_meta_it = inner_fragment.getChunkMetadataMap().find(inner_col->get_column_id());
+      if (chunk_meta_it == inner_fragment.getChunkMetadataMap().end()) {
+        has_metadata = false;
+        break;
+      }
+      const auto& chunk_metadata = chunk_meta_it->second;
+      if (!chunk_metadata.numElements) {
+        continue;
+      }
+      // all-null chunks have an empty range and don't widen the key range, NULL never joins
+      filter.min = std::min(filter.min, extract_min_stat(chunk_metadata.chunkStats, inner_col->get_type_info()));
+      filter.max = std::max(filter.max, extract_max_stat(chunk_metadata.chunkStats, inner_col->get_type_info()));
+      if (sketch && chunk_metadata.chunkSketch) {
+        sketch->unify(*chunk_metadata.chunkSketch);
+      } else {
+        sketch.reset();
+      }
+    }
+    if (!has_metadata) {
+      continue;
+    }
+    filter.sketch = sketch;
+    filters.push_back(filter);
+  }
+  return filters;
+}
+
 std::pair<bool, int64_t> Executor::skipFragment(const InputDescriptor& table_desc,
                                                 const Fragmenter_Namespace::FragmentInfo& fragment,
                                                 const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals,
+                                                const std::vector<InnerJoinKeyFilter>& inner_join_key_filters,
                                                 const ExecutionDispatch& execution_dispatch,
                                                 const size_t frag_idx) {
   const int table_id = table_desc.getTableId();
@@ -2588,6 +2779,28 @@ std::pair<bool, int64_t> Executor::skipFragment(const InputDescriptor& table_des
       boost::get<IterTabPtr>(&get_temporary_table(temporary_tables_, table_id))) {
     return {false, -1};
   }
+  for (const auto& qual : execution_dispatch.getExecutionUnit().quals) {
+    const auto in_values = dynamic_cast<const Analyzer::InValues*>(qual.get());
+    if (in_values && in_values_miss_fragment(in_values, fragment)) {
+      return {true, -1};
+    }
+  }
+  for (const auto& join_key_filter : inner_join_key_filters) {
+    const auto chunk_meta_it = fragment.getChunkMetadataMap().find(join_key_filter.outer_col_id);
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+      continue;
+    }
+    const auto& chunk_metadata = chunk_meta_it->second;
+    const auto chunk_min = extract_min_stat(chunk_metadata.chunkStats, join_key_filter.outer_col_type);
+    const auto chunk_max = extract_max_stat(chunk_metadata.chunkStats, join_key_filter.outer_col_type);
+    if (chunk_max < join_key_filter.min || chunk_min > join_key_filter.max) {
+      return {true, -1};
+    }
+    if (join_key_filter.sketch && chunk_metadata.chunkSketch &&
+        !chunk_metadata.chunkSketch->mayIntersect(*join_key_filter.sketch)) {
+      return {true, -1};
+    }
+  }
   for (const auto simple_qual : simple_quals) {
     const auto comp_expr = std::dynamic_pointer_cast<const Analyzer::BinOper>(simple_qual);
     if (!comp_expr) {
@@ -2655,6 +2868,8 @@ std::pair<bool, int64_t> Executor::skipFragment(const InputDescriptor& table_des
           return {true, -1};
         } else if (is_rowid) {
           return {false, rhs_val - start_rowid};
+        } else if (chunk_meta_it->second.chunkSketch && !chunk_meta_it->second.chunkSketch->mayContain(rhs_val)) {
+          return {true, -1};
         }
         break;
       default:
@@ -2664,6 +2879,11 @@ std::pair<bool, int64_t> Executor::skipFragment(const InputDescriptor& table_des
   return {false, -1};
 }
 
-std::map<std::pair<int, ::QueryRenderer::QueryRenderManager*>, std::shared_ptr<Executor>> Executor::executors_;
-std::mutex Executor::execute_mutex_;
+std::map<std::pair<int, ::QueryRenderer::QueryRenderManager*>, std::vector<std::shared_ptr<Executor>>>
+    Executor::executors_;
 mapd_shared_mutex Executor::executors_cache_mutex_;
+std::mutex Executor::compilation_mutex_;
+std::mutex Executor::gpu_exec_mutex_[max_gpu_count];
+std::unique_ptr<llvm::TargetMachine> Executor::nvptx_target_machine_;
+CodeCache Executor::cpu_code_cache_;
+CodeCache Executor::gpu_code_cache_;
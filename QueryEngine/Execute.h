@@ -20,6 +20,7 @@
 #include "AggregatedColRange.h"
 #include "BufferCompaction.h"
 #include "CartesianProduct.h"
+#include "CodeCache.h"
 #include "GroupByAndAggregate.h"
 #include "IRCodegenUtils.h"
 #include "InValuesBitmap.h"
@@ -28,6 +29,7 @@
 #include "LLVMGlobalContext.h"
 #include "LoopControlFlow/JoinLoop.h"
 #include "NvidiaKernel.h"
+#include "QueryAdmission.h"
 #include "RelAlgExecutionUnit.h"
 #include "StringDictionaryGenerations.h"
 #include "TableGenerations.h"
@@ -39,6 +41,7 @@
 #include "../Shared/MapDParameters.h"
 #include "../Shared/measure.h"
 #include "../Shared/thread_count.h"
+#include "../StringDictionary/NumericDictionary.h"
 #include "../StringDictionary/StringDictionary.h"
 #include "../StringDictionary/StringDictionaryProxy.h"
 
@@ -128,7 +131,8 @@ inline const Analyzer::Expr* extract_cast_arg(const Analyzer::Expr* expr) {
 inline std::string numeric_type_name(const SQLTypeInfo& ti) {
   CHECK(ti.is_integer() || ti.is_decimal() || ti.is_boolean() || ti.is_time() || ti.is_fp() ||
         (ti.is_string() && ti.get_compression() == kENCODING_DICT) || ti.is_timeinterval());
-  if (ti.is_integer() || ti.is_decimal() || ti.is_boolean() || ti.is_time() || ti.is_string() || ti.is_timeinterval()) {
+  if (ti.is_integer() || ti.is_decimal() || ti.is_boolean() || ti.is_time() || ti.is_string() || ti.is_timeinterval() ||
+      ti.is_dict_encoded_number()) {
     return "int" + std::to_string(ti.get_logical_size() * 8) + "_t";
   }
   return ti.get_type() == kDOUBLE ? "double" : "float";
@@ -263,11 +267,20 @@ class Executor {
                                                ::QueryRenderer::QueryRenderManager* render_manager = nullptr);
 
   static void nukeCacheOfExecutors() {
-    std::lock_guard<std::mutex> flush_lock(execute_mutex_);  // don't want native code to vanish while executing
+    std::lock_guard<std::mutex> flush_lock(compilation_mutex_);  // don't want native code to vanish while compiling
     mapd_unique_lock<mapd_shared_mutex> lock(executors_cache_mutex_);
     (decltype(executors_){}).swap(executors_);
+    cpu_code_cache_.clear();
+    gpu_code_cache_.clear();
   }
 
+  static CodeCache::Stats getCodeCacheStats(const ExecutorDeviceType device_type) {
+    return device_type == ExecutorDeviceType::GPU ? gpu_code_cache_.getStats() : cpu_code_cache_.getStats();
+  }
+
+  // Interrupts the queries running on all the executors for the given database.
+  static void interruptExecutors(const int db_id);
+
   typedef std::tuple<std::string, const Analyzer::Expr*, int64_t, const size_t> AggInfo;
 
   std::shared_ptr<ResultSet> execute(const Planner::RootPlan* root_plan,
@@ -492,6 +505,11 @@ class Executor {
                            const SQLTypeInfo& ti,
                            const bool operand_is_const,
                            const CompilationOptions& co);
+  llvm::Value* codegenCastDictEncodedNumber(llvm::Value* operand_lv,
+                                            const SQLTypeInfo& operand_ti,
+                                            const SQLTypeInfo& ti,
+                                            const bool operand_is_const,
+                                            const CompilationOptions& co);
   llvm::Value* codegenCastTimestampToDate(llvm::Value* ts_lv, const bool nullable);
   llvm::Value* codegenCastFromString(llvm::Value* operand_lv,
                                      const SQLTypeInfo& operand_ti,
@@ -567,6 +585,7 @@ class Executor {
     QueryMemoryDescriptor query_mem_desc;
     bool output_columnar;
     std::string llvm_ir;
+    std::shared_ptr<CodeCacheEntry> native_code_owner;  // keeps native_functions alive if evicted from the cache
   };
 
   bool isArchPascal(const ExecutorDeviceType dt) const {
@@ -1002,18 +1021,18 @@ class Executor {
                     const JoinInfo& join_info,
                     const std::vector<InputTableInfo>& query_infos,
                     const std::list<std::shared_ptr<Analyzer::Expr>>& outer_join_quals);
-  std::vector<std::pair<void*, void*>> optimizeAndCodegenCPU(llvm::Function*,
-                                                             llvm::Function*,
-                                                             std::unordered_set<llvm::Function*>&,
-                                                             llvm::Module*,
-                                                             const CompilationOptions&);
-  std::vector<std::pair<void*, void*>> optimizeAndCodegenGPU(llvm::Function*,
-                                                             llvm::Function*,
-                                                             std::unordered_set<llvm::Function*>&,
-                                                             llvm::Module*,
-                                                             const bool no_inline,
-                                                             const CudaMgr_Namespace::CudaMgr* cuda_mgr,
-                                                             const CompilationOptions&);
+  std::shared_ptr<CodeCacheEntry> optimizeAndCodegenCPU(llvm::Function*,
+                                                        llvm::Function*,
+                                                        std::unordered_set<llvm::Function*>&,
+                                                        llvm::Module*,
+                                                        const CompilationOptions&);
+  std::shared_ptr<CodeCacheEntry> optimizeAndCodegenGPU(llvm::Function*,
+                                                        llvm::Function*,
+                                                        std::unordered_set<llvm::Function*>&,
+                                                        llvm::Module*,
+                                                        const bool no_inline,
+                                                        const CudaMgr_Namespace::CudaMgr* cuda_mgr,
+                                                        const CompilationOptions&);
   std::string generatePTX(const std::string&) const;
   void initializeNVPTXBackend() const;
 
@@ -1044,22 +1063,33 @@ class Executor {
   void allocateLocalColumnIds(const std::list<std::shared_ptr<const InputColDescriptor>>& global_col_ids);
   int getLocalColumnId(const Analyzer::ColumnVar* col_var, const bool fetch_column) const;
 
+  // Range and Bloom filter of the values an equi-join key takes in the selected fragments of the inner table.
+  struct InnerJoinKeyFilter {
+    int outer_col_id;
+    SQLTypeInfo outer_col_type;
+    int64_t min;
+    int64_t max;
+    std::shared_ptr<const ChunkSketch> sketch;  // null unless all the inner chunks have one
+  };
+
+  std::vector<InnerJoinKeyFilter> getInnerJoinKeyFilters(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::map<int, const TableFragments*>& selected_tables_fragments) const;
+
   std::pair<bool, int64_t> skipFragment(const InputDescriptor& table_desc,
                                         const Fragmenter_Namespace::FragmentInfo& frag_info,
                                         const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals,
+                                        const std::vector<InnerJoinKeyFilter>& inner_join_key_filters,
                                         const ExecutionDispatch& execution_dispatch,
                                         const size_t frag_idx);
 
-  typedef std::vector<std::string> CodeCacheKey;
-  typedef std::vector<std::tuple<void*, std::unique_ptr<llvm::ExecutionEngine>, std::unique_ptr<GpuCompilationContext>>>
-      CodeCacheVal;
-  std::vector<std::pair<void*, void*>> getCodeFromCache(
+  std::shared_ptr<CodeCacheEntry> getCodeFromCache(const CodeCacheKey&, CodeCache&);
+  std::shared_ptr<CodeCacheEntry> addCodeToCache(
       const CodeCacheKey&,
-      const std::map<CodeCacheKey, std::pair<CodeCacheVal, llvm::Module*>>&);
-  void addCodeToCache(const CodeCacheKey&,
-                      const std::vector<std::tuple<void*, llvm::ExecutionEngine*, GpuCompilationContext*>>&,
-                      llvm::Module*,
-                      std::map<CodeCacheKey, std::pair<CodeCacheVal, llvm::Module*>>&);
+      const std::vector<std::tuple<void*, llvm::ExecutionEngine*, GpuCompilationContext*>>&,
+      llvm::Module*,
+      const int64_t compile_time_ms,
+      CodeCache&);
 
   std::vector<int8_t> serializeLiterals(const std::unordered_map<int, Executor::LiteralValues>& literals,
                                         const int device_id);
@@ -1114,6 +1144,14 @@ class Executor {
                            const int dict_id,
                            const int device_id) {
       const auto& ti = constant->get_type_info();
+      if (ti.is_number() && enc_type == kENCODING_DICT) {
+        // the id of the value in the dictionary of a numeric column, resolved like a string literal
+        if (constant->get_is_null()) {
+          return getOrAddLiteral(int32_t(inline_int_null_value<int32_t>()), device_id);
+        }
+        return getOrAddLiteral(
+            std::make_pair(numeric_dict_key(numeric_dict_bits(constant->get_constval(), ti)), dict_id), device_id);
+      }
       const auto type = ti.is_decimal() ? decimal_to_int_type(ti) : ti.get_type();
       switch (type) {
         case kBOOLEAN:
@@ -1204,6 +1242,8 @@ class Executor {
     }
 
     llvm::Module* module_;
+    // the cache entry module_ belongs to once the code is native, eviction can't free the module under the query
+    std::shared_ptr<CodeCacheEntry> module_owner_;
     llvm::Function* row_func_;
     std::vector<llvm::Function*> helper_functions_;
     llvm::LLVMContext& context_;
@@ -1333,8 +1373,11 @@ class Executor {
 
   bool is_nested_;
 
+  // serializes queries which share this executor's code generation and plan state
+  std::mutex execute_mutex_;
+
   static const int max_gpu_count{16};
-  std::mutex gpu_exec_mutex_[max_gpu_count];
+  static std::mutex gpu_exec_mutex_[max_gpu_count];
 
   mutable std::mutex gpu_active_modules_mutex_;
   mutable uint32_t gpu_active_modules_device_mask_;
@@ -1344,15 +1387,20 @@ class Executor {
   mutable std::shared_ptr<StringDictionaryProxy> lit_str_dict_proxy_;
   mutable std::mutex str_dict_mutex_;
 
-  mutable std::unique_ptr<llvm::TargetMachine> nvptx_target_machine_;
+  static std::unique_ptr<llvm::TargetMachine> nvptx_target_machine_;
+
+  // The LLVM context is shared by all executors, only one query can generate code at a time.
+  // It also guards the code caches and the NVPTX target machine.
+  static std::mutex compilation_mutex_;
 
-  std::map<CodeCacheKey, std::pair<CodeCacheVal, llvm::Module*>> cpu_code_cache_;
-  std::map<CodeCacheKey, std::pair<CodeCacheVal, llvm::Module*>> gpu_code_cache_;
+  static CodeCache cpu_code_cache_;
+  static CodeCache gpu_code_cache_;
 
   ::QueryRenderer::QueryRenderManager* render_manager_;
 
   const size_t small_groups_buffer_entry_count_{512};
   static const size_t baseline_threshold{1000000};  // if a perfect hash needs more entries, use baseline
+  static const size_t min_rows_per_fragment_task_{1000000};  // smaller CPU fragments share a worker pool task
 
   const unsigned block_size_x_;
   const unsigned grid_size_x_;
@@ -1368,8 +1416,10 @@ class Executor {
   StringDictionaryGenerations string_dictionary_generations_;
   TableGenerations table_generations_;
 
-  static std::map<std::pair<int, ::QueryRenderer::QueryRenderManager*>, std::shared_ptr<Executor>> executors_;
-  static std::mutex execute_mutex_;
+  // Executors which aren't referenced outside of the cache are handed out to new queries,
+  // so concurrent queries on the same database get their own executor.
+  static std::map<std::pair<int, ::QueryRenderer::QueryRenderManager*>, std::vector<std::shared_ptr<Executor>>>
+      executors_;
   static mapd_shared_mutex executors_cache_mutex_;
 
   static const int32_t ERR_DIV_BY_ZERO{1};
@@ -19,6 +19,7 @@
 #include "ExecutionException.h"
 
 #include "DataMgr/BufferMgr/BufferMgr.h"
+#include "../Shared/BitPacking.h"
 
 #include <numeric>
 
@@ -848,7 +849,31 @@ std::pair<const int8_t*, size_t> Executor::ExecutionDispatch::getColumnFragment(
   const auto cd = get_column_descriptor_maybe(hash_col.get_column_id(), hash_col.get_table_id(), catalog);
   CHECK(!cd || !(cd->isVirtualCol));
   const int8_t* col_buff = nullptr;
-  if (cd) {
+  if (cd && cd->columnType.get_compression() == kENCODING_PACKED) {
+    // hash tables are built from fixed width values, unpack the chunk on the host
+    ChunkKey chunk_key{
+        catalog.get_currentDB().dbId, fragment.physicalTableId, hash_col.get_column_id(), fragment.fragmentId};
+    const auto chunk = Chunk_NS::Chunk::getChunk(cd,
+                                                 &catalog.get_dataMgr(),
+                                                 chunk_key,
+                                                 Data_Namespace::CPU_LEVEL,
+                                                 0,
+                                                 chunk_meta_it->second.numBytes,
+                                                 chunk_meta_it->second.numElements);
+    CHECK(chunk);
+    const auto elem_count = chunk_meta_it->second.numElements;
+    const auto slot_size = cd->columnType.get_size();
+    auto unpacked = reinterpret_cast<int8_t*>(checked_malloc(elem_count * slot_size));
+    executor->row_set_mem_owner_->addColBuffer(unpacked);
+    unpack_bits(
+        chunk->get_buffer()->getMemoryPtr(), cd->columnType.get_comp_param(), 0, elem_count, unpacked, slot_size);
+    col_buff = unpacked;
+    if (effective_mem_lvl == Data_Namespace::GPU_LEVEL) {
+      auto gpu_col_buff = alloc_gpu_mem(&catalog.get_dataMgr(), elem_count * slot_size, device_id, nullptr);
+      copy_to_gpu(&catalog.get_dataMgr(), gpu_col_buff, unpacked, elem_count * slot_size, device_id);
+      col_buff = reinterpret_cast<const int8_t*>(gpu_col_buff);
+    }
+  } else if (cd) {
     ChunkKey chunk_key{
         catalog.get_currentDB().dbId, fragment.physicalTableId, hash_col.get_column_id(), fragment.fragmentId};
     const auto chunk = Chunk_NS::Chunk::getChunk(cd,
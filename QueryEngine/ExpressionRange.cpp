@@ -352,7 +352,9 @@ ExpressionRange getLeafColumnRange(const Analyzer::ColumnVar* col_expr,
   int col_id = col_expr->get_column_id();
   const auto& col_phys_ti =
       col_expr->get_type_info().is_array() ? col_expr->get_type_info().get_elem_type() : col_expr->get_type_info();
-  const auto col_ti = get_logical_type_info(col_phys_ti);
+  // the stats of dictionary encoded numbers are those of the ids
+  const auto col_ti =
+      col_phys_ti.is_dict_encoded_number() ? SQLTypeInfo(kINT, false) : get_logical_type_info(col_phys_ti);
   switch (col_ti.get_type()) {
     case kTEXT:
     case kCHAR:
@@ -509,6 +511,24 @@ ExpressionRange getExpressionRange(const Analyzer::UOper* u_expr,
     return ExpressionRange::makeInvalidRange();
   }
   const auto& ti = u_expr->get_type_info();
+  if (ti.is_dict_encoded_number()) {
+    const auto sdp = executor->getStringDictionaryProxy(ti.get_comp_param(), executor->getRowSetMemoryOwner(), true);
+    CHECK(sdp);
+    const auto const_operand = dynamic_cast<const Analyzer::Constant*>(u_expr->get_operand());
+    if (!const_operand) {
+      return ExpressionRange::makeInvalidRange();
+    }
+    if (const_operand->get_is_null()) {
+      return ExpressionRange::makeIntRange(0, -1, 0, true);
+    }
+    const int64_t v = sdp->getIdOfString(
+        numeric_dict_key(numeric_dict_bits(const_operand->get_constval(), const_operand->get_type_info())));
+    return ExpressionRange::makeIntRange(v, v, 0, false);
+  }
+  if (u_expr->get_operand()->get_type_info().is_dict_encoded_number()) {
+    // ranges of dictionary encoded numbers are those of the ids
+    return ExpressionRange::makeInvalidRange();
+  }
   if (ti.is_string() && ti.get_compression() == kENCODING_DICT) {
     const auto sdp = executor->getStringDictionaryProxy(ti.get_comp_param(), executor->getRowSetMemoryOwner(), true);
     CHECK(sdp);
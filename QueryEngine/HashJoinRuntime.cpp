@@ -62,12 +62,25 @@ DEVICE void SUFFIX(init_hash_join_buff)(int32_t* groups_buffer,
 #define mapd_cas(address, compare, val) __sync_val_compare_and_swap(address, compare, val)
 #endif
 
+// Returns -1, the invalid string id, if the outer dictionary doesn't have the string or its id
+// is out of the range of the hash table, in which case no outer row can match it.
+DEVICE FORCE_INLINE int64_t SUFFIX(translate_str_id_to_outer_dict)(const int64_t elem,
+                                                                    const JoinColumnTypeInfo& type_info,
+                                                                    const int32_t* sd_inner_to_outer_translation_map,
+                                                                    const int32_t min_inner_elem) {
+  const int64_t outer_id = sd_inner_to_outer_translation_map[elem - min_inner_elem];
+  if (outer_id < type_info.min_val || outer_id >= type_info.translated_null_val) {
+    return -1;
+  }
+  return outer_id;
+}
+
 DEVICE int SUFFIX(fill_hash_join_buff)(int32_t* buff,
                                        const int32_t invalid_slot_val,
                                        const JoinColumn join_column,
                                        const JoinColumnTypeInfo type_info,
-                                       const void* sd_inner_proxy,
-                                       const void* sd_outer_proxy,
+                                       const int32_t* sd_inner_to_outer_translation_map,
+                                       const int32_t min_inner_elem,
                                        const int32_t cpu_thread_idx,
                                        const int32_t cpu_thread_count) {
 #ifdef __CUDACC__
@@ -88,19 +101,14 @@ DEVICE int SUFFIX(fill_hash_join_buff)(int32_t* buff,
         continue;
       }
     }
-#ifndef __CUDACC__
-    if (sd_inner_proxy && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      CHECK(sd_outer_proxy);
-      const auto sd_inner_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
-      const auto sd_outer_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-      const auto elem_str = sd_inner_dict_proxy->getString(elem);
-      const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
-      if (outer_id == StringDictionary::INVALID_STR_ID) {
+    if (sd_inner_to_outer_translation_map && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
+      const auto outer_id = SUFFIX(translate_str_id_to_outer_dict)(
+          elem, type_info, sd_inner_to_outer_translation_map, min_inner_elem);
+      if (outer_id == -1) {
         continue;
       }
       elem = outer_id;
     }
-#endif
     int32_t* entry_ptr = SUFFIX(get_hash_slot)(buff, elem, type_info.min_val);
     if (mapd_cas(entry_ptr, invalid_slot_val, i) != invalid_slot_val) {
       return -1;
@@ -114,8 +122,8 @@ DEVICE int SUFFIX(fill_hash_join_buff_sharded)(int32_t* buff,
                                                const JoinColumn join_column,
                                                const JoinColumnTypeInfo type_info,
                                                const ShardInfo shard_info,
-                                               const void* sd_inner_proxy,
-                                               const void* sd_outer_proxy,
+                                               const int32_t* sd_inner_to_outer_translation_map,
+                                               const int32_t min_inner_elem,
                                                const int32_t cpu_thread_idx,
                                                const int32_t cpu_thread_count) {
 #ifdef __CUDACC__
@@ -139,19 +147,14 @@ DEVICE int SUFFIX(fill_hash_join_buff_sharded)(int32_t* buff,
         continue;
       }
     }
-#ifndef __CUDACC__
-    if (sd_inner_proxy && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      CHECK(sd_outer_proxy);
-      const auto sd_inner_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
-      const auto sd_outer_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-      const auto elem_str = sd_inner_dict_proxy->getString(elem);
-      const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
-      if (outer_id == StringDictionary::INVALID_STR_ID) {
+    if (sd_inner_to_outer_translation_map && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
+      const auto outer_id = SUFFIX(translate_str_id_to_outer_dict)(
+          elem, type_info, sd_inner_to_outer_translation_map, min_inner_elem);
+      if (outer_id == -1) {
         continue;
       }
       elem = outer_id;
     }
-#endif
     int32_t* entry_ptr = SUFFIX(get_hash_slot_sharded)(buff,
                                                        elem,
                                                        type_info.min_val,
@@ -383,11 +386,11 @@ DEVICE int SUFFIX(fill_baseline_hash_join_buff)(int8_t* hash_buff,
 GLOBAL void SUFFIX(count_matches)(int32_t* count_buff,
                                   const int32_t invalid_slot_val,
                                   const JoinColumn join_column,
-                                  const JoinColumnTypeInfo type_info
+                                  const JoinColumnTypeInfo type_info,
+                                  const int32_t* sd_inner_to_outer_translation_map,
+                                  const int32_t min_inner_elem
 #ifndef __CUDACC__
                                   ,
-                                  const void* sd_inner_proxy,
-                                  const void* sd_outer_proxy,
                                   const int32_t cpu_thread_idx,
                                   const int32_t cpu_thread_count
 #endif
@@ -410,19 +413,14 @@ GLOBAL void SUFFIX(count_matches)(int32_t* count_buff,
         continue;
       }
     }
-#ifndef __CUDACC__
-    if (sd_inner_proxy && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      CHECK(sd_outer_proxy);
-      const auto sd_inner_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
-      const auto sd_outer_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-      const auto elem_str = sd_inner_dict_proxy->getString(elem);
-      const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
-      if (outer_id == StringDictionary::INVALID_STR_ID) {
+    if (sd_inner_to_outer_translation_map && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
+      const auto outer_id = SUFFIX(translate_str_id_to_outer_dict)(
+          elem, type_info, sd_inner_to_outer_translation_map, min_inner_elem);
+      if (outer_id == -1) {
         continue;
       }
       elem = outer_id;
     }
-#endif
     int32_t* entry_ptr = SUFFIX(get_hash_slot)(count_buff, elem, type_info.min_val);
     mapd_add(entry_ptr, int32_t(1));
   }
@@ -432,11 +430,11 @@ GLOBAL void SUFFIX(count_matches_sharded)(int32_t* count_buff,
                                           const int32_t invalid_slot_val,
                                           const JoinColumn join_column,
                                           const JoinColumnTypeInfo type_info,
-                                          const ShardInfo shard_info
+                                          const ShardInfo shard_info,
+                                          const int32_t* sd_inner_to_outer_translation_map,
+                                          const int32_t min_inner_elem
 #ifndef __CUDACC__
                                           ,
-                                          const void* sd_inner_proxy,
-                                          const void* sd_outer_proxy,
                                           const int32_t cpu_thread_idx,
                                           const int32_t cpu_thread_count
 #endif
@@ -459,19 +457,14 @@ GLOBAL void SUFFIX(count_matches_sharded)(int32_t* count_buff,
         continue;
       }
     }
-#ifndef __CUDACC__
-    if (sd_inner_proxy && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      CHECK(sd_outer_proxy);
-      const auto sd_inner_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
-      const auto sd_outer_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-      const auto elem_str = sd_inner_dict_proxy->getString(elem);
-      const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
-      if (outer_id == StringDictionary::INVALID_STR_ID) {
+    if (sd_inner_to_outer_translation_map && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
+      const auto outer_id = SUFFIX(translate_str_id_to_outer_dict)(
+          elem, type_info, sd_inner_to_outer_translation_map, min_inner_elem);
+      if (outer_id == -1) {
         continue;
       }
       elem = outer_id;
     }
-#endif
     int32_t* entry_ptr = SUFFIX(get_hash_slot_sharded)(count_buff,
                                                        elem,
                                                        type_info.min_val,
@@ -581,11 +574,11 @@ GLOBAL void SUFFIX(fill_row_ids)(int32_t* buff,
                                  const int32_t hash_entry_count,
                                  const int32_t invalid_slot_val,
                                  const JoinColumn join_column,
-                                 const JoinColumnTypeInfo type_info
+                                 const JoinColumnTypeInfo type_info,
+                                 const int32_t* sd_inner_to_outer_translation_map,
+                                 const int32_t min_inner_elem
 #ifndef __CUDACC__
                                  ,
-                                 const void* sd_inner_proxy,
-                                 const void* sd_outer_proxy,
                                  const int32_t cpu_thread_idx,
                                  const int32_t cpu_thread_count
 #endif
@@ -612,19 +605,14 @@ GLOBAL void SUFFIX(fill_row_ids)(int32_t* buff,
         continue;
       }
     }
-#ifndef __CUDACC__
-    if (sd_inner_proxy && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      CHECK(sd_outer_proxy);
-      const auto sd_inner_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
-      const auto sd_outer_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-      const auto elem_str = sd_inner_dict_proxy->getString(elem);
-      const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
-      if (outer_id == StringDictionary::INVALID_STR_ID) {
+    if (sd_inner_to_outer_translation_map && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
+      const auto outer_id = SUFFIX(translate_str_id_to_outer_dict)(
+          elem, type_info, sd_inner_to_outer_translation_map, min_inner_elem);
+      if (outer_id == -1) {
         continue;
       }
       elem = outer_id;
     }
-#endif
     int32_t* pos_ptr = SUFFIX(get_hash_slot)(pos_buff, elem, type_info.min_val);
 #ifndef __CUDACC__
     CHECK_NE(*pos_ptr, invalid_slot_val);
@@ -640,11 +628,11 @@ GLOBAL void SUFFIX(fill_row_ids_sharded)(int32_t* buff,
                                          const int32_t invalid_slot_val,
                                          const JoinColumn join_column,
                                          const JoinColumnTypeInfo type_info,
-                                         const ShardInfo shard_info
+                                         const ShardInfo shard_info,
+                                         const int32_t* sd_inner_to_outer_translation_map,
+                                         const int32_t min_inner_elem
 #ifndef __CUDACC__
                                          ,
-                                         const void* sd_inner_proxy,
-                                         const void* sd_outer_proxy,
                                          const int32_t cpu_thread_idx,
                                          const int32_t cpu_thread_count
 #endif
@@ -671,19 +659,14 @@ GLOBAL void SUFFIX(fill_row_ids_sharded)(int32_t* buff,
         continue;
       }
     }
-#ifndef __CUDACC__
-    if (sd_inner_proxy && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      CHECK(sd_outer_proxy);
-      const auto sd_inner_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
-      const auto sd_outer_dict_proxy = static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-      const auto elem_str = sd_inner_dict_proxy->getString(elem);
-      const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
-      if (outer_id == StringDictionary::INVALID_STR_ID) {
+    if (sd_inner_to_outer_translation_map && (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
+      const auto outer_id = SUFFIX(translate_str_id_to_outer_dict)(
+          elem, type_info, sd_inner_to_outer_translation_map, min_inner_elem);
+      if (outer_id == -1) {
         continue;
       }
       elem = outer_id;
     }
-#endif
     int32_t* pos_ptr = SUFFIX(get_hash_slot_sharded)(pos_buff,
                                                      elem,
                                                      type_info.min_val,
@@ -897,8 +880,8 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                  const int32_t invalid_slot_val,
                                  const JoinColumn& join_column,
                                  const JoinColumnTypeInfo& type_info,
-                                 const void* sd_inner_proxy,
-                                 const void* sd_outer_proxy,
+                                 const int32_t* sd_inner_to_outer_translation_map,
+                                 const int32_t min_inner_elem,
                                  const int32_t cpu_thread_count) {
   int32_t* pos_buff = buff;
   int32_t* count_buff = buff + hash_entry_count;
@@ -911,8 +894,8 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                          invalid_slot_val,
                                          join_column,
                                          type_info,
-                                         sd_inner_proxy,
-                                         sd_outer_proxy,
+                                         sd_inner_to_outer_translation_map,
+                                         min_inner_elem,
                                          cpu_thread_idx,
                                          cpu_thread_count));
   }
@@ -955,8 +938,8 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                        invalid_slot_val,
                                        std::ref(join_column),
                                        std::ref(type_info),
-                                       sd_inner_proxy,
-                                       sd_outer_proxy,
+                                       sd_inner_to_outer_translation_map,
+                                       min_inner_elem,
                                        cpu_thread_idx,
                                        cpu_thread_count));
   }
@@ -972,8 +955,8 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                          const JoinColumn& join_column,
                                          const JoinColumnTypeInfo& type_info,
                                          const ShardInfo& shard_info,
-                                         const void* sd_inner_proxy,
-                                         const void* sd_outer_proxy,
+                                         const int32_t* sd_inner_to_outer_translation_map,
+                                         const int32_t min_inner_elem,
                                          const int32_t cpu_thread_count) {
   int32_t* pos_buff = buff;
   int32_t* count_buff = buff + hash_entry_count;
@@ -987,8 +970,8 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                          std::ref(join_column),
                                          std::ref(type_info),
                                          std::ref(shard_info),
-                                         sd_inner_proxy,
-                                         sd_outer_proxy,
+                                         sd_inner_to_outer_translation_map,
+                                         min_inner_elem,
                                          cpu_thread_idx,
                                          cpu_thread_count));
   }
@@ -1028,8 +1011,8 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                        std::ref(join_column),
                                        std::ref(type_info),
                                        std::ref(shard_info),
-                                       sd_inner_proxy,
-                                       sd_outer_proxy,
+                                       sd_inner_to_outer_translation_map,
+                                       min_inner_elem,
                                        cpu_thread_idx,
                                        cpu_thread_count));
   }
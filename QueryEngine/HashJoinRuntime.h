@@ -92,8 +92,8 @@ int fill_hash_join_buff(int32_t* buff,
                         const int32_t invalid_slot_val,
                         const JoinColumn join_column,
                         const JoinColumnTypeInfo type_info,
-                        const void* sd_inner,
-                        const void* sd_outer,
+                        const int32_t* sd_inner_to_outer_translation_map,
+                        const int32_t min_inner_elem,
                         const int32_t cpu_thread_idx,
                         const int32_t cpu_thread_count);
 
@@ -102,6 +102,8 @@ void fill_hash_join_buff_on_device(int32_t* buff,
                                    int* dev_err_buff,
                                    const JoinColumn join_column,
                                    const JoinColumnTypeInfo type_info,
+                                   const int32_t* sd_inner_to_outer_translation_map,
+                                   const int32_t min_inner_elem,
                                    const size_t block_size_x,
                                    const size_t grid_size_x);
 
@@ -118,6 +120,8 @@ void fill_hash_join_buff_on_device_sharded(int32_t* buff,
                                            const JoinColumn join_column,
                                            const JoinColumnTypeInfo type_info,
                                            const ShardInfo shard_info,
+                                           const int32_t* sd_inner_to_outer_translation_map,
+                                           const int32_t min_inner_elem,
                                            const size_t block_size_x,
                                            const size_t grid_size_x);
 
@@ -126,8 +130,8 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                  const int32_t invalid_slot_val,
                                  const JoinColumn& join_column,
                                  const JoinColumnTypeInfo& type_info,
-                                 const void* sd_inner_proxy,
-                                 const void* sd_outer_proxy,
+                                 const int32_t* sd_inner_to_outer_translation_map,
+                                 const int32_t min_inner_elem,
                                  const int32_t cpu_thread_count);
 
 void fill_one_to_many_hash_table_sharded(int32_t* buff,
@@ -136,8 +140,8 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                          const JoinColumn& join_column,
                                          const JoinColumnTypeInfo& type_info,
                                          const ShardInfo& shard_info,
-                                         const void* sd_inner_proxy,
-                                         const void* sd_outer_proxy,
+                                         const int32_t* sd_inner_to_outer_translation_map,
+                                         const int32_t min_inner_elem,
                                          const int32_t cpu_thread_count);
 
 void fill_one_to_many_hash_table_on_device(int32_t* buff,
@@ -145,6 +149,8 @@ void fill_one_to_many_hash_table_on_device(int32_t* buff,
                                            const int32_t invalid_slot_val,
                                            const JoinColumn& join_column,
                                            const JoinColumnTypeInfo& type_info,
+                                           const int32_t* sd_inner_to_outer_translation_map,
+                                           const int32_t min_inner_elem,
                                            const size_t block_size_x,
                                            const size_t grid_size_x);
 
@@ -154,6 +160,8 @@ void fill_one_to_many_hash_table_on_device_sharded(int32_t* buff,
                                                    const JoinColumn& join_column,
                                                    const JoinColumnTypeInfo& type_info,
                                                    const ShardInfo& shard_info,
+                                                   const int32_t* sd_inner_to_outer_translation_map,
+                                                   const int32_t min_inner_elem,
                                                    const size_t block_size_x,
                                                    const size_t grid_size_x);
 
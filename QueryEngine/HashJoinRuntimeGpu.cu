@@ -22,8 +22,11 @@ __global__ void fill_hash_join_buff_wrapper(int32_t* buff,
                                             const int32_t invalid_slot_val,
                                             const JoinColumn join_column,
                                             const JoinColumnTypeInfo type_info,
+                                            const int32_t* sd_inner_to_outer_translation_map,
+                                            const int32_t min_inner_elem,
                                             int* err) {
-  int partial_err = SUFFIX(fill_hash_join_buff)(buff, invalid_slot_val, join_column, type_info, NULL, NULL, -1, -1);
+  int partial_err = SUFFIX(fill_hash_join_buff)(
+      buff, invalid_slot_val, join_column, type_info, sd_inner_to_outer_translation_map, min_inner_elem, -1, -1);
   atomicCAS(err, 0, partial_err);
 }
 
@@ -32,10 +35,17 @@ void fill_hash_join_buff_on_device(int32_t* buff,
                                    int* dev_err_buff,
                                    const JoinColumn join_column,
                                    const JoinColumnTypeInfo type_info,
+                                   const int32_t* sd_inner_to_outer_translation_map,
+                                   const int32_t min_inner_elem,
                                    const size_t block_size_x,
                                    const size_t grid_size_x) {
-  fill_hash_join_buff_wrapper<<<grid_size_x, block_size_x>>>(
-      buff, invalid_slot_val, join_column, type_info, dev_err_buff);
+  fill_hash_join_buff_wrapper<<<grid_size_x, block_size_x>>>(buff,
+                                                             invalid_slot_val,
+                                                             join_column,
+                                                             type_info,
+                                                             sd_inner_to_outer_translation_map,
+                                                             min_inner_elem,
+                                                             dev_err_buff);
 }
 
 __global__ void fill_hash_join_buff_wrapper_sharded(int32_t* buff,
@@ -43,9 +53,18 @@ __global__ void fill_hash_join_buff_wrapper_sharded(int32_t* buff,
                                                     const JoinColumn join_column,
                                                     const JoinColumnTypeInfo type_info,
                                                     const ShardInfo shard_info,
+                                                    const int32_t* sd_inner_to_outer_translation_map,
+                                                    const int32_t min_inner_elem,
                                                     int* err) {
-  int partial_err = SUFFIX(fill_hash_join_buff_sharded)(
-      buff, invalid_slot_val, join_column, type_info, shard_info, NULL, NULL, -1, -1);
+  int partial_err = SUFFIX(fill_hash_join_buff_sharded)(buff,
+                                                        invalid_slot_val,
+                                                        join_column,
+                                                        type_info,
+                                                        shard_info,
+                                                        sd_inner_to_outer_translation_map,
+                                                        min_inner_elem,
+                                                        -1,
+                                                        -1);
   atomicCAS(err, 0, partial_err);
 }
 
@@ -55,10 +74,18 @@ void fill_hash_join_buff_on_device_sharded(int32_t* buff,
                                            const JoinColumn join_column,
                                            const JoinColumnTypeInfo type_info,
                                            const ShardInfo shard_info,
+                                           const int32_t* sd_inner_to_outer_translation_map,
+                                           const int32_t min_inner_elem,
                                            const size_t block_size_x,
                                            const size_t grid_size_x) {
-  fill_hash_join_buff_wrapper_sharded<<<grid_size_x, block_size_x>>>(
-      buff, invalid_slot_val, join_column, type_info, shard_info, dev_err_buff);
+  fill_hash_join_buff_wrapper_sharded<<<grid_size_x, block_size_x>>>(buff,
+                                                                     invalid_slot_val,
+                                                                     join_column,
+                                                                     type_info,
+                                                                     shard_info,
+                                                                     sd_inner_to_outer_translation_map,
+                                                                     min_inner_elem,
+                                                                     dev_err_buff);
 }
 
 __global__ void init_hash_join_buff_wrapper(int32_t* buff,
@@ -102,12 +129,15 @@ void fill_one_to_many_hash_table_on_device(int32_t* buff,
                                            const int32_t invalid_slot_val,
                                            const JoinColumn& join_column,
                                            const JoinColumnTypeInfo& type_info,
+                                           const int32_t* sd_inner_to_outer_translation_map,
+                                           const int32_t min_inner_elem,
                                            const size_t block_size_x,
                                            const size_t grid_size_x) {
   int32_t* pos_buff = buff;
   int32_t* count_buff = buff + hash_entry_count;
   cudaMemset(count_buff, 0, hash_entry_count * sizeof(int32_t));
-  SUFFIX(count_matches)<<<grid_size_x, block_size_x>>>(count_buff, invalid_slot_val, join_column, type_info);
+  SUFFIX(count_matches)<<<grid_size_x, block_size_x>>>(
+      count_buff, invalid_slot_val, join_column, type_info, sd_inner_to_outer_translation_map, min_inner_elem);
 
   set_valid_pos_flag<<<grid_size_x, block_size_x>>>(pos_buff, count_buff, hash_entry_count);
 
@@ -115,7 +145,13 @@ void fill_one_to_many_hash_table_on_device(int32_t* buff,
   thrust::inclusive_scan(count_buff_dev_ptr, count_buff_dev_ptr + hash_entry_count, count_buff_dev_ptr);
   set_valid_pos<<<grid_size_x, block_size_x>>>(pos_buff, count_buff, hash_entry_count);
   cudaMemset(count_buff, 0, hash_entry_count * sizeof(int32_t));
-  SUFFIX(fill_row_ids)<<<grid_size_x, block_size_x>>>(buff, hash_entry_count, invalid_slot_val, join_column, type_info);
+  SUFFIX(fill_row_ids)<<<grid_size_x, block_size_x>>>(buff,
+                                                       hash_entry_count,
+                                                       invalid_slot_val,
+                                                       join_column,
+                                                       type_info,
+                                                       sd_inner_to_outer_translation_map,
+                                                       min_inner_elem);
 }
 
 void fill_one_to_many_hash_table_on_device_sharded(int32_t* buff,
@@ -124,13 +160,20 @@ void fill_one_to_many_hash_table_on_device_sharded(int32_t* buff,
                                                    const JoinColumn& join_column,
                                                    const JoinColumnTypeInfo& type_info,
                                                    const ShardInfo& shard_info,
+                                                   const int32_t* sd_inner_to_outer_translation_map,
+                                                   const int32_t min_inner_elem,
                                                    const size_t block_size_x,
                                                    const size_t grid_size_x) {
   int32_t* pos_buff = buff;
   int32_t* count_buff = buff + hash_entry_count;
   cudaMemset(count_buff, 0, hash_entry_count * sizeof(int32_t));
-  SUFFIX(count_matches_sharded)<<<grid_size_x, block_size_x>>>(
-      count_buff, invalid_slot_val, join_column, type_info, shard_info);
+  SUFFIX(count_matches_sharded)<<<grid_size_x, block_size_x>>>(count_buff,
+                                                               invalid_slot_val,
+                                                               join_column,
+                                                               type_info,
+                                                               shard_info,
+                                                               sd_inner_to_outer_translation_map,
+                                                               min_inner_elem);
 
   set_valid_pos_flag<<<grid_size_x, block_size_x>>>(pos_buff, count_buff, hash_entry_count);
 
@@ -138,8 +181,14 @@ void fill_one_to_many_hash_table_on_device_sharded(int32_t* buff,
   thrust::inclusive_scan(count_buff_dev_ptr, count_buff_dev_ptr + hash_entry_count, count_buff_dev_ptr);
   set_valid_pos<<<grid_size_x, block_size_x>>>(pos_buff, count_buff, hash_entry_count);
   cudaMemset(count_buff, 0, hash_entry_count * sizeof(int32_t));
-  SUFFIX(fill_row_ids_sharded)<<<grid_size_x, block_size_x>>>(
-      buff, hash_entry_count, invalid_slot_val, join_column, type_info, shard_info);
+  SUFFIX(fill_row_ids_sharded)<<<grid_size_x, block_size_x>>>(buff,
+                                                               hash_entry_count,
+                                                               invalid_slot_val,
+                                                               join_column,
+                                                               type_info,
+                                                               shard_info,
+                                                               sd_inner_to_outer_translation_map,
+                                                               min_inner_elem);
 }
 
 template <typename T>
@@ -33,15 +33,18 @@ Fragmenter_Namespace::TableInfo copy_table_info(const Fragmenter_Namespace::Tabl
   return table_info_copy;
 }
 
-Fragmenter_Namespace::TableInfo build_table_info(const std::vector<const TableDescriptor*>& shard_tables) {
+Fragmenter_Namespace::TableInfo build_table_info(const std::vector<const TableDescriptor*>& shard_tables,
+                                                 std::vector<mapd_shared_lock<mapd_shared_mutex>>& table_locks) {
   size_t total_number_of_tuples{0};
   Fragmenter_Namespace::TableInfo table_info_all_shards;
   for (const TableDescriptor* shard_table : shard_tables) {
     CHECK(shard_table->fragmenter);
-    const auto& shard_metainfo = shard_table->fragmenter->getFragmentsForQuery();
+    auto shard_metainfo = shard_table->fragmenter->getFragmentsForQuery();
     total_number_of_tuples += shard_metainfo.getPhysicalNumTuples();
     table_info_all_shards.fragments.insert(
         table_info_all_shards.fragments.end(), shard_metainfo.fragments.begin(), shard_metainfo.fragments.end());
+    // the fragmenter mustn't rewrite the chunks of the fragments while the query reads them
+    table_locks.push_back(std::move(shard_metainfo.tableLock));
   }
   table_info_all_shards.setPhysicalNumTuples(total_number_of_tuples);
   return table_info_all_shards;
@@ -60,7 +63,7 @@ Fragmenter_Namespace::TableInfo InputTableInfoCache::getTableInfo(const int tabl
   const auto td = cat->getMetadataForTable(table_id);
   CHECK(td);
   const auto shard_tables = cat->getPhysicalTablesDescriptors(td);
-  auto table_info = build_table_info(shard_tables);
+  auto table_info = build_table_info(shard_tables, table_locks_);
   auto it_ok = cache_.emplace(table_id, copy_table_info(table_info));
   CHECK(it_ok.second);
   return copy_table_info(table_info);
@@ -68,6 +71,7 @@ Fragmenter_Namespace::TableInfo InputTableInfoCache::getTableInfo(const int tabl
 
 void InputTableInfoCache::clear() {
   decltype(cache_)().swap(cache_);
+  decltype(table_locks_)().swap(table_locks_);
 }
 
 namespace {
@@ -45,6 +45,8 @@ class InputTableInfoCache {
 
  private:
   std::unordered_map<int, Fragmenter_Namespace::TableInfo> cache_;
+  // the fragments of the cached tables stay valid until clear(), held for the whole query
+  std::vector<mapd_shared_lock<mapd_shared_mutex>> table_locks_;
   Executor* executor_;
 };
 
@@ -136,7 +136,7 @@ BufferFragment IteratorTable::transformGroupByBuffer(const int64_t* group_by_buf
 namespace {
 
 int64_t lazy_decode(const SQLTypeInfo& type_info, const int8_t* byte_stream, const int64_t pos) {
-  CHECK(kENCODING_DICT != type_info.get_compression() && kENCODING_FIXED != type_info.get_compression());
+  CHECK(kENCODING_NONE == type_info.get_compression());
   CHECK(type_info.is_integer());
   size_t type_bitwidth = get_bit_width(type_info);
   CHECK_EQ(size_t(0), type_bitwidth % 8);
@@ -47,6 +47,11 @@ std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*> normalize_column_pa
       (rhs_cast && rhs_cast->get_optype() != kCAST)) {
     throw HashJoinFail("Cannot use hash join for given expression");
   }
+  // the hash tables hold ids, which can't be looked up by decoded values
+  if ((lhs_cast && lhs_cast->get_operand()->get_type_info().is_dict_encoded_number()) ||
+      (rhs_cast && rhs_cast->get_operand()->get_type_info().is_dict_encoded_number())) {
+    throw HashJoinFail("Cannot apply hash join to dictionary encoded numbers of different dictionaries");
+  }
   const auto lhs_col = lhs_cast ? dynamic_cast<const Analyzer::ColumnVar*>(lhs_cast->get_operand())
                                 : dynamic_cast<const Analyzer::ColumnVar*>(lhs);
   const auto rhs_col = rhs_cast ? dynamic_cast<const Analyzer::ColumnVar*>(rhs_cast->get_operand())
@@ -97,6 +102,10 @@ std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*> normalize_column_pa
         (inner_col_real_ti.is_string() && inner_col_real_ti.get_compression() == kENCODING_DICT))) {
     throw HashJoinFail("Can only apply hash join to integer-like types and dictionary encoded strings");
   }
+  // hash table builders read the inner column at fixed width
+  if (inner_col_real_ti.get_compression() == kENCODING_RL || inner_col_real_ti.get_compression() == kENCODING_DIFF) {
+    throw HashJoinFail("Cannot apply hash join to run length or differential encoded columns");
+  }
   return {inner_col, outer_col ? outer_col : outer_expr};
 }
 
@@ -342,6 +351,54 @@ bool needs_dictionary_translation(const Analyzer::ColumnVar* inner_col,
   return outer_ti.get_comp_param() != inner_ti.get_comp_param();
 }
 
+StringDictionaryProxy::TranslationMap JoinHashTable::getInnerToOuterTranslationMap(
+    const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols) const {
+  const auto inner_col = cols.first;
+  CHECK(inner_col);
+  if (!needs_dictionary_translation(inner_col, cols.second, executor_)) {
+    return {nullptr, 0};
+  }
+  const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
+  CHECK(outer_col);
+  const auto sd_inner_proxy =
+      executor_->getStringDictionaryProxy(inner_col->get_comp_param(), executor_->row_set_mem_owner_, true);
+  CHECK(sd_inner_proxy);
+  const auto sd_outer_proxy =
+      executor_->getStringDictionaryProxy(outer_col->get_comp_param(), executor_->row_set_mem_owner_, true);
+  CHECK(sd_outer_proxy);
+  if (sd_inner_proxy == sd_outer_proxy) {
+    return {nullptr, 0};
+  }
+  return sd_inner_proxy->getTranslationMap(sd_outer_proxy);
+}
+
+namespace {
+
+// The translation map at the memory level the hash table is built at, null if there's none.
+const int32_t* get_translation_map_buff(const StringDictionaryProxy::TranslationMap& translation_map,
+                                        const Data_Namespace::MemoryLevel effective_memory_level,
+                                        const int device_id,
+                                        Data_Namespace::DataMgr* data_mgr,
+                                        ThrustAllocator& dev_buff_owner) {
+  if (!translation_map.ids || translation_map.ids->empty()) {
+    return nullptr;
+  }
+  const auto& ids = *translation_map.ids;
+#ifdef HAVE_CUDA
+  if (effective_memory_level == Data_Namespace::GPU_LEVEL) {
+    const auto buff_size = ids.size() * sizeof(int32_t);
+    auto dev_buff = dev_buff_owner.allocate(buff_size);
+    copy_to_gpu(data_mgr, reinterpret_cast<CUdeviceptr>(dev_buff), ids.data(), buff_size, device_id);
+    return reinterpret_cast<const int32_t*>(dev_buff);
+  }
+#else
+  CHECK_EQ(Data_Namespace::CPU_LEVEL, effective_memory_level);
+#endif
+  return ids.data();
+}
+
+}  // namespace
+
 std::deque<Fragmenter_Namespace::FragmentInfo> only_shards_for_device(
     const std::deque<Fragmenter_Namespace::FragmentInfo>& fragments,
     const int device_id,
@@ -522,23 +579,28 @@ int JoinHashTable::reifyOneToOneForDevice(const std::deque<Fragmenter_Namespace:
     return ERR_FAILED_TO_JOIN_ON_VIRTUAL_COLUMN;
   }
   CHECK(!inner_cd || !(inner_cd->isVirtualCol));
-  // Since we don't have the string dictionary payloads on the GPU, we'll build
-  // the join hash table on the CPU and transfer it to the GPU.
-  const auto effective_memory_level =
-      needs_dictionary_translation(inner_col, cols.second, executor_) ? Data_Namespace::CPU_LEVEL : memory_level_;
+  // The strings of the inner column are translated to the outer dictionary through a dense map,
+  // which works on the GPU too.
+  const auto effective_memory_level = memory_level_;
   if (fragments.empty()) {
     // No data in this fragment. Still need to create a hash table and initialize it properly.
     ChunkKey empty_chunk;
-    return initHashTableForDevice(empty_chunk, nullptr, 0, cols, effective_memory_level, buff_and_err, device_id);
+    return initHashTableForDevice(
+        empty_chunk, nullptr, 0, cols, nullptr, 0, effective_memory_level, buff_and_err, device_id);
   }
 
   std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
   ThrustAllocator dev_buff_owner(&data_mgr, device_id);
   const int8_t* col_buff = nullptr;
   size_t elem_count = 0;
+  StringDictionaryProxy::TranslationMap translation_map{nullptr, 0};
+  const int32_t* sd_inner_to_outer_translation_map{nullptr};
   try {
     std::tie(col_buff, elem_count) =
         fetchFragments(inner_col, fragments, effective_memory_level, device_id, chunks_owner, dev_buff_owner);
+    translation_map = getInnerToOuterTranslationMap(cols);
+    sd_inner_to_outer_translation_map = get_translation_map_buff(
+        translation_map, effective_memory_level, device_id, &data_mgr, dev_buff_owner);
   } catch (...) {
     return ERR_FAILED_TO_FETCH_COLUMN;
   }
@@ -549,6 +611,8 @@ int JoinHashTable::reifyOneToOneForDevice(const std::deque<Fragmenter_Namespace:
                                  col_buff,
                                  elem_count,
                                  cols,
+                                 sd_inner_to_outer_translation_map,
+                                 translation_map.min_id,
                                  effective_memory_level,
                                  buff_and_err,
                                  device_id);
@@ -586,13 +650,12 @@ int JoinHashTable::reifyOneToManyForDevice(const std::deque<Fragmenter_Namespace
     return ERR_FAILED_TO_JOIN_ON_VIRTUAL_COLUMN;
   }
   CHECK(!inner_cd || !(inner_cd->isVirtualCol));
-  // Since we don't have the string dictionary payloads on the GPU, we'll build
-  // the join hash table on the CPU and transfer it to the GPU.
-  const auto effective_memory_level =
-      needs_dictionary_translation(inner_col, cols.second, executor_) ? Data_Namespace::CPU_LEVEL : memory_level_;
+  // The strings of the inner column are translated to the outer dictionary through a dense map,
+  // which works on the GPU too.
+  const auto effective_memory_level = memory_level_;
   if (fragments.empty()) {
     ChunkKey empty_chunk;
-    initOneToManyHashTable(empty_chunk, nullptr, 0, cols, effective_memory_level, device_id);
+    initOneToManyHashTable(empty_chunk, nullptr, 0, cols, nullptr, 0, effective_memory_level, device_id);
     return 0;
   }
 
@@ -600,10 +663,15 @@ int JoinHashTable::reifyOneToManyForDevice(const std::deque<Fragmenter_Namespace
   ThrustAllocator dev_buff_owner(&data_mgr, device_id);
   const int8_t* col_buff = nullptr;
   size_t elem_count = 0;
+  StringDictionaryProxy::TranslationMap translation_map{nullptr, 0};
+  const int32_t* sd_inner_to_outer_translation_map{nullptr};
 
   try {
     std::tie(col_buff, elem_count) =
         fetchFragments(inner_col, fragments, effective_memory_level, device_id, chunks_owner, dev_buff_owner);
+    translation_map = getInnerToOuterTranslationMap(cols);
+    sd_inner_to_outer_translation_map = get_translation_map_buff(
+        translation_map, effective_memory_level, device_id, &data_mgr, dev_buff_owner);
   } catch (...) {
     return ERR_FAILED_TO_FETCH_COLUMN;
   }
@@ -613,6 +681,8 @@ int JoinHashTable::reifyOneToManyForDevice(const std::deque<Fragmenter_Namespace
                            col_buff,
                            elem_count,
                            cols,
+                           sd_inner_to_outer_translation_map,
+                           translation_map.min_id,
                            effective_memory_level,
                            device_id);
   } catch (...) {
@@ -639,6 +709,8 @@ void JoinHashTable::checkHashJoinReplicationConstraint(const int table_id) const
 int JoinHashTable::initHashTableOnCpu(const int8_t* col_buff,
                                       const size_t num_elements,
                                       const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+                                      const int32_t* sd_inner_to_outer_translation_map,
+                                      const int32_t min_inner_elem,
                                       const int32_t hash_entry_count,
                                       const int32_t hash_join_invalid_val) {
   const auto inner_col = cols.first;
@@ -647,19 +719,6 @@ int JoinHashTable::initHashTableOnCpu(const int8_t* col_buff,
   int err = 0;
   if (!cpu_hash_table_buff_) {
     cpu_hash_table_buff_ = std::make_shared<std::vector<int32_t>>(hash_entry_count);
-    const StringDictionaryProxy* sd_inner_proxy{nullptr};
-    const StringDictionaryProxy* sd_outer_proxy{nullptr};
-    if (ti.is_string()) {
-      CHECK_EQ(kENCODING_DICT, ti.get_compression());
-      sd_inner_proxy =
-          executor_->getStringDictionaryProxy(inner_col->get_comp_param(), executor_->row_set_mem_owner_, true);
-      CHECK(sd_inner_proxy);
-      const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
-      CHECK(outer_col);
-      sd_outer_proxy =
-          executor_->getStringDictionaryProxy(outer_col->get_comp_param(), executor_->row_set_mem_owner_, true);
-      CHECK(sd_outer_proxy);
-    }
     int thread_count = cpu_threads();
     std::vector<std::thread> init_cpu_buff_threads;
     for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
@@ -677,8 +736,8 @@ int JoinHashTable::initHashTableOnCpu(const int8_t* col_buff,
                                           hash_join_invalid_val,
                                           col_buff,
                                           num_elements,
-                                          sd_inner_proxy,
-                                          sd_outer_proxy,
+                                          sd_inner_to_outer_translation_map,
+                                          min_inner_elem,
                                           thread_idx,
                                           thread_count,
                                           &ti,
@@ -692,8 +751,8 @@ int JoinHashTable::initHashTableOnCpu(const int8_t* col_buff,
                                                isBitwiseEq(),
                                                col_range_.getIntMax() + 1,
                                                is_unsigned_type(ti)},
-                                              sd_inner_proxy,
-                                              sd_outer_proxy,
+                                              sd_inner_to_outer_translation_map,
+                                              min_inner_elem,
                                               thread_idx,
                                               thread_count);
         __sync_val_compare_and_swap(&err, 0, partial_err);
@@ -713,6 +772,8 @@ void JoinHashTable::initOneToManyHashTableOnCpu(
     const int8_t* col_buff,
     const size_t num_elements,
     const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+    const int32_t* sd_inner_to_outer_translation_map,
+    const int32_t min_inner_elem,
     const int32_t hash_entry_count,
     const int32_t hash_join_invalid_val) {
   const auto inner_col = cols.first;
@@ -722,19 +783,6 @@ void JoinHashTable::initOneToManyHashTableOnCpu(
     return;
   }
   cpu_hash_table_buff_ = std::make_shared<std::vector<int32_t>>(2 * hash_entry_count + num_elements);
-  const StringDictionaryProxy* sd_inner_proxy{nullptr};
-  const StringDictionaryProxy* sd_outer_proxy{nullptr};
-  if (ti.is_string()) {
-    CHECK_EQ(kENCODING_DICT, ti.get_compression());
-    sd_inner_proxy =
-        executor_->getStringDictionaryProxy(inner_col->get_comp_param(), executor_->row_set_mem_owner_, true);
-    CHECK(sd_inner_proxy);
-    const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
-    CHECK(outer_col);
-    sd_outer_proxy =
-        executor_->getStringDictionaryProxy(outer_col->get_comp_param(), executor_->row_set_mem_owner_, true);
-    CHECK(sd_outer_proxy);
-  }
   int thread_count = cpu_threads();
   std::vector<std::future<void>> init_threads;
   for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
@@ -760,8 +808,8 @@ void JoinHashTable::initOneToManyHashTableOnCpu(
                                isBitwiseEq(),
                                col_range_.getIntMax() + 1,
                                is_unsigned_type(ti)},
-                              sd_inner_proxy,
-                              sd_outer_proxy,
+                              sd_inner_to_outer_translation_map,
+                              min_inner_elem,
                               thread_count);
 }
 
@@ -782,6 +830,8 @@ int JoinHashTable::initHashTableForDevice(
     const int8_t* col_buff,
     const size_t num_elements,
     const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+    const int32_t* sd_inner_to_outer_translation_map,
+    const int32_t min_inner_elem,
     const Data_Namespace::MemoryLevel effective_memory_level,
     std::pair<Data_Namespace::AbstractBuffer*, Data_Namespace::AbstractBuffer*>& buff_and_err,
     const int device_id) {
@@ -792,8 +842,6 @@ int JoinHashTable::initHashTableForDevice(
 #ifdef HAVE_CUDA
   const auto shard_count = shardCount();
   const size_t entries_per_shard{shard_count ? get_entries_per_shard(hash_entry_count, shard_count) : 0};
-  // Even if we join on dictionary encoded strings, the memory on the GPU is still needed
-  // once the join hash table has been built on the CPU.
   const auto catalog = executor_->getCatalog();
   if (memory_level_ == Data_Namespace::GPU_LEVEL) {
     auto& data_mgr = catalog->get_dataMgr();
@@ -823,7 +871,13 @@ int JoinHashTable::initHashTableForDevice(
     }
     {
       std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
-      err = initHashTableOnCpu(col_buff, num_elements, cols, hash_entry_count, hash_join_invalid_val);
+      err = initHashTableOnCpu(col_buff,
+                               num_elements,
+                               cols,
+                               sd_inner_to_outer_translation_map,
+                               min_inner_elem,
+                               hash_entry_count,
+                               hash_join_invalid_val);
     }
     if (err == -1) {
       err = ERR_COLUMN_NOT_UNIQUE;
@@ -831,22 +885,6 @@ int JoinHashTable::initHashTableForDevice(
     if (!err && inner_col->get_table_id() > 0) {
       putHashTableOnCpuToCache(chunk_key, num_elements, cols);
     }
-    // Transfer the hash table on the GPU if we've only built it on CPU
-    // but the query runs on GPU (join on dictionary encoded columns).
-    // Don't transfer the buffer if there was an error since we'll bail anyway.
-    if (memory_level_ == Data_Namespace::GPU_LEVEL && !err) {
-#ifdef HAVE_CUDA
-      CHECK(ti.is_string());
-      auto& data_mgr = catalog->get_dataMgr();
-      copy_to_gpu(&data_mgr,
-                  gpu_hash_table_buff_[device_id],
-                  &(*cpu_hash_table_buff_)[0],
-                  cpu_hash_table_buff_->size() * sizeof((*cpu_hash_table_buff_)[0]),
-                  device_id);
-#else
-      CHECK(false);
-#endif
-    }
   } else {
 #ifdef HAVE_CUDA
     CHECK_EQ(Data_Namespace::GPU_LEVEL, effective_memory_level);
@@ -879,6 +917,8 @@ int JoinHashTable::initHashTableForDevice(
                                               join_column,
                                               type_info,
                                               shard_info,
+                                              sd_inner_to_outer_translation_map,
+                                              min_inner_elem,
                                               executor_->blockSize(),
                                               executor_->gridSize());
       }
@@ -888,6 +928,8 @@ int JoinHashTable::initHashTableForDevice(
                                     reinterpret_cast<int*>(dev_err_buff),
                                     join_column,
                                     type_info,
+                                    sd_inner_to_outer_translation_map,
+                                    min_inner_elem,
                                     executor_->blockSize(),
                                     executor_->gridSize());
     }
@@ -906,14 +948,14 @@ void JoinHashTable::initOneToManyHashTable(const ChunkKey& chunk_key,
                                            const int8_t* col_buff,
                                            const size_t num_elements,
                                            const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+                                           const int32_t* sd_inner_to_outer_translation_map,
+                                           const int32_t min_inner_elem,
                                            const Data_Namespace::MemoryLevel effective_memory_level,
                                            const int device_id) {
   auto hash_entry_count = get_hash_entry_count(col_range_, isBitwiseEq());
 #ifdef HAVE_CUDA
   const auto shard_count = get_shard_count(qual_bin_oper_.get(), ra_exe_unit_, executor_);
   const size_t entries_per_shard = (shard_count ? get_entries_per_shard(hash_entry_count, shard_count) : 0);
-  // Even if we join on dictionary encoded strings, the memory on the GPU is still needed
-  // once the join hash table has been built on the CPU.
   if (memory_level_ == Data_Namespace::GPU_LEVEL && shard_count) {
     const auto shards_per_device = (shard_count + device_count_ - 1) / device_count_;
     CHECK_GT(shards_per_device, 0);
@@ -940,26 +982,17 @@ void JoinHashTable::initOneToManyHashTable(const ChunkKey& chunk_key,
     initHashTableOnCpuFromCache(chunk_key, num_elements, cols);
     {
       std::lock_guard<std::mutex> cpu_hash_table_buff_lock(cpu_hash_table_buff_mutex_);
-      initOneToManyHashTableOnCpu(col_buff, num_elements, cols, hash_entry_count, hash_join_invalid_val);
+      initOneToManyHashTableOnCpu(col_buff,
+                                  num_elements,
+                                  cols,
+                                  sd_inner_to_outer_translation_map,
+                                  min_inner_elem,
+                                  hash_entry_count,
+                                  hash_join_invalid_val);
     }
     if (inner_col->get_table_id() > 0) {
       putHashTableOnCpuToCache(chunk_key, num_elements, cols);
     }
-    // Transfer the hash table on the GPU if we've only built it on CPU
-    // but the query runs on GPU (join on dictionary encoded columns).
-    // Don't transfer the buffer if there was an error since we'll bail anyway.
-    if (memory_level_ == Data_Namespace::GPU_LEVEL) {
-#ifdef HAVE_CUDA
-      CHECK(ti.is_string());
-      copy_to_gpu(&data_mgr,
-                  gpu_hash_table_buff_[device_id],
-                  &(*cpu_hash_table_buff_)[0],
-                  cpu_hash_table_buff_->size() * sizeof((*cpu_hash_table_buff_)[0]),
-                  device_id);
-#else
-      CHECK(false);
-#endif
-    }
   } else {
 #ifdef HAVE_CUDA
     CHECK_EQ(Data_Namespace::GPU_LEVEL, effective_memory_level);
@@ -986,6 +1019,8 @@ void JoinHashTable::initOneToManyHashTable(const ChunkKey& chunk_key,
                                                       join_column,
                                                       type_info,
                                                       shard_info,
+                                                      sd_inner_to_outer_translation_map,
+                                                      min_inner_elem,
                                                       executor_->blockSize(),
                                                       executor_->gridSize());
       }
@@ -995,6 +1030,8 @@ void JoinHashTable::initOneToManyHashTable(const ChunkKey& chunk_key,
                                             hash_join_invalid_val,
                                             join_column,
                                             type_info,
+                                            sd_inner_to_outer_translation_map,
+                                            min_inner_elem,
                                             executor_->blockSize(),
                                             executor_->gridSize());
     }
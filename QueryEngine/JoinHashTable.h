@@ -27,6 +27,7 @@
 #include "../Analyzer/Analyzer.h"
 #include "../Catalog/Catalog.h"
 #include "../Chunk/Chunk.h"
+#include "../StringDictionary/StringDictionaryProxy.h"
 #include "ColumnarResults.h"
 #include "ExpressionRange.h"
 #include "InputDescriptors.h"
@@ -152,10 +153,14 @@ class JoinHashTable : public JoinHashTableInterface {
   int reifyOneToOneForDevice(const std::deque<Fragmenter_Namespace::FragmentInfo>& fragments, const int device_id);
   int reifyOneToManyForDevice(const std::deque<Fragmenter_Namespace::FragmentInfo>& fragments, const int device_id);
   void checkHashJoinReplicationConstraint(const int table_id) const;
+  StringDictionaryProxy::TranslationMap getInnerToOuterTranslationMap(
+      const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols) const;
   int initHashTableForDevice(const ChunkKey& chunk_key,
                              const int8_t* col_buff,
                              const size_t num_elements,
                              const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+                             const int32_t* sd_inner_to_outer_translation_map,
+                             const int32_t min_inner_elem,
                              const Data_Namespace::MemoryLevel effective_memory_level,
                              std::pair<Data_Namespace::AbstractBuffer*, Data_Namespace::AbstractBuffer*>& buff_and_err,
                              const int device_id);
@@ -163,6 +168,8 @@ class JoinHashTable : public JoinHashTableInterface {
                               const int8_t* col_buff,
                               const size_t num_elements,
                               const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+                              const int32_t* sd_inner_to_outer_translation_map,
+                              const int32_t min_inner_elem,
                               const Data_Namespace::MemoryLevel effective_memory_level,
                               const int device_id);
   void initHashTableOnCpuFromCache(const ChunkKey& chunk_key,
@@ -174,11 +181,15 @@ class JoinHashTable : public JoinHashTableInterface {
   int initHashTableOnCpu(const int8_t* col_buff,
                          const size_t num_elements,
                          const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+                         const int32_t* sd_inner_to_outer_translation_map,
+                         const int32_t min_inner_elem,
                          const int32_t hash_entry_count,
                          const int32_t hash_join_invalid_val);
   void initOneToManyHashTableOnCpu(const int8_t* col_buff,
                                    const size_t num_elements,
                                    const std::pair<const Analyzer::ColumnVar*, const Analyzer::Expr*>& cols,
+                                   const int32_t* sd_inner_to_outer_translation_map,
+                                   const int32_t min_inner_elem,
                                    const int32_t hash_entry_count,
                                    const int32_t hash_join_invalid_val);
 
@@ -558,6 +558,7 @@ std::shared_ptr<ResultSet> Executor::execute(const Planner::RootPlan* root_plan,
   const auto stmt_type = root_plan->get_stmt_type();
   // capture the lock acquistion time
   auto clock_begin = timer_start();
+  const auto admission = QueryAdmission::admit(device_type);
   std::lock_guard<std::mutex> lock(execute_mutex_);
   if (g_enable_dynamic_watchdog) {
     resetInterrupt();
@@ -16,6 +16,7 @@
 
 #include "Execute.h"
 #include "ExtensionFunctionsWhitelist.h"
+#include "PersistentObjectCache.h"
 #include "QueryTemplateGenerator.h"
 
 #include "Shared/mapdpath.h"
@@ -131,31 +132,33 @@ std::string serialize_llvm_object(const T* llvm_obj) {
   return ss.str();
 }
 
+std::vector<std::pair<void*, void*>> get_native_functions(const CodeCacheEntry& cached_code) {
+  std::vector<std::pair<void*, void*>> native_functions;
+  for (const auto& native_code : cached_code.native_code) {
+    GpuCompilationContext* gpu_context = std::get<2>(native_code).get();
+    native_functions.emplace_back(std::get<0>(native_code), gpu_context ? gpu_context->module() : nullptr);
+  }
+  return native_functions;
+}
+
 }  // namespace
 
-std::vector<std::pair<void*, void*>> Executor::getCodeFromCache(
-    const CodeCacheKey& key,
-    const std::map<CodeCacheKey, std::pair<CodeCacheVal, llvm::Module*>>& cache) {
-  auto it = cache.find(key);
-  if (it != cache.end()) {
+std::shared_ptr<CodeCacheEntry> Executor::getCodeFromCache(const CodeCacheKey& key, CodeCache& cache) {
+  auto cached_code = cache.get(key);
+  if (cached_code) {
     delete cgen_state_->module_;
-    cgen_state_->module_ = it->second.second;
-    std::vector<std::pair<void*, void*>> native_functions;
-    for (auto& native_code : it->second.first) {
-      GpuCompilationContext* gpu_context = std::get<2>(native_code).get();
-      native_functions.push_back(
-          std::make_pair(std::get<0>(native_code), gpu_context ? gpu_context->module() : nullptr));
-    }
-    return native_functions;
+    cgen_state_->module_ = cached_code->module;
+    cgen_state_->module_owner_ = cached_code;
   }
-  return {};
+  return cached_code;
 }
 
-void Executor::addCodeToCache(
+std::shared_ptr<CodeCacheEntry> Executor::addCodeToCache(
     const CodeCacheKey& key,
     const std::vector<std::tuple<void*, llvm::ExecutionEngine*, GpuCompilationContext*>>& native_code,
     llvm::Module* module,
-    std::map<CodeCacheKey, std::pair<CodeCacheVal, llvm::Module*>>& cache) {
+    const int64_t compile_time_ms,
+    CodeCache& cache) {
   CHECK(!native_code.empty());
   CodeCacheVal cache_val;
   for (const auto& native_func : native_code) {
@@ -163,26 +166,32 @@ void Executor::addCodeToCache(
                            std::unique_ptr<llvm::ExecutionEngine>(std::get<1>(native_func)),
                            std::unique_ptr<GpuCompilationContext>(std::get<2>(native_func)));
   }
-  auto it_ok = cache.insert(std::make_pair(key, std::make_pair(std::move(cache_val), module)));
-  CHECK(it_ok.second);
+  auto cached_code = cache.put(key, std::move(cache_val), module, compile_time_ms);
+  cgen_state_->module_owner_ = cached_code;
+  return cached_code;
 }
 
-std::vector<std::pair<void*, void*>> Executor::optimizeAndCodegenCPU(llvm::Function* query_func,
-                                                                     llvm::Function* multifrag_query_func,
-                                                                     std::unordered_set<llvm::Function*>& live_funcs,
-                                                                     llvm::Module* module,
-                                                                     const CompilationOptions& co) {
+std::shared_ptr<CodeCacheEntry> Executor::optimizeAndCodegenCPU(llvm::Function* query_func,
+                                                                llvm::Function* multifrag_query_func,
+                                                                std::unordered_set<llvm::Function*>& live_funcs,
+                                                                llvm::Module* module,
+                                                                const CompilationOptions& co) {
   CodeCacheKey key{serialize_llvm_object(query_func), serialize_llvm_object(cgen_state_->row_func_)};
   for (const auto helper : cgen_state_->helper_functions_) {
     key.push_back(serialize_llvm_object(helper));
   }
   auto cached_code = getCodeFromCache(key, cpu_code_cache_);
-  if (!cached_code.empty()) {
+  if (cached_code) {
     return cached_code;
   }
 
-  // run optimizations
-  optimizeIR(query_func, module, live_funcs, co, debug_dir_, debug_file_);
+  const auto clock_begin = timer_start();
+  PersistentObjectCache object_cache(key);
+  // the object code found on disk has been generated from the optimized module already
+  if (!object_cache.hasObject()) {
+    // run optimizations
+    optimizeIR(query_func, module, live_funcs, co, debug_dir_, debug_file_);
+  }
 
   llvm::ExecutionEngine* execution_engine{nullptr};
 
@@ -209,13 +218,19 @@ std::vector<std::pair<void*, void*>> Executor::optimizeAndCodegenCPU(llvm::Funct
   execution_engine = eb.create();
   CHECK(execution_engine);
 
+  if (PersistentObjectCache::enabled()) {
+    execution_engine->setObjectCache(&object_cache);
+  }
   execution_engine->finalizeObject();
+  execution_engine->setObjectCache(nullptr);
   auto native_code = execution_engine->getPointerToFunction(multifrag_query_func);
 
   CHECK(native_code);
-  addCodeToCache(key, {{std::make_tuple(native_code, execution_engine, nullptr)}}, module, cpu_code_cache_);
-
-  return {std::make_pair(native_code, nullptr)};
+  return addCodeToCache(key,
+                        {{std::make_tuple(native_code, execution_engine, nullptr)}},
+                        module,
+                        timer_stop(clock_begin),
+                        cpu_code_cache_);
 }
 
 namespace {
@@ -414,13 +429,13 @@ void legalize_nvvm_ir(llvm::Function* query_func) {
 
 }  // namespace
 
-std::vector<std::pair<void*, void*>> Executor::optimizeAndCodegenGPU(llvm::Function* query_func,
-                                                                     llvm::Function* multifrag_query_func,
-                                                                     std::unordered_set<llvm::Function*>& live_funcs,
-                                                                     llvm::Module* module,
-                                                                     const bool no_inline,
-                                                                     const CudaMgr_Namespace::CudaMgr* cuda_mgr,
-                                                                     const CompilationOptions& co) {
+std::shared_ptr<CodeCacheEntry> Executor::optimizeAndCodegenGPU(llvm::Function* query_func,
+                                                                llvm::Function* multifrag_query_func,
+                                                                std::unordered_set<llvm::Function*>& live_funcs,
+                                                                llvm::Module* module,
+                                                                const bool no_inline,
+                                                                const CudaMgr_Namespace::CudaMgr* cuda_mgr,
+                                                                const CompilationOptions& co) {
 #ifdef HAVE_CUDA
   CHECK(cuda_mgr);
   CodeCacheKey key{serialize_llvm_object(query_func), serialize_llvm_object(cgen_state_->row_func_)};
@@ -428,10 +443,12 @@ std::vector<std::pair<void*, void*>> Executor::optimizeAndCodegenGPU(llvm::Funct
     key.push_back(serialize_llvm_object(helper));
   }
   auto cached_code = getCodeFromCache(key, gpu_code_cache_);
-  if (!cached_code.empty()) {
+  if (cached_code) {
     return cached_code;
   }
 
+  const auto clock_begin = timer_start();
+
   auto get_group_value_func = module->getFunction("get_group_value_one_key");
   CHECK(get_group_value_func);
   get_group_value_func->setAttributes(llvm::AttributeSet{});
@@ -512,7 +529,6 @@ std::vector<std::pair<void*, void*>> Executor::optimizeAndCodegenGPU(llvm::Funct
 
   auto cuda_llir = cuda_rt_decls + extension_function_decls() + ss.str();
 
-  std::vector<std::pair<void*, void*>> native_functions;
   std::vector<std::tuple<void*, llvm::ExecutionEngine*, GpuCompilationContext*>> cached_functions;
 
   const auto ptx = generatePTX(cuda_llir);
@@ -532,16 +548,14 @@ std::vector<std::pair<void*, void*>> Executor::optimizeAndCodegenGPU(llvm::Funct
     auto native_module = gpu_context->module();
     CHECK(native_code);
     CHECK(native_module);
-    native_functions.push_back(std::make_pair(native_code, native_module));
     cached_functions.emplace_back(native_code, nullptr, gpu_context);
   }
-  addCodeToCache(key, cached_functions, module, gpu_code_cache_);
 
   checkCudaErrors(cuLinkDestroy(link_state));
 
-  return native_functions;
+  return addCodeToCache(key, cached_functions, module, timer_stop(clock_begin), gpu_code_cache_);
 #else
-  return {};
+  return nullptr;
 #endif
 }
 
@@ -983,6 +997,7 @@ Executor::CompilationResult Executor::compileWorkUnit(const std::vector<InputTab
                                                       const bool has_cardinality_estimation,
                                                       ColumnCacheMap& column_cache,
                                                       RenderInfo* render_info) {
+  std::lock_guard<std::mutex> compilation_lock(compilation_mutex_);
   nukeOldState(allow_lazy_fetch, join_info, query_infos, ra_exe_unit.outer_join_quals);
 
   GroupByAndAggregate group_by_and_aggregate(this,
@@ -1116,7 +1131,7 @@ Executor::CompilationResult Executor::compileWorkUnit(const std::vector<InputTab
     llvm_ir = serialize_llvm_object(query_func) + serialize_llvm_object(cgen_state_->row_func_);
   }
   verify_function_ir(cgen_state_->row_func_);
-  return Executor::CompilationResult{
+  const auto native_code =
       co.device_type_ == ExecutorDeviceType::CPU
           ? optimizeAndCodegenCPU(query_func, multifrag_query_func, live_funcs, cgen_state_->module_, co)
           : optimizeAndCodegenGPU(query_func,
@@ -1125,11 +1140,14 @@ Executor::CompilationResult Executor::compileWorkUnit(const std::vector<InputTab
                                   cgen_state_->module_,
                                   is_group_by || ra_exe_unit.estimator,
                                   cuda_mgr,
-                                  co),
+                                  co);
+  return Executor::CompilationResult{
+      native_code ? get_native_functions(*native_code) : std::vector<std::pair<void*, void*>>{},
       cgen_state_->getLiterals(),
       query_mem_desc,
       output_columnar,
-      llvm_ir};
+      llvm_ir,
+      native_code};
 }
 
 bool Executor::compileBody(const RelAlgExecutionUnit& ra_exe_unit,
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PersistentObjectCache.h"
+
+#include "../Shared/mapdpath.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Host.h>
+#include <boost/filesystem.hpp>
+#include <glog/logging.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+namespace {
+
+// Everything besides the IR which determines the object code: the compiler, the target and
+// the runtime functions the query module has been linked with.
+const std::string& environment_key() {
+  static const std::string env_key = [] {
+    std::string key = std::string("llvm:") + LLVM_VERSION_STRING + "\ncpu:" + llvm::sys::getHostCPUName().str() + "\n";
+    llvm::StringMap<bool> host_features;
+    if (llvm::sys::getHostCPUFeatures(host_features)) {
+      // StringMap iteration order is unspecified, sort for a stable key
+      std::map<std::string, bool> sorted_features;
+      for (const auto& feature : host_features) {
+        sorted_features.emplace(feature.getKey().str(), feature.getValue());
+      }
+      for (const auto& feature : sorted_features) {
+        key += (feature.second ? "+" : "-") + feature.first + ",";
+      }
+    }
+    auto runtime_bc = llvm::MemoryBuffer::getFile(mapd_root_abs_path() + "/QueryEngine/RuntimeFunctions.bc");
+    CHECK(!runtime_bc.getError());
+    key += "\nruntime:" + std::to_string(std::hash<std::string>()(runtime_bc.get()->getBuffer().str())) + "\n";
+    return key;
+  }();
+  return env_key;
+}
+
+bool write_file(const std::string& path, const char* data, const size_t size) {
+  // write to a temporary file first, a crash must never leave a truncated entry behind
+  const auto tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    out.write(data, size);
+    if (!out) {
+      return false;
+    }
+  }
+  return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+}  // namespace
+
+PersistentObjectCache::PersistentObjectCache(const CodeCacheKey& key) {
+  if (!enabled()) {
+    return;
+  }
+  serialized_key_ = environment_key();
+  for (const auto& part : key) {
+    serialized_key_ += std::to_string(part.size()) + ":" + part;
+  }
+  char hash_str[17];
+  snprintf(hash_str, sizeof(hash_str), "%016zx", std::hash<std::string>()(serialized_key_));
+  path_prefix_ = (boost::filesystem::path(cache_dir_) / hash_str).string();
+  auto stored_key = llvm::MemoryBuffer::getFile(path_prefix_ + ".key", -1, false);
+  if (stored_key.getError() || stored_key.get()->getBuffer() != serialized_key_) {
+    return;
+  }
+  auto stored_object = llvm::MemoryBuffer::getFile(path_prefix_ + ".o", -1, false);
+  if (stored_object.getError()) {
+    LOG(WARNING) << "Could not read cached object code " << path_prefix_ << ".o";
+    return;
+  }
+  object_ = std::move(stored_object.get());
+}
+
+void PersistentObjectCache::init(const std::string& cache_dir) {
+  if (!cache_dir.empty() && !boost::filesystem::exists(cache_dir) &&
+      !boost::filesystem::create_directory(cache_dir)) {
+    LOG(ERROR) << "Could not create the code cache directory " << cache_dir << ", persistent code cache disabled";
+    return;
+  }
+  cache_dir_ = cache_dir;
+}
+
+#if LLVM_VERSION_MAJOR == 3 && LLVM_VERSION_MINOR == 5
+void PersistentObjectCache::notifyObjectCompiled(const llvm::Module* module, const llvm::MemoryBuffer* obj) {
+  storeObject(obj->getBufferStart(), obj->getBufferSize());
+}
+
+llvm::MemoryBuffer* PersistentObjectCache::getObject(const llvm::Module* module) {
+  return object_.release();
+}
+#else
+void PersistentObjectCache::notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef obj) {
+  storeObject(obj.getBufferStart(), obj.getBufferSize());
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentObjectCache::getObject(const llvm::Module* module) {
+  return std::move(object_);
+}
+#endif
+
+void PersistentObjectCache::storeObject(const char* data, const size_t size) const {
+  if (!enabled()) {
+    return;
+  }
+  // the key is written last, its presence marks a complete entry
+  if (!write_file(path_prefix_ + ".o", data, size) ||
+      !write_file(path_prefix_ + ".key", serialized_key_.data(), serialized_key_.size())) {
+    LOG(WARNING) << "Could not write cached object code " << path_prefix_;
+  }
+}
+
+std::string PersistentObjectCache::cache_dir_;
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    PersistentObjectCache.h
+ * @brief   On-disk cache of the object code MCJIT generates for CPU queries.
+ *
+ * Entries survive restarts of the server. An entry is keyed on the code cache key along
+ * with the LLVM version, the host CPU and the runtime functions bitcode, and is stored as
+ * a pair of files: the full key, used to rule out hash collisions, and the object code,
+ * which is memory-mapped back in on a hit. The directory can be wiped at any time.
+ */
+
+#ifndef QUERYENGINE_PERSISTENTOBJECTCACHE_H
+#define QUERYENGINE_PERSISTENTOBJECTCACHE_H
+
+#include "CodeCache.h"
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <memory>
+#include <string>
+
+// Serves the object code for a single module, it's meant to be attached to an execution
+// engine only for the duration of the finalizeObject() call.
+class PersistentObjectCache : public llvm::ObjectCache {
+ public:
+  PersistentObjectCache(const CodeCacheKey& key);
+
+  // Sets the cache directory, an empty path disables the cache.
+  static void init(const std::string& cache_dir);
+
+  static bool enabled() { return !cache_dir_.empty(); }
+
+  // Whether the object code for the key has been found on disk. The module
+  // doesn't need to be optimized in that case, MCJIT won't generate code for it.
+  bool hasObject() const { return object_ != nullptr; }
+
+#if LLVM_VERSION_MAJOR == 3 && LLVM_VERSION_MINOR == 5
+  void notifyObjectCompiled(const llvm::Module* module, const llvm::MemoryBuffer* obj) override;
+
+  llvm::MemoryBuffer* getObject(const llvm::Module* module) override;
+#else
+  void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef obj) override;
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+#endif
+
+ private:
+  void storeObject(const char* data, const size_t size) const;
+
+  std::string serialized_key_;
+  std::string path_prefix_;
+  std::unique_ptr<llvm::MemoryBuffer> object_;
+
+  static std::string cache_dir_;
+};
+
+#endif  // QUERYENGINE_PERSISTENTOBJECTCACHE_H
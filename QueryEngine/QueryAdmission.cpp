@@ -0,0 +1,74 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryAdmission.h"
+
+#include <glog/logging.h>
+#include <algorithm>
+
+extern bool g_enable_dynamic_watchdog;
+
+unsigned g_max_concurrent_cpu_queries{4};
+
+std::unique_ptr<QueryAdmission> QueryAdmission::admit(const ExecutorDeviceType device_type) {
+  const bool uses_gpu = device_type != ExecutorDeviceType::CPU;
+  std::unique_lock<std::mutex> lock(slots_mutex_);
+  slots_cv_.wait(lock, [uses_gpu] { return hasSlot(uses_gpu); });
+  if (uses_gpu) {
+    ++running_gpu_queries_;
+  } else {
+    ++running_cpu_queries_;
+  }
+  return std::unique_ptr<QueryAdmission>(new QueryAdmission(uses_gpu));
+}
+
+QueryAdmission::~QueryAdmission() {
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    if (uses_gpu_) {
+      CHECK_GT(running_gpu_queries_, size_t(0));
+      --running_gpu_queries_;
+    } else {
+      CHECK_GT(running_cpu_queries_, size_t(0));
+      --running_cpu_queries_;
+    }
+  }
+  slots_cv_.notify_all();
+}
+
+size_t QueryAdmission::runningCpuQueries() {
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+  return running_cpu_queries_;
+}
+
+size_t QueryAdmission::runningGpuQueries() {
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+  return running_gpu_queries_;
+}
+
+bool QueryAdmission::hasSlot(const bool uses_gpu) {
+  // The dynamic watchdog deadline and abort flag are process-wide, so are the watchdog globals of the
+  // cached GPU modules. Queries would reset each other's deadline or abort each other, run one at a time.
+  if (g_enable_dynamic_watchdog) {
+    return running_cpu_queries_ == 0 && running_gpu_queries_ == 0;
+  }
+  return uses_gpu ? running_gpu_queries_ == 0 : running_cpu_queries_ < std::max(g_max_concurrent_cpu_queries, 1u);
+}
+
+std::mutex QueryAdmission::slots_mutex_;
+std::condition_variable QueryAdmission::slots_cv_;
+size_t QueryAdmission::running_cpu_queries_{0};
+size_t QueryAdmission::running_gpu_queries_{0};
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    QueryAdmission.h
+ * @brief   Limits the number of queries running at the same time.
+ *
+ * CPU queries get up to g_max_concurrent_cpu_queries slots, queries which
+ * touch a GPU are still run one at a time since they compete for device memory.
+ * With the dynamic watchdog on, a single query runs at a time on any device.
+ */
+
+#ifndef QUERYENGINE_QUERYADMISSION_H
+#define QUERYENGINE_QUERYADMISSION_H
+
+#include "CompilationOptions.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+extern unsigned g_max_concurrent_cpu_queries;
+
+class QueryAdmission {
+ public:
+  // Blocks until a slot for the given device type is available. The slot
+  // is given back when the returned object is destroyed.
+  static std::unique_ptr<QueryAdmission> admit(const ExecutorDeviceType device_type);
+
+  ~QueryAdmission();
+
+  QueryAdmission(const QueryAdmission&) = delete;
+  void operator=(const QueryAdmission&) = delete;
+
+  static size_t runningCpuQueries();
+  static size_t runningGpuQueries();
+
+ private:
+  QueryAdmission(const bool uses_gpu) : uses_gpu_(uses_gpu) {}
+
+  // Must be called with slots_mutex_ held.
+  static bool hasSlot(const bool uses_gpu);
+
+  const bool uses_gpu_;
+
+  static std::mutex slots_mutex_;
+  static std::condition_variable slots_cv_;
+  static size_t running_cpu_queries_;
+  static size_t running_gpu_queries_;
+};
+
+#endif  // QUERYENGINE_QUERYADMISSION_H
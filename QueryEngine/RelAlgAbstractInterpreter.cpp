@@ -438,6 +438,13 @@ std::unique_ptr<RexAbstractInput> parse_abstract_input(const rapidjson::Value& e
   return std::unique_ptr<RexAbstractInput>(new RexAbstractInput(json_i64(input)));
 }
 
+void check_bound_parameter(const rapidjson::Value& expr) {
+  // parameters are replaced with literals by MapDHandler::execute_prepared
+  if (expr.IsObject() && expr.HasMember("dynamic_param")) {
+    throw QueryNotSupported("Query parameters must be bound, use execute_prepared");
+  }
+}
+
 std::unique_ptr<RexLiteral> parse_literal(const rapidjson::Value& expr) {
   CHECK(expr.IsObject());
   const auto& literal = field(expr, "literal");
@@ -589,6 +596,7 @@ std::unique_ptr<const RexScalar> parse_scalar_expr(const rapidjson::Value& expr,
                                                    const Catalog_Namespace::Catalog& cat,
                                                    RelAlgExecutor* ra_executor) {
   CHECK(expr.IsObject());
+  check_bound_parameter(expr);
   if (expr.IsObject() && expr.HasMember("input")) {
     return std::unique_ptr<const RexScalar>(parse_abstract_input(expr));
   }
@@ -1549,6 +1557,12 @@ class RelAlgAbstractInterpreter {
                                               : NullSortedPosition::Last;
       collation.emplace_back(field_idx, sort_dir, null_pos);
     }
+    for (const auto bound_field : {"fetch", "offset"}) {
+      const auto it = sort_ra.FindMember(bound_field);
+      if (it != sort_ra.MemberEnd()) {
+        check_bound_parameter(it->value);
+      }
+    }
     auto limit = get_int_literal_field(sort_ra, "fetch", -1);
     if (limit == 0) {
       throw QueryNotSupported("LIMIT 0 not supported");
@@ -128,6 +128,7 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const std::string& que
   const auto ra = deserialize_ra_dag(query_ra, cat_, this);
   // capture the lock acquistion time
   auto clock_begin = timer_start();
+  const auto admission = QueryAdmission::admit(co.device_type_);
   std::lock_guard<std::mutex> lock(executor_->execute_mutex_);
   int64_t queue_time_ms = timer_stop(clock_begin);
   if (g_enable_dynamic_watchdog) {
@@ -144,10 +145,11 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const std::string& que
   };
   executor_->row_set_mem_owner_ = std::make_shared<RowSetMemoryOwner>();
   executor_->catalog_ = &cat_;
+  // releases the table locks taken by the first lookup of the table infos below
+  ScopeGuard restore_metainfo_cache = [this] { executor_->clearMetaInfoCache(); };
   executor_->agg_col_range_cache_ = computeColRangesCache(ra.get());
   executor_->string_dictionary_generations_ = computeStringDictionaryGenerations(ra.get());
   executor_->table_generations_ = computeTableGenerations(ra.get());
-  ScopeGuard restore_metainfo_cache = [this] { executor_->clearMetaInfoCache(); };
   auto ed_list = get_execution_descriptors(ra.get());
   if (render_info) {  // save the table names for render queries
     // set whether the render will be done in-situ (in_situ_data = true) or
@@ -1289,6 +1291,32 @@ size_t groups_approx_upper_bound(const std::vector<InputTableInfo>& table_infos)
   return std::max(max_num_groups, size_t(1));
 }
 
+// Estimates the number of groups from the HyperLogLog sketches of the chunks when a single table
+// is grouped by one of its columns, without filters. Saves the NDV estimation query. Returns 0
+// when some chunk has no sketch.
+size_t groups_approx_from_chunk_sketches(const RelAlgExecutionUnit& ra_exe_unit,
+                                         const std::vector<InputTableInfo>& table_infos) {
+  if (table_infos.size() != 1 || ra_exe_unit.groupby_exprs.size() != 1 || !ra_exe_unit.simple_quals.empty() ||
+      !ra_exe_unit.quals.empty()) {
+    return 0;
+  }
+  const auto groupby_expr = ra_exe_unit.groupby_exprs.front().get();
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(groupby_expr);
+  if (!col_var || dynamic_cast<const Analyzer::Var*>(groupby_expr) || col_var->get_table_id() <= 0) {
+    return 0;
+  }
+  ChunkSketch table_sketch;
+  for (const auto& fragment : table_infos.front().info.fragments) {
+    const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+    const auto chunk_meta_it = chunk_metadata_map.find(col_var->get_column_id());
+    if (chunk_meta_it == chunk_metadata_map.end() || !chunk_meta_it->second.chunkSketch) {
+      return 0;
+    }
+    table_sketch.unify(*chunk_meta_it->second.chunkSketch);
+  }
+  return table_sketch.approxDistinctCount();
+}
+
 bool can_use_scan_limit(const RelAlgExecutionUnit& ra_exe_unit) {
   for (const auto target_expr : ra_exe_unit.target_exprs) {
     if (dynamic_cast<const Analyzer::AggExpr*>(target_expr)) {
@@ -1434,8 +1462,11 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(const RelAlgExecutor::WorkUnit&
                                          groups_approx_upper_bound(table_infos) <= big_group_threshold),
               targets_meta};
   } catch (const CardinalityEstimationRequired&) {
-    max_groups_buffer_entry_guess =
-        2 * std::min(groups_approx_upper_bound(table_infos), getNDVEstimation(work_unit, is_agg, co, eo));
+    auto ndv_estimation = groups_approx_from_chunk_sketches(ra_exe_unit, table_infos);
+    if (!ndv_estimation) {
+      ndv_estimation = getNDVEstimation(work_unit, is_agg, co, eo);
+    }
+    max_groups_buffer_entry_guess = 2 * std::min(groups_approx_upper_bound(table_infos), ndv_estimation);
     CHECK_GT(max_groups_buffer_entry_guess, size_t(0));
     result = {executor_->executeWorkUnit(&error_code,
                                          max_groups_buffer_entry_guess,
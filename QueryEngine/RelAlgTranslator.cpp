@@ -195,6 +195,11 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateAggregateRex(
       }
     }
   }
+  if (arg_expr && arg_expr->get_type_info().is_dict_encoded_number() &&
+      (agg_kind == kSUM || agg_kind == kAVG || agg_kind == kMIN || agg_kind == kMAX)) {
+    // the counts only need the ids, the other aggregates the values
+    arg_expr = arg_expr->decompress();
+  }
   const auto agg_ti = get_agg_type(agg_kind, arg_expr.get());
   return makeExpr<Analyzer::AggExpr>(agg_ti, agg_kind, arg_expr, is_distinct, err_rate);
 }
@@ -302,7 +307,12 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateInput(const RexInput*
     if (rte_idx > 0 && join_type_ == JoinType::LEFT) {
       col_ti.set_notnull(false);
     }
-    return std::make_shared<Analyzer::ColumnVar>(col_ti, table_desc->tableId, cd->columnId, rte_idx);
+    auto col_var = std::make_shared<Analyzer::ColumnVar>(col_ti, table_desc->tableId, cd->columnId, rte_idx);
+    if (col_ti.is_dict_encoded_number() && col_ti.is_fp()) {
+      // dictionary encoding only saves storage for doubles, they're decoded when read
+      return col_var->decompress();
+    }
+    return col_var;
   }
   CHECK(!in_metainfo.empty());
   CHECK_GE(rte_idx, 0);
@@ -427,15 +437,19 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateInOper(const RexOpera
     throw std::runtime_error("EXPLAIN is not supported with sub-queries");
   }
   CHECK(rex_operator->size() == 2);
-  const auto lhs = translateScalarRex(rex_operator->getOperand(0));
+  auto lhs = translateScalarRex(rex_operator->getOperand(0));
   const auto rhs = rex_operator->getOperand(1);
   const auto rex_subquery = dynamic_cast<const RexSubQuery*>(rhs);
   CHECK(rex_subquery);
-  auto ti = lhs->get_type_info();
   auto result = rex_subquery->getExecutionResult();
   auto& row_set = result->getRows();
   CHECK_EQ(size_t(1), row_set->colCount());
   const auto& rhs_ti = row_set->getColType(0);
+  if (lhs->get_type_info().is_dict_encoded_number() || rhs_ti.is_dict_encoded_number()) {
+    // the values of the subquery are decoded, compare them with the decoded left hand side
+    lhs = lhs->decompress();
+  }
+  auto ti = lhs->get_type_info();
   if (rhs_ti.get_type() != ti.get_type()) {
     throw std::runtime_error("The two sides of the IN operator must have the same type; found " + ti.get_type_name() +
                              " and " + rhs_ti.get_type_name());
@@ -444,7 +458,7 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateInOper(const RexOpera
   if (row_set->entryCount() > 10000) {
     std::shared_ptr<Analyzer::Expr> expr;
     if ((ti.is_integer() || (ti.is_string() && ti.get_compression() == kENCODING_DICT)) &&
-        !row_set->getQueryMemDesc().output_columnar) {
+        !rhs_ti.is_dict_encoded_number() && !row_set->getQueryMemDesc().output_columnar) {
       expr = getInIntegerSetExpr(lhs, *row_set);
       // Handle the highly unlikely case when the InIntegerSet ended up being tiny.
       // Just let it fall through the usual InValues path at the end of this method,
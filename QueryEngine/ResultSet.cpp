@@ -656,6 +656,21 @@ std::function<bool(const uint32_t, const uint32_t)> ResultSet::createComparator(
           }
           return use_desc_cmp ? lhs_str > rhs_str : lhs_str < rhs_str;
         }
+        if (UNLIKELY(entry_ti.is_dict_encoded_number() && !is_distinct_target(targets_[order_entry.tle_no - 1]))) {
+          if (lhs_v.i1 == rhs_v.i1) {
+            continue;
+          }
+          const auto string_dict_proxy =
+              executor_->getStringDictionaryProxy(entry_ti.get_comp_param(), row_set_mem_owner_, false);
+          const auto lhs_bits = numeric_dict_bits(string_dict_proxy->getString(lhs_v.i1));
+          const auto rhs_bits = numeric_dict_bits(string_dict_proxy->getString(rhs_v.i1));
+          if (entry_ti.is_fp()) {
+            const auto lhs_dval = numeric_dict_double(lhs_bits);
+            const auto rhs_dval = numeric_dict_double(rhs_bits);
+            return use_desc_cmp ? lhs_dval > rhs_dval : lhs_dval < rhs_dval;
+          }
+          return use_desc_cmp ? lhs_bits > rhs_bits : lhs_bits < rhs_bits;
+        }
         if (UNLIKELY(is_distinct_target(targets_[order_entry.tle_no - 1]))) {
           const auto lhs_sz =
               count_distinct_set_size(lhs_v.i1, order_entry.tle_no - 1, query_mem_desc_.count_distinct_descriptors_);
@@ -501,6 +501,17 @@ int64_t lazy_decode(const ColumnLazyFetchInfo& col_lazy_fetch, const int8_t* byt
   }
   CHECK(type_info.is_integer() || type_info.is_decimal() || type_info.is_time() || type_info.is_boolean() ||
         type_info.is_string());
+  // these decoders already return the logical null value
+  if (type_info.get_compression() == kENCODING_RL) {
+    return run_length_int_decode_noinline(byte_stream, type_info.get_size(), pos);
+  }
+  if (type_info.get_compression() == kENCODING_DIFF) {
+    return diff_fixed_width_int_decode_noinline(byte_stream, type_info.get_size(), inline_int_null_val(type_info), pos);
+  }
+  if (type_info.get_compression() == kENCODING_PACKED) {
+    const auto val = packed_int_decode_noinline(byte_stream, type_info.get_comp_param(), pos);
+    return val == inline_fixed_encoding_null_val(type_info) ? inline_int_null_val(type_info) : val;
+  }
   size_t type_bitwidth = get_bit_width(type_info);
   if (type_info.get_compression() == kENCODING_FIXED) {
     type_bitwidth = type_info.get_comp_param();
@@ -764,6 +775,20 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
       }
     }
   }
+  if (chosen_type.is_dict_encoded_number() && !is_distinct_target(target_info)) {
+    if (!translate_strings) {
+      return static_cast<int64_t>(static_cast<int32_t>(ival));
+    }
+    if (static_cast<int32_t>(ival) == NULL_INT) {
+      return chosen_type.is_fp() ? TargetValue(NULL_DOUBLE)
+                                 : TargetValue(inline_int_null_val(SQLTypeInfo(chosen_type.get_type(), false)));
+    }
+    const auto sdp = executor_
+                         ? executor_->getStringDictionaryProxy(chosen_type.get_comp_param(), row_set_mem_owner_, false)
+                         : row_set_mem_owner_->getStringDictProxy(chosen_type.get_comp_param());
+    const auto bits = numeric_dict_bits(sdp->getString(ival));
+    return chosen_type.is_fp() ? TargetValue(numeric_dict_double(bits)) : TargetValue(bits);
+  }
   if (chosen_type.is_fp()) {
     switch (actual_compact_sz) {
       case 8: {
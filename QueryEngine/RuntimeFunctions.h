@@ -173,6 +173,17 @@ extern "C" int64_t fixed_width_unsigned_decode_noinline(const int8_t* byte_strea
                                                         const int32_t byte_width,
                                                         const int64_t pos);
 
+extern "C" int64_t diff_fixed_width_int_decode_noinline(const int8_t* byte_stream,
+                                                        const int32_t byte_width,
+                                                        const int64_t null_val,
+                                                        const int64_t pos);
+
+extern "C" int64_t run_length_int_decode_noinline(const int8_t* byte_stream,
+                                                  const int32_t slot_width,
+                                                  const int64_t pos);
+
+extern "C" int64_t packed_int_decode_noinline(const int8_t* byte_stream, const int32_t bit_width, const int64_t pos);
+
 extern "C" float fixed_width_float_decode_noinline(const int8_t* byte_stream, const int64_t pos);
 
 extern "C" double fixed_width_double_decode_noinline(const int8_t* byte_stream, const int64_t pos);
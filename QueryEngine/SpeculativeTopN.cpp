@@ -139,13 +139,18 @@ RowSetPtr SpeculativeTopNMap::asRows(const RelAlgExecutionUnit& ra_exe_unit,
 }
 
 void SpeculativeTopNBlacklist::add(const std::shared_ptr<Analyzer::Expr> expr, const bool desc) {
+  std::lock_guard<std::mutex> lock(mutex_);
   for (const auto e : blacklist_) {
-    CHECK(!(*e.first == *expr) || e.second != desc);
+    if (*e.first == *expr && e.second == desc) {
+      // a concurrent query has already found out the same thing
+      return;
+    }
   }
   blacklist_.emplace_back(expr, desc);
 }
 
 bool SpeculativeTopNBlacklist::contains(const std::shared_ptr<Analyzer::Expr> expr, const bool desc) const {
+  std::lock_guard<std::mutex> lock(mutex_);
   for (const auto e : blacklist_) {
     if (*e.first == *expr && e.second == desc) {
       return true;
@@ -28,6 +28,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <unordered_map>
 #include <vector>
@@ -88,6 +89,7 @@ class SpeculativeTopNBlacklist {
 
  private:
   std::vector<std::pair<std::shared_ptr<Analyzer::Expr>, bool>> blacklist_;
+  mutable std::mutex mutex_;
 };
 
 bool use_speculative_top_n(const RelAlgExecutionUnit&, const QueryMemoryDescriptor&);
@@ -85,7 +85,7 @@ inline bool detect_overflow_and_underflow(const T a,
 
 inline int64_t inline_int_null_val(const SQLTypeInfo& ti) {
   auto type = ti.is_decimal() ? decimal_to_int_type(ti) : ti.get_type();
-  if (ti.is_string()) {
+  if (ti.is_string() || ti.is_dict_encoded_number()) {
     CHECK_EQ(kENCODING_DICT, ti.get_compression());
     CHECK_EQ(4, ti.get_logical_size());
     type = kINT;
@@ -111,11 +111,13 @@ inline int64_t inline_int_null_val(const SQLTypeInfo& ti) {
 }
 
 inline int64_t inline_fixed_encoding_null_val(const SQLTypeInfo& ti) {
-  if (ti.get_compression() == kENCODING_NONE) {
+  // run length and differential encoders take the logical values, nulls included
+  if (ti.get_compression() == kENCODING_NONE || ti.get_compression() == kENCODING_RL ||
+      ti.get_compression() == kENCODING_DIFF) {
     return inline_int_null_val(ti);
   }
   if (ti.get_compression() == kENCODING_DICT) {
-    CHECK(ti.is_string());
+    CHECK(ti.is_string() || ti.is_dict_encoded_number());
     switch (ti.get_size()) {
       case 1:
         return inline_int_null_value<uint8_t>();
@@ -127,6 +129,10 @@ inline int64_t inline_fixed_encoding_null_val(const SQLTypeInfo& ti) {
         CHECK(false);
     }
   }
+  if (ti.get_compression() == kENCODING_PACKED) {
+    CHECK(ti.is_integer() || ti.is_time());
+    return -(1L << (ti.get_comp_param() - 1));
+  }
   CHECK_EQ(kENCODING_FIXED, ti.get_compression());
   CHECK(ti.is_integer() || ti.is_time() || ti.is_decimal());
   CHECK_EQ(0, ti.get_comp_param() % 8);
@@ -155,6 +161,9 @@ inline uint64_t exp_to_scale(const unsigned exp) {
 }
 
 inline size_t get_bit_width(const SQLTypeInfo& ti) {
+  if (ti.is_dict_encoded_number()) {
+    return 32;
+  }
   const auto int_type = ti.is_decimal() ? decimal_to_int_type(ti) : ti.get_type();
   switch (int_type) {
     case kBOOLEAN:
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkStealingPool.h"
+
+#include "../Shared/measure.h"
+#include "../Shared/thread_count.h"
+
+#include <glog/logging.h>
+
+namespace {
+
+// index of the worker owning the current thread, -1 for threads outside the pool
+thread_local ssize_t g_worker_idx{-1};
+
+}  // namespace
+
+void WorkStealingPool::TaskGroup::wait() {
+  if (g_worker_idx < 0) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_ == 0; });
+  } else {
+    auto& pool = WorkStealingPool::instance();
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!pending_) {
+          break;
+        }
+      }
+      if (!pool.tryRunTask(g_worker_idx)) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait_for(lock, std::chrono::milliseconds(1), [this] { return pending_ == 0; });
+      }
+    }
+  }
+}
+
+void WorkStealingPool::TaskGroup::taskDone() {
+  // notify under the lock, the waiter is free to destroy the group as soon as it sees no pending tasks
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK_GT(pending_, size_t(0));
+  --pending_;
+  done_cv_.notify_all();
+}
+
+void WorkStealingPool::init(const size_t thread_count) {
+  requested_thread_count_ = thread_count;
+}
+
+WorkStealingPool& WorkStealingPool::instance() {
+  static WorkStealingPool pool(requested_thread_count_ ? requested_thread_count_ : cpu_threads());
+  return pool;
+}
+
+WorkStealingPool::WorkStealingPool(const size_t thread_count)
+    : thread_count_(thread_count),
+      queued_tasks_(0),
+      shutdown_(false),
+      next_queue_(0),
+      tasks_submitted_(0),
+      tasks_executed_(0),
+      tasks_stolen_(0),
+      idle_time_us_(0) {
+  CHECK_GT(thread_count_, size_t(0));
+  for (size_t i = 0; i < thread_count_; ++i) {
+    queues_.emplace_back(new WorkerQueue());
+  }
+  for (size_t i = 0; i < thread_count_; ++i) {
+    workers_.emplace_back([this, i] { workerLoop(i); });
+  }
+  VLOG(1) << "Started " << thread_count_ << " fragment worker threads";
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    shutdown_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void WorkStealingPool::submit(TaskGroup& group, Task task) {
+  {
+    std::lock_guard<std::mutex> lock(group.mutex_);
+    ++group.pending_;
+  }
+  // account for the task before it becomes visible to the workers
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    ++queued_tasks_;
+  }
+  // tasks submitted by a worker stay local to it, everything else is spread round-robin
+  const size_t queue_idx = g_worker_idx >= 0 ? g_worker_idx : next_queue_++ % thread_count_;
+  {
+    auto& queue = *queues_[queue_idx];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.emplace_back([&group, task] {
+      task();
+      group.taskDone();
+    });
+  }
+  ++tasks_submitted_;
+  sleep_cv_.notify_one();
+}
+
+WorkStealingPool::Stats WorkStealingPool::getStats() const {
+  return {thread_count_, tasks_submitted_, tasks_executed_, tasks_stolen_, idle_time_us_ / 1000};
+}
+
+bool WorkStealingPool::tryRunTask(const size_t worker_idx) {
+  Task task;
+  {
+    auto& own_queue = *queues_[worker_idx];
+    std::lock_guard<std::mutex> lock(own_queue.mutex);
+    if (!own_queue.tasks.empty()) {
+      task = std::move(own_queue.tasks.back());
+      own_queue.tasks.pop_back();
+    }
+  }
+  if (!task) {
+    for (size_t i = 1; i < thread_count_ && !task; ++i) {
+      auto& victim_queue = *queues_[(worker_idx + i) % thread_count_];
+      std::lock_guard<std::mutex> lock(victim_queue.mutex);
+      if (!victim_queue.tasks.empty()) {
+        task = std::move(victim_queue.tasks.front());
+        victim_queue.tasks.pop_front();
+        ++tasks_stolen_;
+      }
+    }
+  }
+  if (!task) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    CHECK_GT(queued_tasks_, size_t(0));
+    --queued_tasks_;
+  }
+  task();
+  ++tasks_executed_;
+  return true;
+}
+
+void WorkStealingPool::workerLoop(const size_t worker_idx) {
+  g_worker_idx = worker_idx;
+  while (true) {
+    if (tryRunTask(worker_idx)) {
+      continue;
+    }
+    const auto clock_begin = timer_start();
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.wait(lock, [this] { return shutdown_ || queued_tasks_ > 0; });
+    idle_time_us_ += timer_stop<std::chrono::steady_clock::time_point, std::chrono::microseconds>(clock_begin);
+    if (shutdown_ && !queued_tasks_) {
+      return;
+    }
+  }
+}
+
+size_t WorkStealingPool::requested_thread_count_{0};
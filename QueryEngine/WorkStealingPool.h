@@ -0,0 +1,110 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    WorkStealingPool.h
+ * @brief   Process-wide pool of worker threads which run the fragment tasks of all queries.
+ *
+ * Every worker owns a deque of tasks. Workers pop their own tasks in LIFO order and
+ * steal from the front of the other deques when they run out of work.
+ */
+
+#ifndef QUERYENGINE_WORKSTEALINGPOOL_H
+#define QUERYENGINE_WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+ public:
+  typedef std::function<void()> Task;
+
+  // Tracks the completion of the tasks submitted by a single dispatch.
+  class TaskGroup {
+   public:
+    TaskGroup() : pending_(0) {}
+
+    // Blocks until all the tasks submitted with this group have run. A worker
+    // thread keeps running tasks while it waits, so nested dispatch can't deadlock.
+    void wait();
+
+   private:
+    void taskDone();
+
+    size_t pending_;
+    std::mutex mutex_;
+    std::condition_variable done_cv_;
+
+    friend class WorkStealingPool;
+  };
+
+  struct Stats {
+    size_t thread_count;
+    size_t tasks_submitted;
+    size_t tasks_executed;
+    size_t tasks_stolen;
+    int64_t idle_time_ms;
+  };
+
+  // Sets the number of worker threads, must be called before the first use of the pool.
+  static void init(const size_t thread_count);
+
+  static WorkStealingPool& instance();
+
+  ~WorkStealingPool();
+
+  void submit(TaskGroup& group, Task task);
+
+  Stats getStats() const;
+
+ private:
+  WorkStealingPool(const size_t thread_count);
+
+  struct WorkerQueue {
+    std::deque<Task> tasks;
+    std::mutex mutex;
+  };
+
+  void workerLoop(const size_t worker_idx);
+
+  bool tryRunTask(const size_t worker_idx);
+
+  const size_t thread_count_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  size_t queued_tasks_;
+  bool shutdown_;
+
+  std::atomic<size_t> next_queue_;
+  std::atomic<size_t> tasks_submitted_;
+  std::atomic<size_t> tasks_executed_;
+  std::atomic<size_t> tasks_stolen_;
+  std::atomic<int64_t> idle_time_us_;
+
+  static size_t requested_thread_count_;
+};
+
+#endif  // QUERYENGINE_WORKSTEALINGPOOL_H
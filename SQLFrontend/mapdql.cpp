@@ -1221,6 +1221,17 @@ void print_memory_info(ClientContext context, std::string memory_level) {
 
       tss << std::endl;
     }
+    if (!nodeIt.table_stats.empty()) {
+      tss << "DB_ID TABLE_ID         HITS       MISSES    EVICTIONS" << std::endl;
+      for (const auto& table_stats : nodeIt.table_stats) {
+        tss << std::setfill(' ') << std::setw(5) << table_stats.db_id;
+        tss << std::setfill(' ') << std::setw(9) << table_stats.table_id;
+        tss << std::setfill(' ') << std::setw(13) << table_stats.hits;
+        tss << std::setfill(' ') << std::setw(13) << table_stats.misses;
+        tss << std::setfill(' ') << std::setw(13) << table_stats.evictions;
+        tss << std::endl;
+      }
+    }
     tss << "---------------------------------------------------------------" << std::endl;
   }
   std::cout << tss.str() << std::endl;
@@ -1722,6 +1733,11 @@ int main(int argc, char** argv) {
         std::cout << "The Server Start Time      : " << buf << " : " << tm_ptr->tm_hour << ":" << tm_ptr->tm_min << ":"
                   << tm_ptr->tm_sec << std::endl;
         std::cout << "The Server edition         : " << server_version << std::endl;
+        std::cout << "Fragment Worker Threads    : " << context.cluster_status[0].fragment_worker_threads << std::endl;
+        std::cout << "Fragment Tasks (stolen)    : " << context.cluster_status[0].fragment_tasks_executed << " ("
+                  << context.cluster_status[0].fragment_tasks_stolen << ")" << std::endl;
+        std::cout << "Fragment Worker Idle Time  : " << context.cluster_status[0].fragment_worker_idle_ms << " ms"
+                  << std::endl;
 
         if (context.cluster_status.size() > 1) {
           std::cout << "The Number of Leaves       : " << context.cluster_status.size() - 1 << std::endl;
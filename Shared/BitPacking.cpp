@@ -0,0 +1,113 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BitPacking.h"
+
+#include <glog/logging.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HAVE_AVX2_UNPACK
+#endif
+
+namespace {
+
+template <typename T>
+void unpack_bits_scalar(const int8_t* packed, const int bit_width, const size_t start, const size_t count, T* out) {
+  const uint64_t mask = (uint64_t(1) << bit_width) - 1;
+  const uint64_t sign = uint64_t(1) << (bit_width - 1);
+  size_t bit = start * bit_width;
+  for (size_t i = 0; i < count; ++i, bit += bit_width) {
+    uint64_t word;
+    memcpy(&word, packed + (bit >> 3), sizeof(word));
+    const uint64_t val = (word >> (bit & 7)) & mask;
+    out[i] = static_cast<T>(static_cast<int64_t>((val ^ sign) - sign));
+  }
+}
+
+#ifdef HAVE_AVX2_UNPACK
+
+// Four values per iteration: gathers the 64-bit words holding them, shifts each by its own bit offset,
+// masks and sign extends. SSE4 has no per-lane 64-bit shifts, CPUs without AVX2 use the scalar loop.
+template <typename T>
+__attribute__((target("avx2"))) void unpack_bits_avx2(const int8_t* packed,
+                                                      const int bit_width,
+                                                      const size_t start,
+                                                      const size_t count,
+                                                      T* out) {
+  const int64_t bw = bit_width;
+  const __m256i mask = _mm256_set1_epi64x((int64_t(1) << bit_width) - 1);
+  const __m256i sign = _mm256_set1_epi64x(int64_t(1) << (bit_width - 1));
+  const __m256i seven = _mm256_set1_epi64x(7);
+  const __m256i step = _mm256_set1_epi64x(4 * bw);
+  __m256i bits = _mm256_add_epi64(_mm256_set1_epi64x(start * bw), _mm256_set_epi64x(3 * bw, 2 * bw, bw, 0));
+  alignas(32) int64_t vals[4];
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i words =
+        _mm256_i64gather_epi64(reinterpret_cast<const long long*>(packed), _mm256_srli_epi64(bits, 3), 1);
+    words = _mm256_and_si256(_mm256_srlv_epi64(words, _mm256_and_si256(bits, seven)), mask);
+    words = _mm256_sub_epi64(_mm256_xor_si256(words, sign), sign);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(vals), words);
+    for (size_t j = 0; j < 4; ++j) {
+      out[i + j] = static_cast<T>(vals[j]);
+    }
+    bits = _mm256_add_epi64(bits, step);
+  }
+  unpack_bits_scalar(packed, bit_width, start + i, count - i, out + i);
+}
+
+#endif  // HAVE_AVX2_UNPACK
+
+template <typename T>
+void unpack_bits_impl(const int8_t* packed, const int bit_width, const size_t start, const size_t count, T* out) {
+#ifdef HAVE_AVX2_UNPACK
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  if (has_avx2) {
+    unpack_bits_avx2(packed, bit_width, start, count, out);
+    return;
+  }
+#endif  // HAVE_AVX2_UNPACK
+  unpack_bits_scalar(packed, bit_width, start, count, out);
+}
+
+}  // namespace
+
+void unpack_bits(const int8_t* packed,
+                 const int bit_width,
+                 const size_t start,
+                 const size_t count,
+                 int8_t* out,
+                 const size_t out_width) {
+  CHECK_GT(bit_width, 0);
+  CHECK_LE(bit_width, MAX_PACKED_BIT_WIDTH);
+  switch (out_width) {
+    case 1:
+      unpack_bits_impl(packed, bit_width, start, count, out);
+      break;
+    case 2:
+      unpack_bits_impl(packed, bit_width, start, count, reinterpret_cast<int16_t*>(out));
+      break;
+    case 4:
+      unpack_bits_impl(packed, bit_width, start, count, reinterpret_cast<int32_t*>(out));
+      break;
+    case 8:
+      unpack_bits_impl(packed, bit_width, start, count, reinterpret_cast<int64_t*>(out));
+      break;
+    default:
+      CHECK(false);
+  }
+}
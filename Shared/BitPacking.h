@@ -0,0 +1,63 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    BitPacking.h
+ * @brief   Packing of integers on an arbitrary number of bits.
+ *
+ * Value i of a packed buffer occupies bits [i * bit_width, (i + 1) * bit_width), little endian,
+ * as a two's complement integer. Packed buffers are followed by PACKED_PADDING zero bytes so that
+ * every value can be read with a single, possibly unaligned, 64-bit load.
+ */
+
+#ifndef SHARED_BITPACKING_H
+#define SHARED_BITPACKING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+constexpr size_t PACKED_PADDING = sizeof(uint64_t);
+
+// The widest value which can be read with one 64-bit load whatever its bit offset in the first byte.
+constexpr int MAX_PACKED_BIT_WIDTH = 56;
+
+inline size_t packed_byte_size(const size_t num_elems, const int bit_width) {
+  return (num_elems * bit_width + 7) / 8;
+}
+
+// ORs the low bit_width bits of vals[0, count) into out, starting at bit first_bit.
+// The bytes of out the values land in must be zero, out must extend PACKED_PADDING bytes past them.
+inline void pack_bits(const int64_t* vals, const size_t count, const int bit_width, int8_t* out, size_t first_bit) {
+  const uint64_t mask = bit_width == 64 ? ~uint64_t(0) : (uint64_t(1) << bit_width) - 1;
+  for (size_t i = 0; i < count; ++i, first_bit += bit_width) {
+    uint64_t word;
+    memcpy(&word, out + (first_bit >> 3), sizeof(word));
+    word |= (static_cast<uint64_t>(vals[i]) & mask) << (first_bit & 7);
+    memcpy(out + (first_bit >> 3), &word, sizeof(word));
+  }
+}
+
+// Unpacks the values [start, start + count) of a packed buffer, sign extended, into out as integers of
+// out_width bytes. Uses AVX2 when the CPU supports it.
+void unpack_bits(const int8_t* packed,
+                 const int bit_width,
+                 const size_t start,
+                 const size_t count,
+                 int8_t* out,
+                 const size_t out_width);
+
+#endif  // SHARED_BITPACKING_H
@@ -37,6 +37,7 @@ struct MapDParameters {
   std::string ha_brokers;           // name of the HA broker
   std::string ha_shared_data;       // name of shared data directory base
   bool is_decr_start_epoch;         // are we doing a start epoch decrement?
+  size_t num_executor_threads = 0;  // number of fragment worker threads, 0 means one per cpu thread
 
   MapDParameters() : cuda_block_size(0), cuda_grid_size(0), calcite_max_mem(1024) {}
 };
@@ -117,7 +117,8 @@ enum EncodingType {
   kENCODING_DIFF = 3,    // Differential encoding
   kENCODING_DICT = 4,    // Dictionary encoding
   kENCODING_SPARSE = 5,  // Null encoding for sparse columns
-  kENCODING_LAST = 6
+  kENCODING_PACKED = 6,  // Bit-packed encoding
+  kENCODING_LAST = 7
 };
 
 #define IS_INTEGER(T) (((T) == kINT) || ((T) == kSMALLINT) || ((T) == kBIGINT))
@@ -200,7 +201,8 @@ class SQLTypeInfo {
   HOST DEVICE inline int get_comp_param() const { return comp_param; }
   HOST DEVICE inline int get_size() const { return size; }
   inline int get_logical_size() const {
-    if (compression == kENCODING_FIXED) {
+    if (compression == kENCODING_FIXED || compression == kENCODING_RL || compression == kENCODING_DIFF ||
+        compression == kENCODING_PACKED) {
       SQLTypeInfo ti(type, dimension, scale, notnull, kENCODING_NONE, 0, subtype);
       return ti.get_size();
     }
@@ -236,6 +238,7 @@ class SQLTypeInfo {
   inline bool is_number() const { return IS_NUMBER(type); }
   inline bool is_time() const { return IS_TIME(type); }
   inline bool is_boolean() const { return type == kBOOLEAN; }
+  inline bool is_dict_encoded_number() const { return compression == kENCODING_DICT && IS_NUMBER(type); }
   inline bool is_array() const { return type == kARRAY; }
   inline bool is_timeinterval() const { return type == kINTERVAL_DAY_TIME || type == kINTERVAL_YEAR_MONTH; }
 
@@ -378,17 +381,20 @@ class SQLTypeInfo {
   inline int get_storage_size() const {
     switch (type) {
       case kBOOLEAN:
-        return sizeof(int8_t);
+        // run length encoding stores the runs in slots of at least 4 bytes, see RunLengthEncoder
+        return compression == kENCODING_RL ? sizeof(int32_t) : sizeof(int8_t);
       case kSMALLINT:
         switch (compression) {
           case kENCODING_NONE:
             return sizeof(int16_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
+          case kENCODING_DIFF:
             return comp_param / 8;
           case kENCODING_RL:
-          case kENCODING_DIFF:
-            break;
+            return sizeof(int32_t);
+          case kENCODING_PACKED:
+            return get_packed_slot_size();
           default:
             assert(false);
         }
@@ -399,10 +405,14 @@ class SQLTypeInfo {
             return sizeof(int32_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
+          case kENCODING_DIFF:
             return comp_param / 8;
           case kENCODING_RL:
-          case kENCODING_DIFF:
-            break;
+            return sizeof(int32_t);
+          case kENCODING_PACKED:
+            return get_packed_slot_size();
+          case kENCODING_DICT:
+            return sizeof(int32_t);  // the dictionary ids, the catalog narrows it like for strings
           default:
             assert(false);
         }
@@ -415,10 +425,14 @@ class SQLTypeInfo {
             return sizeof(int64_t);
           case kENCODING_FIXED:
           case kENCODING_SPARSE:
+          case kENCODING_DIFF:
             return comp_param / 8;
           case kENCODING_RL:
-          case kENCODING_DIFF:
-            break;
+            return sizeof(int64_t);
+          case kENCODING_PACKED:
+            return get_packed_slot_size();
+          case kENCODING_DICT:
+            return sizeof(int32_t);
           default:
             assert(false);
         }
@@ -441,6 +455,8 @@ class SQLTypeInfo {
         switch (compression) {
           case kENCODING_NONE:
             return sizeof(double);
+          case kENCODING_DICT:
+            return sizeof(int32_t);
           case kENCODING_FIXED:
           case kENCODING_RL:
           case kENCODING_DIFF:
@@ -460,11 +476,13 @@ class SQLTypeInfo {
       case kDATE:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
             return sizeof(time_t);
           case kENCODING_FIXED:
-            return comp_param / 8;
-          case kENCODING_RL:
           case kENCODING_DIFF:
+            return comp_param / 8;
+          case kENCODING_PACKED:
+            return get_packed_slot_size();
           case kENCODING_SPARSE:
             assert(false);
             break;
@@ -483,6 +501,11 @@ class SQLTypeInfo {
     }
     return -1;
   }
+  // bit-packed values are unpacked to the smallest integer which holds comp_param bits
+  inline int get_packed_slot_size() const {
+    return comp_param <= 8 ? sizeof(int8_t)
+                           : comp_param <= 16 ? sizeof(int16_t) : comp_param <= 32 ? sizeof(int32_t) : sizeof(int64_t);
+  }
 };
 
 SQLTypes decimal_to_int_type(const SQLTypeInfo&);
@@ -501,7 +524,8 @@ int64_t convert_decimal_value_to_scale(const int64_t decimal_value,
 
 inline SQLTypeInfo get_logical_type_info(const SQLTypeInfo& type_info) {
   EncodingType encoding = type_info.get_compression();
-  if (encoding == kENCODING_FIXED) {
+  if (encoding == kENCODING_FIXED || encoding == kENCODING_RL || encoding == kENCODING_DIFF ||
+      encoding == kENCODING_PACKED) {
     encoding = kENCODING_NONE;
   }
   return SQLTypeInfo(type_info.get_type(),
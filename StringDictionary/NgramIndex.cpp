@@ -0,0 +1,270 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    NgramIndex.cpp
+ * @brief   Trigram inverted index of the strings of a dictionary.
+ */
+
+#include "NgramIndex.h"
+
+#include "../QueryEngine/MurmurHash1Inl.h"
+
+#include <boost/filesystem.hpp>
+#include <glog/logging.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+bool g_enable_string_dictionary_ngram_index{false};
+
+namespace {
+
+const uint32_t NGRAM_INDEX_MAGIC{0x4e474958};  // "NGIX"
+const uint32_t NGRAM_INDEX_VERSION{1};
+
+// The index is a NgramIndexHeader, then numNgrams posting lists, each a NgramIndexPostingRecord
+// followed by count ids, and a checksum of all of the above.
+struct NgramIndexHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t generation;
+  uint64_t numNgrams;
+};
+
+struct NgramIndexPostingRecord {
+  uint32_t ngram;
+  uint32_t count;
+};
+
+template <typename T>
+void append_value(std::vector<int8_t>& buf, const T& val) {
+  const auto pos = buf.size();
+  buf.resize(pos + sizeof(T));
+  memcpy(&buf[pos], &val, sizeof(T));
+}
+
+template <typename T>
+bool read_value(const std::vector<int8_t>& buf, size_t& pos, T& val) {
+  if (pos + sizeof(T) > buf.size()) {
+    return false;
+  }
+  memcpy(&val, &buf[pos], sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+uint32_t lowercase(const char c) {
+  return static_cast<unsigned char>('A' <= c && c <= 'Z' ? 'a' + (c - 'A') : c);
+}
+
+uint32_t trigram(const char* str) {
+  return (lowercase(str[0]) << 16) | (lowercase(str[1]) << 8) | lowercase(str[2]);
+}
+
+}  // namespace
+
+void NgramIndex::add(const char* str, const size_t len) {
+  const auto string_id = static_cast<int32_t>(generation_);
+  for (size_t i = 0; i + 3 <= len; ++i) {
+    auto& posting = postings_[trigram(str + i)];
+    if (posting.empty() || posting.back() != string_id) {
+      posting.push_back(string_id);
+    }
+  }
+  ++generation_;
+}
+
+bool NgramIndex::getCandidates(std::vector<int32_t>& candidates,
+                               const std::vector<std::string>& literals,
+                               const size_t start,
+                               const size_t end) const {
+  CHECK_LE(end, generation_);
+  std::vector<uint32_t> ngrams;
+  for (const auto& literal : literals) {
+    for (size_t i = 0; i + 3 <= literal.size(); ++i) {
+      ngrams.push_back(trigram(literal.data() + i));
+    }
+  }
+  if (ngrams.empty()) {
+    return false;
+  }
+  std::sort(ngrams.begin(), ngrams.end());
+  ngrams.erase(std::unique(ngrams.begin(), ngrams.end()), ngrams.end());
+  std::vector<const std::vector<int32_t>*> postings;
+  for (const auto ngram : ngrams) {
+    const auto it = postings_.find(ngram);
+    if (it == postings_.end()) {
+      return true;
+    }
+    postings.push_back(&it->second);
+  }
+  // start from the rarest trigram, the intersection only shrinks
+  std::sort(postings.begin(),
+            postings.end(),
+            [](const std::vector<int32_t>* lhs, const std::vector<int32_t>* rhs) { return lhs->size() < rhs->size(); });
+  const auto range_begin = [start](const std::vector<int32_t>& posting) {
+    return std::lower_bound(posting.begin(), posting.end(), static_cast<int32_t>(start));
+  };
+  const auto range_end = [end](const std::vector<int32_t>& posting) {
+    return std::lower_bound(posting.begin(), posting.end(), static_cast<int32_t>(end));
+  };
+  candidates.assign(range_begin(*postings.front()), range_end(*postings.front()));
+  std::vector<int32_t> intersection;
+  for (size_t i = 1; i < postings.size() && !candidates.empty(); ++i) {
+    intersection.clear();
+    std::set_intersection(candidates.begin(),
+                          candidates.end(),
+                          range_begin(*postings[i]),
+                          range_end(*postings[i]),
+                          std::back_inserter(intersection));
+    candidates.swap(intersection);
+  }
+  return true;
+}
+
+bool NgramIndex::read(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  const auto size = lseek(fd, 0, SEEK_END);
+  std::vector<int8_t> buf(size > 0 ? size : 0);
+  size_t numRead = 0;
+  while (numRead < buf.size()) {
+    const auto status = pread(fd, &buf[numRead], buf.size() - numRead, numRead);
+    if (status <= 0) {
+      break;
+    }
+    numRead += status;
+  }
+  ::close(fd);
+  if (numRead < buf.size() || buf.size() < sizeof(NgramIndexHeader) + sizeof(uint64_t)) {
+    return false;
+  }
+  const size_t bodySize = buf.size() - sizeof(uint64_t);
+  uint64_t checksum;
+  memcpy(&checksum, &buf[bodySize], sizeof(checksum));
+  if (checksum != MurmurHash64AImpl(&buf[0], bodySize, 0)) {
+    LOG(WARNING) << "N-gram index '" << path << "' is corrupt, it will be rebuilt";
+    return false;
+  }
+  buf.resize(bodySize);
+  size_t pos = 0;
+  NgramIndexHeader header;
+  read_value(buf, pos, header);
+  if (header.magic != NGRAM_INDEX_MAGIC || header.version != NGRAM_INDEX_VERSION) {
+    return false;
+  }
+  decltype(postings_) postings;
+  postings.reserve(header.numNgrams);
+  for (uint64_t i = 0; i < header.numNgrams; ++i) {
+    NgramIndexPostingRecord record;
+    if (!read_value(buf, pos, record) || pos + record.count * sizeof(int32_t) > buf.size()) {
+      return false;
+    }
+    auto& posting = postings[record.ngram];
+    posting.resize(record.count);
+    memcpy(posting.data(), &buf[pos], record.count * sizeof(int32_t));
+    pos += record.count * sizeof(int32_t);
+  }
+  if (pos != buf.size()) {
+    return false;
+  }
+  postings_.swap(postings);
+  generation_ = header.generation;
+  return true;
+}
+
+bool NgramIndex::write(const std::string& path) const {
+  std::vector<int8_t> buf;
+  append_value(buf, NgramIndexHeader{NGRAM_INDEX_MAGIC, NGRAM_INDEX_VERSION, generation_, postings_.size()});
+  for (const auto& kv : postings_) {
+    append_value(buf, NgramIndexPostingRecord{kv.first, static_cast<uint32_t>(kv.second.size())});
+    const auto pos = buf.size();
+    buf.resize(pos + kv.second.size() * sizeof(int32_t));
+    memcpy(&buf[pos], kv.second.data(), kv.second.size() * sizeof(int32_t));
+  }
+  append_value(buf, MurmurHash64AImpl(&buf[0], buf.size(), 0));
+
+  // written aside and renamed over the index, a crash leaves either the old or the new one
+  const std::string tmpPath(path + ".tmp");
+  const int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG(WARNING) << "Could not create n-gram index '" << tmpPath << "', the errno is " << errno;
+    return false;
+  }
+  size_t numWritten = 0;
+  while (numWritten < buf.size()) {
+    const auto status = ::write(fd, &buf[numWritten], buf.size() - numWritten);
+    if (status < 0 && errno == EINTR) {
+      continue;
+    }
+    if (status <= 0) {
+      break;
+    }
+    numWritten += status;
+  }
+  const bool synced = numWritten == buf.size() && fsync(fd) == 0;
+  ::close(fd);
+  boost::system::error_code ec;
+  if (!synced) {
+    LOG(WARNING) << "Could not write n-gram index '" << tmpPath << "', the errno is " << errno;
+    boost::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+  boost::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    LOG(WARNING) << "Could not rename n-gram index '" << tmpPath << "': " << ec.message();
+    return false;
+  }
+  return true;
+}
+
+std::vector<std::string> like_pattern_literals(const std::string& pattern, const bool is_simple, const char escape) {
+  if (is_simple) {
+    return {pattern};
+  }
+  std::vector<std::string> literals;
+  std::string literal;
+  const auto end_literal = [&literals, &literal]() {
+    if (!literal.empty()) {
+      literals.push_back(literal);
+      literal.clear();
+    }
+  };
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == escape && i + 1 < pattern.size()) {
+      literal.push_back(pattern[++i]);
+    } else if (c == '%' || c == '_') {
+      end_literal();
+    } else if (c == '[') {
+      // a set of characters matches a single one of them
+      end_literal();
+      while (i < pattern.size() && pattern[i] != ']') {
+        ++i;
+      }
+    } else {
+      literal.push_back(c);
+    }
+  }
+  end_literal();
+  return literals;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    NgramIndex.h
+ * @brief   Trigram inverted index of the strings of a dictionary.
+ *
+ * A LIKE '%term%' used to run the matcher over every string of the dictionary. The index maps
+ * each trigram of the lowercased strings to the ascending ids of the strings containing it, so
+ * that only the strings holding all the trigrams of the literals of a pattern are matched. It
+ * is maintained as strings are added and saved next to the payload and offsets files at
+ * checkpoints; on open, the strings added after the last checkpoint are indexed again. The
+ * posting lists take about four bytes per trigram of every string, the index is only built if
+ * g_enable_string_dictionary_ngram_index is set when the dictionary is opened.
+ */
+
+#ifndef STRINGDICTIONARY_NGRAMINDEX_H
+#define STRINGDICTIONARY_NGRAMINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern bool g_enable_string_dictionary_ngram_index;
+
+class NgramIndex {
+ public:
+  NgramIndex() : generation_(0) {}
+
+  // Indexes the string with the next id, the strings must be added in id order.
+  void add(const char* str, const size_t len);
+
+  // Number of strings indexed.
+  size_t generation() const { return generation_; }
+
+  /**
+   * @brief Collects the ids in [start, end) of the strings holding all the trigrams of literals
+   *
+   * The candidates are ascending and a superset of the matches, they still have to be checked.
+   * Returns false if the literals have no trigram, every string is a candidate then.
+   */
+  bool getCandidates(std::vector<int32_t>& candidates,
+                     const std::vector<std::string>& literals,
+                     const size_t start,
+                     const size_t end) const;
+
+  // Returns false if the index at path doesn't exist or is corrupt.
+  bool read(const std::string& path);
+
+  // Atomically replaces the index at path.
+  bool write(const std::string& path) const;
+
+ private:
+  std::unordered_map<uint32_t, std::vector<int32_t>> postings_;
+  size_t generation_;
+};
+
+// The runs of literal characters of a LIKE pattern, the whole pattern if it's simple.
+std::vector<std::string> like_pattern_literals(const std::string& pattern, const bool is_simple, const char escape);
+
+#endif  // STRINGDICTIONARY_NGRAMINDEX_H
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    NumericDictionary.h
+ * @brief   Keys of the dictionaries of dictionary encoded numeric columns.
+ *
+ * An INTEGER, BIGINT or DOUBLE column declared with ENCODING DICT stores dense ids like a
+ * dictionary encoded string column, and its StringDictionary holds the distinct values. Each
+ * value is kept as the 8 bytes of its bits: integers sign extended to 64 bits, doubles as
+ * their IEEE representation with negative zero folded into zero. The empty string stands for
+ * null, the same way it does for strings.
+ */
+
+#ifndef STRINGDICTIONARY_NUMERICDICTIONARY_H
+#define STRINGDICTIONARY_NUMERICDICTIONARY_H
+
+#include "../Shared/sqltypes.h"
+
+#include <glog/logging.h>
+
+#include <cstring>
+#include <string>
+
+inline int64_t numeric_dict_bits(const double val) {
+  const double normalized = val == 0 ? 0. : val;
+  int64_t bits;
+  memcpy(&bits, &normalized, sizeof(bits));
+  return bits;
+}
+
+inline double numeric_dict_double(const int64_t bits) {
+  double val;
+  memcpy(&val, &bits, sizeof(val));
+  return val;
+}
+
+inline int64_t numeric_dict_bits(const Datum d, const SQLTypeInfo& ti) {
+  switch (ti.get_type()) {
+    case kINT:
+      return d.intval;
+    case kBIGINT:
+      return d.bigintval;
+    case kDOUBLE:
+      return numeric_dict_bits(d.doubleval);
+    default:
+      CHECK(false);
+  }
+  return 0;
+}
+
+inline std::string numeric_dict_key(const int64_t bits) {
+  return std::string(reinterpret_cast<const char*>(&bits), sizeof(bits));
+}
+
+inline int64_t numeric_dict_bits(const std::string& key) {
+  CHECK_EQ(sizeof(int64_t), key.size());
+  int64_t bits;
+  memcpy(&bits, key.data(), sizeof(bits));
+  return bits;
+}
+
+#endif  // STRINGDICTIONARY_NUMERICDICTIONARY_H
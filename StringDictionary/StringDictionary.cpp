@@ -15,7 +15,9 @@
  */
 
 #include "StringDictionary.h"
+#include "NgramIndex.h"
 #include "StringDictionaryClient.h"
+#include "../QueryEngine/MurmurHash1Inl.h"
 #include "../Shared/sqltypes.h"
 #include "../Utils/StringLike.h"
 #include "../Utils/Regexp.h"
@@ -26,6 +28,7 @@
 #include <glog/logging.h>
 #include <sys/fcntl.h>
 
+#include <algorithm>
 #include <thread>
 #include <future>
 
@@ -80,22 +83,26 @@ const uint32_t round_up_p2(const size_t num) {
   return in;
 }
 
-size_t rk_hash(const std::string& str) {
-  size_t str_hash = 1;
-  for (size_t i = 0; i < str.size(); ++i) {
-    str_hash = str_hash * 997 + str[i];
-  }
-  return str_hash;
+// The low bits pick the bucket, all of them are kept in it to reject most mismatches without
+// reading the payload and to rehash without reading the strings.
+uint32_t hash_string(const char* str, const size_t len) {
+  return MurmurHash64AImpl(str, len, 0);
+}
+
+uint32_t hash_string(const std::string& str) {
+  return hash_string(str.data(), str.size());
 }
 }  // namespace
 
+size_t g_string_dictionary_like_cache_max_size{256 * 1024 * 1024};
+
 const int32_t StringDictionary::INVALID_STR_ID{-1};
 
 StringDictionary::StringDictionary(const std::string& folder,
                                    const bool isTemp,
                                    const bool recover,
                                    size_t initial_capacity) noexcept : str_count_(0),
-                                                                       str_ids_(initial_capacity, INVALID_STR_ID),
+                                                                       str_ids_(initial_capacity, {INVALID_STR_ID, 0}),
                                                                        isTemp_(isTemp),
                                                                        payload_fd_(-1),
                                                                        offset_fd_(-1),
@@ -104,7 +111,13 @@ StringDictionary::StringDictionary(const std::string& folder,
                                                                        offset_file_size_(0),
                                                                        payload_file_size_(0),
                                                                        payload_file_off_(0),
-                                                                       strings_cache_(nullptr) {
+                                                                       like_cache_size_(0),
+                                                                       like_cache_hits_(0),
+                                                                       like_cache_extensions_(0),
+                                                                       like_cache_misses_(0),
+                                                                       like_cache_evictions_(0),
+                                                                       strings_cache_(nullptr),
+                                                                       ngram_index_checkpointed_generation_(0) {
   if (!isTemp && folder.empty()) {
     return;
   }
@@ -114,6 +127,7 @@ StringDictionary::StringDictionary(const std::string& folder,
     boost::filesystem::path storage_path(folder);
     offsets_path_ = (storage_path / boost::filesystem::path("DictOffsets")).string();
     const auto payload_path = (storage_path / boost::filesystem::path("DictPayload")).string();
+    ngram_index_path_ = (storage_path / boost::filesystem::path("DictNgrams")).string();
     payload_fd_ = checked_open(payload_path.c_str(), recover);
     offset_fd_ = checked_open(offsets_path_.c_str(), recover);
     payload_file_size_ = file_size(payload_fd_);
@@ -138,7 +152,7 @@ StringDictionary::StringDictionary(const std::string& folder,
       // at this point we know the size of the StringDict we need to load
       // so lets reallocate the vector to the correct size
       const uint32_t max_entries = round_up_p2(str_count * 2 + 1);
-      std::vector<int32_t> new_str_ids(max_entries, INVALID_STR_ID);
+      std::vector<HashBucket> new_str_ids(max_entries, HashBucket{INVALID_STR_ID, 0});
       str_ids_.swap(new_str_ids);
       unsigned string_id = 0;
       mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
@@ -155,8 +169,8 @@ StringDictionary::StringDictionary(const std::string& folder,
               // hit the canary, recovery finished
               break;
             } else {
-              std::string temp = std::string(std::get<0>(recovered), std::get<1>(recovered));
-              hashVec.emplace_back(std::make_pair(rk_hash(temp), temp.size()));
+              hashVec.emplace_back(
+                  std::make_pair(hash_string(std::get<0>(recovered), std::get<1>(recovered)), std::get<1>(recovered)));
             }
           }
           return hashVec;
@@ -172,6 +186,25 @@ StringDictionary::StringDictionary(const std::string& folder,
       }
     }
   }
+  if (!isTemp_) {
+    if (!recover) {
+      // the payload has just been truncated, so has the index
+      boost::system::error_code ec;
+      boost::filesystem::remove(ngram_index_path_, ec);
+    }
+    if (g_enable_string_dictionary_ngram_index) {
+      ngram_index_.reset(new NgramIndex());
+      // the index can't be ahead of the strings it was saved with, unless they got lost in a crash
+      if (!recover || !ngram_index_->read(ngram_index_path_) || ngram_index_->generation() > str_count_) {
+        ngram_index_.reset(new NgramIndex());
+      }
+      ngram_index_checkpointed_generation_ = ngram_index_->generation();
+      for (size_t string_id = ngram_index_->generation(); string_id < str_count_; ++string_id) {
+        const auto str_bytes = getStringBytesChecked(string_id);
+        ngram_index_->add(str_bytes.first, str_bytes.second);
+      }
+    }
+  }
 }
 
 void StringDictionary::processDictionaryFutures(
@@ -180,9 +213,9 @@ void StringDictionary::processDictionaryFutures(
     dictionary_future.wait();
     auto hashVec = dictionary_future.get();
     for (auto& hash : hashVec) {
-      int32_t bucket = computeUniqueBucketWithHash(hash.first, str_ids_);
+      const auto bucket = computeUniqueBucketWithHash(hash.first, str_ids_);
       payload_file_off_ += hash.second;
-      str_ids_[bucket] = static_cast<int32_t>(str_count_);
+      str_ids_[bucket] = {static_cast<int32_t>(str_count_), hash.first};
       ++str_count_;
     }
   }
@@ -190,7 +223,13 @@ void StringDictionary::processDictionaryFutures(
 }
 
 StringDictionary::StringDictionary(const LeafHostInfo& host, const int dict_id)
-    : strings_cache_(nullptr),
+    : like_cache_size_(0),
+      like_cache_hits_(0),
+      like_cache_extensions_(0),
+      like_cache_misses_(0),
+      like_cache_evictions_(0),
+      strings_cache_(nullptr),
+      ngram_index_checkpointed_generation_(0),
       client_(new StringDictionaryClient(host, dict_id, true)),
       client_no_timeout_(new StringDictionaryClient(host, dict_id, false)) {}
 
@@ -242,19 +281,46 @@ void StringDictionary::getOrAddBulk(const std::vector<std::string>& string_vec,
     getOrAddBulkRemote(string_vec, encoded_vec);
     return;
   }
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
-  size_t out_idx{0};
-  for (const auto& str : string_vec) {
-    const auto string_id = getOrAddImpl(str, false);
+  const auto encode = [&string_vec, encoded_vec](const size_t idx, const int32_t string_id) {
     const bool invalid = string_id > max_valid_int_value<T>();
     if (invalid || string_id == inline_int_null_value<int32_t>()) {
       if (invalid) {
-        log_encoding_error<T>(str);
+        log_encoding_error<T>(string_vec[idx]);
       }
-      encoded_vec[out_idx++] = inline_int_null_value<T>();
-      continue;
+      encoded_vec[idx] = inline_int_null_value<T>();
+      return;
+    }
+    encoded_vec[idx] = string_id;
+  };
+  std::vector<uint32_t> hashes(string_vec.size());
+  for (size_t idx = 0; idx < string_vec.size(); ++idx) {
+    hashes[idx] = hash_string(string_vec[idx]);
+  }
+  // the strings already in the dictionary are looked up by all the import threads at once
+  std::vector<size_t> new_idxs;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    for (size_t idx = 0; idx < string_vec.size(); ++idx) {
+      const auto& str = string_vec[idx];
+      if (str.empty()) {
+        encode(idx, inline_int_null_value<int32_t>());
+        continue;
+      }
+      const auto string_id = str_ids_[computeBucket(hashes[idx], str, str_ids_)].id;
+      if (string_id == INVALID_STR_ID) {
+        new_idxs.push_back(idx);
+        continue;
+      }
+      encode(idx, string_id);
     }
-    encoded_vec[out_idx++] = string_id;
+  }
+  if (new_idxs.empty()) {
+    return;
+  }
+  // the new ones get their ids in a single exclusive section, another thread could have added some meanwhile
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  for (const auto idx : new_idxs) {
+    encode(idx, getOrAddImpl(string_vec[idx], hashes[idx], false));
   }
 }
 
@@ -295,8 +361,7 @@ int32_t StringDictionary::getIdOfString(const std::string& str) const {
 }
 
 int32_t StringDictionary::getUnlocked(const std::string& str) const noexcept {
-  auto str_id = str_ids_[computeBucket(str, str_ids_, false)];
-  return str_id;
+  return str_ids_[computeBucket(hash_string(str), str, str_ids_)].id;
 }
 
 std::string StringDictionary::getString(int32_t string_id) const {
@@ -350,42 +415,16 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
                                                const bool is_simple,
                                                const char escape,
                                                const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
     return client_->get_like(pattern, icase, is_simple, escape, generation);
   }
-  const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape);
-  const auto it = like_cache_.find(cache_key);
-  if (it != like_cache_.end()) {
-    return it->second;
-  }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
-  CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back(
-        [&worker_results, &pattern, generation, icase, is_simple, escape, worker_idx, worker_count, this]() {
-          for (size_t string_id = worker_idx; string_id < generation; string_id += worker_count) {
-            const auto str = getStringUnlocked(string_id);
-            if (is_like(str, pattern, icase, is_simple, escape)) {
-              worker_results[worker_idx].push_back(string_id);
-            }
-          }
-        });
-  }
-  for (auto& worker : workers) {
-    worker.join();
-  }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
-  }
-  // place result into cache for reuse if similar query
-  const auto it_ok = like_cache_.insert(std::make_pair(cache_key, result));
-  CHECK(it_ok.second);
-  return result;
+  return getMatchingIds(std::make_tuple(pattern, false, icase, is_simple, escape),
+                        generation,
+                        [&pattern, icase, is_simple, escape](const std::string& str) {
+                          return is_like(str, pattern, icase, is_simple, escape);
+                        },
+                        like_pattern_literals(pattern, is_simple, escape));
 }
 
 namespace {
@@ -399,40 +438,157 @@ bool is_regexp_like(const std::string& str, const std::string& pattern, const ch
 std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
                                                      const char escape,
                                                      const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
     return client_->get_regexp_like(pattern, escape, generation);
   }
-  const auto cache_key = std::make_pair(pattern, escape);
-  const auto it = regex_cache_.find(cache_key);
-  if (it != regex_cache_.end()) {
-    return it->second;
-  }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
+  return getMatchingIds(std::make_tuple(pattern, true, false, false, escape),
+                        generation,
+                        [&pattern, escape](const std::string& str) { return is_regexp_like(str, pattern, escape); },
+                        {});
+}
+
+StringDictionary::LikeCacheStats StringDictionary::getLikeCacheStats() const {
+  std::lock_guard<std::mutex> lock(like_cache_mutex_);
+  return {like_cache_.size(),
+          like_cache_size_,
+          g_string_dictionary_like_cache_max_size,
+          like_cache_hits_,
+          like_cache_extensions_,
+          like_cache_misses_,
+          like_cache_evictions_};
+}
+
+namespace {
+
+size_t like_cache_entry_size(const std::tuple<std::string, bool, bool, bool, char>& key,
+                             const std::vector<int32_t>& ids) {
+  return std::get<0>(key).size() + ids.size() * sizeof(int32_t);
+}
+
+}  // namespace
+
+// Must be called with rw_mutex_ held, shared or exclusive.
+template <class Matcher>
+std::vector<int32_t> StringDictionary::getMatchingIds(const LikeCacheKey& key,
+                                                      const size_t generation,
+                                                      Matcher matcher,
+                                                      const std::vector<std::string>& literals) const {
   CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results, &pattern, generation, escape, worker_idx, worker_count, this]() {
-      for (size_t string_id = worker_idx; string_id < generation; string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_regexp_like(str, pattern, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
+  std::shared_ptr<const std::vector<int32_t>> cached_ids;
+  size_t cached_generation = 0;
+  {
+    std::lock_guard<std::mutex> lock(like_cache_mutex_);
+    const auto it = like_cache_.find(key);
+    if (it != like_cache_.end()) {
+      like_cache_lru_.splice(like_cache_lru_.begin(), like_cache_lru_, it->second.lru_it);
+      cached_ids = it->second.ids;
+      cached_generation = it->second.generation;
+      if (cached_generation >= generation) {
+        ++like_cache_hits_;
+      }
+    }
+  }
+  if (cached_ids && cached_generation >= generation) {
+    // an older proxy sees fewer strings, leave out the ids added after its generation
+    return std::vector<int32_t>(
+        cached_ids->begin(),
+        std::lower_bound(cached_ids->begin(), cached_ids->end(), static_cast<int32_t>(generation)));
+  }
+  auto ids = std::make_shared<std::vector<int32_t>>();
+  if (cached_ids) {
+    *ids = *cached_ids;
+  }
+  appendMatchingIds(*ids, cached_generation, generation, matcher, literals);
+  std::lock_guard<std::mutex> lock(like_cache_mutex_);
+  ++(cached_ids ? like_cache_extensions_ : like_cache_misses_);
+  const auto entry_size = like_cache_entry_size(key, *ids);
+  if (entry_size > g_string_dictionary_like_cache_max_size) {
+    return *ids;
+  }
+  auto it = like_cache_.find(key);
+  if (it == like_cache_.end()) {
+    it = like_cache_.emplace(key, LikeCacheEntry{nullptr, 0, like_cache_lru_.end()}).first;
+    like_cache_lru_.push_front(&it->first);
+    it->second.lru_it = like_cache_lru_.begin();
+  } else if (it->second.generation >= generation) {
+    // a concurrent scan got as far already
+    return *ids;
+  } else {
+    like_cache_size_ -= like_cache_entry_size(key, *it->second.ids);
+  }
+  it->second.ids = ids;
+  it->second.generation = generation;
+  like_cache_size_ += entry_size;
+  evictLikeCacheOverBudget();
+  return *ids;
+}
+
+// Appends the ids in [start, end) of the strings accepted by matcher, in ascending order. The
+// strings have to contain the literals, only the ones the n-gram index lists are checked.
+template <class Matcher>
+void StringDictionary::appendMatchingIds(std::vector<int32_t>& ids,
+                                         const size_t start,
+                                         const size_t end,
+                                         Matcher matcher,
+                                         const std::vector<std::string>& literals) const {
+  CHECK_LE(start, end);
+  std::vector<int32_t> candidates;
+  if (ngram_index_ && ngram_index_->getCandidates(candidates, literals, start, end)) {
+    for (const auto string_id : candidates) {
+      if (matcher(getStringUnlocked(string_id))) {
+        ids.push_back(string_id);
       }
-    });
+    }
+    return;
   }
-  for (auto& worker : workers) {
-    worker.join();
+  const bool multithreaded = end - start > 10000;
+  const auto worker_count = multithreaded ? static_cast<size_t>(cpu_threads()) : size_t(1);
+  CHECK_GT(worker_count, size_t(0));
+  std::vector<std::vector<int32_t>> worker_results(worker_count);
+  auto match = [&matcher, this](std::vector<int32_t>& result, const size_t start_id, const size_t end_id) {
+    for (size_t string_id = start_id; string_id < end_id; ++string_id) {
+      if (matcher(getStringUnlocked(string_id))) {
+        result.push_back(string_id);
+      }
+    }
+  };
+  if (multithreaded) {
+    // contiguous ranges of ids keep the concatenated result sorted
+    std::vector<std::future<void>> workers;
+    const auto stride = (end - start + (worker_count - 1)) / worker_count;
+    for (size_t worker_idx = 0, range_start = start; worker_idx < worker_count && range_start < end;
+         ++worker_idx, range_start += stride) {
+      workers.push_back(std::async(std::launch::async,
+                                   match,
+                                   std::ref(worker_results[worker_idx]),
+                                   range_start,
+                                   std::min(range_start + stride, end)));
+    }
+    for (auto& worker : workers) {
+      worker.get();
+    }
+  } else {
+    match(worker_results[0], start, end);
   }
   for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
+    ids.insert(ids.end(), worker_result.begin(), worker_result.end());
+  }
+}
+
+// Must be called with like_cache_mutex_ held.
+void StringDictionary::evictLikeCacheOverBudget() const {
+  // never evict the entry which has just been added, the caller is about to return it
+  while (like_cache_lru_.size() > 1 && like_cache_size_ > g_string_dictionary_like_cache_max_size) {
+    const auto it = like_cache_.find(*like_cache_lru_.back());
+    CHECK(it != like_cache_.end());
+    like_cache_lru_.pop_back();
+    const auto entry_size = like_cache_entry_size(it->first, *it->second.ids);
+    CHECK_GE(like_cache_size_, entry_size);
+    like_cache_size_ -= entry_size;
+    like_cache_.erase(it);
+    ++like_cache_evictions_;
   }
-  const auto it_ok = regex_cache_.insert(std::make_pair(cache_key, result));
-  CHECK(it_ok.second);
-  return result;
 }
 
 std::shared_ptr<const std::vector<std::string>> StringDictionary::copyStrings() const {
@@ -481,6 +637,75 @@ std::shared_ptr<const std::vector<std::string>> StringDictionary::copyStrings()
   return strings_cache_;
 }
 
+std::shared_ptr<const std::vector<int32_t>> StringDictionary::getTranslationMap(
+    const std::shared_ptr<StringDictionary>& dest,
+    const size_t source_generation,
+    const size_t dest_generation) const {
+  CHECK(dest);
+  CHECK_LE(source_generation, storageEntryCount());
+  CHECK_LE(dest_generation, dest->storageEntryCount());
+  std::lock_guard<std::mutex> lock(translation_maps_mutex_);
+  for (auto it = translation_maps_.begin(); it != translation_maps_.end();) {
+    it = it->second.dest.expired() ? translation_maps_.erase(it) : std::next(it);
+  }
+  auto& entry = translation_maps_[dest.get()];
+  if (!entry.ids) {
+    entry = {dest, std::make_shared<std::vector<int32_t>>(), 0, 0};
+  }
+  if (source_generation <= entry.source_generation && dest_generation <= entry.dest_generation) {
+    return entry.ids;
+  }
+  if (!entry.ids.unique()) {
+    // the queries holding the current map keep it unchanged
+    entry.ids = std::make_shared<std::vector<int32_t>>(*entry.ids);
+  }
+  auto& ids = *entry.ids;
+  if (dest_generation > entry.dest_generation) {
+    if (dest_generation - entry.dest_generation < entry.source_generation) {
+      // some of the strings without a translation may have been added to dest since
+      for (size_t dest_id = entry.dest_generation; dest_id < dest_generation; ++dest_id) {
+        const auto source_id = getIdOfString(dest->getString(dest_id));
+        if (source_id != INVALID_STR_ID && static_cast<size_t>(source_id) < entry.source_generation) {
+          ids[source_id] = dest_id;
+        }
+      }
+    } else {
+      // dest grew more than the map covers, translating it all again is cheaper
+      ids.clear();
+      entry.source_generation = 0;
+    }
+    entry.dest_generation = dest_generation;
+  }
+  if (source_generation > entry.source_generation) {
+    const auto start = entry.source_generation;
+    const auto end = source_generation;
+    ids.resize(end);
+    auto translate = [this, &dest, &ids, &entry](const size_t start_id, const size_t end_id) {
+      for (size_t string_id = start_id; string_id < end_id; ++string_id) {
+        ids[string_id] = truncate_to_generation(dest->getIdOfString(getString(string_id)), entry.dest_generation);
+      }
+    };
+    const bool multithreaded = end - start > 10000;
+    const auto worker_count = multithreaded ? static_cast<size_t>(cpu_threads()) : size_t(1);
+    CHECK_GT(worker_count, 0);
+    if (multithreaded) {
+      std::vector<std::future<void>> workers;
+      const auto stride = (end - start + (worker_count - 1)) / worker_count;
+      for (size_t worker_start = start; worker_start < end; worker_start += stride) {
+        workers.push_back(
+            std::async(std::launch::async, translate, worker_start, std::min(worker_start + stride, end)));
+      }
+      for (auto& worker : workers) {
+        worker.get();
+      }
+    } else {
+      translate(start, end);
+    }
+    entry.source_generation = end;
+  }
+  return entry.ids;
+}
+
 bool StringDictionary::fillRateIsHigh() const noexcept {
   return str_ids_.size() <= str_count_ * 2;
 }
@@ -492,37 +717,43 @@ void StringDictionary::increaseCapacity() noexcept {
                << ") of Dictionary encoded Strings reached for this column, offset path for column is  "
                << offsets_path_;
   }
-  std::vector<int32_t> new_str_ids(str_ids_.size() * 2, INVALID_STR_ID);
-  for (size_t i = 0; i < str_count_; ++i) {
-    const auto str = getStringChecked(i);
-    int32_t bucket = computeBucket(str, new_str_ids, true);
-    new_str_ids[bucket] = i;
+  std::vector<HashBucket> new_str_ids(str_ids_.size() * 2, HashBucket{INVALID_STR_ID, 0});
+  for (const auto& entry : str_ids_) {
+    if (entry.id != INVALID_STR_ID) {
+      new_str_ids[computeUniqueBucketWithHash(entry.hash, new_str_ids)] = entry;
+    }
   }
   str_ids_.swap(new_str_ids);
 }
 
 int32_t StringDictionary::getOrAddImpl(const std::string& str, bool recover) noexcept {
+  return getOrAddImpl(str, hash_string(str), recover);
+}
+
+int32_t StringDictionary::getOrAddImpl(const std::string& str, const uint32_t hash, bool recover) noexcept {
   // @TODO(wei) treat empty string as NULL for now
   if (str.size() == 0)
     return inline_int_null_value<int32_t>();
   CHECK(str.size() <= MAX_STRLEN);
-  int32_t bucket = computeBucket(str, str_ids_, recover);
-  if (str_ids_[bucket] == INVALID_STR_ID) {
+  auto bucket = computeBucket(hash, str, str_ids_);
+  if (str_ids_[bucket].id == INVALID_STR_ID) {
     if (fillRateIsHigh()) {
       // resize when more than 50% is full
       increaseCapacity();
-      bucket = computeBucket(str, str_ids_, recover);
+      bucket = computeUniqueBucketWithHash(hash, str_ids_);
     }
     if (recover) {
       payload_file_off_ += str.size();
     } else {
       appendToStorage(str);
     }
-    str_ids_[bucket] = static_cast<int32_t>(str_count_);
+    str_ids_[bucket] = {static_cast<int32_t>(str_count_), hash};
     ++str_count_;
-    invalidateInvertedIndex();
+    if (ngram_index_) {
+      ngram_index_->add(str.data(), str.size());
+    }
   }
-  return str_ids_[bucket];
+  return str_ids_[bucket].id;
 }
 
 std::string StringDictionary::getStringChecked(const int string_id) const noexcept {
@@ -537,18 +768,19 @@ std::pair<char*, size_t> StringDictionary::getStringBytesChecked(const int strin
   return std::make_pair(std::get<0>(str_canary), std::get<1>(str_canary));
 }
 
-int32_t StringDictionary::computeBucket(const std::string& str,
-                                        const std::vector<int32_t>& data,
-                                        const bool unique) const noexcept {
-  auto bucket = rk_hash(str) & (data.size() - 1);
+size_t StringDictionary::computeBucket(const uint32_t hash,
+                                       const std::string& str,
+                                       const std::vector<HashBucket>& data) const noexcept {
+  auto bucket = hash & (data.size() - 1);
   while (true) {
-    if (data[bucket] == INVALID_STR_ID) {  // In this case it means the slot is available for use
+    const auto& entry = data[bucket];
+    if (entry.id == INVALID_STR_ID) {  // In this case it means the slot is available for use
       break;
     }
-    // if records are unique I don't need to do this test as I know it will not be the same
-    if (!unique) {
-      const auto old_str = getStringChecked(data[bucket]);
-      if (str.size() == old_str.size() && !memcmp(str.c_str(), old_str.c_str(), str.size())) {
+    // only read the string back if the whole hash matches
+    if (entry.hash == hash) {
+      const auto old_str = getStringBytesChecked(entry.id);
+      if (str.size() == old_str.second && !memcmp(str.data(), old_str.first, str.size())) {
         // found the string
         break;
       }
@@ -561,11 +793,11 @@ int32_t StringDictionary::computeBucket(const std::string& str,
   return bucket;
 }
 
-int32_t StringDictionary::computeUniqueBucketWithHash(const size_t hash, const std::vector<int32_t>& data) const
+size_t StringDictionary::computeUniqueBucketWithHash(const uint32_t hash, const std::vector<HashBucket>& data) const
     noexcept {
   auto bucket = hash & (data.size() - 1);
   while (true) {
-    if (data[bucket] == INVALID_STR_ID) {  // In this case it means the slot is available for use
+    if (data[bucket].id == INVALID_STR_ID) {  // In this case it means the slot is available for use
       break;
     }
     // wrap around
@@ -663,15 +895,6 @@ void* StringDictionary::addMemoryCapacity(void* addr, size_t& mem_size) noexcept
   return new_addr;
 }
 
-void StringDictionary::invalidateInvertedIndex() noexcept {
-  if (!like_cache_.empty()) {
-    decltype(like_cache_)().swap(like_cache_);
-  }
-  if (!regex_cache_.empty()) {
-    decltype(regex_cache_)().swap(regex_cache_);
-  }
-}
-
 char* StringDictionary::CANARY_BUFFER{nullptr};
 
 bool StringDictionary::checkpoint() noexcept {
@@ -688,6 +911,16 @@ bool StringDictionary::checkpoint() noexcept {
   ret = ret && (msync((void*)payload_map_, payload_file_size_, MS_SYNC) == 0);
   ret = ret && (fsync(offset_fd_) == 0);
   ret = ret && (fsync(payload_fd_) == 0);
+  if (ngram_index_) {
+    std::lock_guard<std::mutex> checkpoint_lock(ngram_index_checkpoint_mutex_);
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    if (ngram_index_->generation() != ngram_index_checkpointed_generation_) {
+      ret = ret && ngram_index_->write(ngram_index_path_);
+      if (ret) {
+        ngram_index_checkpointed_generation_ = ngram_index_->generation();
+      }
+    }
+  }
   return ret;
 }
 
@@ -25,12 +25,18 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
 #include <future>
 
+extern size_t g_string_dictionary_like_cache_max_size;
+
+class NgramIndex;
 class StringDictionaryClient;
 
 class StringDictionary {
@@ -58,8 +64,31 @@ class StringDictionary {
 
   std::vector<int32_t> getRegexpLike(const std::string& pattern, const char escape, const size_t generation) const;
 
+  struct LikeCacheStats {
+    size_t entries;
+    size_t size;
+    size_t max_size;
+    size_t hits;
+    size_t extensions;  // cached results extended with the strings added since
+    size_t misses;
+    size_t evictions;
+  };
+
+  LikeCacheStats getLikeCacheStats() const;
+
   std::shared_ptr<const std::vector<std::string>> copyStrings() const;
 
+  /**
+   * @brief Maps the ids below source_generation to the ids of the same strings in dest
+   *
+   * The strings dest doesn't have below dest_generation map to INVALID_STR_ID. The maps are
+   * cached for each dest and extended as either dictionary grows, so the returned map can
+   * cover more ids and hold ids of dest at or above dest_generation.
+   */
+  std::shared_ptr<const std::vector<int32_t>> getTranslationMap(const std::shared_ptr<StringDictionary>& dest,
+                                                                const size_t source_generation,
+                                                                const size_t dest_generation) const;
+
   bool checkpoint() noexcept;
 
   static const int32_t INVALID_STR_ID;
@@ -76,24 +105,62 @@ class StringDictionary {
   bool fillRateIsHigh() const noexcept;
   void increaseCapacity() noexcept;
   int32_t getOrAddImpl(const std::string& str, bool recover) noexcept;
+  int32_t getOrAddImpl(const std::string& str, const uint32_t hash, bool recover) noexcept;
   template <class T>
   void getOrAddBulkRemote(const std::vector<std::string>& string_vec, T* encoded_vec);
   int32_t getUnlocked(const std::string& str) const noexcept;
   std::string getStringUnlocked(int32_t string_id) const noexcept;
   std::string getStringChecked(const int string_id) const noexcept;
   std::pair<char*, size_t> getStringBytesChecked(const int string_id) const noexcept;
-  int32_t computeBucket(const std::string& str, const std::vector<int32_t>& data, const bool unique) const noexcept;
-  int32_t computeUniqueBucketWithHash(const size_t hash, const std::vector<int32_t>& data) const noexcept;
+  // A bucket of the open addressing table from the strings to their ids, along with the hash of the string.
+  struct HashBucket {
+    int32_t id;
+    uint32_t hash;
+  };
+
+  size_t computeBucket(const uint32_t hash, const std::string& str, const std::vector<HashBucket>& data) const
+      noexcept;
+  size_t computeUniqueBucketWithHash(const uint32_t hash, const std::vector<HashBucket>& data) const noexcept;
   void appendToStorage(const std::string& str) noexcept;
   std::tuple<char*, size_t, bool> getStringFromStorage(const int string_id) const noexcept;
   void addPayloadCapacity() noexcept;
   void addOffsetCapacity() noexcept;
   size_t addStorageCapacity(int fd) noexcept;
   void* addMemoryCapacity(void* addr, size_t& mem_size) noexcept;
-  void invalidateInvertedIndex() noexcept;
+
+  // LIKE and REGEXP results are cached on the pattern, whether it's a regular expression, icase,
+  // is_simple and the escape character.
+  typedef std::tuple<std::string, bool, bool, bool, char> LikeCacheKey;
+  typedef std::list<const LikeCacheKey*> LikeCacheLru;
+
+  struct LikeCacheEntry {
+    std::shared_ptr<const std::vector<int32_t>> ids;  // ascending
+    size_t generation;                                // the ids cover the strings below it
+    LikeCacheLru::iterator lru_it;
+  };
+
+  template <class Matcher>
+  std::vector<int32_t> getMatchingIds(const LikeCacheKey& key,
+                                      const size_t generation,
+                                      Matcher matcher,
+                                      const std::vector<std::string>& literals) const;
+  template <class Matcher>
+  void appendMatchingIds(std::vector<int32_t>& ids,
+                         const size_t start,
+                         const size_t end,
+                         Matcher matcher,
+                         const std::vector<std::string>& literals) const;
+  void evictLikeCacheOverBudget() const;
+
+  struct TranslationMapCacheEntry {
+    std::weak_ptr<StringDictionary> dest;  // the entry is dropped once dest goes away
+    std::shared_ptr<std::vector<int32_t>> ids;
+    size_t source_generation;
+    size_t dest_generation;
+  };
 
   size_t str_count_;
-  std::vector<int32_t> str_ids_;
+  std::vector<HashBucket> str_ids_;
   bool isTemp_;
   std::string offsets_path_;
   int payload_fd_;
@@ -104,9 +171,26 @@ class StringDictionary {
   size_t payload_file_size_;
   size_t payload_file_off_;
   mutable mapd_shared_mutex rw_mutex_;
-  mutable std::map<std::tuple<std::string, bool, bool, char>, std::vector<int32_t>> like_cache_;
-  mutable std::map<std::pair<std::string, char>, std::vector<int32_t>> regex_cache_;
+  // The dictionary only grows, so a cached result stays valid for the strings it covers and
+  // is extended by scanning the ones added since. The scans hold rw_mutex_ shared, the cache
+  // itself is guarded by like_cache_mutex_.
+  mutable std::map<LikeCacheKey, LikeCacheEntry> like_cache_;
+  mutable LikeCacheLru like_cache_lru_;  // most recently used first, points to the keys of like_cache_
+  mutable size_t like_cache_size_;
+  mutable size_t like_cache_hits_;
+  mutable size_t like_cache_extensions_;
+  mutable size_t like_cache_misses_;
+  mutable size_t like_cache_evictions_;
+  mutable std::mutex like_cache_mutex_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
+  mutable std::map<const StringDictionary*, TranslationMapCacheEntry> translation_maps_;
+  mutable std::mutex translation_maps_mutex_;
+  std::unique_ptr<NgramIndex> ngram_index_;  // guarded by rw_mutex_, null unless enabled when opened
+  std::string ngram_index_path_;
+  size_t ngram_index_checkpointed_generation_;
+  // Serializes the checkpoints of the n-gram index: they share its temporary file and hold
+  // rw_mutex_ shared only, which keeps the index from changing while it's written.
+  std::mutex ngram_index_checkpoint_mutex_;
   std::unique_ptr<StringDictionaryClient> client_;
   std::unique_ptr<StringDictionaryClient> client_no_timeout_;
 
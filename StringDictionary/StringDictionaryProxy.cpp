@@ -16,6 +16,7 @@
 
 #include "StringDictionary.h"
 #include "StringDictionaryProxy.h"
+#include "NumericDictionary.h"
 #include "../Shared/sqltypes.h"
 #include "../Utils/StringLike.h"
 #include "../Utils/Regexp.h"
@@ -142,6 +143,64 @@ std::vector<int32_t> StringDictionaryProxy::getRegexpLike(const std::string& pat
   return result;
 }
 
+const std::vector<int64_t>& StringDictionaryProxy::getNumericValues() {
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  CHECK(transient_int_to_str_.empty());
+  const size_t entry_count = generation_ >= 0 ? generation_ : string_dict_->storageEntryCount();
+  if (numeric_values_.empty() || numeric_values_.back().size() < entry_count) {
+    // the dictionary grew, decode into a new vector since code may have been generated for the current one
+    std::vector<int64_t> values;
+    values.reserve(entry_count);
+    if (!numeric_values_.empty()) {
+      values.assign(numeric_values_.back().begin(), numeric_values_.back().end());
+    }
+    for (size_t id = values.size(); id < entry_count; ++id) {
+      values.push_back(numeric_dict_bits(string_dict_->getString(id)));
+    }
+    numeric_values_.push_back(std::move(values));
+  }
+  return numeric_values_.back();
+}
+
+StringDictionaryProxy::TranslationMap StringDictionaryProxy::getTranslationMap(
+    const StringDictionaryProxy* dest) const {
+  CHECK(dest);
+  const size_t dest_generation =
+      dest->generation_ >= 0 ? dest->generation_ : dest->string_dict_->storageEntryCount();
+  // the persisted part is shared with the other queries, it covers every id a column can hold
+  const auto persisted_ids =
+      string_dict_->getTranslationMap(dest->string_dict_, string_dict_->storageEntryCount(), dest_generation);
+  std::map<int32_t, std::string> transient_int_to_str;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    transient_int_to_str = transient_int_to_str_;
+  }
+  bool dest_has_transients{false};
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(dest->rw_mutex_);
+    dest_has_transients = !dest->transient_str_to_int_.empty();
+  }
+  if (transient_int_to_str.empty() && !dest_has_transients) {
+    return {persisted_ids, 0};
+  }
+  // the transient ids are negative, below INVALID_STR_ID
+  const int32_t min_id = transient_int_to_str.empty() ? 0 : transient_int_to_str.begin()->first;
+  auto ids = std::make_shared<std::vector<int32_t>>(-min_id, StringDictionary::INVALID_STR_ID);
+  for (const auto& kv : transient_int_to_str) {
+    (*ids)[kv.first - min_id] = dest->getIdOfString(kv.second);
+  }
+  ids->insert(ids->end(), persisted_ids->begin(), persisted_ids->end());
+  if (dest_has_transients) {
+    for (size_t id = 0; id < persisted_ids->size(); ++id) {
+      auto& dest_id = (*ids)[id - min_id];
+      if (dest_id == StringDictionary::INVALID_STR_ID) {
+        dest_id = dest->getIdOfString(string_dict_->getString(id));
+      }
+    }
+  }
+  return {ids, min_id};
+}
+
 int32_t StringDictionaryProxy::getOrAdd(const std::string& str) noexcept {
   return string_dict_->getOrAdd(str);
 }
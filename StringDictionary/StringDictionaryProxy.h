@@ -24,6 +24,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <list>
 #include <map>
 #include <string>
 #include <tuple>
@@ -52,10 +53,23 @@ class StringDictionaryProxy {
 
   std::vector<int32_t> getRegexpLike(const std::string& pattern, const char escape) const;
 
+  // The values of a dictionary encoded numeric column indexed by id, as numeric_dict_bits. The
+  // returned vector is never modified, the generated code keeps its address for the proxy's life.
+  const std::vector<int64_t>& getNumericValues();
+
+  struct TranslationMap {
+    std::shared_ptr<const std::vector<int32_t>> ids;  // indexed by the id minus min_id
+    int32_t min_id;
+  };
+
+  // Maps all the ids of this proxy, transient ones included, to the ids of the same strings in dest.
+  TranslationMap getTranslationMap(const StringDictionaryProxy* dest) const;
+
  private:
   std::shared_ptr<StringDictionary> string_dict_;
   std::map<int32_t, std::string> transient_int_to_str_;
   std::map<std::string, int32_t> transient_str_to_int_;
+  std::list<std::vector<int64_t>> numeric_values_;  // the latest last, the earlier ones may still be read
   ssize_t generation_;
   mutable mapd_shared_mutex rw_mutex_;
 };
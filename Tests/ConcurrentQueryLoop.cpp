@@ -0,0 +1,140 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Runs a mixed workload from several client threads at the same time and
+ * reports the throughput and the latency distribution of the queries.
+ *
+ * ConcurrentQueryLoop <catalog path> --query "SELECT ..." --query "SELECT ..." --threads 8 --iter 100 [--cpu]
+ */
+
+#include "QueryRunner.h"
+
+#include "../Shared/measure.h"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int64_t percentile(const std::vector<int64_t>& sorted_latencies, const double p) {
+  CHECK(!sorted_latencies.empty());
+  const size_t idx = std::min(static_cast<size_t>(p * sorted_latencies.size()), sorted_latencies.size() - 1);
+  return sorted_latencies[idx];
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string db_path;
+  std::vector<std::string> queries;
+  size_t thread_count;
+  size_t iter;
+
+  ExecutorDeviceType device_type{ExecutorDeviceType::GPU};
+
+  boost::program_options::options_description desc("Options");
+  desc.add_options()(
+      "path", boost::program_options::value<std::string>(&db_path)->required(), "Directory path to Mapd catalogs")(
+      "query",
+      boost::program_options::value<std::vector<std::string>>(&queries)->required(),
+      "Query, can be given multiple times for a mixed workload")(
+      "threads", boost::program_options::value<size_t>(&thread_count), "Number of client threads")(
+      "iter", boost::program_options::value<size_t>(&iter), "Number of queries per client thread")(
+      "cpu", "Run on CPU (run on GPU by default)");
+
+  boost::program_options::positional_options_description positionalOptions;
+  positionalOptions.add("path", 1);
+
+  boost::program_options::variables_map vm;
+
+  try {
+    boost::program_options::store(
+        boost::program_options::command_line_parser(argc, argv).options(desc).positional(positionalOptions).run(), vm);
+    boost::program_options::notify(vm);
+  } catch (boost::program_options::error& err) {
+    LOG(ERROR) << err.what();
+    return 1;
+  }
+
+  if (!vm.count("threads")) {
+    thread_count = 8;
+  }
+
+  if (!vm.count("iter")) {
+    iter = 100;
+  }
+
+  if (vm.count("cpu")) {
+    device_type = ExecutorDeviceType::CPU;
+  }
+
+  std::unique_ptr<Catalog_Namespace::SessionInfo> session(get_session(db_path.c_str()));
+
+  // warm up the code cache, we're interested in the steady state
+  for (const auto& query : queries) {
+    run_multiple_agg(query, session, device_type, true, true);
+  }
+
+  std::vector<int64_t> latencies;
+  std::mutex latencies_mutex;
+  std::atomic<size_t> failed_count{0};
+  std::vector<std::thread> clients;
+  const auto clock_begin = timer_start();
+  for (size_t client_idx = 0; client_idx < thread_count; ++client_idx) {
+    clients.emplace_back([&, client_idx] {
+      std::vector<int64_t> client_latencies;
+      for (size_t i = 0; i < iter; ++i) {
+        // stagger the clients so that different queries overlap
+        const auto& query = queries[(client_idx + i) % queries.size()];
+        const auto query_clock_begin = timer_start();
+        try {
+          run_multiple_agg(query, session, device_type, true, true);
+        } catch (const std::exception& e) {
+          LOG(ERROR) << e.what();
+          ++failed_count;
+          continue;
+        }
+        client_latencies.push_back(timer_stop(query_clock_begin));
+      }
+      std::lock_guard<std::mutex> lock(latencies_mutex);
+      latencies.insert(latencies.end(), client_latencies.begin(), client_latencies.end());
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  const auto total_ms = timer_stop(clock_begin);
+
+  if (latencies.empty()) {
+    LOG(ERROR) << "All queries failed";
+    return 1;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "Clients: " << thread_count << ", queries: " << latencies.size() << ", failed: " << failed_count
+            << std::endl;
+  std::cout << "Throughput: " << latencies.size() * 1000. / std::max(total_ms, int64_t(1)) << " queries/s"
+            << std::endl;
+  std::cout << "Latency p50: " << percentile(latencies, 0.5) << " ms, p99: " << percentile(latencies, 0.99)
+            << " ms, max: " << latencies.back() << " ms" << std::endl;
+  return failed_count ? 1 : 0;
+}
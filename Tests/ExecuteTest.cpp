@@ -21,7 +21,10 @@
 #include "../SqliteConnector/SqliteConnector.h"
 #include "../Import/Importer.h"
 
+#include <atomic>
+#include <future>
 #include <sstream>
+#include <thread>
 #include <boost/algorithm/string.hpp>
 #include <boost/program_options.hpp>
 #include <glog/logging.h>
@@ -33,6 +36,8 @@
 
 using namespace std;
 
+extern bool g_enable_chunk_sketches;
+
 namespace {
 
 std::unique_ptr<Catalog_Namespace::SessionInfo> g_session;
@@ -3034,6 +3039,301 @@ TEST(Select, BigDecimalRange) {
   }
 }
 
+TEST(Select, ChunkSketchFragmentSkipping) {
+  const std::string drop_old_sketch_test{"DROP TABLE IF EXISTS sketch_test;"};
+  run_ddl_statement(drop_old_sketch_test);
+  g_sqlite_comparator.query(drop_old_sketch_test);
+  const bool enable_chunk_sketches = g_enable_chunk_sketches;
+  g_enable_chunk_sketches = true;
+  run_ddl_statement("CREATE TABLE sketch_test(x int, y bigint) WITH (fragment_size=4);");
+  g_sqlite_comparator.query("CREATE TABLE sketch_test(x int, y bigint);");
+  // the values are scattered, every fragment spans most of the range of x and min / max can't skip it
+  for (size_t i = 0; i < 40; ++i) {
+    const std::string insert_query{"INSERT INTO sketch_test VALUES(" + std::to_string(i * 7 % 40) + ", " +
+                                   std::to_string(i % 5) + ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  g_enable_chunk_sketches = enable_chunk_sketches;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM sketch_test WHERE x = 13;", dt);
+    c("SELECT COUNT(*) FROM sketch_test WHERE x = 41;", dt);
+    c("SELECT COUNT(*) FROM sketch_test WHERE x IN (3, 17, 29);", dt);
+    c("SELECT COUNT(*) FROM sketch_test WHERE x IN (3, 17, 29) AND y = 1;", dt);
+    c("SELECT x, COUNT(*) FROM sketch_test GROUP BY x ORDER BY x;", dt);
+    c("SELECT COUNT(*) FROM sketch_test a, sketch_test b WHERE a.x = b.y;", dt);
+  }
+  run_ddl_statement(drop_old_sketch_test);
+  g_sqlite_comparator.query(drop_old_sketch_test);
+}
+
+TEST(Select, SortedTableFragmentSkipping) {
+  const std::string drop_old_sorted_test{"DROP TABLE IF EXISTS sorted_test;"};
+  run_ddl_statement(drop_old_sorted_test);
+  g_sqlite_comparator.query(drop_old_sorted_test);
+  run_ddl_statement("CREATE TABLE sorted_test(x int, y bigint, z text encoding dict) WITH (fragment_size=4, "
+                    "sort_column='x');");
+  g_sqlite_comparator.query("CREATE TABLE sorted_test(x int, y bigint, z text);");
+  for (size_t i = 0; i < 40; ++i) {
+    const std::string insert_query{"INSERT INTO sorted_test VALUES(" + std::to_string(i * 7 % 40) + ", " +
+                                   std::to_string(i % 5) + ", 'str" + std::to_string(i * 7 % 40) + "');"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  // the fragments before the last one, still open to inserts, cover disjoint, ascending ranges of x
+  const auto td = g_session->get_catalog().getMetadataForTable("sorted_test");
+  CHECK(td);
+  const auto x_cd = g_session->get_catalog().getMetadataForColumn(td->tableId, "x");
+  CHECK(x_cd);
+  const auto table_info = td->fragmenter->getFragmentsForQuery();
+  ASSERT_EQ(size_t(10), table_info.fragments.size());
+  for (size_t i = 1; i + 1 < table_info.fragments.size(); ++i) {
+    const auto& prev_stats = table_info.fragments[i - 1].getChunkMetadataMapPhysical().at(x_cd->columnId).chunkStats;
+    const auto& stats = table_info.fragments[i].getChunkMetadataMapPhysical().at(x_cd->columnId).chunkStats;
+    ASSERT_LT(prev_stats.max.intval, stats.min.intval);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM sorted_test WHERE x = 13;", dt);
+    c("SELECT COUNT(*) FROM sorted_test WHERE x BETWEEN 10 AND 21;", dt);
+    c("SELECT SUM(y) FROM sorted_test WHERE x > 30;", dt);
+    c("SELECT x, y, z FROM sorted_test WHERE x < 6 ORDER BY x;", dt);
+    c("SELECT z, COUNT(*) FROM sorted_test GROUP BY z ORDER BY z;", dt);
+  }
+  run_ddl_statement(drop_old_sorted_test);
+  g_sqlite_comparator.query(drop_old_sorted_test);
+}
+
+TEST(Select, DictEncodedNumbers) {
+  const std::string drop_old_dict_number_test{"DROP TABLE IF EXISTS dict_number_test;"};
+  run_ddl_statement(drop_old_dict_number_test);
+  g_sqlite_comparator.query(drop_old_dict_number_test);
+  run_ddl_statement(
+      "CREATE TABLE dict_number_test(x int encoding dict(8), y bigint encoding dict(16), d double encoding dict, "
+      "z bigint encoding dict(16)) WITH (fragment_size=5);");
+  g_sqlite_comparator.query("CREATE TABLE dict_number_test(x int, y bigint, d double, z bigint);");
+  for (size_t i = 0; i < 20; ++i) {
+    const std::string insert_query{"INSERT INTO dict_number_test VALUES(" +
+                                   (i % 6 ? std::to_string(static_cast<int>(i % 4) - 1) : std::string("NULL")) +
+                                   ", " + std::to_string(5000000000LL + i % 3) + ", " + std::to_string(i % 5) +
+                                   ".25, " + std::to_string(i % 7 - 3) + ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  // decoding the values reads the dictionary, the GPU queries are retried on CPU
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM dict_number_test WHERE x = -1;", dt);
+    c("SELECT COUNT(*) FROM dict_number_test WHERE y <> 5000000001;", dt);
+    c("SELECT COUNT(*) FROM dict_number_test WHERE x IS NULL;", dt);
+    c("SELECT COUNT(*) FROM dict_number_test WHERE x > 0;", dt);
+    c("SELECT COUNT(*) FROM dict_number_test WHERE x IN (0, 2);", dt);
+    c("SELECT COUNT(*) FROM dict_number_test WHERE d = 2.25;", dt);
+    c("SELECT SUM(x), MIN(y), MAX(y), SUM(d), AVG(z) FROM dict_number_test;", dt);
+    c("SELECT x, COUNT(*) FROM dict_number_test GROUP BY x ORDER BY x;", dt);
+    c("SELECT y, SUM(d) FROM dict_number_test GROUP BY y ORDER BY y;", dt);
+    c("SELECT x + 1, y FROM dict_number_test WHERE x IS NOT NULL ORDER BY z, x, y, d;", dt);
+    c("SELECT COUNT(*) FROM dict_number_test WHERE y = z + 5000000000;", dt);
+    c("SELECT COUNT(*) FROM dict_number_test a, dict_number_test b WHERE a.y = b.y;", dt);
+  }
+  run_ddl_statement(drop_old_dict_number_test);
+  g_sqlite_comparator.query(drop_old_dict_number_test);
+}
+
+TEST(Select, SortedTableDictEncodedNumbers) {
+  const std::string drop_old_sorted_dict_number_test{"DROP TABLE IF EXISTS sorted_dict_number_test;"};
+  run_ddl_statement(drop_old_sorted_dict_number_test);
+  g_sqlite_comparator.query(drop_old_sorted_dict_number_test);
+  run_ddl_statement(
+      "CREATE TABLE sorted_dict_number_test(x int encoding dict(8), y bigint encoding dict(16), d double encoding "
+      "dict) WITH (fragment_size=4, sort_column='x');");
+  g_sqlite_comparator.query("CREATE TABLE sorted_dict_number_test(x int, y bigint, d double);");
+  // the ids of x follow the first insert of each value, the later inserts of a value move to its fragment
+  for (size_t i = 0; i < 40; ++i) {
+    const std::string insert_query{"INSERT INTO sorted_dict_number_test VALUES(" +
+                                   std::to_string(static_cast<int>(i * 3 % 10) - 5) + ", " +
+                                   std::to_string(5000000000LL + i) + ", " + std::to_string(i % 6) + ".5);"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  {
+    // the fragments before the last one are in ascending order of the ids of x, a value may straddle two
+    const auto td = g_session->get_catalog().getMetadataForTable("sorted_dict_number_test");
+    CHECK(td);
+    const auto x_cd = g_session->get_catalog().getMetadataForColumn(td->tableId, "x");
+    CHECK(x_cd);
+    const auto table_info = td->fragmenter->getFragmentsForQuery();
+    ASSERT_EQ(size_t(10), table_info.fragments.size());
+    for (size_t i = 1; i + 1 < table_info.fragments.size(); ++i) {
+      const auto& prev_stats =
+          table_info.fragments[i - 1].getChunkMetadataMapPhysical().at(x_cd->columnId).chunkStats;
+      const auto& stats = table_info.fragments[i].getChunkMetadataMapPhysical().at(x_cd->columnId).chunkStats;
+      ASSERT_LE(prev_stats.max.intval, stats.min.intval);
+    }
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM sorted_dict_number_test WHERE x = -2;", dt);
+    c("SELECT COUNT(*), SUM(d) FROM sorted_dict_number_test WHERE x IN (1, 4);", dt);
+    c("SELECT x, COUNT(*), MIN(y), MAX(y) FROM sorted_dict_number_test GROUP BY x ORDER BY x;", dt);
+    c("SELECT x, y, d FROM sorted_dict_number_test ORDER BY y;", dt);
+  }
+  run_ddl_statement(drop_old_sorted_dict_number_test);
+  g_sqlite_comparator.query(drop_old_sorted_dict_number_test);
+}
+
+TEST(Select, SortedTableDiffOverflow) {
+  const std::string drop_old_sorted_diff_test{"DROP TABLE IF EXISTS sorted_diff_test;"};
+  run_ddl_statement(drop_old_sorted_diff_test);
+  g_sqlite_comparator.query(drop_old_sorted_diff_test);
+  run_ddl_statement(
+      "CREATE TABLE sorted_diff_test(x int, y int encoding diff(8), s text encoding dict) WITH (fragment_size=4, "
+      "sort_column='x');");
+  g_sqlite_comparator.query("CREATE TABLE sorted_diff_test(x int, y int, s text);");
+  // the values of y of a fragment are close, merging two overlapping fragments would put values 1000
+  // apart in one chunk of 8 bit deltas
+  for (int i = 0; i < 32; ++i) {
+    const int fragment = i / 4;
+    const std::string insert_query{"INSERT INTO sorted_diff_test VALUES(" + std::to_string(fragment + i % 4 * 10) +
+                                   ", " + std::to_string(fragment * 1000 + i % 4) + ", 'str" + std::to_string(i) +
+                                   "');"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  {
+    // the merges are refused before any column is rewritten, the fragments keep their rows
+    const auto td = g_session->get_catalog().getMetadataForTable("sorted_diff_test");
+    CHECK(td);
+    const auto x_cd = g_session->get_catalog().getMetadataForColumn(td->tableId, "x");
+    CHECK(x_cd);
+    const auto table_info = td->fragmenter->getFragmentsForQuery();
+    ASSERT_EQ(size_t(8), table_info.fragments.size());
+    const auto& first_stats = table_info.fragments[0].getChunkMetadataMapPhysical().at(x_cd->columnId).chunkStats;
+    const auto& second_stats = table_info.fragments[1].getChunkMetadataMapPhysical().at(x_cd->columnId).chunkStats;
+    ASSERT_GT(first_stats.max.intval, second_stats.min.intval);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*), SUM(y), MIN(y), MAX(y) FROM sorted_diff_test;", dt);
+    c("SELECT x, y, s FROM sorted_diff_test ORDER BY x;", dt);
+    c("SELECT x, y FROM sorted_diff_test WHERE y > 3000 ORDER BY x;", dt);
+    c("SELECT y / 1000 AS f, COUNT(*), MIN(x), MAX(x) FROM sorted_diff_test GROUP BY f ORDER BY f;", dt);
+  }
+  run_ddl_statement(drop_old_sorted_diff_test);
+  g_sqlite_comparator.query(drop_old_sorted_diff_test);
+}
+
+TEST(Select, PackedEncoding) {
+  const std::string drop_old_packed_test{"DROP TABLE IF EXISTS packed_test;"};
+  run_ddl_statement(drop_old_packed_test);
+  g_sqlite_comparator.query(drop_old_packed_test);
+  run_ddl_statement(
+      "CREATE TABLE packed_test(x int encoding packed(7), y bigint encoding packed(40)) WITH (fragment_size=4);");
+  g_sqlite_comparator.query("CREATE TABLE packed_test(x int, y bigint);");
+  for (int i = 0; i < 30; ++i) {
+    // the limits of 7 bits, the smallest value is null
+    const std::string x{i % 7 == 3 ? "NULL" : std::to_string(i % 2 ? 63 - (i - 1) * 4 : -63 + i * 4)};
+    const std::string y{i % 5 == 1 ? "NULL" : std::to_string((int64_t(1) << 39) - 1 - i * 1000003)};
+    const std::string insert_query{"INSERT INTO packed_test VALUES(" + x + ", " + y + ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  // values which would be truncated or read as null are refused, nothing is stored
+  EXPECT_THROW(run_multiple_agg("INSERT INTO packed_test VALUES(64, 0);", ExecutorDeviceType::CPU),
+               std::runtime_error);
+  EXPECT_THROW(run_multiple_agg("INSERT INTO packed_test VALUES(-64, 0);", ExecutorDeviceType::CPU),
+               std::runtime_error);
+  EXPECT_THROW(run_multiple_agg("INSERT INTO packed_test VALUES(0, 549755813888);", ExecutorDeviceType::CPU),
+               std::runtime_error);
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*), COUNT(x), COUNT(y), MIN(x), MAX(x), MIN(y), MAX(y) FROM packed_test;", dt);
+    c("SELECT x, y FROM packed_test WHERE x IS NOT NULL AND y IS NOT NULL ORDER BY x;", dt);
+    c("SELECT COUNT(*) FROM packed_test WHERE x > 10;", dt);
+    c("SELECT COUNT(*) FROM packed_test WHERE x = -63 OR x = 63;", dt);
+    c("SELECT COUNT(*) FROM packed_test WHERE x IS NULL;", dt);
+    c("SELECT COUNT(*) FROM packed_test WHERE y IS NULL AND x IS NOT NULL;", dt);
+    c("SELECT SUM(y) FROM packed_test WHERE y < 549755000000;", dt);
+    c("SELECT x, COUNT(*), SUM(y) FROM packed_test WHERE x IS NOT NULL GROUP BY x ORDER BY x;", dt);
+  }
+  run_ddl_statement(drop_old_packed_test);
+  g_sqlite_comparator.query(drop_old_packed_test);
+}
+
+TEST(Select, RunLengthAndDiffEncoding) {
+  const std::string drop_old_rl_diff_test{"DROP TABLE IF EXISTS rl_diff_test;"};
+  run_ddl_statement(drop_old_rl_diff_test);
+  g_sqlite_comparator.query(drop_old_rl_diff_test);
+  // small pages, so that the runs and deltas of a chunk span several of them
+  run_ddl_statement(
+      "CREATE TABLE rl_diff_test(x int encoding rl, s smallint encoding rl, d int encoding diff(8), y bigint encoding "
+      "diff(16)) WITH (fragment_size=40, page_size=96);");
+  g_sqlite_comparator.query("CREATE TABLE rl_diff_test(x int, s smallint, d int, y bigint);");
+  for (int i = 0; i < 160; ++i) {
+    // the runs of x and s cross the fragment boundaries, every fifth run of x is null
+    const std::string x{i / 7 % 5 == 2 ? "NULL" : std::to_string(i / 7)};
+    const std::string s_val{std::to_string(i / 23 % 4 - 1)};
+    const std::string d{i % 11 == 3 ? "NULL" : std::to_string(i % 37 - 18)};
+    const std::string y{i % 17 == 5 ? "NULL" : std::to_string(5000000000LL + i % 13 * 1000)};
+    const std::string insert_query{"INSERT INTO rl_diff_test VALUES(" + x + ", " + s_val + ", " + d + ", " + y + ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*), COUNT(x), MIN(x), MAX(x), SUM(x), SUM(s), COUNT(d), SUM(d), COUNT(y), MIN(y), MAX(y) FROM "
+      "rl_diff_test;",
+      dt);
+    c("SELECT x, d, y, s FROM rl_diff_test WHERE x IS NOT NULL AND d IS NOT NULL AND y IS NOT NULL ORDER BY x, d, y, "
+      "s;",
+      dt);
+    c("SELECT COUNT(*) FROM rl_diff_test WHERE x = 5;", dt);
+    c("SELECT COUNT(*) FROM rl_diff_test WHERE x IS NULL;", dt);
+    c("SELECT COUNT(*) FROM rl_diff_test WHERE d IS NULL OR y IS NULL;", dt);
+    c("SELECT COUNT(*), SUM(x) FROM rl_diff_test WHERE d > 3 AND y < 5000006000;", dt);
+    c("SELECT x, COUNT(*), SUM(d), MAX(y) FROM rl_diff_test WHERE x IS NOT NULL GROUP BY x ORDER BY x;", dt);
+    c("SELECT s, COUNT(*), MIN(y), SUM(d) FROM rl_diff_test GROUP BY s ORDER BY s;", dt);
+    c("SELECT y, COUNT(*) FROM rl_diff_test WHERE y IS NOT NULL GROUP BY y ORDER BY y;", dt);
+  }
+  run_ddl_statement(drop_old_rl_diff_test);
+  g_sqlite_comparator.query(drop_old_rl_diff_test);
+}
+
+TEST(Optimize, CompactTable) {
+  const std::string drop_old_optimize_test{"DROP TABLE IF EXISTS optimize_test;"};
+  run_ddl_statement(drop_old_optimize_test);
+  g_sqlite_comparator.query(drop_old_optimize_test);
+  run_ddl_statement("CREATE TABLE optimize_test(x int, s text encoding dict) WITH (fragment_size=3, max_rows=12);");
+  g_sqlite_comparator.query("CREATE TABLE optimize_test(x int, s text);");
+  // every insert checkpoints a new version of the pages of the last fragment, max_rows drops the first fragments
+  for (size_t i = 0; i < 30; ++i) {
+    const std::string insert_query{"INSERT INTO optimize_test VALUES(" + std::to_string(i) + ", 'str" +
+                                   std::to_string(i % 7) + "');"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+  }
+  run_ddl_statement("OPTIMIZE TABLE optimize_test;");
+  const auto import_status = Importer_NS::Importer::get_import_status("optimize_optimize_test");
+  ASSERT_EQ(import_status.rows_estimated, import_status.rows_completed);
+  ASSERT_LT(size_t(0), import_status.rows_completed);
+  // the dropped rows aren't deterministic, the ones left are compared
+  const auto rows_left = v<int64_t>(run_simple_agg("SELECT MIN(x) FROM optimize_test;", ExecutorDeviceType::CPU));
+  for (int64_t i = rows_left; i < 30; ++i) {
+    g_sqlite_comparator.query("INSERT INTO optimize_test VALUES(" + std::to_string(i) + ", 'str" +
+                              std::to_string(i % 7) + "');");
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*), SUM(x) FROM optimize_test;", dt);
+    c("SELECT s, COUNT(*) FROM optimize_test GROUP BY s ORDER BY s;", dt);
+  }
+  run_multiple_agg("INSERT INTO optimize_test VALUES(30, 'str2');", ExecutorDeviceType::CPU);
+  g_sqlite_comparator.query("INSERT INTO optimize_test VALUES(30, 'str2');");
+  c("SELECT x, s FROM optimize_test ORDER BY x;", ExecutorDeviceType::CPU);
+  run_ddl_statement(drop_old_optimize_test);
+  g_sqlite_comparator.query(drop_old_optimize_test);
+}
+
 TEST(Drop, AfterDrop) {
   run_ddl_statement("create table droptest (i1 integer);");
   run_multiple_agg("insert into droptest values(1);", ExecutorDeviceType::CPU);
@@ -3307,6 +3607,56 @@ TEST(Select, Joins_InnerJoin_TwoTables) {
   }
 }
 
+TEST(Select, Joins_StringsAcrossDictionaries) {
+  const std::vector<std::string> tables{"str_join_outer", "str_join_unique", "str_join_dup"};
+  for (const auto& table : tables) {
+    const std::string drop_old_table{"DROP TABLE IF EXISTS " + table + ";"};
+    run_ddl_statement(drop_old_table);
+    g_sqlite_comparator.query(drop_old_table);
+    // every table has its own dictionary, the ids of the same string differ across them
+    run_ddl_statement("CREATE TABLE " + table + "(x int, s text encoding dict);");
+    g_sqlite_comparator.query("CREATE TABLE " + table + "(x int, s text);");
+  }
+  auto insert_rows = [](
+      const std::string& table, const int first_row, const int num_rows, const int stride, const int num_strings) {
+    for (int i = first_row; i < first_row + num_rows; ++i) {
+      const std::string s{i % 9 == 4 ? "NULL" : "'str" + std::to_string(i * stride % num_strings) + "'"};
+      const std::string insert_query{"INSERT INTO " + table + " VALUES(" + std::to_string(i) + ", " + s + ");"};
+      run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+      g_sqlite_comparator.query(insert_query);
+    }
+  };
+  // unique strings on the inner side of the one-to-one join, repeated ones on the one-to-many side
+  insert_rows("str_join_outer", 0, 30, 5, 13);
+  insert_rows("str_join_unique", 0, 8, 12, 13);
+  insert_rows("str_join_dup", 0, 24, 3, 13);
+  auto check_joins = [](const ExecutorDeviceType dt) {
+    c("SELECT COUNT(*) FROM str_join_outer a JOIN str_join_unique b ON a.s = b.s;", dt);
+    c("SELECT a.x, b.x FROM str_join_outer a JOIN str_join_unique b ON a.s = b.s ORDER BY a.x, b.x;", dt);
+    c("SELECT a.x, b.x FROM str_join_outer a LEFT JOIN str_join_unique b ON a.s = b.s ORDER BY a.x, b.x;", dt);
+    c("SELECT COUNT(*) FROM str_join_outer a JOIN str_join_dup b ON a.s = b.s;", dt);
+    c("SELECT a.x, b.x FROM str_join_outer a JOIN str_join_dup b ON a.s = b.s ORDER BY a.x, b.x;", dt);
+    c("SELECT b.s, COUNT(*) FROM str_join_outer a JOIN str_join_dup b ON a.s = b.s GROUP BY b.s ORDER BY b.s;", dt);
+  };
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    check_joins(dt);
+  }
+  // strings new to both dictionaries after their translation was cached
+  insert_rows("str_join_outer", 30, 10, 7, 17);
+  insert_rows("str_join_unique", 8, 4, 12, 13);
+  insert_rows("str_join_dup", 24, 12, 5, 17);
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    check_joins(dt);
+  }
+  for (const auto& table : tables) {
+    const std::string drop_table{"DROP TABLE " + table + ";"};
+    run_ddl_statement(drop_table);
+    g_sqlite_comparator.query(drop_table);
+  }
+}
+
 TEST(Select, Joins_InnerJoin_AtLeastThreeTables) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -3794,6 +4144,49 @@ TEST(Select, WatchdogTest) {
   }
 }
 
+TEST(Select, DynamicWatchdogConcurrentQueries) {
+  const auto enable_dynamic_watchdog = g_enable_dynamic_watchdog;
+  std::vector<ExecutorDeviceType> device_types;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    device_types.push_back(dt);
+  }
+  const std::string query{"SELECT COUNT(*) FROM test WHERE x > 6;"};
+  const auto expected = v<int64_t>(run_simple_agg(query, ExecutorDeviceType::CPU));
+  g_enable_dynamic_watchdog = true;
+  {
+    // the deadline is process-wide, a query on either device waits for the one running
+    auto cpu_admission = QueryAdmission::admit(ExecutorDeviceType::CPU);
+    auto gpu_admission =
+        std::async(std::launch::async, [] { return QueryAdmission::admit(ExecutorDeviceType::GPU); });
+    ASSERT_EQ(std::future_status::timeout, gpu_admission.wait_for(std::chrono::milliseconds(100)));
+    cpu_admission.reset();
+    gpu_admission.get();
+  }
+  std::atomic<size_t> failures{0};
+  std::vector<std::thread> clients;
+  for (size_t i = 0; i < 8; ++i) {
+    const auto dt = device_types[i % device_types.size()];
+    clients.emplace_back([&query, expected, dt, &failures] {
+      for (size_t j = 0; j < 10; ++j) {
+        try {
+          if (v<int64_t>(run_simple_agg(query, dt)) != expected) {
+            ++failures;
+          }
+        } catch (const std::exception& e) {
+          LOG(ERROR) << e.what();
+          ++failures;
+        }
+      }
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  g_enable_dynamic_watchdog = enable_dynamic_watchdog;
+  ASSERT_EQ(size_t(0), failures.load());
+}
+
 TEST(Truncate, Count) {
   run_ddl_statement("create table trunc_test (i1 integer, t1 text);");
   run_multiple_agg("insert into trunc_test values(1, '1');", ExecutorDeviceType::CPU);
@@ -116,8 +116,16 @@ ExecutionResult run_select_query(const std::string& query_str,
                                  const bool allow_loop_joins) {
   const auto& cat = session->get_catalog();
   auto executor = Executor::getExecutor(cat.get_currentDB().dbId);
-  CompilationOptions co = {device_type, true, ExecutorOptLevel::LoopStrengthReduction, false};
-  ExecutionOptions eo = {false, true, false, allow_loop_joins, false, false, false, false, 10000};
+  CompilationOptions co = {device_type, true, ExecutorOptLevel::LoopStrengthReduction, g_enable_dynamic_watchdog};
+  ExecutionOptions eo = {false,
+                         true,
+                         false,
+                         allow_loop_joins,
+                         false,
+                         false,
+                         false,
+                         g_enable_dynamic_watchdog,
+                         g_dynamic_watchdog_time_limit};
   auto& calcite_mgr = cat.get_calciteMgr();
   const auto query_ra = calcite_mgr.process(*session, pg_shim(query_str), true, false);
   RelAlgExecutor ra_executor(executor.get(), cat);
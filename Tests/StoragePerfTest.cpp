@@ -28,14 +28,24 @@
 #include "../Analyzer/Analyzer.h"
 #include "../Parser/ParserNode.h"
 #include "../DataMgr/DataMgr.h"
+#include "../DataMgr/FileMgr/GlobalFileMgr.h"
 #include "../Fragmenter/Fragmenter.h"
+#include "../Shared/measure.h"
 #include "PopulateTableRandom.h"
 #include "ScanTable.h"
 #include "gtest/gtest.h"
 #include "glog/logging.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <thread>
 #include <future>
 
+extern bool g_enable_async_file_reads;
+extern bool g_enable_table_wal;
+extern size_t g_table_wal_flush_interval;
+extern bool g_enable_metadata_index;
+
 using namespace std;
 using namespace Catalog_Namespace;
 using namespace Analyzer;
@@ -127,8 +137,330 @@ static size_t load_data_for_thread_test_2(int num_rows, string table_name) {
   return insert_col_hashs.size();
 }
 
+// Drops the CPU buffers and the OS page cache of the table files, the next scan reads everything from disk.
+void evict_table(const TableDescriptor* td) {
+  auto& cat = gsession->get_catalog();
+  cat.get_dataMgr().clearMemory(Data_Namespace::MemoryLevel::CPU_LEVEL);
+  boost::filesystem::path table_dir{BASE_PATH};
+  table_dir /= "mapd_data";
+  table_dir /= "table_" + to_string(cat.get_currentDB().dbId) + "_" + to_string(td->tableId);
+  for (boost::filesystem::directory_iterator it(table_dir), end_it; it != end_it; ++it) {
+    const int fd = open(it->path().c_str(), O_RDONLY);
+    CHECK_GE(fd, 0);
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+  }
+}
+
+// Returns the disk space actually allocated to the files of the table, holes excluded.
+size_t table_disk_bytes(const TableDescriptor* td) {
+  auto& cat = gsession->get_catalog();
+  boost::filesystem::path table_dir{BASE_PATH};
+  table_dir /= "mapd_data";
+  table_dir /= "table_" + to_string(cat.get_currentDB().dbId) + "_" + to_string(td->tableId);
+  size_t num_bytes = 0;
+  for (boost::filesystem::directory_iterator it(table_dir), end_it; it != end_it; ++it) {
+    struct stat file_stat;
+    CHECK_EQ(stat(it->path().c_str(), &file_stat), 0);
+    num_bytes += file_stat.st_blocks * 512;
+  }
+  return num_bytes;
+}
+
+size_t table_num_bytes(const string& table_name) {
+  auto& cat = gsession->get_catalog();
+  const auto td = cat.getMetadataForTable(table_name);
+  CHECK(td);
+  std::vector<std::pair<ChunkKey, ChunkMetadata>> chunk_metadata;
+  cat.get_dataMgr().getChunkMetadataVecForKeyPrefix(chunk_metadata, {cat.get_currentDB().dbId, td->tableId});
+  size_t num_bytes = 0;
+  for (const auto& chunk : chunk_metadata) {
+    num_bytes += chunk.second.numBytes;
+  }
+  return num_bytes;
+}
+
+double cold_scan_gb_per_sec(const string& table_name) {
+  auto& cat = gsession->get_catalog();
+  const auto td = cat.getMetadataForTable(table_name);
+  CHECK(td);
+  const auto num_bytes = table_num_bytes(table_name);
+  evict_table(td);
+  const auto scan_ms = measure<>::execution([&]() { scan_table_return_hash_non_iter(table_name, cat); });
+  return static_cast<double>(num_bytes) / (1 << 30) / (std::max(scan_ms, int64_t(1)) / 1000.);
+}
+
+// Inserts the rows (a[i], b[i]) into a table with an INT column a and a BIGINT column b.
+void insert_rows(const string& table_name, std::vector<int32_t>& a, std::vector<int64_t>& b) {
+  auto& cat = gsession->get_catalog();
+  const auto td = cat.getMetadataForTable(table_name);
+  CHECK(td);
+  const auto cds = cat.getAllColumnMetadataForTable(td->tableId, false, false);
+  CHECK_EQ(cds.size(), size_t(2));
+  CHECK_EQ(a.size(), b.size());
+  InsertData insert_data;
+  insert_data.databaseId = cat.get_currentDB().dbId;
+  insert_data.tableId = td->tableId;
+  for (const auto cd : cds) {
+    insert_data.columnIds.push_back(cd->columnId);
+  }
+  insert_data.numRows = a.size();
+  DataBlockPtr p{0};
+  p.numbersPtr = reinterpret_cast<int8_t*>(&a[0]);
+  insert_data.data.push_back(p);
+  p.numbersPtr = reinterpret_cast<int8_t*>(&b[0]);
+  insert_data.data.push_back(p);
+  td->fragmenter->insertData(insert_data);
+}
+
+// Loads clustered rows into a table with an INT column a and a BIGINT column b: a repeats each value for 1000
+// consecutive rows, b grows slowly from a large base, the data run length and differential encodings are meant for.
+void load_clustered_data(const string& table_name, const size_t num_rows) {
+  std::vector<int32_t> a(num_rows);
+  std::vector<int64_t> b(num_rows);
+  for (size_t i = 0; i < num_rows; ++i) {
+    a[i] = i / 1000;
+    b[i] = 1500000000 + i / 64;
+  }
+  insert_rows(table_name, a, b);
+}
+
+// Replaces the files of a table directory with copies of the files of another one.
+void copy_table_dir(const boost::filesystem::path& from, const boost::filesystem::path& to) {
+  boost::filesystem::remove_all(to);
+  boost::filesystem::create_directories(to);
+  for (boost::filesystem::directory_iterator it(from), end_it; it != end_it; ++it) {
+    boost::filesystem::copy_file(it->path(), to / it->path().filename());
+  }
+}
+
+// Reads an INT chunk written straight to the file manager of a table.
+std::vector<int32_t> read_int_chunk(File_Namespace::FileMgr* fm, const ChunkKey& key) {
+  auto buffer = fm->getBuffer(key);
+  std::vector<int32_t> rows(buffer->size() / sizeof(int32_t));
+  buffer->read(reinterpret_cast<int8_t*>(rows.data()), buffer->size());
+  return rows;
+}
+
 }  // namespace
 
+TEST(StoragePerf, ColdScan) {
+  ASSERT_NO_THROW(run_ddl("drop table if exists cold_scan;"););
+  ASSERT_NO_THROW(run_ddl("create table cold_scan (a smallint, b int, c bigint, d numeric(7,3), e "
+                          "double, f float) with (fragment_size = 1000000);"););
+  EXPECT_TRUE(load_data_test("cold_scan", SMALL));
+  const bool enable_async_file_reads = g_enable_async_file_reads;
+  g_enable_async_file_reads = false;
+  const auto stdio_gb_per_sec = cold_scan_gb_per_sec("cold_scan");
+  g_enable_async_file_reads = true;
+  const auto async_gb_per_sec = cold_scan_gb_per_sec("cold_scan");
+  g_enable_async_file_reads = enable_async_file_reads;
+  LOG(INFO) << "Cold scan: " << stdio_gb_per_sec << " GB/s with stdio reads, " << async_gb_per_sec
+            << " GB/s with asynchronous reads and prefetching";
+  ASSERT_NO_THROW(run_ddl("drop table cold_scan;"););
+}
+
+TEST(StoragePerf, ClusteredEncodings) {
+  const std::vector<std::pair<string, string>> encodings{
+      {"fixed", "a int encoding fixed(16), b bigint encoding fixed(32)"},
+      {"rl", "a int encoding rl, b bigint encoding rl"},
+      {"diff", "a int encoding diff(16), b bigint encoding diff(16)"},
+      {"packed", "a int encoding packed(15), b bigint encoding packed(32)"}};
+  std::vector<size_t> fixed_hashes;
+  for (const auto& encoding : encodings) {
+    const auto table_name = "clustered_" + encoding.first;
+    ASSERT_NO_THROW(run_ddl("drop table if exists " + table_name + ";"););
+    ASSERT_NO_THROW(
+        run_ddl("create table " + table_name + " (" + encoding.second + ") with (fragment_size = 1000000);"););
+    load_clustered_data(table_name, SMALL);
+    auto& cat = gsession->get_catalog();
+    evict_table(cat.getMetadataForTable(table_name));
+    std::vector<size_t> hashes;
+    const auto scan_ms =
+        measure<>::execution([&]() { hashes = scan_table_return_hash_non_iter(table_name, cat); });
+    if (fixed_hashes.empty()) {
+      fixed_hashes = hashes;
+    } else {
+      EXPECT_EQ(fixed_hashes, hashes);
+    }
+    LOG(INFO) << encoding.first << " encoding: " << table_num_bytes(table_name) << " bytes, cold scan in " << scan_ms
+              << " ms";
+    ASSERT_NO_THROW(run_ddl("drop table " + table_name + ";"););
+  }
+}
+
+// The win depends on the read bandwidth of the disk holding BASE_PATH, it's largest on spinning and network disks.
+TEST(StoragePerf, CompressedColdScan) {
+  std::vector<size_t> uncompressed_hashes;
+  for (const string codec : {"none", "lz4", "zstd"}) {
+    const auto table_name = "cold_scan_" + codec;
+    ASSERT_NO_THROW(run_ddl("drop table if exists " + table_name + ";"););
+    try {
+      run_ddl("create table " + table_name +
+              " (a int, b bigint) with (fragment_size = 1000000, storage_compression = '" + codec + "');");
+    } catch (const std::runtime_error& e) {
+      LOG(INFO) << "Skipping " << codec << " storage compression: " << e.what();
+      continue;
+    }
+    load_clustered_data(table_name, SMALL);
+    auto& cat = gsession->get_catalog();
+    const auto td = cat.getMetadataForTable(table_name);
+    evict_table(td);
+    std::vector<size_t> hashes;
+    const auto scan_ms = measure<>::execution([&]() { hashes = scan_table_return_hash_non_iter(table_name, cat); });
+    if (uncompressed_hashes.empty()) {
+      uncompressed_hashes = hashes;
+    } else {
+      EXPECT_EQ(uncompressed_hashes, hashes);
+    }
+    const auto num_bytes = table_num_bytes(table_name);
+    LOG(INFO) << codec << " storage compression: " << table_disk_bytes(td) << " bytes on disk, cold scan at "
+              << static_cast<double>(num_bytes) / (1 << 30) / (std::max(scan_ms, int64_t(1)) / 1000.) << " GB/s";
+    ASSERT_NO_THROW(run_ddl("drop table " + table_name + ";"););
+  }
+}
+
+// Streaming clients insert a few hundred rows per call, each insert is a checkpoint of the table.
+TEST(StoragePerf, SmallBatchInserts) {
+  const bool enable_table_wal = g_enable_table_wal;
+  std::vector<size_t> no_wal_hashes;
+  for (const bool wal : {false, true}) {
+    g_enable_table_wal = wal;  // read when the table files are first opened
+    const string table_name = wal ? "small_batches_wal" : "small_batches";
+    ASSERT_NO_THROW(run_ddl("drop table if exists " + table_name + ";"););
+    ASSERT_NO_THROW(run_ddl("create table " + table_name + " (a int, b bigint);"););
+    const size_t num_batches = 500;
+    const auto load_ms = measure<>::execution([&]() {
+      for (size_t i = 0; i < num_batches; ++i) {
+        load_clustered_data(table_name, 300);
+      }
+    });
+    auto& cat = gsession->get_catalog();
+    const auto hashes = scan_table_return_hash_non_iter(table_name, cat);
+    if (no_wal_hashes.empty()) {
+      no_wal_hashes = hashes;
+    } else {
+      EXPECT_EQ(no_wal_hashes, hashes);
+    }
+    LOG(INFO) << num_batches << " inserts of 300 rows " << (wal ? "with" : "without") << " write-ahead log: "
+              << num_batches * 1000. / std::max(load_ms, int64_t(1)) << " inserts/s";
+    ASSERT_NO_THROW(run_ddl("drop table " + table_name + ";"););
+  }
+  g_enable_table_wal = enable_table_wal;
+}
+
+// A restart opens each table on first access: from its metadata index, or from its page headers after a crash.
+TEST(StoragePerf, TableOpen) {
+  ASSERT_NO_THROW(run_ddl("drop table if exists table_open;"););
+  ASSERT_NO_THROW(run_ddl("create table table_open (a int, b bigint) with (fragment_size = 10000);"););
+  for (size_t i = 0; i < 100; ++i) {
+    load_clustered_data("table_open", 10000);
+  }
+  auto& cat = gsession->get_catalog();
+  const auto td = cat.getMetadataForTable("table_open");
+  const bool enable_metadata_index = g_enable_metadata_index;
+  std::vector<size_t> num_chunks;
+  for (const bool metadata_index : {true, false}) {
+    g_enable_metadata_index = metadata_index;
+    evict_table(td);
+    // a second file manager over the same files opens the table as a restarted server would
+    File_Namespace::GlobalFileMgr gfm(0, string(BASE_PATH) + "/mapd_data");
+    const auto open_ms = measure<>::execution(
+        [&]() { num_chunks.push_back(gfm.getFileMgr(cat.get_currentDB().dbId, td->tableId)->getNumChunks()); });
+    LOG(INFO) << "Opened " << num_chunks.back() << " chunks "
+              << (metadata_index ? "from the metadata index" : "by scanning the page headers") << " in " << open_ms
+              << " ms";
+  }
+  EXPECT_EQ(num_chunks.front(), num_chunks.back());
+  g_enable_metadata_index = enable_metadata_index;
+  ASSERT_NO_THROW(run_ddl("drop table table_open;"););
+}
+
+TEST(StorageSmall, DiffEncodingOverflow) {
+  ASSERT_NO_THROW(run_ddl("drop table if exists diff_overflow;"););
+  ASSERT_NO_THROW(run_ddl("create table diff_overflow (a int encoding diff(8), b bigint encoding diff(16));"););
+  load_clustered_data("diff_overflow", 100000);
+  auto& cat = gsession->get_catalog();
+  const auto td = cat.getMetadataForTable("diff_overflow");
+  const auto hashes = scan_table_return_hash_non_iter("diff_overflow", cat);
+  // the baseline of a is 0, 1000 doesn't fit in 8 bits, b is in range: neither column may be appended to
+  std::vector<int32_t> a{5, 1000};
+  std::vector<int64_t> b{1500000000, 1500000001};
+  EXPECT_THROW(insert_rows("diff_overflow", a, b), std::runtime_error);
+  EXPECT_EQ(size_t(100000), td->fragmenter->getFragmentsForQuery().getPhysicalNumTuples());
+  EXPECT_EQ(hashes, scan_table_return_hash_non_iter("diff_overflow", cat));
+  // a value below the baseline by more than the width can represent is rejected as well
+  a = {-200};
+  b = {1500000000};
+  EXPECT_THROW(insert_rows("diff_overflow", a, b), std::runtime_error);
+  a = {-100};
+  ASSERT_NO_THROW(insert_rows("diff_overflow", a, b));
+  EXPECT_EQ(size_t(100001), td->fragmenter->getFragmentsForQuery().getPhysicalNumTuples());
+  ASSERT_NO_THROW(run_ddl("drop table diff_overflow;"););
+}
+
+// Commits to the write-ahead log must survive a crash which loses every write to the data files since the table was
+// created, a commit the crash tore is ignored.
+TEST(StorageSmall, WalRecovery) {
+  const bool enable_table_wal = g_enable_table_wal;
+  const size_t table_wal_flush_interval = g_table_wal_flush_interval;
+  g_enable_table_wal = true;
+  g_table_wal_flush_interval = 3600;  // the log must not be flushed to the data files during the test
+  const boost::filesystem::path base_path{string(BASE_PATH) + "/wal_recovery"};
+  const auto table_path = base_path / "table_1_1";
+  const auto created_path = base_path / "created";
+  const auto wal_path = base_path / "wal";
+  boost::filesystem::remove_all(base_path);
+  const ChunkKey key{1, 1, 1, 0};
+  std::vector<int32_t> rows;
+  std::vector<size_t> commit_wal_sizes;
+  {
+    File_Namespace::GlobalFileMgr gfm(0, base_path.string());
+    auto fm = gfm.getFileMgr(1, 1);
+    // with the log, the data files aren't synced after the table is created
+    copy_table_dir(table_path, created_path);
+    auto buffer = fm->createBuffer(key);
+    for (size_t i = 0; i < 10; ++i) {
+      std::vector<int32_t> batch(300);
+      for (auto& row : batch) {
+        row = rows.size();
+        rows.push_back(row);
+      }
+      buffer->append(reinterpret_cast<int8_t*>(batch.data()), batch.size() * sizeof(int32_t));
+      fm->checkpoint();
+      commit_wal_sizes.push_back(boost::filesystem::file_size(table_path / "wal"));
+      if (i > 0) {
+        EXPECT_GT(commit_wal_sizes[i], commit_wal_sizes[i - 1]);  // committed to the log, not synced
+      }
+    }
+  }
+  boost::filesystem::copy_file(table_path / "wal", wal_path);
+  // the state a crash leaves on disk: the files of the table as it was created, the log up to wal_size
+  auto crash = [&](const size_t wal_size) {
+    copy_table_dir(created_path, table_path);
+    boost::filesystem::remove(table_path / "wal");
+    boost::filesystem::copy_file(wal_path, table_path / "wal");
+    boost::filesystem::resize_file(table_path / "wal", wal_size);
+  };
+  crash(commit_wal_sizes.back());
+  {
+    File_Namespace::GlobalFileMgr gfm(0, base_path.string());
+    EXPECT_EQ(rows, read_int_chunk(gfm.getFileMgr(1, 1), key));
+  }
+  // the crash tore the last commit in the middle of its records
+  const auto torn_commit_start = commit_wal_sizes[commit_wal_sizes.size() - 2];
+  crash(torn_commit_start + (commit_wal_sizes.back() - torn_commit_start) / 2);
+  rows.resize(rows.size() - 300);
+  {
+    File_Namespace::GlobalFileMgr gfm(0, base_path.string());
+    EXPECT_EQ(rows, read_int_chunk(gfm.getFileMgr(1, 1), key));
+  }
+  boost::filesystem::remove_all(base_path);
+  g_table_wal_flush_interval = table_wal_flush_interval;
+  g_enable_table_wal = enable_table_wal;
+}
+
 TEST(DataLoad, Numbers) {
   ASSERT_NO_THROW(run_ddl("drop table if exists numbers;"););
   ASSERT_NO_THROW(run_ddl("create table numbers (a smallint, b int, c bigint, d numeric(7,3), e "
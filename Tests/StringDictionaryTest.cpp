@@ -15,8 +15,12 @@
  */
 
 #include "../StringDictionary/StringDictionary.h"
+#include "../StringDictionary/NgramIndex.h"
 
+#include <algorithm>
+#include <chrono>
 #include <limits>
+#include <thread>
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -86,6 +90,233 @@ TEST(StringDictionary, RecoverMany) {
   }
 }
 
+TEST(StringDictionary, LikeCache) {
+  StringDictionary string_dict(BASE_PATH, false, false);
+  for (int i = 0; i < g_op_count; ++i) {
+    CHECK_EQ(i, string_dict.getOrAdd(std::to_string(i)));
+  }
+  const auto first = string_dict.getLike("%99", false, false, '\\', g_op_count);
+  ASSERT_EQ(size_t(g_op_count / 100), first.size());
+  ASSERT_TRUE(std::is_sorted(first.begin(), first.end()));
+  ASSERT_EQ(first, string_dict.getLike("%99", false, false, '\\', g_op_count));
+  // an earlier generation only sees the strings added before it
+  ASSERT_EQ(size_t(10), string_dict.getLike("%99", false, false, '\\', 1000).size());
+  for (int i = g_op_count; i < 2 * g_op_count; ++i) {
+    CHECK_EQ(i, string_dict.getOrAdd(std::to_string(i)));
+  }
+  const auto start = std::chrono::steady_clock::now();
+  const auto extended = string_dict.getLike("%99", false, false, '\\', 2 * g_op_count);
+  const auto extend_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  ASSERT_EQ(size_t(2 * g_op_count / 100), extended.size());
+  ASSERT_TRUE(std::equal(first.begin(), first.end(), extended.begin()));
+  ASSERT_EQ(size_t(2), string_dict.getRegexpLike("12[0-1]", '\\', 1000).size());
+  auto stats = string_dict.getLikeCacheStats();
+  ASSERT_EQ(size_t(2), stats.hits);
+  ASSERT_EQ(size_t(1), stats.extensions);
+  ASSERT_EQ(size_t(2), stats.misses);
+  ASSERT_EQ(size_t(2), stats.entries);
+  LOG(INFO) << "Extended a LIKE result over " << g_op_count << " new strings in " << extend_ms << " ms";
+
+  const auto max_size = g_string_dictionary_like_cache_max_size;
+  g_string_dictionary_like_cache_max_size = stats.size;
+  string_dict.getLike("%98", false, false, '\\', 2 * g_op_count);
+  stats = string_dict.getLikeCacheStats();
+  ASSERT_LE(stats.size, g_string_dictionary_like_cache_max_size);
+  ASSERT_LT(size_t(0), stats.evictions);
+  g_string_dictionary_like_cache_max_size = max_size;
+}
+
+namespace {
+
+std::string url(const int i) {
+  return "http://host" + std::to_string(i % 1000) + ".example.com/path/" + std::to_string(int64_t(i) * 7919 % 1000003);
+}
+
+}  // namespace
+
+TEST(StringDictionary, NgramIndex) {
+  const bool enable_ngram_index = g_enable_string_dictionary_ngram_index;
+  for (const int str_count : {10000, 100000, 1000000}) {
+    std::vector<int32_t> scan_ids;
+    for (const bool ngram_index : {false, true}) {
+      g_enable_string_dictionary_ngram_index = ngram_index;  // read when the dictionary is opened
+      StringDictionary string_dict(BASE_PATH, false, false);
+      for (int i = 0; i < str_count; ++i) {
+        CHECK_EQ(i, string_dict.getOrAdd(url(i)));
+      }
+      const auto start = std::chrono::steady_clock::now();
+      const auto ids = string_dict.getLike("%st4%.com/path/12%", true, false, '\\', str_count);
+      const auto like_us =
+          std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+      if (ngram_index) {
+        ASSERT_EQ(scan_ids, ids);
+      } else {
+        ASSERT_LT(size_t(0), ids.size());
+        scan_ids = ids;
+      }
+      LOG(INFO) << "Substring LIKE over " << str_count << " strings " << (ngram_index ? "with" : "without")
+                << " the n-gram index: " << like_us << " us";
+    }
+  }
+
+  // the index is saved at checkpoints and extended with the strings added since when reopened
+  g_enable_string_dictionary_ngram_index = true;
+  {
+    StringDictionary string_dict(BASE_PATH, false, false);
+    for (int i = 0; i < 1000; ++i) {
+      string_dict.getOrAdd(url(i));
+    }
+    ASSERT_TRUE(string_dict.checkpoint());
+    for (int i = 1000; i < 2000; ++i) {
+      string_dict.getOrAdd(url(i));
+    }
+  }
+  StringDictionary string_dict(BASE_PATH, false, true);
+  const auto ids = string_dict.getLike("host99.", false, true, '\\', 2000);
+  ASSERT_EQ(size_t(2), ids.size());
+  ASSERT_EQ(url(99), string_dict.getString(ids[0]));
+  ASSERT_EQ(url(1099), string_dict.getString(ids[1]));
+  g_enable_string_dictionary_ngram_index = enable_ngram_index;
+}
+
+TEST(StringDictionary, Throughput) {
+  const int str_count{1000000};
+  std::vector<std::string> strings;
+  strings.reserve(str_count);
+  for (int i = 0; i < str_count; ++i) {
+    strings.push_back(url(i));
+  }
+  StringDictionary string_dict(BASE_PATH, false, false);
+  std::vector<int32_t> ids(str_count);
+  auto start = std::chrono::steady_clock::now();
+  string_dict.getOrAddBulk(strings, ids.data());
+  const auto add_ms = std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+      decltype(start)::rep(1));
+  for (int i = 0; i < str_count; ++i) {
+    ASSERT_EQ(i, ids[i]);
+  }
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < str_count; ++i) {
+    ids[i] = string_dict.getIdOfString(strings[i]);
+  }
+  const auto lookup_ms = std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+      decltype(start)::rep(1));
+  for (int i = 0; i < str_count; ++i) {
+    ASSERT_EQ(i, ids[i]);
+  }
+  ASSERT_EQ(StringDictionary::INVALID_STR_ID, string_dict.getIdOfString("http://host1000.example.com/path/"));
+  LOG(INFO) << "Bulk add of " << str_count << " strings: " << str_count * 1000. / add_ms << " strings/s, lookups: "
+            << str_count * 1000. / lookup_ms << " strings/s";
+}
+
+TEST(StringDictionary, ConcurrentBulkAdd) {
+  // the import threads look up and add the same strings at the same time
+  const int thread_count{8};
+  const int batch_size{10000};
+  const int str_count{1000000};
+  StringDictionary string_dict(BASE_PATH, false, false);
+  std::vector<int32_t> ids(str_count);
+  std::vector<std::vector<int32_t>> thread_ids(thread_count, std::vector<int32_t>(str_count));
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&string_dict, &thread_ids, t]() {
+      std::vector<std::string> strings(batch_size);
+      // every thread adds all the strings, starting from a different batch
+      const int batch_count = str_count / batch_size;
+      for (int batch = 0; batch < batch_count; ++batch) {
+        const int batch_first = (batch + t * batch_count / thread_count) % batch_count * batch_size;
+        for (int i = 0; i < batch_size; ++i) {
+          strings[i] = url(batch_first + i);
+        }
+        string_dict.getOrAddBulk(strings, &thread_ids[t][batch_first]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto add_ms = std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+      decltype(start)::rep(1));
+  ASSERT_EQ(size_t(str_count), string_dict.storageEntryCount());
+  for (int i = 0; i < str_count; ++i) {
+    const auto id = thread_ids[0][i];
+    for (int t = 1; t < thread_count; ++t) {
+      ASSERT_EQ(id, thread_ids[t][i]);
+    }
+    ASSERT_EQ(url(i), string_dict.getString(id));
+  }
+  LOG(INFO) << "Bulk add of " << str_count << " strings from " << thread_count
+            << " threads: " << str_count * thread_count * 1000. / add_ms << " strings/s";
+}
+
+TEST(StringDictionary, TranslationMap) {
+  const int str_count{1000000};
+  auto source_dict = std::make_shared<StringDictionary>("", true, false);
+  auto dest_dict = std::make_shared<StringDictionary>("", true, false);
+  // every other source string is in the destination, in reverse order, half of them above the middle id
+  for (int i = 0; i < str_count; ++i) {
+    source_dict->getOrAdd(url(i));
+    dest_dict->getOrAdd(i % 2 ? url(-1 - i) : url(str_count - 1 - i));
+  }
+  // a map can be cached for a later generation of the destination, translated ids past the requested one are fine
+  const auto check_map = [&source_dict, &dest_dict](
+      const std::vector<int32_t>& ids, const size_t source_generation, const size_t dest_generation) {
+    ASSERT_EQ(source_generation, ids.size());
+    for (size_t i = 0; i < source_generation; ++i) {
+      const auto dest_id = ids[i];
+      if (dest_id == StringDictionary::INVALID_STR_ID) {
+        const auto id = dest_dict->getIdOfString(source_dict->getString(i));
+        ASSERT_TRUE(id == StringDictionary::INVALID_STR_ID || size_t(id) >= dest_generation);
+      } else {
+        ASSERT_EQ(source_dict->getString(i), dest_dict->getString(dest_id));
+      }
+    }
+  };
+  const auto count_from = [](const std::vector<int32_t>& ids, const size_t dest_id) {
+    return std::count_if(ids.begin(), ids.end(), [dest_id](const int32_t id) {
+      return id != StringDictionary::INVALID_STR_ID && size_t(id) >= dest_id;
+    });
+  };
+  auto start = std::chrono::steady_clock::now();
+  const auto half_ids = source_dict->getTranslationMap(dest_dict, str_count, str_count / 2);
+  const auto translate_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  check_map(*half_ids, str_count, str_count / 2);
+  ASSERT_EQ(0, count_from(*half_ids, str_count / 2));
+  ASSERT_LT(0, count_from(*half_ids, 0));
+  // the rest of the destination only fills in the strings missing so far
+  const auto ids = source_dict->getTranslationMap(dest_dict, str_count, str_count);
+  check_map(*ids, str_count, str_count);
+  ASSERT_LT(0, count_from(*ids, str_count / 2));
+  start = std::chrono::steady_clock::now();
+  ASSERT_EQ(ids, source_dict->getTranslationMap(dest_dict, str_count, str_count));
+  const auto hit_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  // an earlier generation of the destination gets the cached map
+  ASSERT_EQ(ids, source_dict->getTranslationMap(dest_dict, str_count, str_count / 2));
+  check_map(*ids, str_count, str_count / 2);
+
+  // strings added to either side only extend the map, some are already in the destination
+  for (int i = str_count; i < str_count + 1000; ++i) {
+    source_dict->getOrAdd(url(i));
+    dest_dict->getOrAdd(url(i - 500));
+  }
+  const auto dest_generation = dest_dict->storageEntryCount();
+  ASSERT_LT(size_t(str_count), dest_generation);
+  start = std::chrono::steady_clock::now();
+  const auto extended = source_dict->getTranslationMap(dest_dict, str_count + 1000, dest_generation);
+  const auto extend_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  check_map(*extended, str_count + 1000, dest_generation);
+  LOG(INFO) << "Translated " << str_count << " strings in " << translate_ms << " ms, cache hit in " << hit_us
+            << " us, extended by 1000 strings on each side in " << extend_ms << " ms";
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   auto err = RUN_ALL_TESTS();
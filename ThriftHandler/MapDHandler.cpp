@@ -54,6 +54,7 @@
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/GpuMemUtils.h"
 #include "QueryEngine/JsonAccessors.h"
+#include "QueryEngine/WorkStealingPool.h"
 #include "Shared/geosupport.h"
 #include "Shared/mapd_shared_mutex.h"
 #include "Shared/measure.h"
@@ -135,7 +136,8 @@ MapDHandler::MapDHandler(const std::vector<LeafHostInfo>& db_leaves,
       mapd_parameters_(mapd_parameters),
       legacy_syntax_(legacy_syntax),
       super_user_rights_(false),
-      access_priv_check_(access_priv_check) {
+      access_priv_check_(access_priv_check),
+      next_prepared_query_id_(0) {
   LOG(INFO) << "MapD Server " << MAPD_RELEASE;
   if (executor_device == "gpu") {
 #ifdef HAVE_CUDA
@@ -334,6 +336,14 @@ void MapDHandler::disconnect(const TSessionId& session) {
   LOG(INFO) << "User " << session_it->second->get_currentUser().userName << " disconnected from database " << dbname
             << std::endl;
   sessions_.erase(session_it);
+  std::lock_guard<std::mutex> prepared_queries_lock(prepared_queries_mutex_);
+  for (auto it = prepared_queries_.begin(); it != prepared_queries_.end();) {
+    if (it->second->session == session) {
+      it = prepared_queries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
 void MapDHandler::interrupt(const TSessionId& session) {
@@ -346,15 +356,12 @@ void MapDHandler::interrupt(const TSessionId& session) {
     const auto dbname = session_it->second->get_catalog().get_currentDB().dbName;
     auto session_info_ptr = session_it->second.get();
     auto& cat = session_info_ptr->get_catalog();
-    auto executor = Executor::getExecutor(
-        cat.get_currentDB().dbId, jit_debug_ ? "/tmp" : "", jit_debug_ ? "mapdquery" : "", mapd_parameters_, nullptr);
-    CHECK(executor);
 
     VLOG(1) << "Received interrupt: "
-            << "Session " << session << ", Executor " << executor << ", leafCount " << leaf_aggregator_.leafCount()
-            << ", User " << session_it->second->get_currentUser().userName << ", Database " << dbname << std::endl;
+            << "Session " << session << ", leafCount " << leaf_aggregator_.leafCount() << ", User "
+            << session_it->second->get_currentUser().userName << ", Database " << dbname << std::endl;
 
-    executor->interrupt();
+    Executor::interruptExecutors(cat.get_currentDB().dbId);
 
     LOG(INFO) << "User " << session_it->second->get_currentUser().userName << " interrupted session with database "
               << dbname << std::endl;
@@ -368,6 +375,11 @@ void MapDHandler::get_server_status(TServerStatus& _return, const TSessionId& se
   _return.start_time = start_time_;
   _return.edition = MAPD_EDITION;
   _return.host_name = "aggregator";
+  const auto worker_stats = WorkStealingPool::instance().getStats();
+  _return.fragment_worker_threads = worker_stats.thread_count;
+  _return.fragment_tasks_executed = worker_stats.tasks_executed;
+  _return.fragment_tasks_stolen = worker_stats.tasks_stolen;
+  _return.fragment_worker_idle_ms = worker_stats.idle_time_ms;
 }
 
 void MapDHandler::get_status(std::vector<TServerStatus>& _return, const TSessionId& session) {
@@ -378,6 +390,11 @@ void MapDHandler::get_status(std::vector<TServerStatus>& _return, const TSession
   ret.start_time = start_time_;
   ret.edition = MAPD_EDITION;
   ret.host_name = "aggregator";
+  const auto worker_stats = WorkStealingPool::instance().getStats();
+  ret.fragment_worker_threads = worker_stats.thread_count;
+  ret.fragment_tasks_executed = worker_stats.tasks_executed;
+  ret.fragment_tasks_stolen = worker_stats.tasks_stolen;
+  ret.fragment_worker_idle_ms = worker_stats.idle_time_ms;
   _return.push_back(ret);
   if (leaf_aggregator_.leafCount() > 0) {
     std::vector<TServerStatus> leaf_status = leaf_aggregator_.getLeafStatus(session);
@@ -599,6 +616,11 @@ void MapDHandler::sql_execute(TQueryResult& _return,
                                     first_n,
                                     at_most_n);
     });
+    const auto plan_cache_stats = calcite_->getPlanCacheStats();
+    _return.plan_cache_hits = plan_cache_stats.hits;
+    _return.plan_cache_misses = plan_cache_stats.misses;
+    _return.plan_cache_entries = plan_cache_stats.entries;
+    _return.plan_cache_max_entries = plan_cache_stats.max_entries;
     LOG(INFO) << "sql_execute-COMPLETED Total: " << _return.total_time_ms
               << " (ms), Execution: " << _return.execution_time_ms << " (ms)";
   }
@@ -710,6 +732,120 @@ void MapDHandler::sql_validate(TTableDescriptor& _return, const TSessionId& sess
   MapDHandler::validate_rel_alg(_return, query_str, session_info);
 }
 
+void MapDHandler::prepare_query(TPreparedQuery& _return, const TSessionId& session, const std::string& query_str) {
+  const auto session_info = get_session(session);
+  ParserWrapper pw{query_str};
+  if (pw.is_select_explain || pw.is_select_calcite_explain || pw.is_other_explain || pw.is_ddl || pw.is_update_dml) {
+    THROW_MAPD_EXCEPTION("Can only prepare SELECT statements.");
+  }
+  if (leaf_aggregator_.leafCount() > 0) {
+    THROW_MAPD_EXCEPTION("Prepared queries are not supported in distributed mode.");
+  }
+  LOG(INFO) << "prepare_query :" << session << ":query_str:" << query_str;
+  std::shared_ptr<const PreparedQuery> prepared_query;
+  try {
+    prepared_query = prepare_query_impl(session_info, session, query_str);
+  } catch (std::exception& e) {
+    THROW_MAPD_EXCEPTION(std::string("Exception: ") + e.what());
+  }
+  for (const auto& param : prepared_query->params) {
+    TTypeInfo param_type;
+    param_type.type = type_to_thrift(param.ti);
+    param_type.encoding = encoding_to_thrift(param.ti);
+    param_type.nullable = !param.ti.get_notnull();
+    param_type.is_array = false;
+    param_type.precision = param.ti.get_precision();
+    param_type.scale = param.ti.get_scale();
+    _return.param_types.push_back(param_type);
+  }
+  std::lock_guard<std::mutex> lock(prepared_queries_mutex_);
+  _return.handle = std::to_string(next_prepared_query_id_++);
+  prepared_queries_.emplace(_return.handle, prepared_query);
+}
+
+std::shared_ptr<const MapDHandler::PreparedQuery> MapDHandler::prepare_query_impl(
+    const Catalog_Namespace::SessionInfo& session_info,
+    const TSessionId& session,
+    const std::string& query_str) {
+  // get the version before planning, a concurrent metadata change must make the plan look stale
+  const auto catalog_version = calcite_->getCatalogVersion(session_info.get_catalog().get_currentDB().dbName);
+  const auto query_ra = parse_to_ra(query_str, session_info);
+  return std::make_shared<const PreparedQuery>(
+      PreparedQuery{session, query_str, query_ra, catalog_version, collect_query_parameters(query_ra)});
+}
+
+void MapDHandler::execute_prepared(TQueryResult& _return,
+                                   const TSessionId& session,
+                                   const std::string& handle,
+                                   const std::vector<TDatum>& params,
+                                   const bool column_format,
+                                   const std::string& nonce,
+                                   const int32_t first_n,
+                                   const int32_t at_most_n) {
+  if (first_n >= 0 && at_most_n >= 0) {
+    THROW_MAPD_EXCEPTION(std::string("At most one of first_n and at_most_n can be set"));
+  }
+  const auto session_info = get_session(session);
+  LOG(INFO) << "execute_prepared :" << session << ":handle:" << handle;
+  std::shared_ptr<const PreparedQuery> prepared_query;
+  {
+    std::lock_guard<std::mutex> lock(prepared_queries_mutex_);
+    const auto it = prepared_queries_.find(handle);
+    if (it == prepared_queries_.end() || it->second->session != session) {
+      THROW_MAPD_EXCEPTION("Prepared query handle not valid.");
+    }
+    prepared_query = it->second;
+  }
+  _return.total_time_ms = measure<>::execution([&]() {
+    if (leaf_handler_) {
+      leaf_handler_->flush_queue();
+    }
+    _return.nonce = nonce;
+    _return.execution_time_ms = 0;
+    try {
+      const auto& catalog_name = session_info.get_catalog().get_currentDB().dbName;
+      if (calcite_->getCatalogVersion(catalog_name) != prepared_query->catalog_version) {
+        // the metadata has changed since the query has been planned, plan it again
+        _return.execution_time_ms += measure<>::execution(
+            [&]() { prepared_query = prepare_query_impl(session_info, session, prepared_query->query_str); });
+        std::lock_guard<std::mutex> lock(prepared_queries_mutex_);
+        const auto it = prepared_queries_.find(handle);
+        if (it != prepared_queries_.end()) {
+          it->second = prepared_query;
+        }
+      } else {
+        // Calcite is skipped, the privileges could have been revoked since the query has been prepared
+        calcite_->checkAccessPrivileges(session_info, prepared_query->query_ra);
+      }
+      std::string query_ra;
+      _return.execution_time_ms += measure<>::execution(
+          [&]() { query_ra = bind_query_parameters(prepared_query->query_ra, prepared_query->params, params); });
+      execute_rel_alg(_return,
+                      query_ra,
+                      column_format,
+                      session_info,
+                      session_info.get_executor_device_type(),
+                      first_n,
+                      at_most_n,
+                      false,
+                      false);
+    } catch (std::exception& e) {
+      THROW_MAPD_EXCEPTION(std::string("Exception: ") + e.what());
+    }
+  });
+  LOG(INFO) << "execute_prepared-COMPLETED Total: " << _return.total_time_ms
+            << " (ms), Execution: " << _return.execution_time_ms << " (ms)";
+}
+
+void MapDHandler::close_prepared(const TSessionId& session, const std::string& handle) {
+  std::lock_guard<std::mutex> lock(prepared_queries_mutex_);
+  const auto it = prepared_queries_.find(handle);
+  if (it == prepared_queries_.end() || it->second->session != session) {
+    THROW_MAPD_EXCEPTION("Prepared query handle not valid.");
+  }
+  prepared_queries_.erase(it);
+}
+
 void MapDHandler::get_completion_hints(std::vector<TCompletionHint>& hints,
                                        const TSessionId& session,
                                        const std::string& sql,
@@ -1125,6 +1261,13 @@ TSessionId MapDHandler::getInvalidSessionId() const {
   return INVALID_SESSION_ID;
 }
 
+void MapDHandler::precompile_rel_alg(const TSessionId& session, const std::string& query_ra) {
+  const auto session_info = get_session(session);
+  // explaining a query compiles it but doesn't fetch any data
+  TQueryResult result;
+  execute_rel_alg(result, query_ra, true, session_info, session_info.get_executor_device_type(), -1, -1, true, false);
+}
+
 void MapDHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
                              const TSessionId& session,
                              const std::string& memory_level) {
@@ -1158,6 +1301,15 @@ void MapDHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
       md.is_free = gpu.isFree == Buffer_Namespace::MemStatus::FREE;
       nodeInfo.node_memory_data.push_back(md);
     }
+    for (const auto& table_stats : memInfo.tableStats) {
+      TTableMemoryStats ts;
+      ts.db_id = table_stats.first.first;
+      ts.table_id = table_stats.first.second;
+      ts.hits = table_stats.second.hits;
+      ts.misses = table_stats.second.misses;
+      ts.evictions = table_stats.second.evictions;
+      nodeInfo.table_stats.push_back(ts);
+    }
     _return.push_back(nodeInfo);
   }
   if (leaf_aggregator_.leafCount() > 0) {
@@ -1166,6 +1318,31 @@ void MapDHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
   }
 }
 
+void MapDHandler::get_code_cache_stats(std::vector<TCodeCacheStats>& _return, const TSessionId& session) {
+  get_session(session);
+  std::vector<TDeviceType::type> device_types{TDeviceType::CPU};
+  if (data_mgr_->gpusPresent()) {
+    device_types.push_back(TDeviceType::GPU);
+  }
+  for (const auto device_type : device_types) {
+    const auto cache_stats = Executor::getCodeCacheStats(device_type == TDeviceType::GPU ? ExecutorDeviceType::GPU
+                                                                                          : ExecutorDeviceType::CPU);
+    TCodeCacheStats stats;
+    stats.device_type = device_type;
+    stats.num_entries = cache_stats.entries;
+    stats.size = cache_stats.size;
+    stats.max_entries = cache_stats.max_entries;
+    stats.max_size = cache_stats.max_size;
+    stats.hits = cache_stats.hits;
+    stats.misses = cache_stats.misses;
+    stats.evictions = cache_stats.evictions;
+    const auto& buckets = CodeCache::compileTimeBuckets();
+    stats.compile_time_buckets_ms.assign(buckets.begin(), buckets.end());
+    stats.compile_time_counts.assign(cache_stats.compile_time_counts.begin(), cache_stats.compile_time_counts.end());
+    _return.push_back(stats);
+  }
+}
+
 void MapDHandler::get_databases(std::vector<TDBInfo>& dbinfos, const TSessionId& session) {
   const auto session_info = get_session(session);
   if (!isUserAuthorized(session_info, std::string("get_databases"))) {
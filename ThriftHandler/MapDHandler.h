@@ -54,6 +54,7 @@
 #include "QueryEngine/GpuMemUtils.h"
 #include "QueryEngine/JsonAccessors.h"
 #include "QueryEngine/TableGenerations.h"
+#include "QueryParameters.h"
 #include "Shared/MapDParameters.h"
 #include "Shared/StringTransform.h"
 #include "Shared/geosupport.h"
@@ -145,6 +146,7 @@ class MapDHandler : public MapDIf {
   void stop_heap_profile(const TSessionId& session);
   void get_heap_profile(std::string& _return, const TSessionId& session);
   void get_memory(std::vector<TNodeMemoryInfo>& _return, const TSessionId& session, const std::string& memory_level);
+  void get_code_cache_stats(std::vector<TCodeCacheStats>& _return, const TSessionId& session);
   void clear_cpu_memory(const TSessionId& session);
   void clear_gpu_memory(const TSessionId& session);
   void set_table_epoch(const TSessionId& session, const int db_id, const int table_id, const int new_epoch);
@@ -176,6 +178,16 @@ class MapDHandler : public MapDIf {
   void deallocate_df(const TDataFrame& df, const TDeviceType::type device_type, const int32_t device_id);
   void interrupt(const TSessionId& session);
   void sql_validate(TTableDescriptor& _return, const TSessionId& session, const std::string& query);
+  void prepare_query(TPreparedQuery& _return, const TSessionId& session, const std::string& query);
+  void execute_prepared(TQueryResult& _return,
+                        const TSessionId& session,
+                        const std::string& handle,
+                        const std::vector<TDatum>& params,
+                        const bool column_format,
+                        const std::string& nonce,
+                        const int32_t first_n,
+                        const int32_t at_most_n);
+  void close_prepared(const TSessionId& session, const std::string& handle);
   void set_execution_mode(const TSessionId& session, const TExecuteMode::type mode);
   void render_vega(TRenderResult& _return,
                    const TSessionId& session,
@@ -288,6 +300,9 @@ class MapDHandler : public MapDIf {
 
   TSessionId getInvalidSessionId() const;
 
+  // Compiles the given relational algebra without running it, to populate the code caches.
+  void precompile_rel_alg(const TSessionId& session, const std::string& query_ra);
+
   void internal_connect(TSessionId& session, const std::string& user, const std::string& dbname);
   void connectImpl(TSessionId& session,
                    const std::string& user,
@@ -422,6 +437,23 @@ class MapDHandler : public MapDIf {
   bool super_user_rights_;  // default is "false"; setting to "true" ignores passwd checks in "connect(..)" method
   const bool access_priv_check_;
 
+  // A query planned once by Calcite, with placeholders for the bound values.
+  struct PreparedQuery {
+    TSessionId session;
+    std::string query_str;
+    std::string query_ra;
+    size_t catalog_version;
+    std::vector<QueryParameter> params;
+  };
+
+  std::shared_ptr<const PreparedQuery> prepare_query_impl(const Catalog_Namespace::SessionInfo& session_info,
+                                                          const TSessionId& session,
+                                                          const std::string& query_str);
+
+  std::mutex prepared_queries_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const PreparedQuery>> prepared_queries_;
+  size_t next_prepared_query_id_;
+
   // Only for IPC device memory deallocation
   mutable std::mutex handle_to_dev_ptr_mutex_;
   mutable std::unordered_map<std::string, int8_t*> ipc_handle_to_dev_ptr_;
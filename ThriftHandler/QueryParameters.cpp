@@ -0,0 +1,203 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryParameters.h"
+
+#include "QueryEngine/CalciteDeserializerUtils.h"
+#include "QueryEngine/JsonAccessors.h"
+
+#include <boost/algorithm/string/replace.hpp>
+#include <glog/logging.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+bool is_parameter(const rapidjson::Value& node) {
+  return node.IsObject() && node.HasMember("dynamic_param");
+}
+
+void parse_ra(rapidjson::Document& query_ast, const std::string& query_ra) {
+  query_ast.Parse(query_ra.c_str());
+  CHECK(!query_ast.HasParseError());
+}
+
+template <class F>
+void visit_parameters(rapidjson::Value& node, const F& visitor) {
+  if (is_parameter(node)) {
+    visitor(node);
+    return;
+  }
+  if (node.IsObject()) {
+    for (auto it = node.MemberBegin(); it != node.MemberEnd(); ++it) {
+      visit_parameters(it->value, visitor);
+    }
+  } else if (node.IsArray()) {
+    for (auto it = node.Begin(); it != node.End(); ++it) {
+      visit_parameters(*it, visitor);
+    }
+  }
+}
+
+QueryParameter parse_parameter(const rapidjson::Value& param) {
+  const auto& type_obj = field(param, "type");
+  const auto type_name = json_str(field(type_obj, "type"));
+  SQLTypeInfo ti(to_sql_type(type_name), !json_bool(field(type_obj, "nullable")));
+  const auto precision_it = type_obj.FindMember("precision");
+  ti.set_precision(precision_it != type_obj.MemberEnd() ? json_i64(precision_it->value) : 0);
+  const auto scale_it = type_obj.FindMember("scale");
+  ti.set_scale(scale_it != type_obj.MemberEnd() ? json_i64(scale_it->value) : 0);
+  return {type_name, ti};
+}
+
+unsigned decimal_digits(int64_t val) {
+  unsigned digits = 1;
+  while (val /= 10) {
+    ++digits;
+  }
+  return digits;
+}
+
+int64_t floor_div(const int64_t dividend, const int64_t divisor) {
+  return dividend / divisor - (dividend % divisor < 0 ? 1 : 0);
+}
+
+// Builds the literal node MapDRelJson would have generated for the value in place of the parameter.
+rapidjson::Value to_literal(const QueryParameter& param,
+                            const TDatum& datum,
+                            rapidjson::Document::AllocatorType& allocator) {
+  const auto& ti = param.ti;
+  rapidjson::Value literal;
+  std::string type_name;
+  unsigned scale = 0;
+  unsigned precision = 0;
+  int type_precision = std::max(ti.get_precision(), 0);
+  if (datum.is_null) {
+    type_name = "NULL";
+  } else {
+    switch (ti.get_type()) {
+      case kBOOLEAN:
+        type_name = "BOOLEAN";
+        literal.SetBool(datum.val.int_val != 0);
+        break;
+      case kSMALLINT:
+      case kINT:
+      case kBIGINT:
+        type_name = "DECIMAL";
+        literal.SetInt64(datum.val.int_val);
+        precision = decimal_digits(datum.val.int_val);
+        if (!type_precision) {
+          // Calcite doesn't serialize the precision of integer types, use its defaults
+          type_precision = ti.get_type() == kSMALLINT ? 5 : ti.get_type() == kINT ? 10 : 19;
+        }
+        break;
+      case kDECIMAL:
+      case kNUMERIC:
+        type_name = "DECIMAL";
+        literal.SetInt64(std::llround(datum.val.real_val * std::pow(10., ti.get_scale())));
+        scale = ti.get_scale();
+        precision = ti.get_precision();
+        break;
+      case kFLOAT:
+      case kDOUBLE:
+        type_name = "DOUBLE";
+        literal.SetDouble(datum.val.real_val);
+        break;
+      case kTEXT:
+      case kCHAR:
+      case kVARCHAR: {
+        type_name = "CHAR";
+        // same escaping as the literals serialized by Calcite
+        const auto str_val = boost::replace_all_copy(datum.val.str_val, "\\", "\\\\");
+        literal.SetString(str_val.c_str(), str_val.size(), allocator);
+        precision = datum.val.str_val.size();
+        break;
+      }
+      // Calcite represents times and timestamps in milliseconds, dates in days
+      case kTIME:
+      case kTIMESTAMP:
+        type_name = ti.get_type() == kTIME ? "TIME" : "TIMESTAMP";
+        literal.SetInt64(datum.val.int_val * 1000);
+        break;
+      case kDATE:
+        type_name = "DATE";
+        literal.SetInt64(floor_div(datum.val.int_val, 86400));
+        break;
+      default:
+        throw std::runtime_error("Parameters of type " + param.type_name + " not supported");
+    }
+  }
+  rapidjson::Value node(rapidjson::kObjectType);
+  node.AddMember("literal", literal, allocator);
+  node.AddMember("type", rapidjson::Value(type_name.c_str(), type_name.size(), allocator), allocator);
+  node.AddMember(
+      "target_type", rapidjson::Value(param.type_name.c_str(), param.type_name.size(), allocator), allocator);
+  node.AddMember("scale", scale, allocator);
+  node.AddMember("precision", precision, allocator);
+  node.AddMember("type_scale", ti.get_scale(), allocator);
+  node.AddMember("type_precision", type_precision, allocator);
+  return node;
+}
+
+}  // namespace
+
+std::vector<QueryParameter> collect_query_parameters(const std::string& query_ra) {
+  rapidjson::Document query_ast;
+  parse_ra(query_ast, query_ra);
+  std::vector<QueryParameter> params;
+  std::vector<bool> seen;
+  visit_parameters(query_ast, [&params, &seen](const rapidjson::Value& param) {
+    const auto index = json_i64(field(param, "dynamic_param"));
+    CHECK_GE(index, 0);
+    if (static_cast<size_t>(index) >= params.size()) {
+      params.resize(index + 1);
+      seen.resize(index + 1, false);
+    }
+    if (!seen[index]) {
+      params[index] = parse_parameter(param);
+      seen[index] = true;
+    }
+  });
+  for (const bool param_seen : seen) {
+    CHECK(param_seen);
+  }
+  return params;
+}
+
+std::string bind_query_parameters(const std::string& query_ra,
+                                  const std::vector<QueryParameter>& params,
+                                  const std::vector<TDatum>& values) {
+  if (params.size() != values.size()) {
+    throw std::runtime_error("Query expects " + std::to_string(params.size()) + " parameters, " +
+                             std::to_string(values.size()) + " given");
+  }
+  rapidjson::Document query_ast;
+  parse_ra(query_ast, query_ra);
+  auto& allocator = query_ast.GetAllocator();
+  visit_parameters(query_ast, [&params, &values, &allocator](rapidjson::Value& param) {
+    const auto index = json_i64(field(param, "dynamic_param"));
+    CHECK_LT(static_cast<size_t>(index), params.size());
+    param = to_literal(params[index], values[index], allocator);
+  });
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  query_ast.Accept(writer);
+  return buffer.GetString();
+}
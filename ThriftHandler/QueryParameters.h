@@ -0,0 +1,50 @@
+/*
+ * Copyright 2017 MapD Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    QueryParameters.h
+ * @brief   Binding of the values of prepared queries to the placeholders of their plan.
+ *
+ * Calcite serializes a '?' placeholder as a {"dynamic_param": index, "type": ...} node of
+ * the relational algebra. Binding replaces every such node with a literal node of the same
+ * shape Calcite would have generated for the value, so the rest of the engine doesn't know
+ * about parameters. Since literals are hoisted, the generated code doesn't depend on them
+ * and is shared across executions of the same prepared query.
+ */
+
+#ifndef THRIFTHANDLER_QUERYPARAMETERS_H
+#define THRIFTHANDLER_QUERYPARAMETERS_H
+
+#include "Shared/sqltypes.h"
+#include "gen-cpp/mapd_types.h"
+
+#include <string>
+#include <vector>
+
+struct QueryParameter {
+  std::string type_name;  // as serialized by Calcite
+  SQLTypeInfo ti;
+};
+
+// Returns the parameters of the plan, ordered by their index.
+std::vector<QueryParameter> collect_query_parameters(const std::string& query_ra);
+
+// Returns the plan with the placeholders replaced by the values, throws if a value doesn't fit its parameter.
+std::string bind_query_parameters(const std::string& query_ra,
+                                  const std::vector<QueryParameter>& params,
+                                  const std::vector<TDatum>& values);
+
+#endif  // THRIFTHANDLER_QUERYPARAMETERS_H
@@ -121,6 +121,105 @@ DEVICE static void decompress(const SQLTypeInfo& ti, int8_t* compressed, VarlenD
   result->is_null = ti.is_null(*datum);
 }
 
+DEVICE static int64_t fixed_width_int(const int8_t* byte_stream, const int byte_width, const int64_t pos) {
+  switch (byte_width) {
+    case 1:
+      return byte_stream[pos];
+    case 2:
+      return reinterpret_cast<const int16_t*>(byte_stream)[pos];
+    case 4:
+      return reinterpret_cast<const int32_t*>(byte_stream)[pos];
+    case 8:
+      return reinterpret_cast<const int64_t*>(byte_stream)[pos];
+    default:
+      assert(false);
+  }
+  return 0;
+}
+
+// Run length, differential and bit-packed chunks can't be addressed by element, decodes the nth
+// element from the start of the chunk. See RunLengthEncoder, DiffEncoder and BitPacking.h for the layouts.
+DEVICE static void decompress_nth(const SQLTypeInfo& ti,
+                                  const int8_t* chunk,
+                                  const int64_t n,
+                                  VarlenDatum* result,
+                                  Datum* datum) {
+  const int byte_width = ti.get_size();
+  int64_t val;
+  bool is_null = false;
+  if (ti.get_compression() == kENCODING_RL) {
+    int64_t lo = 1;
+    int64_t hi = fixed_width_int(chunk, byte_width, 0);
+    while (lo < hi) {
+      const int64_t mid = lo + (hi - lo) / 2;
+      if (fixed_width_int(chunk, byte_width, 2 * mid) > n) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    val = fixed_width_int(chunk, byte_width, 2 * lo + 1);
+  } else if (ti.get_compression() == kENCODING_PACKED) {
+    const int bit_width = ti.get_comp_param();
+    const int64_t bit = n * bit_width;
+    uint64_t word = 0;
+    for (int i = 0; i < 8; ++i) {
+      word |= static_cast<uint64_t>(static_cast<uint8_t>(chunk[(bit >> 3) + i])) << (8 * i);
+    }
+    const uint64_t sign = static_cast<uint64_t>(1) << (bit_width - 1);
+    val = static_cast<int64_t>((((word >> (bit & 7)) & ((sign << 1) - 1)) ^ sign) - sign);
+    is_null = val == -static_cast<int64_t>(sign);
+  } else {
+    assert(ti.get_compression() == kENCODING_DIFF);
+    const int64_t diff = fixed_width_int(chunk + sizeof(int64_t), byte_width, n);
+    is_null = diff == -(1LL << (8 * byte_width - 1));
+    val = fixed_width_int(chunk, sizeof(int64_t), 0) + diff;
+  }
+  if (is_null) {
+    // hand out the logical null value, the run length encoder already stores it
+    val = ti.get_type() == kSMALLINT ? NULL_SMALLINT : ti.get_type() == kINT ? NULL_INT : NULL_BIGINT;
+  }
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+      datum->boolval = static_cast<int8_t>(val);
+      result->length = sizeof(int8_t);
+      result->pointer = (int8_t*)&datum->boolval;
+      break;
+    case kSMALLINT:
+      datum->smallintval = static_cast<int16_t>(val);
+      result->length = sizeof(int16_t);
+      result->pointer = (int8_t*)&datum->smallintval;
+      break;
+    case kINT:
+      datum->intval = static_cast<int32_t>(val);
+      result->length = sizeof(int32_t);
+      result->pointer = (int8_t*)&datum->intval;
+      break;
+    case kBIGINT:
+    case kNUMERIC:
+    case kDECIMAL:
+      datum->bigintval = val;
+      result->length = sizeof(int64_t);
+      result->pointer = (int8_t*)&datum->bigintval;
+      break;
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      datum->timeval = static_cast<time_t>(val);
+      result->length = sizeof(time_t);
+      result->pointer = (int8_t*)&datum->timeval;
+      break;
+    default:
+      assert(false);
+  }
+  result->is_null = is_null || ti.is_null(*datum);
+}
+
+DEVICE static bool is_element_addressable(const SQLTypeInfo& ti) {
+  return ti.get_compression() != kENCODING_RL && ti.get_compression() != kENCODING_DIFF &&
+         ti.get_compression() != kENCODING_PACKED;
+}
+
 void ChunkIter_reset(ChunkIter* it) {
   it->current_pos = it->start_pos;
 }
@@ -137,7 +236,11 @@ DEVICE void ChunkIter_get_next(ChunkIter* it, bool uncompress, VarlenDatum* resu
 
   if (it->skip_size > 0) {
     // for fixed-size
-    if (uncompress && it->type_info.get_compression() != kENCODING_NONE) {
+    if (!is_element_addressable(it->type_info)) {
+      // positions are virtual, second_buf holds the start of the chunk
+      const int64_t n = (it->current_pos - it->second_buf) / it->skip_size;
+      decompress_nth(it->type_info, it->second_buf, n, result, &it->datum);
+    } else if (uncompress && it->type_info.get_compression() != kENCODING_NONE) {
       decompress(it->type_info, it->current_pos, result, &it->datum);
     } else {
       result->length = it->skip_size;
@@ -169,7 +272,9 @@ DEVICE void ChunkIter_get_nth(ChunkIter* it, int n, bool uncompress, VarlenDatum
   if (it->skip_size > 0) {
     // for fixed-size
     int8_t* current_pos = it->start_pos + n * it->skip_size;
-    if (uncompress && it->type_info.get_compression() != kENCODING_NONE) {
+    if (!is_element_addressable(it->type_info)) {
+      decompress_nth(it->type_info, it->second_buf, (current_pos - it->second_buf) / it->skip_size, result, &it->datum);
+    } else if (uncompress && it->type_info.get_compression() != kENCODING_NONE) {
       decompress(it->type_info, current_pos, result, &it->datum);
     } else {
       result->length = it->skip_size;
@@ -0,0 +1,40 @@
+#.rst:
+# FindLZ4
+# --------
+#
+# Find the lz4 compression library
+#
+# IMPORTED Targets
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines the :prop_tgt:`IMPORTED` target ``LZ4::LZ4``,
+# if LZ4 has been found.
+#
+# Result Variables
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines the following variables:
+#
+# ::
+#
+#   LZ4_INCLUDE_DIRS - include directories for LZ4
+#   LZ4_LIBRARIES - libraries to link against LZ4
+#   LZ4_FOUND - true if LZ4 has been found and can be used
+
+find_path(LZ4_INCLUDE_DIR lz4.h)
+find_library(LZ4_LIBRARY NAMES lz4 PATH_SUFFIXES lib64)
+
+set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4 REQUIRED_VARS LZ4_INCLUDE_DIR LZ4_LIBRARY)
+
+if(LZ4_FOUND AND NOT TARGET LZ4::LZ4)
+  add_library(LZ4::LZ4 UNKNOWN IMPORTED)
+  set_target_properties(LZ4::LZ4 PROPERTIES
+    IMPORTED_LOCATION "${LZ4_LIBRARY}"
+    INTERFACE_INCLUDE_DIRECTORIES "${LZ4_INCLUDE_DIRS}")
+endif()
+
+mark_as_advanced(LZ4_INCLUDE_DIR LZ4_LIBRARY)
@@ -0,0 +1,40 @@
+#.rst:
+# FindZstd
+# --------
+#
+# Find the zstd compression library
+#
+# IMPORTED Targets
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines the :prop_tgt:`IMPORTED` target ``Zstd::Zstd``,
+# if Zstd has been found.
+#
+# Result Variables
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines the following variables:
+#
+# ::
+#
+#   Zstd_INCLUDE_DIRS - include directories for Zstd
+#   Zstd_LIBRARIES - libraries to link against Zstd
+#   Zstd_FOUND - true if Zstd has been found and can be used
+
+find_path(Zstd_INCLUDE_DIR zstd.h)
+find_library(Zstd_LIBRARY NAMES zstd PATH_SUFFIXES lib64)
+
+set(Zstd_INCLUDE_DIRS ${Zstd_INCLUDE_DIR})
+set(Zstd_LIBRARIES ${Zstd_LIBRARY})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Zstd REQUIRED_VARS Zstd_INCLUDE_DIR Zstd_LIBRARY)
+
+if(Zstd_FOUND AND NOT TARGET Zstd::Zstd)
+  add_library(Zstd::Zstd UNKNOWN IMPORTED)
+  set_target_properties(Zstd::Zstd PROPERTIES
+    IMPORTED_LOCATION "${Zstd_LIBRARY}"
+    INTERFACE_INCLUDE_DIRECTORIES "${Zstd_INCLUDE_DIRS}")
+endif()
+
+mark_as_advanced(Zstd_INCLUDE_DIR Zstd_LIBRARY)
@@ -24,7 +24,8 @@ enum TEncodingType {
   RL,
   DIFF,
   DICT,
-  SPARSE
+  SPARSE,
+  PACKED
 }
 
 enum TExecuteMode {
@@ -130,6 +131,15 @@ struct TQueryResult {
   2: i64 execution_time_ms
   3: i64 total_time_ms
   4: string nonce
+  5: i64 plan_cache_hits
+  6: i64 plan_cache_misses
+  7: i64 plan_cache_entries
+  8: i64 plan_cache_max_entries
+}
+
+struct TPreparedQuery {
+  1: string handle
+  2: list<TTypeInfo> param_types
 }
 
 struct TDataFrame {
@@ -195,6 +205,10 @@ struct TServerStatus {
   4: i64 start_time
   5: string edition
   6: string host_name
+  7: i64 fragment_worker_threads
+  8: i64 fragment_tasks_executed
+  9: i64 fragment_tasks_stolen
+  10: i64 fragment_worker_idle_ms
 }
 
 typedef map<string, TRenderProperty> TRenderPropertyMap
@@ -253,6 +267,14 @@ struct TMemoryData {
   7: bool is_free
 }
 
+struct TTableMemoryStats {
+  1: i32 db_id
+  2: i32 table_id
+  3: i64 hits
+  4: i64 misses
+  5: i64 evictions
+}
+
 struct TNodeMemoryInfo {
   1: string host_name
   2: i64 page_size
@@ -260,6 +282,20 @@ struct TNodeMemoryInfo {
   4: i64 num_pages_allocated
   5: bool is_allocation_capped
   6: list<TMemoryData> node_memory_data
+  7: list<TTableMemoryStats> table_stats
+}
+
+struct TCodeCacheStats {
+  1: TDeviceType device_type
+  2: i64 num_entries
+  3: i64 size
+  4: i64 max_entries
+  5: i64 max_size
+  6: i64 hits
+  7: i64 misses
+  8: i64 evictions
+  9: list<i64> compile_time_buckets_ms
+  10: list<i64> compile_time_counts
 }
 
 struct TTableDetails {
@@ -386,6 +422,7 @@ service MapD {
   void stop_heap_profile(1: TSessionId session) throws (1: TMapDException e)
   string get_heap_profile(1: TSessionId session) throws (1: TMapDException e)
   list<TNodeMemoryInfo> get_memory(1: TSessionId session, 2: string memory_level) throws (1: TMapDException e)
+  list<TCodeCacheStats> get_code_cache_stats(1: TSessionId session) throws (1: TMapDException e)
   void clear_cpu_memory(1: TSessionId session) throws (1: TMapDException e)
   void clear_gpu_memory(1: TSessionId session) throws (1: TMapDException e)
   void set_table_epoch (1: TSessionId session 2: i32 db_id 3: i32 table_id 4: i32 new_epoch) throws (1: TMapDException e)
@@ -397,6 +434,9 @@ service MapD {
   void deallocate_df(1: TDataFrame df, 2: TDeviceType device_type, 3: i32 device_id = 0) throws (1: TMapDException e)
   void interrupt(1: TSessionId session) throws (1: TMapDException e)
   TTableDescriptor sql_validate(1: TSessionId session, 2: string query) throws (1: TMapDException e)
+  TPreparedQuery prepare_query(1: TSessionId session, 2: string query) throws (1: TMapDException e)
+  TQueryResult execute_prepared(1: TSessionId session, 2: string handle, 3: list<TDatum> params, 4: bool column_format, 5: string nonce, 6: i32 first_n = -1, 7: i32 at_most_n = -1) throws (1: TMapDException e)
+  void close_prepared(1: TSessionId session, 2: string handle) throws (1: TMapDException e)
   list<completion_hints.TCompletionHint> get_completion_hints(1: TSessionId session, 2:string sql, 3:i32 cursor) throws (1: TMapDException e)
   void set_execution_mode(1: TSessionId session, 2: TExecuteMode mode) throws (1: TMapDException e)
   TRenderResult render_vega(1: TSessionId session, 2: i64 widget_id, 3: string vega_json, 4: i32 compression_level, 5: string nonce) throws (1: TMapDException e)